@@ -1,12 +1,26 @@
 function(usFunctionCreateDSTestBundle name)
+  cmake_parse_arguments(US_DS_TEST "PRECOMPILE_METADATA" "" "" ${ARGN})
+
   # Add in rule for how to build the autogen source for the glue
 
   set(_glue_file ${CMAKE_CURRENT_BINARY_DIR}/autogen_${name}_Glue.cpp)
   set(_glue_file ${_glue_file} PARENT_SCOPE)
 
+  set(_outputs ${_glue_file})
+  set(_metadata_args )
+  if(US_DS_TEST_PRECOMPILE_METADATA)
+    # The precompiled metadata is embedded as the binary resource scr/metadata.bin.
+    # The manifest must set "precompiled_metadata" to true in its "scr" section.
+    set(_metadata_file ${CMAKE_CURRENT_BINARY_DIR}/resources/scr/metadata.bin)
+    set(_metadata_file ${_metadata_file} PARENT_SCOPE)
+    list(APPEND _outputs ${_metadata_file})
+    set(_metadata_args --metadata-out-file ${_metadata_file})
+    file(MAKE_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}/resources/scr)
+  endif()
+
   add_custom_command(
-    OUTPUT ${_glue_file}
-    COMMAND $<TARGET_FILE:SCRCodeGen> --manifest ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json --out-file ${_glue_file} --include-headers ServiceComponents.hpp
+    OUTPUT ${_outputs}
+    COMMAND $<TARGET_FILE:SCRCodeGen> --manifest ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json --out-file ${_glue_file} --include-headers ServiceComponents.hpp ${_metadata_args}
     DEPENDS SCRCodeGen usServiceComponent ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json
     COMMENT "Generate bundle activator based on manifest.json"
     VERBATIM)
@@ -104,6 +104,9 @@ public:
    *  if the Configuration caused a bundle's shared library to be loaded and the bundle failed
    *  a security check.
    *
+   * @remarks On a thread holding a ConfigurationAdmin::BeginUpdateBatch batch, the returned
+   *  future only becomes ready once the batch has ended; it must not be waited on inside the batch.
+   *
    * @return a shared_future<void> which can be used to wait for the asynchronous
    * operation that pushed the update to a ManagedService, ManagedServiceFactory or
    * ConfigurationListener to complete. If an exception occurs during the execution
@@ -132,6 +135,9 @@ public:
    *  if the Configuration caused a bundle's shared library to be loaded and the bundle failed
    *  a security check.
    * 
+   * @remarks On a thread holding a ConfigurationAdmin::BeginUpdateBatch batch, the returned
+   *  future only becomes ready once the batch has ended; it must not be waited on inside the batch.
+   *
    * @return std::pair<boolean, std::shared_future<void>> The boolean indicates whether 
    * the properties were updated or not. The shared_future<void> allows access to the result of the asynchronous 
    * operation that pushed the update operation to a ManagedService, ManagedServiceFactory or 
@@ -152,6 +158,9 @@ public:
    *
    * @throws std::runtime_error if this Configuration object has been Removed already
    * 
+   * @remarks On a thread holding a ConfigurationAdmin::BeginUpdateBatch batch, the returned
+   *  future only becomes ready once the batch has ended; it must not be waited on inside the batch.
+   *
    * @return a shared_future<void> to access the result of the asynchronous operation
    * that pushed the remove operation to a ManagedService, ManagedServiceFactory or 
    * ConfigurationListener. If an exception occurs during the execution
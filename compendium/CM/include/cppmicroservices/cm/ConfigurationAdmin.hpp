@@ -38,6 +38,20 @@ namespace cm {
  \brief Groups ConfigurationAdmin class related symbols.
  */
 
+/**
+ * \ingroup gr_configurationadmin
+ * A batch of configuration updates started with ConfigurationAdmin::BeginUpdateBatch.
+ * Destroying it ends the batch.
+ */
+class UpdateBatch
+{
+public:
+  UpdateBatch() = default;
+  UpdateBatch(const UpdateBatch&) = delete;
+  UpdateBatch& operator=(const UpdateBatch&) = delete;
+  virtual ~UpdateBatch() noexcept = default;
+};
+
 /**
  * \ingroup gr_configurationadmin 
  * The ConfigurationAdmin interface is the means by which applications and services can
@@ -98,6 +112,31 @@ public:
    */
   virtual std::vector<std::shared_ptr<Configuration>> ListConfigurations(
     const std::string& filter = {}) = 0;
+
+  /**
+   * Start a batch of the configuration updates made on the calling thread. While the
+   * returned UpdateBatch exists, notifications of ManagedServices, ManagedServiceFactories
+   * and ConfigurationListeners for the updates made on this thread are held back, and all
+   * updates to the same PID are coalesced into a single notification carrying the latest
+   * properties of that PID. Updates made on other threads are not affected. Batches may be
+   * nested; the held back notifications are delivered asynchronously when the outermost
+   * batch of the thread is destroyed.
+   *
+   * @warning The futures returned by Configuration::Update, UpdateIfDifferent and Remove on
+   * the thread holding a batch only become ready after its outermost batch is destroyed.
+   * Waiting on one of them on that thread while the batch exists never returns. If
+   * ConfigurationAdmin shuts down first, the held back notifications are dropped and their
+   * futures become ready.
+   *
+   * The default implementation returns a batch which does nothing: implementations which do
+   * not support batches deliver every notification as it happens.
+   *
+   * @return the batch, which ends when it is destroyed
+   */
+  virtual std::unique_ptr<UpdateBatch> BeginUpdateBatch()
+  {
+    return std::make_unique<UpdateBatch>();
+  }
 };
 }
 }
@@ -88,9 +88,12 @@ void CMActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
   auto const& headers = bundle.GetHeaders();
   // bundle has no "cm" configuration
   if (headers.find(CMConstants::CM_KEY) == std::end(headers)) {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "No CM Configuration found in bundle " +
-                  bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "No CM Configuration found in bundle " +
+          bundle.GetSymbolicName();
+      });
     return;
   }
 
@@ -102,14 +105,20 @@ void CMActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
   }
   // This bundle's configuration has not been loaded, so create the extension which will load it
   if (extensionFound) {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "CM Configuration already loaded from bundle " +
-                  bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "CM Configuration already loaded from bundle " +
+          bundle.GetSymbolicName();
+      });
     return;
   }
 
-  logger->Log(SeverityLevel::LOG_DEBUG,
-              "Creating CMBundleExtension ... " + bundle.GetSymbolicName());
+  logger->LogLazily(
+    SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "Creating CMBundleExtension ... " + bundle.GetSymbolicName();
+    });
   try {
     auto const& cmMetadata =
       cppmicroservices::ref_any_cast<cppmicroservices::AnyMap>(
@@ -133,9 +142,12 @@ void CMActivator::RemoveExtension(const cppmicroservices::Bundle& bundle)
   auto const& headers = bundle.GetHeaders();
   // bundle has no "cm" configuration
   if (headers.find(CMConstants::CM_KEY) == std::end(headers)) {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "No CM Configuration found in bundle " +
-                  bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "No CM Configuration found in bundle " +
+          bundle.GetSymbolicName();
+      });
     return;
   }
 
@@ -149,12 +161,18 @@ void CMActivator::RemoveExtension(const cppmicroservices::Bundle& bundle)
     }
   }
   if (extensionFound) {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "Removed CMBundleExtension for " + bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "Removed CMBundleExtension for " + bundle.GetSymbolicName();
+      });
     return;
   }
-  logger->Log(SeverityLevel::LOG_DEBUG,
-              "Found no CMBundleExtension for " + bundle.GetSymbolicName());
+  logger->LogLazily(
+    SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "Found no CMBundleExtension for " + bundle.GetSymbolicName();
+    });
 }
 
 void CMActivator::BundleChanged(const cppmicroservices::BundleEvent& evt)
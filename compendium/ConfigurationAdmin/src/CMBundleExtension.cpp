@@ -58,17 +58,23 @@ CMBundleExtension::CMBundleExtension(
   pidsAndChangeCountsAndIDs =
     configAdminImpl->AddConfigurations(std::move(configurationMetadata));
 
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "Created instance of CMBundleExtension for " +
-                bundleContext.GetBundle().GetSymbolicName());
+  logger->LogLazily(
+    cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "Created instance of CMBundleExtension for " +
+        bundleContext.GetBundle().GetSymbolicName();
+    });
 }
 
 CMBundleExtension::~CMBundleExtension()
 {
   try {
-    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-                "Deleting instance of CMBundleExtension for " +
-                  bundleContext.GetBundle().GetSymbolicName());
+    logger->LogLazily(
+      cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "Deleting instance of CMBundleExtension for " +
+          bundleContext.GetBundle().GetSymbolicName();
+      });
     configAdminImpl->RemoveConfigurations(pidsAndChangeCountsAndIDs);
   } catch (const std::exception&) {
     logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
@@ -117,5 +117,11 @@ void CMLogger::Log(const cppmicroservices::ServiceReferenceBase& sr,
     currLogger->Log(sr, level, message, ex);
   }
 }
+
+bool CMLogger::IsLevelEnabled(logservice::SeverityLevel level) const
+{
+  auto currLogger = std::atomic_load(&logService);
+  return currLogger && currLogger->IsLevelEnabled(level);
+}
 } // cmimpl
 } // cppmicroservices
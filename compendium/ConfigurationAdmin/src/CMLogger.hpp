@@ -63,6 +63,7 @@ public:
            logservice::SeverityLevel level,
            const std::string& message,
            const std::exception_ptr ex) override;
+  bool IsLevelEnabled(logservice::SeverityLevel level) const override;
 
   // methods from the cppmicroservices::ServiceTrackerCustomizer interface
   std::shared_ptr<TrackedParamType> AddingService(
@@ -20,13 +20,16 @@
 
  =============================================================================*/
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <stdexcept>
 #include <thread>
 
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/cm/ConfigurationException.hpp"
 #include "cppmicroservices/detail/ScopeGuard.h"
+#include "cppmicroservices/detail/Trace.h"
 
 #include "CMConstants.hpp"
 #include "ConfigurationAdminImpl.hpp"
@@ -43,6 +46,19 @@ std::string getFactoryPid(const std::string& pid)
   return pid.substr(0, pos);
 }
 
+// true if the LDAP attribute name refers to the pid of a Configuration. Attribute
+// names are matched case-insensitively.
+bool IsPidKey(const std::string& key)
+{
+  return key.size() == 3 &&
+         std::equal(std::begin(key),
+                    std::end(key),
+                    "pid",
+                    [](unsigned char lhs, char rhs) {
+                      return std::tolower(lhs) == rhs;
+                    });
+}
+
 void handleUpdatedException(const std::string& pid,
                             const cppmicroservices::AnyMap& properties,
                             cppmicroservices::logservice::LogService& logger,
@@ -86,6 +102,7 @@ void notifyServiceUpdated(
   const cppmicroservices::AnyMap& properties,
   cppmicroservices::logservice::LogService& logger)
 {
+  US_TRACE_SCOPE(trace, "cm", "update " + pid);
   try {
     managedService.Updated(properties);
   } catch (...) {
@@ -99,6 +116,7 @@ void notifyServiceUpdated(
   const cppmicroservices::AnyMap& properties,
   cppmicroservices::logservice::LogService& logger)
 {
+  US_TRACE_SCOPE(trace, "cm", "update " + pid);
   try {
     managedServiceFactory.Updated(pid, properties);
   } catch (...) {
@@ -174,11 +192,13 @@ ConfigurationAdminImpl::ConfigurationAdminImpl(
   , logger(lggr)
   , asyncWorkService(asyncWS)
   , futuresID{ 0u }
+  , updateBatchOwner(std::make_shared<UpdateBatchOwner>())
   , managedServiceTracker(cmContext, this)
   , managedServiceFactoryTracker(cmContext, this)
   , randomGenerator(std::random_device{}())
   , configListenerTracker(cmContext)
 {
+  updateBatchOwner->admin = this;
   managedServiceTracker.Open();
   managedServiceFactoryTracker.Open();
   configListenerTracker.Open();
@@ -186,6 +206,23 @@ ConfigurationAdminImpl::ConfigurationAdminImpl(
 
 ConfigurationAdminImpl::~ConfigurationAdminImpl()
 {
+  // Batches still held by their threads end without this object. Their
+  // notifications are dropped, the futures handed out for them become ready.
+  {
+    std::lock_guard<std::mutex> lk{ updateBatchOwner->mutex };
+    updateBatchOwner->admin = nullptr;
+  }
+  decltype(updateBatches) abandonedBatches;
+  {
+    std::lock_guard<std::mutex> lk{ pendingNotificationsMutex };
+    abandonedBatches.swap(updateBatches);
+  }
+  for (auto& batch : abandonedBatches) {
+    for (auto& held : batch.second.held) {
+      held.second.delivered.set_value();
+    }
+  }
+
   auto managedServiceWrappers = managedServiceTracker.GetServices();
   auto managedServiceFactoryWrappers =
     managedServiceFactoryTracker.GetServices();
@@ -206,6 +243,7 @@ ConfigurationAdminImpl::~ConfigurationAdminImpl()
     std::lock_guard<std::mutex> lk{ configurationsMutex };
     factoryInstancesCopy.swap(factoryInstances);
     configurationsToInvalidate.swap(configurations);
+    propertyIndex = ConfigurationPropertyIndex{};
   }
   for (const auto& configuration : configurationsToInvalidate) {
     configuration.second->Invalidate();
@@ -277,10 +315,13 @@ ConfigurationAdminImpl::GetConfiguration(const std::string& pid)
     }
     result = it->second;
   }
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "GetConfiguration: returning " +
-                (created ? std::string("new") : "existing") +
-                " Configuration instance with PID " + pid);
+  logger->LogLazily(
+    cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "GetConfiguration: returning " +
+        (created ? std::string("new") : "existing") +
+        " Configuration instance with PID " + pid;
+    });
   return result;
 }
 
@@ -308,10 +349,12 @@ ConfigurationAdminImpl::CreateFactoryConfiguration(
            .first;
     result = it->second;
   }
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "CreateFactoryConfiguration: returning new Configuration "
-              "instance with PID " +
-                pid);
+  logger->LogLazily(
+    cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "CreateFactoryConfiguration: returning new Configuration "
+        "instance with PID " + pid;
+    });
   return result;
 }
 
@@ -320,9 +363,12 @@ ConfigurationAdminImpl::GetFactoryConfiguration(const std::string& factoryPid,
                                                 const std::string& instanceName)
 {
   const auto pid = factoryPid + "~" + instanceName;
-  logger->Log(
+  logger->LogLazily(
     cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-    "GetFactoryConfiguration: deferring to GetConfiguration for PID " + pid);
+    [&] {
+      return "GetFactoryConfiguration: deferring to GetConfiguration for PID " +
+        pid;
+    });
   return GetConfiguration(pid);
 }
 /* ListConfigurations looks for configuration objects in the repository that match the 
@@ -338,50 +384,98 @@ ConfigurationAdminImpl::ListConfigurations(const std::string& filter)
 {
   std::vector<std::shared_ptr<cppmicroservices::service::cm::Configuration>>
     result;
-  {
+  // return all configuration objects if the filter is empty
+  if (filter.empty()) {
     std::lock_guard<std::mutex> lk{ configurationsMutex };
-
-    // return all configuration objects if the filter is empty
-    if (filter.empty()) {
-      result.reserve(configurations.size());
-      for (const auto& it : configurations) {
-        if (it.second->HasBeenUpdatedAtLeastOnce()) {
-          result.push_back(it.second);
-        }
+    result.reserve(configurations.size());
+    for (const auto& it : configurations) {
+      if (it.second->HasBeenUpdatedAtLeastOnce()) {
+        result.push_back(it.second);
       }
-      return result;
     }
+    return result;
+  }
 
-    // filter is not empty so look for pid and property matches
-    LDAPFilter ldap{ filter };
-    cppmicroservices::AnyMap pidMap{
-      cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS
-    };
+  // filter is not empty so look for pid and property matches
+  LDAPFilter ldap{ filter };
 
-    for (const auto& it : configurations) {
-      // configurations that have not yet been updated cannot be
-      // returned.
-      if (!it.second->HasBeenUpdatedAtLeastOnce()) {
-        continue;
+  // Use the property index to narrow down the configurations a single
+  // equality test can match. The index only ever returns a superset of the
+  // matches, the filter is still matched against each candidate below.
+  std::vector<std::pair<std::string, std::shared_ptr<ConfigurationImpl>>>
+    candidates;
+  {
+    std::lock_guard<std::mutex> lk{ configurationsMutex };
+    std::string key;
+    std::string value;
+    std::vector<std::string> pids;
+    bool indexed = false;
+    if (ConfigurationPropertyIndex::ParseEqualityFilter(filter, key, value)) {
+      if (IsPidKey(key)) {
+        pids.push_back(value);
+      }
+      propertyIndex.Find(key, value, pids);
+      indexed = true;
+    } else if (ConfigurationPropertyIndex::ParseEqualityFilter(
+                 filter, key, value, true) &&
+               IsPidKey(key) && value.find('~') == value.size() - 1) {
+      // "(pid=factoryPid~*)" lists the instances of a ManagedServiceFactory
+      const auto instances =
+        factoryInstances.find(value.substr(0, value.size() - 1));
+      if (instances != std::end(factoryInstances)) {
+        pids.insert(std::end(pids),
+                    std::begin(instances->second),
+                    std::end(instances->second));
       }
-      /* Create an AnyMap containing the pid or factoryPid so that the ldap filter 
-	   * functionality can be used to match the pid to the 
-	   * input parameter. Easy way to do the comparison since input parameter could 
-	   * contain a regular expression 
-	   */
-      pidMap["pid"] = it.first;
-
-      if (ldap.Match(pidMap)) {
-        // This configuration object has a matching pid.
-        result.emplace_back(it.second);
-      } else {
-        // The pid wasn't a match but the properties might be. Check those.
-        auto props = it.second->GetProperties();
-        if (ldap.Match(props)) {
-          result.emplace_back(it.second);
+      propertyIndex.FindKey(key, pids);
+      indexed = true;
+    }
+
+    if (indexed) {
+      std::sort(std::begin(pids), std::end(pids));
+      pids.erase(std::unique(std::begin(pids), std::end(pids)), std::end(pids));
+      candidates.reserve(pids.size());
+      for (const auto& pid : pids) {
+        auto it = configurations.find(pid);
+        if (it != std::end(configurations)) {
+          candidates.emplace_back(it->first, it->second);
         }
       }
-    } // end for
+    } else {
+      candidates.reserve(configurations.size());
+      for (const auto& it : configurations) {
+        candidates.emplace_back(it.first, it.second);
+      }
+    }
+  }
+
+  // The matching is done without holding the configurationsMutex, against
+  // the properties each Configuration had when it was looked at.
+  cppmicroservices::AnyMap pidMap{
+    cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS
+  };
+  for (auto& candidate : candidates) {
+    // configurations that have not yet been updated cannot be
+    // returned.
+    if (!candidate.second->HasBeenUpdatedAtLeastOnce()) {
+      continue;
+    }
+    auto props = candidate.second->GetPropertiesSnapshot();
+    if (!props) {
+      // removed since it was looked up
+      continue;
+    }
+    /* Create an AnyMap containing the pid or factoryPid so that the ldap filter 
+     * functionality can be used to match the pid to the 
+     * input parameter. Easy way to do the comparison since input parameter could 
+     * contain a regular expression 
+     */
+    pidMap["pid"] = candidate.first;
+
+    // either the pid or the properties might be a match.
+    if (ldap.Match(pidMap) || ldap.Match(*props)) {
+      result.emplace_back(std::move(candidate.second));
+    }
   }
   return result;
 }
@@ -416,6 +510,7 @@ std::vector<ConfigurationAddedInfo> ConfigurationAdminImpl::AddConfigurations(
                .emplace(pid,
                         std::move(newConfig))
                .first;
+        IndexProperties(pid, *it->second);
         pidsAndChangeCountsAndIDs.emplace_back(
           pid, changeCount, reinterpret_cast<std::uintptr_t>(it->second.get()));
         createdOrUpdated.push_back(true);
@@ -427,6 +522,9 @@ std::vector<ConfigurationAddedInfo> ConfigurationAdminImpl::AddConfigurations(
           it->second->UpdateWithoutNotificationIfDifferent(
             configMetadata.properties);
         changeCount = updatedAndChangeCount.second;
+        if (updatedAndChangeCount.first) {
+          IndexProperties(pid, *it->second);
+        }
         pidsAndChangeCountsAndIDs.emplace_back(
           pid,
           std::get<1>(updatedAndChangeCount),
@@ -439,6 +537,7 @@ std::vector<ConfigurationAddedInfo> ConfigurationAdminImpl::AddConfigurations(
         configurationsToInvalidate.push_back(std::move(it->second));
         it->second = std::make_shared<ConfigurationImpl>(
           this, pid, getFactoryPid(pid), configMetadata.properties);
+        IndexProperties(pid, *it->second);
         pidsAndChangeCountsAndIDs.emplace_back(
           pid, changeCount, reinterpret_cast<std::uintptr_t>(it->second.get()));
         createdOrUpdated.push_back(true);
@@ -454,15 +553,19 @@ std::vector<ConfigurationAddedInfo> ConfigurationAdminImpl::AddConfigurations(
     const auto& pid = pidAndChangeCountAndID.pid;
     if (createdOrUpdated[idx]) {
       NotifyConfigurationUpdated(pid);
-      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-                  "AddConfigurations: Created or Updated Configuration "
-                  "instance with PID " +
-                    pid);
+      logger->LogLazily(
+        cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+        [&] {
+          return "AddConfigurations: Created or Updated Configuration "
+            "instance with PID " + pid;
+        });
     } else {
-      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-                  "AddConfigurations: Configuration already existed with "
-                  "identical properties with PID " +
-                    pid);
+      logger->LogLazily(
+        cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+        [&] {
+          return "AddConfigurations: Configuration already existed with "
+            "identical properties with PID " + pid;
+        });
     }
     ++idx;
   }
@@ -502,6 +605,7 @@ void ConfigurationAdminImpl::RemoveConfigurations(
           removedAndUpdated.emplace_back(true, hasBeenUpdated);
           configurations.erase(it);
           RemoveFactoryInstanceIfRequired(pid);
+          propertyIndex.Remove(pid);
           continue;
         }
         // else Configuration now differs from the one the CMBundleExtension added. Do not remove it.
@@ -512,6 +616,7 @@ void ConfigurationAdminImpl::RemoveConfigurations(
         removedAndUpdated.emplace_back(true, hasBeenUpdated);
         configurations.erase(it);
         RemoveFactoryInstanceIfRequired(pid);
+        propertyIndex.Remove(pid);
       }
     }
   }
@@ -526,15 +631,20 @@ void ConfigurationAdminImpl::RemoveConfigurations(
       if (removedAndUpdated[idx].second) {
         NotifyConfigurationUpdated(pid);
       }
-      logger->Log(
+      logger->LogLazily(
         cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-        "RemoveConfigurations: Removed Configuration instance with PID " + pid);
+        [&] {
+          return "RemoveConfigurations: Removed Configuration instance "
+            "with PID " + pid;
+        });
     } else {
-      logger->Log(
+      logger->LogLazily(
         cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-        "RemoveConfigurations: Configuration with PID " + pid +
-          " was not removed"
-          " (either already removed, or it has been subsequently updated)");
+        [&] {
+          return "RemoveConfigurations: Configuration with PID " + pid +
+            " was not removed"
+            " (either already removed, or it has been subsequently updated)";
+        });
     }
     ++idx;
   }
@@ -551,97 +661,245 @@ std::shared_future<void> ConfigurationAdminImpl::NotifyConfigurationUpdated(
   // is not available and that method cannot be called. For this reason, NotifyConfigurationUpdated
   // should not be called for Remove operations unless the caller has already confirmed
   // the configuration object has been updated at least once. 
-  return PerformAsync([this, pid] {
-    AnyMap properties{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
-    std::string fPid;
-    std::string nonFPid;
-    auto removed = false;
-    auto hasBeenUpdated = false;
-    {
-      std::lock_guard<std::mutex> lk{ configurationsMutex };
-      const auto it = configurations.find(pid);
-      if (it == std::end(configurations)) {
-        removed = true;
-        hasBeenUpdated = true;
-       } else {
-        try {
-           hasBeenUpdated = it->second->HasBeenUpdatedAtLeastOnce();
-           properties = it->second->GetProperties();
-       } catch (const std::runtime_error&) {
-          // Configuration is being removed
-          removed = true;
-        }
-      }
+  //
+  // Notifications are coalesced per PID: if a notification for this PID has been requested
+  // but has not started yet (it is queued, or held back by an update batch), it will pick up
+  // the latest state of the configuration when it runs, so no further notification is needed.
+  // Notifications requested on a thread holding an update batch are held back by that batch.
+  std::shared_future<void> delivered;
+  {
+    std::lock_guard<std::mutex> lk{ pendingNotificationsMutex };
+    const auto batch = updateBatches.find(std::this_thread::get_id());
+    auto& notifications = (batch != std::end(updateBatches))
+                            ? batch->second.held
+                            : pendingNotifications;
+    auto it = notifications.find(pid);
+    if (it != std::end(notifications)) {
+      return it->second.future;
     }
-    // We can only send update notifications for configuration objects that have
-    // been updated. Just return without sending the notification for objects
-    // that have not yet been updated. 
-    if (!hasBeenUpdated) {
-      return;
+    auto& pending = notifications[pid];
+    pending.future = pending.delivered.get_future().share();
+    delivered = pending.future;
+    if (batch != std::end(updateBatches)) {
+      return delivered;
     }
-    if (pid.find('~') != std::string::npos) {
-      //this is a factory pid
-      fPid = pid;
-    } else {
-      nonFPid = pid;
-    }
-    const auto configurationListeners = configListenerTracker.GetServices();
-    auto type =
-      removed
-        ? cppmicroservices::service::cm::ConfigurationEventType::CM_DELETED
-        : cppmicroservices::service::cm::ConfigurationEventType::CM_UPDATED;
-
-    auto configAdminRef = cmContext.GetServiceReference<ConfigurationAdmin>();
-    for (const auto& it : configurationListeners) {
-      auto configEvent = cppmicroservices::service::cm::ConfigurationEvent(
-        configAdminRef, type, fPid, nonFPid);
-      it->configurationEvent((configEvent));
-    }
-
-    const auto managedServiceWrappers = managedServiceTracker.GetServices();
-    const auto it = std::find_if(
-      std::begin(managedServiceWrappers),
-      std::end(managedServiceWrappers),
-      [&pid](const auto& managedServiceWrapper) {
-        // The ServiceTracker will return a default constructed shared_ptr for each ManagedService
-        // that we aren't tracking. We must be careful not to dereference these!
-        return (managedServiceWrapper ? (pid == managedServiceWrapper->pid)
-                                      : false);
-      });
-    if (it != std::end(managedServiceWrappers)) {
-      const auto& managedServiceWrapper = *it;
-      notifyServiceUpdated(
-        pid, *(managedServiceWrapper->trackedService), properties, *logger);
+  }
+  PerformAsync([this, pid] { DeliverPendingNotification(pid); });
+  return delivered;
+}
+
+void ConfigurationAdminImpl::ChangeProperties(
+  const std::string& pid,
+  const std::function<void()>& change)
+{
+  std::lock_guard<std::mutex> lk{ configurationsMutex };
+  change();
+  auto it = configurations.find(pid);
+  if (it != std::end(configurations)) {
+    IndexProperties(pid, *it->second);
+  }
+}
+
+void ConfigurationAdminImpl::IndexProperties(
+  const std::string& pid,
+  const ConfigurationImpl& configuration)
+{
+  auto properties = configuration.GetPropertiesSnapshot();
+  if (properties) {
+    propertyIndex.Index(pid, properties);
+  } else {
+    propertyIndex.Remove(pid);
+  }
+}
+
+class ConfigurationAdminImpl::UpdateBatchImpl final
+  : public cppmicroservices::service::cm::UpdateBatch
+{
+public:
+  explicit UpdateBatchImpl(std::shared_ptr<UpdateBatchOwner> owner)
+    : owner(std::move(owner))
+    , thread(std::this_thread::get_id())
+  {}
+
+  ~UpdateBatchImpl() override
+  {
+    std::lock_guard<std::mutex> lk{ owner->mutex };
+    if (owner->admin) {
+      owner->admin->EndUpdateBatch(thread);
     }
-    const auto factoryPid = getFactoryPid(pid);
-    if (factoryPid.empty()) {
+  }
+
+private:
+  std::shared_ptr<UpdateBatchOwner> owner;
+  std::thread::id thread;
+};
+
+std::unique_ptr<cppmicroservices::service::cm::UpdateBatch>
+ConfigurationAdminImpl::BeginUpdateBatch()
+{
+  std::lock_guard<std::mutex> lk{ pendingNotificationsMutex };
+  ++updateBatches[std::this_thread::get_id()].depth;
+  return std::make_unique<UpdateBatchImpl>(updateBatchOwner);
+}
+
+void ConfigurationAdminImpl::EndUpdateBatch(std::thread::id thread)
+{
+  std::vector<std::string> pidsToNotify;
+  {
+    std::lock_guard<std::mutex> lk{ pendingNotificationsMutex };
+    auto batch = updateBatches.find(thread);
+    assert(batch != std::end(updateBatches) && "Invalid update batch iterator");
+    if (--batch->second.depth != 0u) {
       return;
     }
-    const auto managedServiceFactoryWrappers =
-      managedServiceFactoryTracker.GetServices();
-    const auto factoryIt = std::find_if(
-      std::begin(managedServiceFactoryWrappers),
-      std::end(managedServiceFactoryWrappers),
-      [&factoryPid](const auto& managedServiceFactoryWrapper) {
-        // The ServiceTracker will return a default constructed shared_ptr for each ManagedServiceFactory
-        // that we aren't tracking. We must be careful not to dereference these!
-        return (managedServiceFactoryWrapper
-                  ? (factoryPid == managedServiceFactoryWrapper->pid)
-                  : false);
-      });
-    if (factoryIt != std::end(managedServiceFactoryWrappers)) {
-      const auto& managedServiceFactoryWrapper = *factoryIt;
-      if (removed) {
-        notifyServiceRemoved(
-          pid, *(managedServiceFactoryWrapper->trackedService), *logger);
-      } else {
-        notifyServiceUpdated(pid,
-                             *(managedServiceFactoryWrapper->trackedService),
-                             properties,
-                             *logger);
+    for (auto& held : batch->second.held) {
+      auto it = pendingNotifications.find(held.first);
+      if (it != std::end(pendingNotifications)) {
+        // a notification which has not started yet delivers the latest state
+        it->second.coalesced.push_back(std::move(held.second.delivered));
+        continue;
+      }
+      pendingNotifications.emplace(held.first, std::move(held.second));
+      pidsToNotify.push_back(held.first);
+    }
+    updateBatches.erase(batch);
+  }
+  for (const auto& pid : pidsToNotify) {
+    try {
+      PerformAsync([this, pid] { DeliverPendingNotification(pid); });
+    } catch (...) {
+      // A batch ends in its destructor, which must not throw. Deliver the
+      // notification on this thread instead.
+      try {
+        DeliverPendingNotification(pid);
+      } catch (...) {
+        logger->Log(SeverityLevel::LOG_ERROR,
+                    "Failed to deliver the update notification for PID " +
+                      pid + " at the end of an update batch",
+                    std::current_exception());
+      }
+    }
+  }
+}
+
+void ConfigurationAdminImpl::DeliverPendingNotification(const std::string& pid)
+{
+  // Remove the pending notification before reading the configuration's state. Any update
+  // made after this point requests a new notification.
+  std::vector<std::promise<void>> delivered;
+  {
+    std::lock_guard<std::mutex> lk{ pendingNotificationsMutex };
+    auto it = pendingNotifications.find(pid);
+    assert(it != std::end(pendingNotifications) &&
+           "Invalid pending notification iterator");
+    delivered = std::move(it->second.coalesced);
+    delivered.push_back(std::move(it->second.delivered));
+    pendingNotifications.erase(it);
+  }
+  try {
+    DeliverConfigurationUpdated(pid);
+  } catch (...) {
+    for (auto& promise : delivered) {
+      promise.set_exception(std::current_exception());
+    }
+    throw;
+  }
+  for (auto& promise : delivered) {
+    promise.set_value();
+  }
+}
+
+void ConfigurationAdminImpl::DeliverConfigurationUpdated(const std::string& pid)
+{
+  AnyMap properties{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  std::string fPid;
+  std::string nonFPid;
+  auto removed = false;
+  auto hasBeenUpdated = false;
+  {
+    std::lock_guard<std::mutex> lk{ configurationsMutex };
+    const auto it = configurations.find(pid);
+    if (it == std::end(configurations)) {
+      removed = true;
+      hasBeenUpdated = true;
+     } else {
+      try {
+         hasBeenUpdated = it->second->HasBeenUpdatedAtLeastOnce();
+         properties = it->second->GetProperties();
+     } catch (const std::runtime_error&) {
+        // Configuration is being removed
+        removed = true;
       }
     }
-  });
+  }
+  // We can only send update notifications for configuration objects that have
+  // been updated. Just return without sending the notification for objects
+  // that have not yet been updated. 
+  if (!hasBeenUpdated) {
+    return;
+  }
+  if (pid.find('~') != std::string::npos) {
+    //this is a factory pid
+    fPid = pid;
+  } else {
+    nonFPid = pid;
+  }
+  const auto configurationListeners = configListenerTracker.GetServices();
+  auto type =
+    removed
+      ? cppmicroservices::service::cm::ConfigurationEventType::CM_DELETED
+      : cppmicroservices::service::cm::ConfigurationEventType::CM_UPDATED;
+
+  auto configAdminRef = cmContext.GetServiceReference<ConfigurationAdmin>();
+  for (const auto& it : configurationListeners) {
+    auto configEvent = cppmicroservices::service::cm::ConfigurationEvent(
+      configAdminRef, type, fPid, nonFPid);
+    it->configurationEvent((configEvent));
+  }
+
+  const auto managedServiceWrappers = managedServiceTracker.GetServices();
+  const auto it = std::find_if(
+    std::begin(managedServiceWrappers),
+    std::end(managedServiceWrappers),
+    [&pid](const auto& managedServiceWrapper) {
+      // The ServiceTracker will return a default constructed shared_ptr for each ManagedService
+      // that we aren't tracking. We must be careful not to dereference these!
+      return (managedServiceWrapper ? (pid == managedServiceWrapper->pid)
+                                    : false);
+    });
+  if (it != std::end(managedServiceWrappers)) {
+    const auto& managedServiceWrapper = *it;
+    notifyServiceUpdated(
+      pid, *(managedServiceWrapper->trackedService), properties, *logger);
+  }
+  const auto factoryPid = getFactoryPid(pid);
+  if (factoryPid.empty()) {
+    return;
+  }
+  const auto managedServiceFactoryWrappers =
+    managedServiceFactoryTracker.GetServices();
+  const auto factoryIt = std::find_if(
+    std::begin(managedServiceFactoryWrappers),
+    std::end(managedServiceFactoryWrappers),
+    [&factoryPid](const auto& managedServiceFactoryWrapper) {
+      // The ServiceTracker will return a default constructed shared_ptr for each ManagedServiceFactory
+      // that we aren't tracking. We must be careful not to dereference these!
+      return (managedServiceFactoryWrapper
+                ? (factoryPid == managedServiceFactoryWrapper->pid)
+                : false);
+    });
+  if (factoryIt != std::end(managedServiceFactoryWrappers)) {
+    const auto& managedServiceFactoryWrapper = *factoryIt;
+    if (removed) {
+      notifyServiceRemoved(
+        pid, *(managedServiceFactoryWrapper->trackedService), *logger);
+    } else {
+      notifyServiceUpdated(pid,
+                           *(managedServiceFactoryWrapper->trackedService),
+                           properties,
+                           *logger);
+    }
+  }
 }
 
 std::shared_future<void> ConfigurationAdminImpl::NotifyConfigurationRemoved(
@@ -672,6 +930,7 @@ std::shared_future<void> ConfigurationAdminImpl::NotifyConfigurationRemoved(
     hasBeenUpdated = it->second->HasBeenUpdatedAtLeastOnce();
     configurations.erase(it);
     RemoveFactoryInstanceIfRequired(pid);
+    propertyIndex.Remove(pid);
   }
   if (configurationToInvalidate && hasBeenUpdated) {
     auto removeFuture = NotifyConfigurationUpdated(pid);
@@ -679,8 +938,11 @@ std::shared_future<void> ConfigurationAdminImpl::NotifyConfigurationRemoved(
     // ConfigurationImpl which has called this method doesn't run its own destructor.
     PerformAsync(
       [this, pid, configuration = std::move(configurationToInvalidate)] {
-        logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-                    "Configuration with PID " + pid + " has been removed.");
+        logger->LogLazily(
+          cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+          [&] {
+            return "Configuration with PID " + pid + " has been removed.";
+          });
       });
 
     return removeFuture;
@@ -734,8 +996,11 @@ ConfigurationAdminImpl::AddingService(
 	// According to OSGI, creating a new Configuration object must not initiate a callback to the 
 	// Managed Service updated method until the properties are set in the Configuration with the 
 	// update method. Return here without sending notification.
-    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-                  "New ManagedService with PID " + pid);
+    logger->LogLazily(
+      cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "New ManagedService with PID " + pid;
+      });
     return std::make_shared<
         TrackedServiceWrapper<cppmicroservices::service::cm::ManagedService>>(
         pid, std::move(managedService));  
@@ -759,9 +1024,12 @@ ConfigurationAdminImpl::AddingService(
       });
     }
   }
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "New ManagedService with PID " + pid +
-                " has been added, and async Update has been queued.");
+  logger->LogLazily(
+    cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "New ManagedService with PID " + pid +
+        " has been added, and async Update has been queued.";
+    });
   return std::make_shared<
     TrackedServiceWrapper<cppmicroservices::service::cm::ManagedService>>(
     pid, std::move(managedService));
@@ -784,8 +1052,11 @@ void ConfigurationAdminImpl::RemovedService(
     service)
 {
   // No need to do anything other than log; ManagedService just won't receive any more updates to its Configuration.
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "ManagedService with PID " + service->pid + " has been removed.");
+  logger->LogLazily(
+    cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "ManagedService with PID " + service->pid + " has been removed.";
+    });
 }
 
 std::shared_ptr<
@@ -848,10 +1119,13 @@ ConfigurationAdminImpl::AddingService(
       }
     });
   }
-  logger->Log(
+  logger->LogLazily(
     cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-    "New ManagedServiceFactory with PID " + pid +
-      " has been added, and async Update has been queued for all updated instances.");
+    [&] {
+      return "New ManagedServiceFactory with PID " + pid +
+        " has been added, and async Update has been queued for all "
+        "updated instances.";
+    });
   return std::make_shared<TrackedServiceWrapper<
     cppmicroservices::service::cm::ManagedServiceFactory>>(
     pid, std::move(managedServiceFactory));
@@ -873,9 +1147,12 @@ void ConfigurationAdminImpl::RemovedService(
     cppmicroservices::service::cm::ManagedServiceFactory>>& service)
 {
   // No need to do anything other than log; ManagedServiceFactory just won't receive any more updates to any of its Configurations.
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "ManagedServiceFactory with PID " + service->pid +
-                " has been removed.");
+  logger->LogLazily(
+    cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "ManagedServiceFactory with PID " + service->pid +
+        " has been removed.";
+    });
 }
 
 template<typename Functor>
@@ -27,7 +27,10 @@
 #include <future>
 #include <mutex>
 #include <random>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/ServiceTracker.h"
@@ -41,6 +44,7 @@
 
 #include "ConfigurationAdminPrivate.hpp"
 #include "ConfigurationImpl.hpp"
+#include "ConfigurationPropertyIndex.hpp"
 
 namespace cppmicroservices {
 namespace cmimpl {
@@ -152,6 +156,15 @@ public:
   void RemoveConfigurations(
     std::vector<ConfigurationAddedInfo> pidsAndChangeCountsAndIDs) override;
 
+  /**
+   * Internal method used by {@code ConfigurationImpl} to change the properties of a {@code Configuration}
+   * and update the property index in the same critical section.
+   *
+   * See {@code ConfigurationAdminPrivate#ChangeProperties}
+   */
+  void ChangeProperties(const std::string& pid,
+                        const std::function<void()>& change) override;
+
   /**
    * Internal method used to notify any {@code ManagedService} or {@code ManagedServiceFactory} or 
    * {@code ConfigurationListener} of an update to a {@code Configuration}. Performs the 
@@ -162,6 +175,15 @@ public:
   std::shared_future<void> NotifyConfigurationUpdated(
     const std::string& pid) override;
 
+  /**
+   * Hold back the update notifications of the calling thread until the returned batch,
+   * and any batch of the thread it is nested in, is destroyed.
+   *
+   * See {@code ConfigurationAdmin#BeginUpdateBatch}
+   */
+  std::unique_ptr<cppmicroservices::service::cm::UpdateBatch>
+  BeginUpdateBatch() override;
+
   /**
    * Internal method used by {@code ConfigurationImpl} to notify any {@code ManagedService} or
    * {@code ManagedServiceFactory} of the removal of a {@code Configuration}. Performs the notifications
@@ -218,6 +240,17 @@ private:
   template<typename Functor>
   std::shared_future<void> PerformAsync(Functor&& f);
 
+  // Delivers the pending notification for pid. Runs asynchronously.
+  void DeliverPendingNotification(const std::string& pid);
+
+  // Ends a batch of the given thread, and schedules the notifications it held
+  // back when it was the thread's outermost batch. Called by UpdateBatchImpl.
+  void EndUpdateBatch(std::thread::id thread);
+
+  // Notifies the listeners and managed services of the current state of the
+  // Configuration with the given pid.
+  void DeliverConfigurationUpdated(const std::string& pid);
+
   // Used to generate a random instance name for CreateFactoryConfiguration
   std::string RandomInstanceName();
 
@@ -225,6 +258,10 @@ private:
   void AddFactoryInstanceIfRequired(const std::string& pid,
                                     const std::string& factoryPid);
   void RemoveFactoryInstanceIfRequired(const std::string& pid);
+  // Must be called with the configurationsMutex held, whenever the
+  // properties of a Configuration in configurations change.
+  void IndexProperties(const std::string& pid,
+                       const ConfigurationImpl& configuration);
 
   cppmicroservices::BundleContext cmContext;
   std::shared_ptr<cppmicroservices::logservice::LogService> logger;
@@ -233,11 +270,40 @@ private:
   std::unordered_map<std::string, std::shared_ptr<ConfigurationImpl>>
     configurations;
   std::unordered_map<std::string, std::set<std::string>> factoryInstances;
+  ConfigurationPropertyIndex propertyIndex;
   std::mutex futuresMutex;
   std::uint64_t futuresID;
   std::condition_variable futuresCV;
   std::vector<std::shared_future<void>> completeFutures;
   std::unordered_map<std::uint64_t, std::shared_future<void>> incompleteFutures;
+
+  // A notification which has been requested but has not started yet. Further
+  // notifications for the same pid are coalesced into it.
+  struct PendingNotification
+  {
+    std::promise<void> delivered;
+    std::shared_future<void> future;
+    // the notifications of ended batches which were coalesced into this one
+    std::vector<std::promise<void>> coalesced;
+  };
+  // The notifications held back by the batches of one thread
+  struct ThreadUpdateBatch
+  {
+    unsigned int depth = 0u;
+    std::unordered_map<std::string, PendingNotification> held;
+  };
+  // Shared with the batches handed out by BeginUpdateBatch, which may outlive
+  // this object. admin is reset when this object is destroyed.
+  struct UpdateBatchOwner
+  {
+    std::mutex mutex;
+    ConfigurationAdminImpl* admin;
+  };
+  class UpdateBatchImpl;
+  std::mutex pendingNotificationsMutex;
+  std::unordered_map<std::string, PendingNotification> pendingNotifications;
+  std::unordered_map<std::thread::id, ThreadUpdateBatch> updateBatches;
+  std::shared_ptr<UpdateBatchOwner> updateBatchOwner;
   cppmicroservices::ServiceTracker<
     cppmicroservices::service::cm::ManagedService,
     TrackedServiceWrapper<cppmicroservices::service::cm::ManagedService>>
@@ -25,6 +25,7 @@
 
 #include "metadata/ConfigurationMetadata.hpp"
 #include <cstdint>
+#include <functional>
 #include <future>
 #include <vector>
 
@@ -85,6 +86,22 @@ public:
   virtual void RemoveConfigurations(
     std::vector<ConfigurationAddedInfo> pidsAndChangeCountsAndIDs) = 0;
 
+  /**
+   * Internal method used by {@code ConfigurationImpl} to change the properties of a {@code Configuration}.
+   * The change is made under the same lock as the bookkeeping of the {@code Configuration} objects,
+   * so that a {@code ListConfigurations} which starts after this method has returned sees the new
+   * properties.
+   *
+   * @param pid The PID of the {@code Configuration} whose properties change
+   * @param change The function changing the properties. Exceptions it throws are propagated.
+   */
+  virtual void ChangeProperties(const std::string& pid,
+                                const std::function<void()>& change)
+  {
+    static_cast<void>(pid);
+    change();
+  }
+
   /**
    * Internal method used to notify any {@code ManagedService} or {@code ManagedServiceFactory} of an
    * update to a {@code Configuration}. Performs the notifications asynchronously with the latest state
@@ -41,7 +41,7 @@ ConfigurationImpl::ConfigurationImpl(ConfigurationAdminPrivate* configAdmin,
   : configAdminImpl(configAdmin)
   , pid(std::move(thePid))
   , factoryPid(std::move(theFactoryPid))
-  , properties(std::move(props))
+  , properties(std::make_shared<const AnyMap>(std::move(props)))
   , changeCount{ cCount }
   , removed{ false }
 {
@@ -49,7 +49,7 @@ ConfigurationImpl::ConfigurationImpl(ConfigurationAdminPrivate* configAdmin,
          "Invalid ConfigurationAdminPrivate pointer");
   // constructing a configuration object with properties is the equivalent
   // of a Create and an Update operation.
-  if ((properties.size() > 0) && (changeCount == 0u)) {
+  if ((properties->size() > 0) && (changeCount == 0u)) {
     changeCount++;
   }
 }
@@ -78,6 +78,15 @@ AnyMap ConfigurationImpl::GetProperties() const
   if (removed) {
     throw std::runtime_error(REMOVED_EXCEPTION_MESSAGE);
   }
+  return *properties;
+}
+
+std::shared_ptr<const AnyMap> ConfigurationImpl::GetPropertiesSnapshot() const
+{
+  std::lock_guard<std::mutex> lk{ propertiesMutex };
+  if (removed) {
+    return nullptr;
+  }
   return properties;
 }
 
@@ -92,18 +101,20 @@ unsigned long ConfigurationImpl::GetChangeCount() const
 
 std::shared_future<void> ConfigurationImpl::Update(AnyMap newProperties)
 {
-  {
+  auto update = [this, &newProperties] {
     std::lock_guard<std::mutex> lk{ propertiesMutex };
     if (removed) {
       throw std::runtime_error(REMOVED_EXCEPTION_MESSAGE);
     }
-    properties = std::move(newProperties);
+    properties = std::make_shared<const AnyMap>(std::move(newProperties));
     ++changeCount;
-  }
+  };
   std::lock_guard<std::mutex> lk{ configAdminMutex };
   if (configAdminImpl) {
-   return configAdminImpl->NotifyConfigurationUpdated(pid);
+    configAdminImpl->ChangeProperties(pid, update);
+    return configAdminImpl->NotifyConfigurationUpdated(pid);
   }
+  update();
   std::promise<void> ready;
   std::shared_future<void> fut = ready.get_future();
   ready.set_value();
@@ -115,13 +126,20 @@ std::pair<bool, std::shared_future<void>> ConfigurationImpl::UpdateIfDifferent(
 {
   std::promise<void> ready;
   std::shared_future<void> fut = ready.get_future();
-  const auto updated =
-    UpdateWithoutNotificationIfDifferent(std::move(newProperties));
+  std::pair<bool, unsigned long> updated;
+  auto update = [this, &newProperties, &updated] {
+    updated = UpdateWithoutNotificationIfDifferent(std::move(newProperties));
+  };
+  std::lock_guard<std::mutex> lk{ configAdminMutex };
+  if (configAdminImpl) {
+    configAdminImpl->ChangeProperties(pid, update);
+  } else {
+    update();
+  }
   if (!updated.first) {
     ready.set_value();
     return std::pair<bool, std::shared_future<void>>(updated.first, fut);
   }
-  std::lock_guard<std::mutex> lk{ configAdminMutex };
   if (configAdminImpl) {
     auto fut = configAdminImpl->NotifyConfigurationUpdated(pid);
     return std::pair<bool, std::shared_future<void>>(true, fut);
@@ -160,10 +178,10 @@ ConfigurationImpl::UpdateWithoutNotificationIfDifferent(AnyMap newProperties)
   if (removed) {
     throw std::runtime_error(REMOVED_EXCEPTION_MESSAGE);
   }
-  if (properties == newProperties) {
+  if (*properties == newProperties) {
     return std::pair<bool, unsigned long>{ false, 0u };
   }
-  properties = std::move(newProperties);
+  properties = std::make_shared<const AnyMap>(std::move(newProperties));
   return std::pair<bool, unsigned long>{ true, ++changeCount };
 }
 
@@ -73,6 +73,14 @@ public:
    */
   AnyMap GetProperties() const override;
 
+  /**
+   * Internal method used by {@code ConfigurationAdminImpl} to get the current properties
+   * without copying them. The returned map is never modified; an Update replaces it.
+   *
+   * @return the current properties, or nullptr if this Configuration has been removed.
+   */
+  std::shared_ptr<const AnyMap> GetPropertiesSnapshot() const;
+
   /**
    * Get the value of the changeCount
    *
@@ -147,7 +155,7 @@ private:
   mutable std::mutex propertiesMutex;
   std::string pid;
   std::string factoryPid;
-  AnyMap properties;
+  std::shared_ptr<const AnyMap> properties;
   unsigned long changeCount;
   bool removed;
 };
@@ -0,0 +1,184 @@
+/*=============================================================================
+
+ Library: CppMicroServices
+
+ Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+ file at the top-level directory of this distribution and at
+ https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+
+ =============================================================================*/
+
+#include "ConfigurationPropertyIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+std::string ToLower(std::string str)
+{
+  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+  return str;
+}
+}
+
+namespace cppmicroservices {
+namespace cmimpl {
+
+void ConfigurationPropertyIndex::Index(
+  const std::string& pid,
+  const std::shared_ptr<const AnyMap>& properties)
+{
+  auto it = indexed.find(pid);
+  if (it != std::end(indexed)) {
+    if (it->second == properties) {
+      return;
+    }
+    Erase(pid, *(it->second));
+  }
+  if (!properties || properties->empty()) {
+    if (it != std::end(indexed)) {
+      indexed.erase(it);
+    }
+    return;
+  }
+  Add(pid, *properties);
+  indexed[pid] = properties;
+}
+
+void ConfigurationPropertyIndex::Remove(const std::string& pid)
+{
+  auto it = indexed.find(pid);
+  if (it == std::end(indexed)) {
+    return;
+  }
+  Erase(pid, *(it->second));
+  indexed.erase(it);
+}
+
+void ConfigurationPropertyIndex::Find(const std::string& key,
+                                      const std::string& value,
+                                      std::vector<std::string>& pids) const
+{
+  auto keyIt = keys.find(ToLower(key));
+  if (keyIt == std::end(keys)) {
+    return;
+  }
+  const auto& keyIndex = keyIt->second;
+  auto valueIt = keyIndex.values.find(value);
+  if (valueIt != std::end(keyIndex.values)) {
+    pids.insert(
+      std::end(pids), std::begin(valueIt->second), std::end(valueIt->second));
+  }
+  pids.insert(
+    std::end(pids), std::begin(keyIndex.unindexed), std::end(keyIndex.unindexed));
+}
+
+void ConfigurationPropertyIndex::FindKey(const std::string& key,
+                                         std::vector<std::string>& pids) const
+{
+  auto keyIt = keys.find(ToLower(key));
+  if (keyIt == std::end(keys)) {
+    return;
+  }
+  const auto& keyIndex = keyIt->second;
+  for (const auto& value : keyIndex.values) {
+    pids.insert(std::end(pids), std::begin(value.second), std::end(value.second));
+  }
+  pids.insert(
+    std::end(pids), std::begin(keyIndex.unindexed), std::end(keyIndex.unindexed));
+}
+
+bool ConfigurationPropertyIndex::ParseEqualityFilter(
+  const std::string& filter,
+  std::string& key,
+  std::string& value,
+  bool allowTrailingWildcard)
+{
+  if (filter.size() < 4 || filter.front() != '(' || filter.back() != ')') {
+    return false;
+  }
+  const auto eq = filter.find('=');
+  if (eq == std::string::npos || eq == 1) {
+    return false;
+  }
+  key = filter.substr(1, eq - 1);
+  value = filter.substr(eq + 1, filter.size() - eq - 2);
+  // reject the other comparison operators (~=, <=, >=), presence tests,
+  // nested expressions, escapes and whitespace the LDAP parser would ignore
+  static const std::string keyDelimiters{ "()=<>~*\\ \t\r\n" };
+  static const std::string valueDelimiters{ "()\\" };
+  if (key.find_first_of(keyDelimiters) != std::string::npos ||
+      value.empty() ||
+      value.find_first_of(valueDelimiters) != std::string::npos ||
+      std::isspace(static_cast<unsigned char>(value.front())) ||
+      std::isspace(static_cast<unsigned char>(value.back()))) {
+    return false;
+  }
+  const auto star = value.find('*');
+  if (star == std::string::npos) {
+    return true;
+  }
+  if (!allowTrailingWildcard || star != value.size() - 1 || star == 0) {
+    return false;
+  }
+  value.pop_back();
+  return true;
+}
+
+void ConfigurationPropertyIndex::Add(const std::string& pid,
+                                     const AnyMap& properties)
+{
+  for (const auto& property : properties) {
+    auto& keyIndex = keys[ToLower(property.first)];
+    if (property.second.Type() == typeid(std::string)) {
+      keyIndex
+        .values[cppmicroservices::ref_any_cast<std::string>(property.second)]
+        .insert(pid);
+    } else {
+      keyIndex.unindexed.insert(pid);
+    }
+  }
+}
+
+void ConfigurationPropertyIndex::Erase(const std::string& pid,
+                                       const AnyMap& properties)
+{
+  for (const auto& property : properties) {
+    auto keyIt = keys.find(ToLower(property.first));
+    if (keyIt == std::end(keys)) {
+      continue;
+    }
+    auto& keyIndex = keyIt->second;
+    if (property.second.Type() == typeid(std::string)) {
+      auto valueIt = keyIndex.values.find(
+        cppmicroservices::ref_any_cast<std::string>(property.second));
+      if (valueIt != std::end(keyIndex.values)) {
+        valueIt->second.erase(pid);
+        if (valueIt->second.empty()) {
+          keyIndex.values.erase(valueIt);
+        }
+      }
+    } else {
+      keyIndex.unindexed.erase(pid);
+    }
+    if (keyIndex.values.empty() && keyIndex.unindexed.empty()) {
+      keys.erase(keyIt);
+    }
+  }
+}
+} // cmimpl
+} // cppmicroservices
@@ -0,0 +1,114 @@
+/*=============================================================================
+
+ Library: CppMicroServices
+
+ Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+ file at the top-level directory of this distribution and at
+ https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+
+ =============================================================================*/
+
+#ifndef CONFIGURATIONPROPERTYINDEX_HPP
+#define CONFIGURATIONPROPERTYINDEX_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cppmicroservices/AnyMap.h"
+
+namespace cppmicroservices {
+namespace cmimpl {
+
+/**
+ * An index from property key and string value to the PIDs of the
+ * {@code Configuration} objects which have that property, used by
+ * {@code ConfigurationAdminImpl#ListConfigurations} to narrow down the
+ * Configurations an equality filter such as "(key=value)" can match.
+ *
+ * The index returns a superset of the matching PIDs: keys are compared
+ * case-insensitively and properties whose value is not a std::string are
+ * always returned for their key. Callers must still match the filter
+ * against the candidates.
+ *
+ * This class is not thread-safe.
+ */
+class ConfigurationPropertyIndex
+{
+public:
+  /**
+   * Index (or re-index) the properties of the Configuration with the given pid.
+   * The properties are only processed if they differ from the ones the pid
+   * was last indexed with.
+   */
+  void Index(const std::string& pid,
+             const std::shared_ptr<const AnyMap>& properties);
+
+  /**
+   * Remove the Configuration with the given pid from the index.
+   */
+  void Remove(const std::string& pid);
+
+  /**
+   * Collect the PIDs of all Configurations which may have a property with
+   * the given key and value.
+   */
+  void Find(const std::string& key,
+            const std::string& value,
+            std::vector<std::string>& pids) const;
+
+  /**
+   * Collect the PIDs of all Configurations which have a property with the
+   * given key.
+   */
+  void FindKey(const std::string& key, std::vector<std::string>& pids) const;
+
+  /**
+   * Split a filter of the form "(key=value)" into its key and value. Filters
+   * containing anything but a single equality test of a literal value
+   * (i.e. no wildcards, escapes or nested expressions) are rejected.
+   *
+   * @param allowTrailingWildcard accept a value ending in '*' (the '*' is
+   *        removed from the returned value)
+   * @return true if the filter is a single equality test.
+   */
+  static bool ParseEqualityFilter(const std::string& filter,
+                                  std::string& key,
+                                  std::string& value,
+                                  bool allowTrailingWildcard = false);
+
+private:
+  struct KeyIndex
+  {
+    /// string value -> pids
+    std::unordered_map<std::string, std::unordered_set<std::string>> values;
+    /// pids whose value for this key is not a std::string
+    std::unordered_set<std::string> unindexed;
+  };
+
+  void Add(const std::string& pid, const AnyMap& properties);
+  void Erase(const std::string& pid, const AnyMap& properties);
+
+  /// lower case property key -> index of its values
+  std::unordered_map<std::string, KeyIndex> keys;
+  /// pid -> properties the pid was indexed with
+  std::unordered_map<std::string, std::shared_ptr<const AnyMap>> indexed;
+};
+} // cmimpl
+} // cppmicroservices
+
+#endif /* CONFIGURATIONPROPERTYINDEX_HPP */
@@ -20,6 +20,8 @@
 
  =============================================================================*/
 
+#include <future>
+#include <set>
 #include <sstream>
 
 #include "cppmicroservices/BundleContext.h"
@@ -340,6 +342,143 @@ TEST_F(TestConfigurationAdminImpl, VerifyListConfigurations)
   EXPECT_EQ(allConfigs.size(), 3ul);
 }
 
+TEST_F(TestConfigurationAdminImpl, VerifyListConfigurationsFilters)
+{
+  auto bundleContext = GetFramework().GetBundleContext();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService>
+    asyncWorkService =
+      std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(
+        bundleContext, fakeLogger);
+  ConfigurationAdminImpl configAdmin(
+    bundleContext, fakeLogger, asyncWorkService);
+
+  const auto conf1 = configAdmin.GetConfiguration("test.pid1");
+  const auto conf2 = configAdmin.GetConfiguration("test.pid2");
+  const auto factoryConf1 =
+    configAdmin.GetFactoryConfiguration("test.factory", "one");
+  const auto factoryConf2 =
+    configAdmin.GetFactoryConfiguration("test.factory", "two");
+
+  AnyMap props1{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  props1["foo"] = std::string{ "bar" };
+  props1["count"] = 5;
+  EXPECT_NO_THROW(conf1->Update(props1).get());
+
+  AnyMap props2{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  props2["foo"] = std::string{ "baz" };
+  props2["count"] = 6;
+  EXPECT_NO_THROW(conf2->Update(props2).get());
+
+  AnyMap factoryProps{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  factoryProps["foo"] = std::string{ "bar" };
+  EXPECT_NO_THROW(factoryConf1->Update(factoryProps).get());
+  EXPECT_NO_THROW(
+    factoryConf2->Update(AnyMap{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS })
+      .get());
+
+  auto pidsOf = [](const std::vector<std::shared_ptr<
+                     cppmicroservices::service::cm::Configuration>>& configs) {
+    std::set<std::string> pids;
+    for (const auto& config : configs) {
+      pids.insert(config->GetPid());
+    }
+    return pids;
+  };
+
+  // simple equality tests are served from the property index
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(foo=bar)")),
+            (std::set<std::string>{ "test.pid1", "test.factory~one" }));
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(FOO=baz)")),
+            (std::set<std::string>{ "test.pid2" }));
+  EXPECT_TRUE(configAdmin.ListConfigurations("(foo=BAR)").empty());
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(pid=test.pid2)")),
+            (std::set<std::string>{ "test.pid2" }));
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(pid=test.factory~*)")),
+            (std::set<std::string>{ "test.factory~one", "test.factory~two" }));
+
+  // values which are not strings are still matched
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(count=5)")),
+            (std::set<std::string>{ "test.pid1" }));
+
+  // anything else falls back to matching every configuration
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(count>=6)")),
+            (std::set<std::string>{ "test.pid2" }));
+  EXPECT_EQ(
+    pidsOf(configAdmin.ListConfigurations("(|(foo=baz)(pid=test.pid1))")),
+    (std::set<std::string>{ "test.pid1", "test.pid2" }));
+  EXPECT_EQ(
+    pidsOf(configAdmin.ListConfigurations("(foo=ba*)")),
+    (std::set<std::string>{ "test.pid1", "test.pid2", "test.factory~one" }));
+
+  // the index follows updates and removals
+  props1["foo"] = std::string{ "qux" };
+  EXPECT_NO_THROW(conf1->Update(props1).get());
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(foo=bar)")),
+            (std::set<std::string>{ "test.factory~one" }));
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(foo=qux)")),
+            (std::set<std::string>{ "test.pid1" }));
+
+  EXPECT_NO_THROW(factoryConf1->Remove().get());
+  EXPECT_TRUE(configAdmin.ListConfigurations("(foo=bar)").empty());
+  EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(pid=test.factory~*)")),
+            (std::set<std::string>{ "test.factory~two" }));
+}
+
+// A ListConfigurations which starts after an update has returned sees the
+// update, without waiting for the notifications.
+TEST_F(TestConfigurationAdminImpl, VerifyListConfigurationsAfterUpdate)
+{
+  auto bundleContext = GetFramework().GetBundleContext();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService>
+    asyncWorkService =
+      std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(
+        bundleContext, fakeLogger);
+  ConfigurationAdminImpl configAdmin(
+    bundleContext, fakeLogger, asyncWorkService);
+
+  constexpr int threadCount = 4;
+  constexpr int updateCount = 50;
+  std::vector<std::future<bool>> results;
+  for (int t = 0; t < threadCount; ++t) {
+    results.push_back(std::async(std::launch::async, [&configAdmin, t] {
+      const auto pid = "test.pid" + std::to_string(t);
+      const auto conf = configAdmin.GetConfiguration(pid);
+      for (int i = 0; i < updateCount; ++i) {
+        const auto value = std::to_string(t) + "_" + std::to_string(i);
+        AnyMap props{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+        props["value"] = value;
+        if (i % 2 == 0) {
+          conf->Update(props);
+        } else {
+          conf->UpdateIfDifferent(props);
+        }
+        const auto listed =
+          configAdmin.ListConfigurations("(value=" + value + ")");
+        if (listed.size() != 1 || listed.front()->GetPid() != pid) {
+          return false;
+        }
+      }
+      return true;
+    }));
+  }
+  for (auto& result : results) {
+    EXPECT_TRUE(result.get());
+  }
+
+  // configurations added from a bundle manifest are listed as soon as
+  // AddConfigurations returns, also inside an update batch
+  const auto batch = configAdmin.BeginUpdateBatch();
+  AnyMap props{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  props["value"] = std::string{ "added" };
+  configAdmin.AddConfigurations(
+    { metadata::ConfigurationMetadata("test.added", props) });
+  const auto listed = configAdmin.ListConfigurations("(value=added)");
+  ASSERT_EQ(listed.size(), 1u);
+  EXPECT_EQ(listed.front()->GetPid(), "test.added");
+}
+
 TEST_F(TestConfigurationAdminImpl, VerifyAddConfigurations)
 {
   auto bundleContext = GetFramework().GetBundleContext();
@@ -555,6 +694,129 @@ TEST_F(TestConfigurationAdminImpl, VerifyManagedServiceNotification)
   configAdmin.WaitForAllAsync();
 }
 
+// Updates made to the same PID during an update batch result in a single
+// notification carrying the latest properties.
+TEST_F(TestConfigurationAdminImpl, VerifyUpdateBatchCoalescesNotifications)
+{
+  auto bundleContext = GetFramework().GetBundleContext();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService>
+    asyncWorkService =
+      std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(
+        bundleContext, fakeLogger);
+  ConfigurationAdminImpl configAdmin(
+    bundleContext, fakeLogger, asyncWorkService);
+
+  AnyMap props{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  AnyMap lastProps{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  const int updateCount = 100;
+  lastProps["count"] = updateCount - 1;
+
+  auto mockManagedService = std::make_shared<MockManagedService>();
+  EXPECT_CALL(*mockManagedService, Updated(AnyMapEquals(lastProps))).Times(1);
+  EXPECT_CALL(*mockManagedService,
+              Updated(testing::Not(AnyMapEquals(lastProps))))
+    .Times(0);
+
+  cppmicroservices::ServiceProperties msProps{ { std::string("service.pid"),
+                                                 std::string("test.pid") } };
+  auto reg = bundleContext
+               .RegisterService<cppmicroservices::service::cm::ManagedService>(
+                 mockManagedService, msProps);
+  configAdmin.WaitForAllAsync();
+
+  const auto conf = configAdmin.GetConfiguration("test.pid");
+  ASSERT_TRUE(conf);
+
+  std::vector<std::shared_future<void>> futures;
+  {
+    const auto outerBatch = configAdmin.BeginUpdateBatch();
+    {
+      const auto innerBatch = configAdmin.BeginUpdateBatch();
+      for (int i = 0; i < updateCount; ++i) {
+        props["count"] = i;
+        futures.push_back(conf->Update(props));
+      }
+    }
+    // nothing is delivered until the outermost batch ends
+    EXPECT_EQ(futures.back().wait_for(std::chrono::milliseconds(10)),
+              std::future_status::timeout);
+  }
+
+  for (auto& fut : futures) {
+    EXPECT_NO_THROW(fut.get());
+  }
+
+  reg.Unregister();
+  configAdmin.WaitForAllAsync();
+}
+
+// An update batch only holds back the notifications of the thread which
+// started it.
+TEST_F(TestConfigurationAdminImpl, VerifyUpdateBatchIsScopedToItsThread)
+{
+  auto bundleContext = GetFramework().GetBundleContext();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService>
+    asyncWorkService =
+      std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(
+        bundleContext, fakeLogger);
+  ConfigurationAdminImpl configAdmin(
+    bundleContext, fakeLogger, asyncWorkService);
+
+  const auto batchedConf = configAdmin.GetConfiguration("test.batched");
+  const auto otherConf = configAdmin.GetConfiguration("test.other");
+  AnyMap props{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  props["value"] = 1;
+
+  std::shared_future<void> batchedUpdate;
+  {
+    const auto batch = configAdmin.BeginUpdateBatch();
+    batchedUpdate = batchedConf->Update(props);
+
+    // neither updates of other PIDs nor of the batched PID on another
+    // thread wait for the batch
+    auto otherUpdates = std::async(std::launch::async, [&] {
+      otherConf->Update(props).get();
+      batchedConf->Update(props).get();
+    });
+    EXPECT_EQ(otherUpdates.wait_for(std::chrono::seconds(30)),
+              std::future_status::ready);
+    EXPECT_NO_THROW(otherUpdates.get());
+    EXPECT_EQ(batchedUpdate.wait_for(std::chrono::milliseconds(10)),
+              std::future_status::timeout);
+  }
+  EXPECT_EQ(batchedUpdate.wait_for(std::chrono::seconds(30)),
+            std::future_status::ready);
+  configAdmin.WaitForAllAsync();
+}
+
+// The futures of notifications held back by a batch become ready when
+// ConfigurationAdmin shuts down before the batch ends.
+TEST_F(TestConfigurationAdminImpl, VerifyUpdateBatchOutlivingConfigAdmin)
+{
+  auto bundleContext = GetFramework().GetBundleContext();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService>
+    asyncWorkService =
+      std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(
+        bundleContext, fakeLogger);
+  auto configAdmin = std::make_unique<ConfigurationAdminImpl>(
+    bundleContext, fakeLogger, asyncWorkService);
+
+  AnyMap props{ AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+  props["value"] = 1;
+  auto batch = configAdmin->BeginUpdateBatch();
+  auto update = configAdmin->GetConfiguration("test.pid")->Update(props);
+  EXPECT_EQ(update.wait_for(std::chrono::milliseconds(10)),
+            std::future_status::timeout);
+
+  configAdmin.reset();
+  EXPECT_EQ(update.wait_for(std::chrono::seconds(30)),
+            std::future_status::ready);
+  EXPECT_NO_THROW(batch.reset());
+}
+
 TEST_F(TestConfigurationAdminImpl, VerifyManagedServiceFactoryNotification)
 {
   auto bundleContext = GetFramework().GetBundleContext();
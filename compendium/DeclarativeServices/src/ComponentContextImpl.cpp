@@ -28,6 +28,7 @@
 #include "manager/ReferenceManager.hpp"
 #include "manager/RegistrationManager.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cppmicroservices/ServiceObjects.h>
 #include <cppmicroservices/servicecomponent/ComponentException.hpp>
@@ -61,12 +62,15 @@ void ComponentContextImpl::InitializeServicesCache()
   if (!configManagerPtr) {
     throw ComponentException("Context is invalid");
   }
+  componentMetadata = configManagerPtr->GetMetadata();
 
+  std::unique_ptr<BoundServicesSnapshot> snapshot(new BoundServicesSnapshot);
   const auto refManagers = configManagerPtr->GetAllDependencyManagers();
   for (const auto& refManager : refManagers) {
     const auto& sRefs = refManager->GetBoundReferences();
     const auto& refName = refManager->GetReferenceName();
     const auto& refScope = refManager->GetReferenceScope();
+    auto& boundRef = GetOrAddBoundReference(*snapshot, refName);
     std::for_each(
       sRefs.rbegin(),
       sRefs.rend(),
@@ -74,24 +78,96 @@ void ComponentContextImpl::InitializeServicesCache()
         if (sRef) {
           ServiceReferenceU sRefU(sRef);
           auto bc = GetBundleContext();
-          auto boundServicesCacheHandle = boundServicesCache.lock();
-          auto& serviceMap = (*boundServicesCacheHandle)[refName];
           if (refScope == cppmicroservices::Constants::SCOPE_BUNDLE) {
-            serviceMap.push_back(bc.GetService(sRefU));
+            AppendBoundService(boundRef, bc.GetService(sRefU));
           } else {
-            auto registeredScope =
-              sRef.GetProperty(cppmicroservices::Constants::SERVICE_SCOPE)
-                .ToStringNoExcept();
             cppmicroservices::ServiceObjects<void> sObjs =
               bc.GetServiceObjects(sRefU);
             auto interfaceMap = sObjs.GetService();
             if (interfaceMap) {
-              serviceMap.push_back(interfaceMap);
+              AppendBoundService(boundRef, interfaceMap);
             }
           }
         }
       });
   }
+
+  std::lock_guard<std::mutex> lock(boundServicesWriteMutex);
+  boundServices.Reset(std::move(snapshot));
+}
+
+ComponentContextImpl::BoundServicesGuard
+ComponentContextImpl::LoadBoundServices() const
+{
+  auto guard = boundServices.Read();
+  if (!guard.Get()) {
+    throw ComponentException("Context is invalid");
+  }
+  return guard;
+}
+
+template<class Modify>
+void ComponentContextImpl::UpdateBoundServices(Modify&& modify)
+{
+  std::lock_guard<std::mutex> lock(boundServicesWriteMutex);
+  std::unique_ptr<BoundServicesSnapshot> snapshot;
+  {
+    auto current = boundServices.Read();
+    if (!current.Get()) {
+      return;
+    }
+    snapshot.reset(new BoundServicesSnapshot(*current.Get()));
+  }
+  modify(*snapshot);
+  boundServices.Reset(std::move(snapshot));
+}
+
+ComponentContextImpl::BoundReference&
+ComponentContextImpl::GetOrAddBoundReference(BoundServicesSnapshot& snapshot,
+                                             const std::string& refName) const
+{
+  auto iter = snapshot.find(refName);
+  if (iter != snapshot.end()) {
+    return iter->second;
+  }
+
+  BoundReference boundRef;
+  boundRef.name = refName;
+  if (componentMetadata) {
+    for (const auto& refMetadata : componentMetadata->refsMetadata) {
+      if (refMetadata.name == refName) {
+        boundRef.interfaceName = refMetadata.interfaceName;
+        boundRef.isMandatory =
+          refMetadata.cardinality.empty() ||
+          refMetadata.cardinality.find("1..") != std::string::npos;
+      }
+    }
+  }
+  // without an interface name there is nothing to pre-resolve; every
+  // lookup goes through the interface map
+  boundRef.isResolved = !boundRef.interfaceName.empty();
+  return snapshot.emplace(refName, std::move(boundRef)).first->second;
+}
+
+void ComponentContextImpl::AppendBoundService(
+  BoundReference& boundRef,
+  const InterfaceMapConstPtr& serviceMap)
+{
+  std::shared_ptr<void> service;
+  if (boundRef.isResolved) {
+    if (serviceMap) {
+      auto iter = serviceMap->find(boundRef.interfaceName);
+      if (iter != serviceMap->end()) {
+        service = iter->second;
+      }
+    }
+    if (!service) {
+      // missing or failed services take the checked path in LocateService
+      boundRef.isResolved = false;
+    }
+  }
+  boundRef.serviceMaps.push_back(serviceMap);
+  boundRef.services.push_back(std::move(service));
 }
 
 std::unordered_map<std::string, cppmicroservices::Any>
@@ -179,7 +255,7 @@ ServiceInterfacePointerLookupInfo GetInterfacePointer(
  * and the value of that service pointer is nullptr.
  */
 std::shared_ptr<void> GetServicePointer(
-  const std::shared_ptr<ComponentConfiguration>& configManagerPtr,
+  bool isMandatory,
   const cppmicroservices::InterfaceMapConstPtr& m,
   const std::string& name,
   const std::string& type)
@@ -193,36 +269,20 @@ std::shared_ptr<void> GetServicePointer(
    * If this condition is not true, then we proceed with error checking and throw
    * a ComponentException if the service's cardinality conditions were violated.
    */
-  bool isValid = lookupInfo.IsValid();
-  if (isValid) {
+  if (lookupInfo.IsValid()) {
     return lookupInfo.service;
-  } else { // Checking for error condition and throwing if necessary
-    std::string cardinality{};
-    auto metadata = configManagerPtr->GetMetadata();
-    for (const auto& _data : metadata->refsMetadata) {
-      if (_data.name == name) {
-        cardinality = _data.cardinality;
-      }
-    }
-
-    bool isMandatory = false;
-    if (cardinality.empty()) {
-      isMandatory = true;
-    } else {
-      isMandatory = cardinality.find("1..") != std::string::npos;
-    }
+  }
 
-    // In the case of service being a nullptr, we throw because this implies
-    // that the construction or activation of the service failed.
-    if (!lookupInfo.IsValid() && isMandatory) {
-      std::string errMsg = "Service ";
-      errMsg += name;
-      errMsg += " with type ";
-      errMsg += type;
-      errMsg += " failed to construct or activate.";
+  // In the case of service being a nullptr, we throw because this implies
+  // that the construction or activation of the service failed.
+  if (isMandatory) {
+    std::string errMsg = "Service ";
+    errMsg += name;
+    errMsg += " with type ";
+    errMsg += type;
+    errMsg += " failed to construct or activate.";
 
-      throw ComponentException(errMsg);
-    }
+    throw ComponentException(errMsg);
   }
 
   return nullptr;
@@ -232,45 +292,38 @@ std::shared_ptr<void> ComponentContextImpl::LocateService(
   const std::string& name,
   const std::string& type) const
 {
-  const auto configManagerPtr = configManager.lock();
-  if (!configManagerPtr) {
-    throw ComponentException("Context is invalid");
+  const auto snapshot = LoadBoundServices();
+  auto iter = snapshot.Get()->find(name);
+  if (iter == snapshot.Get()->end() || iter->second.serviceMaps.empty()) {
+    return nullptr;
   }
-  auto boundServicesCacheHandle = boundServicesCache.lock();
-  auto serviceMapItr = boundServicesCacheHandle->find(name);
-  if (serviceMapItr != boundServicesCacheHandle->end()) {
-    auto& serviceMaps = serviceMapItr->second;
-    if (!serviceMaps.empty()) {
-      std::shared_ptr<void> service =
-        GetServicePointer(configManagerPtr, serviceMaps.at(0), name, type);
-      return service;
-    }
+  const auto& boundRef = iter->second;
+  // fast path: the caller asks for the interface declared by the reference
+  if (boundRef.isResolved && boundRef.interfaceName == type) {
+    return boundRef.services.front();
   }
-
-  return nullptr;
+  return GetServicePointer(
+    boundRef.isMandatory, boundRef.serviceMaps.front(), name, type);
 }
 
 std::vector<std::shared_ptr<void>> ComponentContextImpl::LocateServices(
   const std::string& name,
   const std::string& type) const
 {
-  const auto configManagerPtr = configManager.lock();
-  if (!configManagerPtr) {
-    throw ComponentException("Context is invalid");
+  const auto snapshot = LoadBoundServices();
+  auto iter = snapshot.Get()->find(name);
+  if (iter == snapshot.Get()->end()) {
+    return {};
+  }
+  const auto& boundRef = iter->second;
+  if (boundRef.isResolved && boundRef.interfaceName == type) {
+    return boundRef.services;
   }
   std::vector<std::shared_ptr<void>> services;
-  auto boundServicesCacheHandle = boundServicesCache.lock();
-  auto serviceMapItr = boundServicesCacheHandle->find(name);
-  if (serviceMapItr != boundServicesCacheHandle->end()) {
-    auto& serviceMaps = serviceMapItr->second;
-    std::for_each(serviceMaps.begin(),
-                  serviceMaps.end(),
-                  [&configManagerPtr, &services, &name, &type](
-                    const InterfaceMapConstPtr& iMap) {
-                    std::shared_ptr<void> service =
-                      GetServicePointer(configManagerPtr, iMap, name, type);
-                    services.push_back(service);
-                  });
+  services.reserve(boundRef.serviceMaps.size());
+  for (const auto& iMap : boundRef.serviceMaps) {
+    services.push_back(
+      GetServicePointer(boundRef.isMandatory, iMap, name, type));
   }
   return services;
 }
@@ -338,8 +391,8 @@ ServiceReferenceBase ComponentContextImpl::GetServiceReference() const
 void ComponentContextImpl::Invalidate()
 {
   configManager = std::weak_ptr<ComponentConfiguration>();
-  auto boundServicesCacheHandle = boundServicesCache.lock();
-  boundServicesCacheHandle->clear();
+  std::lock_guard<std::mutex> lock(boundServicesWriteMutex);
+  boundServices.Reset();
 }
 
 bool ComponentContextImpl::AddToBoundServicesCache(
@@ -349,13 +402,18 @@ bool ComponentContextImpl::AddToBoundServicesCache(
   auto bc = GetBundleContext();
   cppmicroservices::ServiceObjects<void> sObjs =
     bc.GetServiceObjects(ServiceReferenceU(sRef));
-  auto boundServicesCacheHandle = boundServicesCache.lock();
   auto interfaceMap = sObjs.GetService();
   if (!interfaceMap) {
     return false;
   }
-  (*boundServicesCacheHandle)[refName].emplace_back(interfaceMap);
-  return true;
+
+  bool added = false;
+  UpdateBoundServices([&](BoundServicesSnapshot& snapshot) {
+    AppendBoundService(GetOrAddBoundReference(snapshot, refName),
+                       interfaceMap);
+    added = true;
+  });
+  return added;
 }
 
 void ComponentContextImpl::RemoveFromBoundServicesCache(
@@ -368,26 +426,24 @@ void ComponentContextImpl::RemoveFromBoundServicesCache(
 
   const auto removedService = sObjs.GetService();
   const auto& serviceInterface = removedService->begin()->first;
-  auto boundServicesCacheHandle = boundServicesCache.lock();
-  auto& services = boundServicesCacheHandle->at(refName);
-  // std::remove_if doesn't actually remove the elements from
-  // 'services'. Instead it shifts them to the end of the range
-  // and returns a past-the-end iterator for the new end range.
-  // erase is then called to remove all elements that were shifted,
-  // which are those starting from the past-the-end iterator to
-  // the end of `services`.
-  services.erase(
-    std::remove_if(
-      services.begin(),
-      services.end(),
-      [&removedService, &serviceInterface](
-        const cppmicroservices::InterfaceMapConstPtr& servicesMap) {
-        return (1 == servicesMap->count(serviceInterface)) &&
-               (removedService->at(serviceInterface) ==
-                servicesMap->at(serviceInterface));
-      }),
-    services.end());
-  return;
+  const auto& removedPtr = removedService->begin()->second;
+
+  UpdateBoundServices([&](BoundServicesSnapshot& snapshot) {
+    auto& boundRef = GetOrAddBoundReference(snapshot, refName);
+
+    BoundReference remaining;
+    remaining.name = boundRef.name;
+    remaining.interfaceName = boundRef.interfaceName;
+    remaining.isMandatory = boundRef.isMandatory;
+    remaining.isResolved = !boundRef.interfaceName.empty();
+    for (const auto& servicesMap : boundRef.serviceMaps) {
+      auto iter = servicesMap->find(serviceInterface);
+      if (iter == servicesMap->end() || iter->second != removedPtr) {
+        AppendBoundService(remaining, servicesMap);
+      }
+    }
+    boundRef = std::move(remaining);
+  });
 }
 
 }
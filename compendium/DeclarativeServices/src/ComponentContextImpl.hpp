@@ -24,8 +24,10 @@
 #define __COMPONENT_CONTEXT_IMPL_HPP__
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #ifdef _MSC_VER
 #  pragma warning(push)
@@ -35,9 +37,10 @@
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/detail/QuiescentPtr.h"
 #include "cppmicroservices/servicecomponent/ComponentContext.hpp"
 #include "manager/ComponentConfiguration.hpp"
-#include "manager/ConcurrencyUtil.hpp"
+#include "metadata/ComponentMetadata.hpp"
 
 namespace cppmicroservices {
 namespace scrimpl {
@@ -210,6 +213,33 @@ public:
     const cppmicroservices::ServiceReferenceBase& sRef);
 
 private:
+  /**
+   * The services bound to a single reference of the component. The service
+   * pointers for the reference's declared interface are resolved when the
+   * entry is built so that \c LocateService does not need to search the
+   * interface maps.
+   */
+  struct BoundReference
+  {
+    std::string name;
+    std::string interfaceName;
+    bool isMandatory{ true };
+    // true if every entry in serviceMaps contains interfaceName
+    bool isResolved{ true };
+    std::vector<cppmicroservices::InterfaceMapConstPtr> serviceMaps;
+    // parallel to serviceMaps, the pointers registered for interfaceName
+    std::vector<std::shared_ptr<void>> services;
+  };
+
+  /**
+   * An immutable snapshot of all bound references, keyed by reference name.
+   * Readers neither block nor touch a reference count; writers copy the
+   * snapshot, modify the copy and publish it.
+   */
+  using BoundServicesSnapshot = std::unordered_map<std::string, BoundReference>;
+  using BoundServicesGuard =
+    detail::QuiescentPtr<BoundServicesSnapshot>::ReadGuard;
+
   /**
    * Returns the Id of the bundle containing the component
    *
@@ -219,12 +249,37 @@ private:
 
   void InitializeServicesCache();
 
+  /**
+   * Returns a guard for the current snapshot of bound services, which stays
+   * valid for as long as the guard exists.
+   *
+   * \throws {@link ComponentException} if this {@link ComponentContext} is invalid
+   */
+  BoundServicesGuard LoadBoundServices() const;
+
+  /**
+   * Publishes a copy of the current snapshot after \c modify has changed
+   * it. Does nothing if this context has been invalidated.
+   */
+  template<class Modify>
+  void UpdateBoundServices(Modify&& modify);
+
+  /**
+   * Returns the entry for reference \c refName from \c snapshot, creating
+   * it from the component metadata if it does not exist yet.
+   */
+  BoundReference& GetOrAddBoundReference(BoundServicesSnapshot& snapshot,
+                                         const std::string& refName) const;
+
+  static void AppendBoundService(BoundReference& boundRef,
+                                 const InterfaceMapConstPtr& serviceMap);
+
   std::weak_ptr<ComponentConfiguration> configManager;
   cppmicroservices::Bundle usingBundle;
-  mutable Guarded<
-    std::unordered_map<std::string,
-                       std::vector<cppmicroservices::InterfaceMapConstPtr>>>
-    boundServicesCache;
+  std::shared_ptr<const metadata::ComponentMetadata> componentMetadata;
+  // serializes writers of boundServices; readers never take this lock
+  std::mutex boundServicesWriteMutex;
+  detail::QuiescentPtr<BoundServicesSnapshot> boundServices;
 };
 }
 }
@@ -22,16 +22,39 @@
 
 #include "ComponentRegistry.hpp"
 
+#include <algorithm>
+#include <atomic>
+
 namespace cppmicroservices {
 namespace scrimpl {
 
+namespace {
+std::atomic<std::uint64_t> changeCounter(0);
+}
+
+const std::size_t ComponentRegistry::MAX_REMOVED_COMPONENTS = 4096;
+
+ComponentRegistry::ComponentRegistry()
+  : mRemovedHorizon(GetChangeCount())
+{}
+
+std::uint64_t ComponentRegistry::NextChangeCount()
+{
+  return ++changeCounter;
+}
+
+std::uint64_t ComponentRegistry::GetChangeCount()
+{
+  return changeCounter.load();
+}
+
 std::vector<std::shared_ptr<ComponentManager>>
 ComponentRegistry::GetComponentManagers() const
 {
   std::lock_guard<std::mutex> lock(mMapsMutex);
   std::vector<std::shared_ptr<ComponentManager>> managers;
   for (const auto& kv : mComponentsByName) {
-    managers.push_back(kv.second);
+    managers.push_back(kv.second.manager);
   }
   return managers;
 }
@@ -43,28 +66,44 @@ ComponentRegistry::GetComponentManagers(unsigned long bundleId) const
   std::vector<std::shared_ptr<ComponentManager>> managers;
   for (const auto& kv : mComponentsByName) {
     if (kv.first.first == bundleId) {
-      managers.push_back(kv.second);
+      managers.push_back(kv.second.manager);
     }
   }
   return managers;
 }
 
+std::vector<ComponentRegistry::Entry> ComponentRegistry::GetEntries() const
+{
+  std::lock_guard<std::mutex> lock(mMapsMutex);
+  std::vector<Entry> entries;
+  entries.reserve(mComponentsByName.size());
+  for (const auto& kv : mComponentsByName) {
+    entries.push_back(kv.second);
+  }
+  return entries;
+}
+
 std::shared_ptr<ComponentManager> ComponentRegistry::GetComponentManager(
   unsigned long bundleId,
   const std::string& compName) const
 {
   std::lock_guard<std::mutex> lock(mMapsMutex);
-  return mComponentsByName.at(std::make_pair(bundleId, compName));
+  return mComponentsByName.at(std::make_pair(bundleId, compName)).manager;
 }
 
 bool ComponentRegistry::AddComponentManager(
   const std::shared_ptr<ComponentManager>& cm)
 {
   std::lock_guard<std::mutex> lock(mMapsMutex);
+  // the change count is taken after the manager became visible, so a
+  // query which started earlier reports it next time
   auto result = mComponentsByName.insert(
     std::make_pair(std::make_pair(static_cast<unsigned long>(cm->GetBundleId()),
                                   cm->GetName()),
-                   cm));
+                   Entry{ cm, 0 }));
+  if (result.second) {
+    result.first->second.addedAt = NextChangeCount();
+  }
   return result.second;
 }
 
@@ -72,7 +111,10 @@ void ComponentRegistry::RemoveComponentManager(unsigned long bundleId,
                                                const std::string& compName)
 {
   std::lock_guard<std::mutex> lock(mMapsMutex);
-  mComponentsByName.erase(std::make_pair(bundleId, compName));
+  auto key = std::make_pair(bundleId, compName);
+  if (mComponentsByName.erase(key) != 0) {
+    AddRemoved_unlocked(std::move(key));
+  }
 }
 
 void ComponentRegistry::RemoveComponentManager(
@@ -84,6 +126,9 @@ void ComponentRegistry::RemoveComponentManager(
 void ComponentRegistry::Clear()
 {
   std::lock_guard<std::mutex> lock(mMapsMutex);
+  for (const auto& kv : mComponentsByName) {
+    AddRemoved_unlocked(kv.first);
+  }
   mComponentsByName.clear();
 }
 
@@ -92,5 +137,35 @@ size_t ComponentRegistry::Count() const
   std::lock_guard<std::mutex> lock(mMapsMutex);
   return mComponentsByName.size();
 }
+
+std::vector<std::pair<unsigned long, std::string>>
+ComponentRegistry::GetRemovedComponents(std::uint64_t since,
+                                        bool& complete) const
+{
+  std::lock_guard<std::mutex> lock(mMapsMutex);
+  complete = since >= mRemovedHorizon;
+  std::vector<std::pair<unsigned long, std::string>> removed;
+  auto iter = std::upper_bound(
+    mRemoved.begin(),
+    mRemoved.end(),
+    since,
+    [](std::uint64_t count, const RemovedComponent& component) {
+      return count < component.removedAt;
+    });
+  for (; iter != mRemoved.end(); ++iter) {
+    removed.push_back(iter->key);
+  }
+  return removed;
+}
+
+void ComponentRegistry::AddRemoved_unlocked(
+  std::pair<unsigned long, std::string> key)
+{
+  mRemoved.push_back({ NextChangeCount(), std::move(key) });
+  if (mRemoved.size() > MAX_REMOVED_COMPONENTS) {
+    mRemovedHorizon = mRemoved.front().removedAt;
+    mRemoved.pop_front();
+  }
+}
 }
 }
@@ -24,7 +24,10 @@
 #define __COMPONENT_REGISTRY_HPP__
 
 #include "manager/ComponentManager.hpp"
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace cppmicroservices {
@@ -36,7 +39,23 @@ namespace scrimpl {
 class ComponentRegistry
 {
 public:
-  ComponentRegistry() = default;
+  /**
+   * A component manager and the change count at which it was added to the
+   * registry.
+   */
+  struct Entry
+  {
+    std::shared_ptr<ComponentManager> manager;
+    std::uint64_t addedAt;
+  };
+
+  /**
+   * The number of removed components the registry remembers for
+   * {@link #GetRemovedComponents}.
+   */
+  static const std::size_t MAX_REMOVED_COMPONENTS;
+
+  ComponentRegistry();
   virtual ~ComponentRegistry() = default;
   ComponentRegistry(const ComponentRegistry&) = delete;
   ComponentRegistry& operator=(const ComponentRegistry&) = delete;
@@ -65,6 +84,13 @@ public:
   virtual std::vector<std::shared_ptr<ComponentManager>> GetComponentManagers(
     unsigned long bundleId) const;
 
+  /**
+   * Method returns all the component managers stored in the registry,
+   * ordered by bundle id and component name, with the change count at which
+   * they were added.
+   */
+  std::vector<Entry> GetEntries() const;
+
   /**
    * Method returns a component manager object with the given name and from the given bundle
    *
@@ -125,10 +151,48 @@ public:
    */
   size_t Count() const;
 
+  /**
+   * Returns the bundle ids and names of the components removed after the
+   * change count \c since, in the order of their removal.
+   *
+   * \param since a change count returned by {@link #GetChangeCount}
+   * \param complete set to \c false if components removed after \c since
+   *        are missing from the result, because more than
+   *        {@link #MAX_REMOVED_COMPONENTS} were removed since or \c since
+   *        predates this registry, \c true otherwise
+   */
+  std::vector<std::pair<unsigned long, std::string>> GetRemovedComponents(
+    std::uint64_t since,
+    bool& complete) const;
+
+  /**
+   * Returns a new change count. Change counts are shared by all registries
+   * of the process and increase monotonically, so a count obtained from
+   * one runtime stays meaningful after Declarative Services is restarted.
+   * Component managers and configurations record the count of their most
+   * recent change, which monitoring clients compare with the count they
+   * saw when they last looked.
+   */
+  static std::uint64_t NextChangeCount();
+
+  /**
+   * Returns the most recent change count.
+   */
+  static std::uint64_t GetChangeCount();
+
 private:
-  std::map<std::pair<unsigned long, std::string>,
-           std::shared_ptr<ComponentManager>>
-    mComponentsByName;
+  struct RemovedComponent
+  {
+    std::uint64_t removedAt;
+    std::pair<unsigned long, std::string> key;
+  };
+
+  void AddRemoved_unlocked(std::pair<unsigned long, std::string> key);
+
+  std::map<std::pair<unsigned long, std::string>, Entry> mComponentsByName;
+  std::deque<RemovedComponent> mRemoved;
+  // removals up to this change count are not in mRemoved
+  std::uint64_t mRemovedHorizon;
   mutable std::mutex mMapsMutex;
 };
 } // scrimpl
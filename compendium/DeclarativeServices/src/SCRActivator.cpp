@@ -25,6 +25,7 @@
 #include "SCRAsyncWorkService.hpp"
 #include "SCRLogger.hpp"
 #include "ServiceComponentRuntimeImpl.hpp"
+#include "cppmicroservices/Constants.h"
 #include "cppmicroservices/SecurityException.h"
 #include "cppmicroservices/SharedLibraryException.h"
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
@@ -46,6 +47,19 @@ using cppmicroservices::logservice::SeverityLevel;
 using cppmicroservices::service::component::ComponentConstants::
   SERVICE_COMPONENT;
 
+namespace {
+bool IsLazy(const cppmicroservices::Bundle& bundle)
+{
+  const auto& headers = bundle.GetHeaders();
+  auto policy =
+    headers.find(cppmicroservices::Constants::BUNDLE_ACTIVATIONPOLICY);
+  return policy != headers.end() &&
+         policy->second.Type() == typeid(std::string) &&
+         cppmicroservices::ref_any_cast<std::string>(policy->second) ==
+           cppmicroservices::Constants::ACTIVATION_LAZY;
+}
+}
+
 namespace cppmicroservices {
 namespace scrimpl {
 
@@ -75,6 +89,12 @@ void SCRActivator::Start(BundleContext context)
       cppmicroservices::BundleEvent evt(
         cppmicroservices::BundleEvent::BUNDLE_STARTED, bundle);
       BundleChanged(evt);
+    } else if (bundle.GetState() ==
+                 cppmicroservices::Bundle::State::STATE_STARTING &&
+               IsLazy(bundle)) {
+      cppmicroservices::BundleEvent evt(
+        cppmicroservices::BundleEvent::BUNDLE_LAZY_ACTIVATION, bundle);
+      BundleChanged(evt);
     }
   }
   // Publish ServiceComponentRuntimeService
@@ -133,9 +153,11 @@ void SCRActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
   const auto& headers = bundle.GetHeaders();
   // bundle has no "scr" property
   if (headers.count(SERVICE_COMPONENT) == 0u) {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "No SCR components found in bundle " +
-                  bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "No SCR components found in bundle " + bundle.GetSymbolicName();
+      });
     return;
   }
 
@@ -147,8 +169,11 @@ void SCRActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
 
   // bundle components have not been loaded, so create the extension which will load the components
   if (!extensionFound) {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "Creating SCRBundleExtension ... " + bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "Creating SCRBundleExtension ... " + bundle.GetSymbolicName();
+      });
     try {
       auto const& scrMap =
         ref_any_cast<cppmicroservices::AnyMap>(headers.at(SERVICE_COMPONENT));
@@ -168,15 +193,21 @@ void SCRActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
     } catch (const cppmicroservices::SecurityException&) {
       throw;
     } catch (const std::exception&) {
-      logger->Log(SeverityLevel::LOG_DEBUG,
-                  "Failed to create SCRBundleExtension for " +
-                    bundle.GetSymbolicName(),
-                  std::current_exception());
+      logger->LogLazily(
+        SeverityLevel::LOG_DEBUG,
+        [&] {
+          return "Failed to create SCRBundleExtension for " +
+            bundle.GetSymbolicName();
+        },
+        std::current_exception());
     }
   } else {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "SCR components already loaded from bundle " +
-                  bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "SCR components already loaded from bundle " +
+          bundle.GetSymbolicName();
+      });
   }
 }
 
@@ -185,8 +216,11 @@ void SCRActivator::DisposeExtension(const cppmicroservices::Bundle& bundle)
   const auto& headers = bundle.GetHeaders();
   // bundle has no scr-component property
   if (headers.count(SERVICE_COMPONENT) == 0u) {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "Found No SCR Metadata for " + bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "Found No SCR Metadata for " + bundle.GetSymbolicName();
+      });
     return;
   }
 
@@ -196,16 +230,22 @@ void SCRActivator::DisposeExtension(const cppmicroservices::Bundle& bundle)
     extensionFound = (bundleRegistry.count(bundle.GetBundleId()) != 0u);
   }
   if (extensionFound) {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "Found SCRBundleExtension for " + bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "Found SCRBundleExtension for " + bundle.GetSymbolicName();
+      });
     // remove the bundle extension object from the map.
     {
       std::lock_guard<std::mutex> l(bundleRegMutex);
       bundleRegistry.erase(bundle.GetBundleId());
     }
   } else {
-    logger->Log(SeverityLevel::LOG_DEBUG,
-                "Found No SCRBundleExtension for " + bundle.GetSymbolicName());
+    logger->LogLazily(
+      SeverityLevel::LOG_DEBUG,
+      [&] {
+        return "Found No SCRBundleExtension for " + bundle.GetSymbolicName();
+      });
   }
 }
 
@@ -219,8 +259,10 @@ void SCRActivator::BundleChanged(const cppmicroservices::BundleEvent& evt)
     return;
   }
 
-  // TODO: revisit to include LAZY_ACTIVATION when supported by the framework
-  if (eventType == cppmicroservices::BundleEvent::BUNDLE_STARTED) {
+  // Components of a bundle waiting for its lazy activation are managed
+  // right away; activating a component activates the bundle.
+  if (eventType == cppmicroservices::BundleEvent::BUNDLE_STARTED ||
+      eventType == cppmicroservices::BundleEvent::BUNDLE_LAZY_ACTIVATION) {
     CreateExtension(bundle);
   } else if (eventType == cppmicroservices::BundleEvent::BUNDLE_STOPPING) {
     DisposeExtension(bundle);
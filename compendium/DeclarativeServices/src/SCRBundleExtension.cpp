@@ -27,11 +27,15 @@
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "manager/ComponentManagerImpl.hpp"
 #include "manager/ConfigurationNotifier.hpp"
+#include "metadata/BinaryMetadataReader.hpp"
 #include "metadata/ComponentMetadata.hpp"
 #include "metadata/MetadataParser.hpp"
 #include "metadata/MetadataParserFactory.hpp"
 #include "metadata/Util.hpp"
 
+#include "cppmicroservices/BundleResource.h"
+#include "cppmicroservices/BundleResourceStream.h"
+
 using cppmicroservices::service::component::ComponentConstants::
   SERVICE_COMPONENT;
 
@@ -41,6 +45,74 @@ namespace scrimpl {
 using metadata::ComponentMetadata;
 using util::ObjectValidator;
 
+namespace {
+
+/**
+ * Returns the component metadata precompiled by the SCR code generator if
+ * the manifest announces it, the bundle contains it and it matches the "scr"
+ * section of the manifest. Returns an empty vector otherwise, in which case
+ * the manifest is parsed.
+ */
+std::vector<std::shared_ptr<ComponentMetadata>> LoadPrecompiledMetadata(
+  const cppmicroservices::Bundle& bundle,
+  int version,
+  const cppmicroservices::AnyMap& scrMetadata,
+  const std::shared_ptr<LogService>& logger)
+{
+  // The framework closes the resource container of bundles which only
+  // contain a manifest; looking for the resource would open it again.
+  auto precompiled =
+    scrMetadata.find(metadata::BinaryMetadataReader::MANIFEST_KEY);
+  if (precompiled == scrMetadata.end() ||
+      precompiled->second.Type() != typeid(bool) ||
+      !cppmicroservices::any_cast<bool>(precompiled->second)) {
+    return {};
+  }
+
+  const auto resource =
+    bundle.GetResource(metadata::BinaryMetadataReader::RESOURCE_PATH);
+  if (!resource) {
+    return {};
+  }
+
+  try {
+    cppmicroservices::BundleResourceStream resStream(resource,
+                                                     std::ios_base::binary);
+    metadata::BinaryMetadataReader reader(resStream);
+    // the binary metadata is only used if it was generated from the very
+    // manifest embedded in the bundle
+    std::uint64_t manifestHash = 0;
+    const auto manifest =
+      bundle.GetResource(metadata::BinaryMetadataReader::MANIFEST_PATH);
+    if (manifest) {
+      cppmicroservices::BundleResourceStream manifestStream(
+        manifest, std::ios_base::binary);
+      manifestHash =
+        metadata::BinaryMetadataReader::HashManifest(manifestStream);
+    }
+    const auto& components =
+      cppmicroservices::ref_any_cast<std::vector<cppmicroservices::Any>>(
+        scrMetadata.at("components"));
+    if (reader.GetManifestHash() != manifestHash ||
+        reader.GetManifestVersion() != static_cast<std::uint32_t>(version) ||
+        reader.GetComponentCount() != components.size()) {
+      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                  "Precompiled component metadata in bundle " +
+                    bundle.GetSymbolicName() +
+                    " does not match its manifest and is ignored.");
+      return {};
+    }
+    return reader.ReadComponentsMetadata(logger);
+  } catch (const std::exception&) {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                "Failed to read precompiled component metadata from bundle " +
+                  bundle.GetSymbolicName(),
+                std::current_exception());
+  }
+  return {};
+}
+}
+
 SCRBundleExtension::SCRBundleExtension(
   const cppmicroservices::BundleContext& bundleContext,
   const cppmicroservices::AnyMap& scrMetadata,
@@ -62,11 +134,15 @@ SCRBundleExtension::SCRBundleExtension(
   managers = std::make_shared<std::vector<std::shared_ptr<ComponentManager>>>();
 
   auto version = ObjectValidator(scrMetadata, "version").GetValue<int>();
-  auto metadataparser =
-    metadata::MetadataParserFactory::Create(version, logger);
-  std::vector<std::shared_ptr<ComponentMetadata>> componentsMetadata;
-  componentsMetadata =
-    metadataparser->ParseAndGetComponentsMetadata(scrMetadata);
+  std::vector<std::shared_ptr<ComponentMetadata>> componentsMetadata =
+    LoadPrecompiledMetadata(
+      bundleContext.GetBundle(), version, scrMetadata, logger);
+  if (componentsMetadata.empty()) {
+    auto metadataparser =
+      metadata::MetadataParserFactory::Create(version, logger);
+    componentsMetadata =
+      metadataparser->ParseAndGetComponentsMetadata(scrMetadata);
+  }
   for (auto& oneCompMetadata : componentsMetadata) {
     try {
       auto compManager =
@@ -94,9 +170,12 @@ SCRBundleExtension::SCRBundleExtension(
                   std::current_exception());
     }
   }
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "Created instance of SCRBundleExtension for " +
-                bundleContext.GetBundle().GetSymbolicName());
+  logger->LogLazily(
+    cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "Created instance of SCRBundleExtension for " +
+        bundleContext.GetBundle().GetSymbolicName();
+    });
 }
 
 SCRBundleExtension::~SCRBundleExtension()
@@ -106,9 +185,12 @@ SCRBundleExtension::~SCRBundleExtension()
 
 void SCRBundleExtension::DisableAndRemoveAllComponentManagers()
 {
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-              "Deleting instance of SCRBundleExtension for " +
-                bundleContext.GetBundle().GetSymbolicName());
+  logger->LogLazily(
+    cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+    [&] {
+      return "Deleting instance of SCRBundleExtension for " +
+        bundleContext.GetBundle().GetSymbolicName();
+    });
   for (auto& compManager : *managers) {
     auto fut = compManager->Disable();
     registry->RemoveComponentManager(compManager);
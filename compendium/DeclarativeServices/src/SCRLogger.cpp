@@ -120,5 +120,11 @@ void SCRLogger::Log(const cppmicroservices::ServiceReferenceBase& sr,
     currLogger->Log(sr, level, message, ex);
   }
 }
+
+bool SCRLogger::IsLevelEnabled(logservice::SeverityLevel level) const
+{
+  auto currLogger = std::atomic_load(&logService);
+  return currLogger && currLogger->IsLevelEnabled(level);
+}
 } // scrimpl
 } // cppmicroservices
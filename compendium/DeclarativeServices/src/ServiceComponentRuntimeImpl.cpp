@@ -27,6 +27,7 @@
 #include "manager/ComponentConfiguration.hpp"
 #include "manager/ComponentManager.hpp"
 #include "manager/ReferenceManager.hpp"
+#include <algorithm>
 #include <chrono>
 
 using cppmicroservices::framework::dto::BundleDTO;
@@ -61,17 +62,20 @@ BundleDTO ToDTO(const cppmicroservices::Bundle& bundle)
   return bundleDTO;
 }
 
-ServiceReferenceDTO ToDTO(const cppmicroservices::ServiceReferenceBase& sRef)
+ServiceReferenceDTO ToDTO(const cppmicroservices::ServiceReferenceBase& sRef,
+                          bool withProperties)
 {
   ServiceReferenceDTO refDTO = {};
   refDTO.id = cppmicroservices::any_cast<long>(
     sRef.GetProperty(cppmicroservices::Constants::SERVICE_ID));
   refDTO.bundle = sRef ? sRef.GetBundle().GetBundleId() : 0;
-  std::vector<std::string> keys;
-  sRef.GetPropertyKeys(keys);
-  for (auto& key : keys) {
-    cppmicroservices::Any val = sRef.GetProperty(key);
-    refDTO.properties.insert(std::make_pair(key, val));
+  if (withProperties) {
+    std::vector<std::string> keys;
+    sRef.GetPropertyKeys(keys);
+    for (auto& key : keys) {
+      cppmicroservices::Any val = sRef.GetProperty(key);
+      refDTO.properties.insert(std::make_pair(key, val));
+    }
   }
   std::vector<cppmicroservices::Bundle> bundles = sRef.GetUsingBundles();
   for (auto& bundle : bundles) {
@@ -82,6 +86,11 @@ ServiceReferenceDTO ToDTO(const cppmicroservices::ServiceReferenceBase& sRef)
   return refDTO;
 }
 
+ServiceReferenceDTO ToDTO(const cppmicroservices::ServiceReferenceBase& sRef)
+{
+  return ToDTO(sRef, true);
+}
+
 ReferenceDTO ToDTO(const ReferenceMetadata& refData)
 {
   ReferenceDTO refDTO = {};
@@ -192,6 +201,87 @@ std::shared_future<void> ServiceComponentRuntimeImpl::DisableComponent(
   return holder->Disable();
 }
 
+ComponentQueryResult ServiceComponentRuntimeImpl::QueryComponentDescriptionDTOs(
+  const ComponentQuery& query) const
+{
+  ComponentQueryResult result;
+  for (auto& manager : SelectComponentManagers(query, result)) {
+    result.descriptions.push_back(CreateDTO(manager));
+  }
+  return result;
+}
+
+ComponentQueryResult
+ServiceComponentRuntimeImpl::QueryComponentConfigurationDTOs(
+  const ComponentQuery& query) const
+{
+  ComponentQueryResult result;
+  for (auto& manager : SelectComponentManagers(query, result)) {
+    result.descriptions.push_back(CreateDTO(manager));
+    for (auto& aConfig : manager->GetComponentConfigurations()) {
+      auto compConfigDTO =
+        CreateComponentConfigurationDTO(aConfig, query.serviceProperties);
+      compConfigDTO.description = result.descriptions.back();
+      result.configurations.push_back(std::move(compConfigDTO));
+    }
+  }
+  return result;
+}
+
+std::vector<std::shared_ptr<ComponentManager>>
+ServiceComponentRuntimeImpl::SelectComponentManagers(
+  const ComponentQuery& query,
+  ComponentQueryResult& result) const
+{
+  // take the change count first, changes made during the scan are then
+  // reported again by the next query instead of being missed
+  result.changeCount = ComponentRegistry::GetChangeCount();
+  if (query.changedSince != 0) {
+    result.removed =
+      registry->GetRemovedComponents(query.changedSince, result.complete);
+  }
+
+  std::vector<std::shared_ptr<ComponentManager>> selected;
+  result.total = 0;
+  for (auto& entry : registry->GetEntries()) {
+    const auto& manager = entry.manager;
+    if (!query.bundleIds.empty() &&
+        std::find(query.bundleIds.begin(),
+                  query.bundleIds.end(),
+                  static_cast<unsigned long>(manager->GetBundleId())) ==
+          query.bundleIds.end()) {
+      continue;
+    }
+    if (manager->GetName().compare(
+          0, query.namePrefix.size(), query.namePrefix) != 0) {
+      continue;
+    }
+    if (query.changedSince != 0 &&
+        std::max(entry.addedAt, manager->GetChangeCount()) <=
+          query.changedSince) {
+      continue;
+    }
+    if (!query.states.empty()) {
+      auto configs = manager->GetComponentConfigurations();
+      auto inState = [&query](const auto& config) {
+        return std::find(query.states.begin(),
+                         query.states.end(),
+                         config->GetConfigState()) != query.states.end();
+      };
+      if (std::none_of(configs.begin(), configs.end(), inState)) {
+        continue;
+      }
+    }
+    // only the components on the requested page are converted to DTOs
+    if (result.total >= query.offset &&
+        (query.limit == 0 || selected.size() < query.limit)) {
+      selected.push_back(manager);
+    }
+    ++result.total;
+  }
+  return selected;
+}
+
 ComponentDescriptionDTO ServiceComponentRuntimeImpl::CreateDTO(
   const std::shared_ptr<ComponentManager>& compManager) const
 {
@@ -220,7 +310,8 @@ ComponentDescriptionDTO ServiceComponentRuntimeImpl::CreateDTO(
 
 ComponentConfigurationDTO
 ServiceComponentRuntimeImpl::CreateComponentConfigurationDTO(
-  const std::shared_ptr<ComponentConfiguration>& config) const
+  const std::shared_ptr<ComponentConfiguration>& config,
+  bool withProperties) const
 {
   ComponentConfigurationDTO configDTO = {};
   configDTO.id = config->GetId();
@@ -230,38 +321,40 @@ ServiceComponentRuntimeImpl::CreateComponentConfigurationDTO(
   for (auto& refManager : refManagers) {
     if (refManager->IsSatisfied()) {
       configDTO.satisfiedReferences.push_back(
-        CreateSatisfiedReferenceDTO(refManager));
+        CreateSatisfiedReferenceDTO(refManager, withProperties));
     } else {
       configDTO.unsatisfiedReferences.push_back(
-        CreateUnsatisfiedReferenceDTO(refManager));
+        CreateUnsatisfiedReferenceDTO(refManager, withProperties));
     }
   }
   return configDTO;
 }
 
 SatisfiedReferenceDTO ServiceComponentRuntimeImpl::CreateSatisfiedReferenceDTO(
-  const std::shared_ptr<ReferenceManager>& refManager) const
+  const std::shared_ptr<ReferenceManager>& refManager,
+  bool withProperties) const
 {
   SatisfiedReferenceDTO refDTO = {};
   refDTO.name = refManager->GetReferenceName();
   refDTO.target = refManager->GetLDAPString();
   auto sRefs = refManager->GetBoundReferences();
   for (auto& sRef : sRefs) {
-    refDTO.boundServices.push_back(ToDTO(sRef));
+    refDTO.boundServices.push_back(ToDTO(sRef, withProperties));
   }
   return refDTO;
 }
 
 UnsatisfiedReferenceDTO
 ServiceComponentRuntimeImpl::CreateUnsatisfiedReferenceDTO(
-  const std::shared_ptr<ReferenceManager>& refManager) const
+  const std::shared_ptr<ReferenceManager>& refManager,
+  bool withProperties) const
 {
   UnsatisfiedReferenceDTO refDTO = {};
   refDTO.name = refManager->GetReferenceName();
   refDTO.target = refManager->GetLDAPString();
   auto sRefs = refManager->GetTargetReferences();
   for (auto& sRef : sRefs) {
-    refDTO.targetServices.push_back(ToDTO(sRef));
+    refDTO.targetServices.push_back(ToDTO(sRef, withProperties));
   }
   return refDTO;
 }
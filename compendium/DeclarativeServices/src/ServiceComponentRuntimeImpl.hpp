@@ -33,6 +33,8 @@
 #include "cppmicroservices/logservice/LogService.hpp"
 #include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
 
+using cppmicroservices::service::component::runtime::ComponentQuery;
+using cppmicroservices::service::component::runtime::ComponentQueryResult;
 using cppmicroservices::service::component::runtime::ServiceComponentRuntime;
 using cppmicroservices::service::component::runtime::dto::
   ComponentConfigurationDTO;
@@ -129,17 +131,39 @@ public:
   std::shared_future<void> DisableComponent(
     const ComponentDescriptionDTO& description) override;
 
+  /**
+   * This method returns the descriptions of the components selected by the
+   * query. Only the components on the requested page are converted to DTOs.
+   * See {@code ServiceComponentRuntime#QueryComponentDescriptionDTOs}
+   */
+  ComponentQueryResult QueryComponentDescriptionDTOs(
+    const ComponentQuery& query) const override;
+
+  /**
+   * This method returns the descriptions and component configurations of the
+   * components selected by the query.
+   * See {@code ServiceComponentRuntime#QueryComponentConfigurationDTOs}
+   */
+  ComponentQueryResult QueryComponentConfigurationDTOs(
+    const ComponentQuery& query) const override;
+
 private:
   FRIEND_TEST(ServiceComponentRuntimeImplTest, Validate_Ctor);
 
+  std::vector<std::shared_ptr<ComponentManager>> SelectComponentManagers(
+    const ComponentQuery& query,
+    ComponentQueryResult& result) const;
   ComponentDescriptionDTO CreateDTO(
     const std::shared_ptr<ComponentManager>& compManager) const;
   SatisfiedReferenceDTO CreateSatisfiedReferenceDTO(
-    const std::shared_ptr<ReferenceManager>& refManager) const;
+    const std::shared_ptr<ReferenceManager>& refManager,
+    bool withProperties = true) const;
   UnsatisfiedReferenceDTO CreateUnsatisfiedReferenceDTO(
-    const std::shared_ptr<ReferenceManager>& refManager) const;
+    const std::shared_ptr<ReferenceManager>& refManager,
+    bool withProperties = true) const;
   ComponentConfigurationDTO CreateComponentConfigurationDTO(
-    const std::shared_ptr<ComponentConfiguration>& config) const;
+    const std::shared_ptr<ComponentConfiguration>& config,
+    bool withProperties = true) const;
 
   cppmicroservices::BundleContext scrContext;
   std::shared_ptr<ComponentRegistry> registry;
@@ -26,7 +26,8 @@
 #include "cppmicroservices/SharedLibraryException.h"
 
 #include "BundleLoader.hpp"
-#include <regex>
+#include <unordered_map>
+#include <utility>
 #if defined(_WIN32)
 #  include <Windows.h>
 #else
@@ -78,6 +79,98 @@ std::wstring UTF8StrToWStr(const std::string& inStr)
 }
 #endif
 
+namespace {
+using NewInstanceFuncPtr = ComponentInstance* (*)();
+using DeleteInstanceFuncPtr = void (*)(ComponentInstance*);
+
+/**
+ * The entry points of the components in a bundle's shared library. Built once
+ * when the library is loaded and never modified afterwards.
+ */
+struct BundleSymbols
+{
+  void* handle = nullptr;
+  /// component symbol name -> creator and deleter functions
+  std::unordered_map<std::string,
+                     std::pair<NewInstanceFuncPtr, DeleteInstanceFuncPtr>>
+    components;
+};
+
+/**
+ * Convert a component name into the suffix used by the code generator for
+ * the component's entry points, i.e. replace each "::" with "_"
+ */
+std::string GetComponentSymbolName(const std::string& compName)
+{
+  std::string symbolName;
+  symbolName.reserve(compName.size());
+  for (std::size_t i = 0; i < compName.size(); ++i) {
+    if (compName[i] == ':' && i + 1 < compName.size() &&
+        compName[i + 1] == ':') {
+      symbolName += '_';
+      ++i;
+    } else {
+      symbolName += compName[i];
+    }
+  }
+  return symbolName;
+}
+
+std::shared_ptr<const BundleSymbols> LoadBundleSymbols(
+  const cppmicroservices::Bundle& fromBundle,
+  const std::string& bundleLoc,
+  const std::shared_ptr<cppmicroservices::logservice::LogService>& logger)
+{
+  SharedLibrary sh(bundleLoc);
+  try {
+    auto ctx = fromBundle.GetBundleContext();
+    auto opts = ctx.GetProperty(Constants::LIBRARY_LOAD_OPTIONS);
+    logger->Log(logservice::SeverityLevel::LOG_INFO,
+                "Loading shared library for Bundle #" +
+                  ToString(fromBundle.GetBundleId()) +
+                  " (location=" + bundleLoc + ")");
+    sh.Load(any_cast<int>(opts));
+    logger->Log(logservice::SeverityLevel::LOG_INFO,
+                "Finished loading shared library for Bundle #" +
+                  ToString(fromBundle.GetBundleId()) +
+                  " (location=" + bundleLoc + ")");
+  } catch (const std::system_error& ex) {
+    logger->Log(logservice::SeverityLevel::LOG_INFO,
+                "Failed loading shared library for Bundle #" +
+                  ToString(fromBundle.GetBundleId()) +
+                  " (location=" + bundleLoc + ")",
+                std::make_exception_ptr(ex));
+    // SharedLibrary::Load() will throw a std::system_error when a shared library
+    // fails to load. Creating a SharedLibraryException here to throw with fromBundle information.
+    throw cppmicroservices::SharedLibraryException(
+      ex.code(), ex.what(), fromBundle);
+  }
+
+  auto symbols = std::make_shared<BundleSymbols>();
+  symbols->handle = sh.GetHandle();
+
+  // Bundles whose glue code was generated by an older code generator do not
+  // export a symbol table. Their entry points are looked up by name instead.
+  using GetSymbolTableFuncPtr =
+    const service::component::detail::ComponentSymbol* (*)(std::size_t*);
+  void* tableSym = fromBundle.GetSymbol(
+    symbols->handle,
+    US_STR(US_SCR_COMPONENT_SYMBOLS_PREFIX) + fromBundle.GetSymbolicName());
+  if (tableSym != nullptr) {
+    std::size_t count = 0;
+    auto table =
+      reinterpret_cast<GetSymbolTableFuncPtr>(tableSym)(&count); // NOLINT
+    symbols->components.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      symbols->components.emplace(
+        table[i].name,
+        std::make_pair(table[i].newInstance, table[i].deleteInstance));
+    }
+  }
+  return symbols;
+}
+}
+
 std::tuple<std::function<ComponentInstance*(void)>,
            std::function<void(ComponentInstance*)>>
 GetComponentCreatorDeletors(
@@ -88,49 +181,38 @@ GetComponentCreatorDeletors(
   // cannot use bundle id as key because id is reused when the framework is restarted.
   // strings are not optimal but will work fine as long as a binary is not unloaded
   // from the process.
-  static Guarded<std::map<std::string, void*>>
-    bundleBinaries; ///< map of bundle location and handle pairs
+  static Guarded<
+    std::unordered_map<std::string, std::shared_ptr<const BundleSymbols>>>
+    bundleBinaries; ///< map of bundle location and entry points pairs
   const auto bundleLoc = fromBundle.GetLocation();
 
-  void* handle = nullptr;
-  if (bundleBinaries.lock()->count(bundleLoc) != 0u) {
-    handle = bundleBinaries.lock()->at(bundleLoc);
-  } else {
-    SharedLibrary sh(bundleLoc);
-    try {
-      auto ctx = fromBundle.GetBundleContext();
-      auto opts = ctx.GetProperty(Constants::LIBRARY_LOAD_OPTIONS);
-      logger->Log(logservice::SeverityLevel::LOG_INFO,
-                  "Loading shared library for Bundle #" +
-                    ToString(fromBundle.GetBundleId()) +
-                    " (location=" + bundleLoc + ")");
-      sh.Load(any_cast<int>(opts));
-      logger->Log(logservice::SeverityLevel::LOG_INFO,
-                  "Finished loading shared library for Bundle #" +
-                    ToString(fromBundle.GetBundleId()) +
-                    " (location=" + bundleLoc + ")");
-    } catch (const std::system_error& ex) {
-      logger->Log(logservice::SeverityLevel::LOG_INFO,
-                  "Failed loading shared library for Bundle #" +
-                    ToString(fromBundle.GetBundleId()) +
-                    " (location=" + bundleLoc + ")",
-                  std::make_exception_ptr(ex));
-      // SharedLibrary::Load() will throw a std::system_error when a shared library
-      // fails to load. Creating a SharedLibraryException here to throw with fromBundle information.
-      throw cppmicroservices::SharedLibraryException(
-        ex.code(), ex.what(), fromBundle);
+  std::shared_ptr<const BundleSymbols> symbols;
+  {
+    auto binaries = bundleBinaries.lock();
+    auto it = binaries->find(bundleLoc);
+    if (it != binaries->end()) {
+      symbols = it->second;
     }
-    handle = sh.GetHandle();
-    bundleBinaries.lock()->emplace(bundleLoc, handle);
+  }
+  if (!symbols) {
+    // Loading the library is done without holding the lock. If two threads
+    // race here, the library's reference count is incremented twice and the
+    // first table to be stored is used by both.
+    auto loaded = LoadBundleSymbols(fromBundle, bundleLoc, logger);
+    symbols = bundleBinaries.lock()->emplace(bundleLoc, loaded).first->second;
+  }
+
+  const std::string symbolName = GetComponentSymbolName(compName);
+  auto component = symbols->components.find(symbolName);
+  if (component != symbols->components.end()) {
+    return std::make_tuple(component->second.first, component->second.second);
   }
 
-  const std::string symbolName =
-    std::regex_replace(compName, std::regex("::"), "_");
   const std::string newInstanceFuncName("NewInstance_" + symbolName);
   const std::string deleteInstanceFuncName("DeleteInstance_" + symbolName);
 
-  void* newsym = fromBundle.GetSymbol(handle, newInstanceFuncName);
-  void* delsym = fromBundle.GetSymbol(handle, deleteInstanceFuncName);
+  void* newsym = fromBundle.GetSymbol(symbols->handle, newInstanceFuncName);
+  void* delsym = fromBundle.GetSymbol(symbols->handle, deleteInstanceFuncName);
 
   if (newsym == nullptr || delsym == nullptr) {
     std::string errMsg("Unable to find entry-point functions in bundle ");
@@ -147,8 +229,8 @@ GetComponentCreatorDeletors(
   }
 
   return std::make_tuple(
-    reinterpret_cast<ComponentInstance* (*)(void)>(newsym),  // NOLINT
-    reinterpret_cast<void (*)(ComponentInstance*)>(delsym)); // NOLINT
+    reinterpret_cast<NewInstanceFuncPtr>(newsym),     // NOLINT
+    reinterpret_cast<DeleteInstanceFuncPtr>(delsym)); // NOLINT
 }
 }
 }
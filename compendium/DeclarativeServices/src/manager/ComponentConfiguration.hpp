@@ -25,6 +25,7 @@
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/ServiceReference.h"
 #include "cppmicroservices/servicecomponent/runtime/dto/ComponentConfigurationDTO.hpp"
+#include <cstdint>
 #include <unordered_map>
 
 #include "../metadata/ComponentMetadata.hpp"
@@ -101,6 +102,14 @@ public:
    */
   virtual ComponentState GetConfigState() const = 0;
 
+  /**
+   * Returns the change count of the most recent change of the state,
+   * the properties or the bound services of this component configuration.
+   *
+   * @see ComponentRegistry::NextChangeCount
+   */
+  virtual std::uint64_t GetChangeCount() const = 0;
+
   /**
    * Returns the {@link ComponentMetadata} object created by parsing the
    * component description.
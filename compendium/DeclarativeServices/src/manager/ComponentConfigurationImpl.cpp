@@ -22,7 +22,10 @@
 
 #include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/SecurityException.h"
+#include "cppmicroservices/detail/PerfCounters.h"
+#include "cppmicroservices/detail/Trace.h"
 
+#include "../ComponentRegistry.hpp"
 #include "../ConfigurationListenerImpl.hpp"
 #include "BundleLoader.hpp"
 #include "ComponentConfigurationImpl.hpp"
@@ -70,6 +73,7 @@ ComponentConfigurationImpl::ComponentConfigurationImpl(
   , configNotifier(std::move(configNotifier))
   , managers(std::move(managers))
   , state(std::make_shared<CCUnsatisfiedReferenceState>())
+  , changeCount(ComponentRegistry::NextChangeCount())
   , newCompInstanceFunc(nullptr)
   , deleteCompInstanceFunc(nullptr)
 {
@@ -223,6 +227,8 @@ void ComponentConfigurationImpl::RefChangedState(
     default:
       break;
   }
+  // the bound or target services changed
+  changeCount = ComponentRegistry::NextChangeCount();
 }
 void ComponentConfigurationImpl::ConfigChangedState(
   const ConfigChangeNotification& notification)
@@ -230,6 +236,8 @@ void ComponentConfigurationImpl::ConfigChangedState(
   if (configManager == nullptr) {
     return;
   }
+  US_TRACE_SCOPE(
+    trace, "ds", "configuration " + notification.pid + " of " + metadata->name);
   bool configWasSatisfied = false;
   bool configNowSatisfied = false;
 
@@ -238,6 +246,7 @@ void ComponentConfigurationImpl::ConfigChangedState(
                                         notification.event,
                                         configWasSatisfied,
                                         configNowSatisfied);
+  changeCount = ComponentRegistry::NextChangeCount();
 
   if (configWasSatisfied && configNowSatisfied &&
       (metadata->configurationPolicy != CONFIG_POLICY_IGNORE)) {
@@ -378,11 +387,13 @@ void ComponentConfigurationImpl::Register()
 std::shared_ptr<ComponentInstance> ComponentConfigurationImpl::Activate(
   const Bundle& usingBundle)
 {
+  US_TRACE_SCOPE(trace, "ds", "activate " + metadata->name);
   return GetState()->Activate(*this, usingBundle);
 }
 
 void ComponentConfigurationImpl::Deactivate()
 {
+  US_TRACE_SCOPE(trace, "ds", "deactivate " + metadata->name);
   GetState()->Deactivate(*this);
 }
 
@@ -400,8 +411,13 @@ bool ComponentConfigurationImpl::CompareAndSetState(
   std::shared_ptr<ComponentConfigurationState>* expectedState,
   std::shared_ptr<ComponentConfigurationState> desiredState)
 {
-  return std::atomic_compare_exchange_strong(
-    &state, expectedState, desiredState);
+  if (!std::atomic_compare_exchange_strong(
+        &state, expectedState, desiredState)) {
+    return false;
+  }
+  changeCount = ComponentRegistry::NextChangeCount();
+  US_PERF_COUNT("ds.component_configuration.transition", 0);
+  return true;
 }
 
 std::shared_ptr<ComponentConfigurationState>
@@ -23,6 +23,7 @@
 #ifndef __COMPONENTCONFIGURATIONIMPL_HPP__
 #define __COMPONENTCONFIGURATIONIMPL_HPP__
 
+#include <atomic>
 #include <memory>
 #if defined(USING_GTEST)
 #  include "gtest/gtest_prod.h"
@@ -140,6 +141,11 @@ public:
    */
   ComponentState GetConfigState() const override;
 
+  /** @copydoc ComponentConfiguration::GetChangeCount()
+   *
+   */
+  std::uint64_t GetChangeCount() const override { return changeCount; }
+
    /**
    * This method returns the {@link ConfigurationNotifier} object 
    */
@@ -438,6 +444,8 @@ private:
   std::shared_ptr<std::vector<std::shared_ptr<ComponentManager>>> managers;
   std::shared_ptr<ComponentConfigurationState>
     state; ///< only modified using std::atomic operations
+  std::atomic<std::uint64_t>
+    changeCount; ///< change count of the most recent change
   std::function<ComponentInstance*(void)>
     newCompInstanceFunc; ///< extern C function to create a new instance {@link ComponentInstance} class from the component's bundle
   std::function<void(ComponentInstance*)>
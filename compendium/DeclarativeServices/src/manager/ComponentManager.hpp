@@ -26,6 +26,7 @@
 #include "../metadata/ComponentMetadata.hpp"
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/ServiceFactory.h"
+#include <cstdint>
 #include <future>
 #include <memory>
 
@@ -90,6 +91,14 @@ public:
    */
   virtual std::shared_ptr<const metadata::ComponentMetadata> GetMetadata()
     const = 0;
+
+  /**
+   * Returns the change count of the most recent change of the component or
+   * one of its component configurations.
+   *
+   * @see ComponentRegistry::NextChangeCount
+   */
+  virtual std::uint64_t GetChangeCount() const = 0;
 };
 } // scrimpl
 } // cppmicroservices
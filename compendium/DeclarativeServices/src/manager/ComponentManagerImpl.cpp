@@ -21,12 +21,17 @@
   =============================================================================*/
 
 #include "ComponentManagerImpl.hpp"
+#include "../ComponentRegistry.hpp"
+#include "ComponentConfiguration.hpp"
 #include "ConcurrencyUtil.hpp"
 #include "cppmicroservices/SharedLibraryException.h"
 #include "cppmicroservices/SecurityException.h"
+#include "cppmicroservices/detail/PerfCounters.h"
+#include "cppmicroservices/detail/Trace.h"
 #include "states/CMDisabledState.hpp"
 #include "states/CMEnabledState.hpp"
 #include "states/ComponentManagerState.hpp"
+#include <algorithm>
 #include <cassert>
 #include <future>
 #include <utility>
@@ -47,6 +52,7 @@ ComponentManagerImpl::ComponentManagerImpl(
   , bundleContext(std::move(bundleContext))
   , logger(std::move(logger))
   , state(std::make_shared<CMDisabledState>())
+  , changeCount(0)
   , asyncWorkService(std::move(asyncWorkService))
   , configNotifier(std::move(configNotifier))
   , managers(std::move(managers))
@@ -120,8 +126,22 @@ bool ComponentManagerImpl::CompareAndSetState(
   std::shared_ptr<ComponentManagerState>* expectedState,
   std::shared_ptr<ComponentManagerState> desiredState)
 {
-  return std::atomic_compare_exchange_strong(
-    &state, expectedState, desiredState);
+  if (!std::atomic_compare_exchange_strong(
+        &state, expectedState, desiredState)) {
+    return false;
+  }
+  changeCount = ComponentRegistry::NextChangeCount();
+  US_PERF_COUNT("ds.component_manager.transition", 0);
+  return true;
+}
+
+std::uint64_t ComponentManagerImpl::GetChangeCount() const
+{
+  std::uint64_t count = changeCount.load();
+  for (const auto& config : GetComponentConfigurations()) {
+    count = std::max(count, config->GetChangeCount());
+  }
+  return count;
 }
 
 void ComponentManagerImpl::AccumulateFuture(std::shared_future<void> fObj)
@@ -154,6 +174,7 @@ std::shared_future<void> ComponentManagerImpl::PostAsyncDisabledToEnabled(
 
   ActualTask task([metadata, bundle, reg, logger, configNotifier, managers](
                     std::shared_ptr<CMEnabledState> eState) mutable {
+    US_TRACE_SCOPE(trace, "ds", "enable " + metadata->name);
     eState->CreateConfigurations(
       metadata, bundle, reg, logger, configNotifier, managers);
   });
@@ -189,7 +210,9 @@ std::shared_future<void> ComponentManagerImpl::PostAsyncEnabledToDisabled(
   using ActualTask = std::packaged_task<void(std::shared_ptr<CMEnabledState>)>;
   using PostTask = std::packaged_task<void()>;
 
-  ActualTask task([](std::shared_ptr<CMEnabledState> enabledState) mutable {
+  ActualTask task([metadata = GetMetadata()](
+                    std::shared_ptr<CMEnabledState> enabledState) mutable {
+    US_TRACE_SCOPE(trace, "ds", "disable " + metadata->name);
     enabledState->DeleteConfigurations();
   });
 
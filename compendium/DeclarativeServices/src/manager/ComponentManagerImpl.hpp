@@ -34,6 +34,8 @@
 #include "cppmicroservices/asyncworkservice/AsyncWorkService.hpp"
 #include "cppmicroservices/logservice/LogService.hpp"
 
+#include <atomic>
+
 namespace cppmicroservices {
 namespace scrimpl {
 
@@ -97,6 +99,12 @@ public:
     return compDesc;
   }
 
+  /** @copydoc ComponentManager::GetChangeCount()
+   * Returns the most recent change count of this object and its
+   * component configurations
+   */
+  std::uint64_t GetChangeCount() const override;
+
   /** @copydoc ComponentManager::GetName()
    * Returns the names from the stored component description
    */
@@ -219,6 +227,8 @@ private:
     logger; ///< logger associated with the current runtime
   std::shared_ptr<ComponentManagerState>
     state; ///< This member is always accessed using atomic operations
+  std::atomic<std::uint64_t>
+    changeCount; ///< change count of the most recent state transition
   std::vector<std::shared_future<void>>
     disableFutures; ///< futures created when the component transitioned to \c DISABLED state
   std::mutex futuresMutex; ///< mutex to protect the #disableFutures member
@@ -0,0 +1,256 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "BinaryMetadataReader.hpp"
+#include "MetadataRules.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+
+namespace cppmicroservices {
+namespace scrimpl {
+namespace metadata {
+
+namespace {
+// value tags, see BinaryMetadataGenerator::ValueTag
+enum ValueTag : std::uint8_t
+{
+  TagBool = 1,
+  TagInt = 2,
+  TagDouble = 3,
+  TagString = 4,
+  TagArray = 5,
+  TagObject = 6
+};
+}
+
+const std::string BinaryMetadataReader::RESOURCE_PATH = "scr/metadata.bin";
+const std::string BinaryMetadataReader::MANIFEST_PATH = "manifest.json";
+const std::string BinaryMetadataReader::MANIFEST_KEY = "precompiled_metadata";
+
+BinaryMetadataReader::BinaryMetadataReader(std::istream& in)
+  : in(in)
+  , manifestHash(0)
+  , manifestVersion(0)
+  , componentCount(0)
+{
+  char magic[4] = {};
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, "SCRM", sizeof(magic)) != 0) {
+    throw std::runtime_error("Invalid precompiled component metadata header");
+  }
+  const auto formatVersion = ReadU32();
+  if (formatVersion != FORMAT_VERSION) {
+    throw std::runtime_error(
+      "Unsupported precompiled component metadata version " +
+      std::to_string(formatVersion));
+  }
+  manifestHash = ReadU64();
+  manifestVersion = ReadU32();
+  componentCount = ReadU32();
+}
+
+std::uint64_t BinaryMetadataReader::HashManifest(std::istream& manifest)
+{
+  // see BinaryMetadataGenerator::HashManifest
+  std::uint64_t hash = 14695981039346656037ULL;
+  char buffer[4096];
+  while (manifest.read(buffer, sizeof(buffer)) || manifest.gcount() > 0) {
+    const auto count = manifest.gcount();
+    for (std::streamsize i = 0; i < count; ++i) {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 1099511628211ULL;
+    }
+  }
+  return hash;
+}
+
+std::vector<std::shared_ptr<ComponentMetadata>>
+BinaryMetadataReader::ReadComponentsMetadata(
+  const std::shared_ptr<cppmicroservices::logservice::LogService>& logger)
+{
+  std::vector<std::shared_ptr<ComponentMetadata>> componentsMetadata;
+  componentsMetadata.reserve(componentCount);
+  for (std::uint32_t i = 0; i < componentCount; ++i) {
+    // the code generator records the components the runtime parser would
+    // skip together with the reason
+    if (ReadU8() == 0) {
+      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
+                  rules::ComponentError(ReadString(), i));
+      continue;
+    }
+    for (const auto& warning : ReadStrings()) {
+      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                  warning);
+    }
+    componentsMetadata.push_back(ReadComponentMetadata());
+  }
+  return componentsMetadata;
+}
+
+std::shared_ptr<ComponentMetadata> BinaryMetadataReader::ReadComponentMetadata()
+{
+  auto compMetadata = std::make_shared<ComponentMetadata>();
+  compMetadata->name = ReadString();
+  compMetadata->implClassName = ReadString();
+  compMetadata->enabled = ReadU8() != 0;
+  compMetadata->immediate = ReadU8() != 0;
+  compMetadata->configurationPolicy = ReadString();
+  compMetadata->configurationPids = ReadStrings();
+  compMetadata->factoryComponentID = ReadString();
+
+  if (ReadU8() != 0) {
+    compMetadata->serviceMetadata.scope = ReadString();
+    compMetadata->serviceMetadata.interfaces = ReadStrings();
+  }
+
+  const auto refCount = ReadU32();
+  compMetadata->refsMetadata.reserve(refCount);
+  for (std::uint32_t i = 0; i < refCount; ++i) {
+    ReferenceMetadata refMetadata;
+    refMetadata.name = ReadString();
+    refMetadata.interfaceName = ReadString();
+    refMetadata.target = ReadString();
+    refMetadata.cardinality = ReadString();
+    std::tie(refMetadata.minCardinality, refMetadata.maxCardinality) =
+      GetReferenceCardinalityExtents(refMetadata.cardinality);
+    refMetadata.policy = ReadString();
+    refMetadata.policyOption = ReadString();
+    compMetadata->refsMetadata.push_back(std::move(refMetadata));
+  }
+
+  compMetadata->properties = ReadProperties();
+  compMetadata->factoryComponentProperties = ReadProperties();
+  return compMetadata;
+}
+
+std::unordered_map<std::string, cppmicroservices::Any>
+BinaryMetadataReader::ReadProperties()
+{
+  std::unordered_map<std::string, cppmicroservices::Any> props;
+  const auto count = ReadU32();
+  for (std::uint32_t i = 0; i < count; ++i) {
+    auto key = ReadString();
+    props.emplace(std::move(key), ReadValue());
+  }
+  return props;
+}
+
+cppmicroservices::AnyMap BinaryMetadataReader::ReadAnyMap()
+{
+  // The framework stores all manifest objects with case-insensitive keys
+  cppmicroservices::AnyMap anyMap(
+    cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  const auto count = ReadU32();
+  for (std::uint32_t i = 0; i < count; ++i) {
+    auto key = ReadString();
+    anyMap.emplace(std::move(key), ReadValue());
+  }
+  return anyMap;
+}
+
+cppmicroservices::Any BinaryMetadataReader::ReadValue()
+{
+  switch (ReadU8()) {
+    case TagBool:
+      return cppmicroservices::Any(ReadU8() != 0);
+    case TagInt:
+      return cppmicroservices::Any(static_cast<int>(ReadU32()));
+    case TagDouble: {
+      std::uint64_t bits = ReadU32();
+      bits |= static_cast<std::uint64_t>(ReadU32()) << 32;
+      double value = 0;
+      std::memcpy(&value, &bits, sizeof(value));
+      return cppmicroservices::Any(value);
+    }
+    case TagString:
+      return cppmicroservices::Any(ReadString());
+    case TagArray: {
+      const auto count = ReadU32();
+      std::vector<cppmicroservices::Any> values;
+      values.reserve(count);
+      for (std::uint32_t i = 0; i < count; ++i) {
+        values.push_back(ReadValue());
+      }
+      return cppmicroservices::Any(std::move(values));
+    }
+    case TagObject:
+      return cppmicroservices::Any(ReadAnyMap());
+    default:
+      throw std::runtime_error(
+        "Invalid value type in precompiled component metadata");
+  }
+}
+
+std::vector<std::string> BinaryMetadataReader::ReadStrings()
+{
+  const auto count = ReadU32();
+  std::vector<std::string> values;
+  values.reserve(count);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    values.push_back(ReadString());
+  }
+  return values;
+}
+
+std::string BinaryMetadataReader::ReadString()
+{
+  const auto size = ReadU32();
+  std::string value(size, '\0');
+  if (size != 0 && !in.read(&value[0], size)) {
+    throw std::runtime_error("Truncated precompiled component metadata");
+  }
+  return value;
+}
+
+std::uint64_t BinaryMetadataReader::ReadU64()
+{
+  const std::uint64_t low = ReadU32();
+  const std::uint64_t high = ReadU32();
+  return low | (high << 32);
+}
+
+std::uint32_t BinaryMetadataReader::ReadU32()
+{
+  unsigned char bytes[4] = {};
+  if (!in.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) { // NOLINT
+    throw std::runtime_error("Truncated precompiled component metadata");
+  }
+  return static_cast<std::uint32_t>(bytes[0]) |
+         (static_cast<std::uint32_t>(bytes[1]) << 8) |
+         (static_cast<std::uint32_t>(bytes[2]) << 16) |
+         (static_cast<std::uint32_t>(bytes[3]) << 24);
+}
+
+std::uint8_t BinaryMetadataReader::ReadU8()
+{
+  char byte = 0;
+  if (!in.get(byte)) {
+    throw std::runtime_error("Truncated precompiled component metadata");
+  }
+  return static_cast<std::uint8_t>(byte);
+}
+
+}
+}
+}
@@ -0,0 +1,133 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef BINARYMETADATAREADER_HPP
+#define BINARYMETADATAREADER_HPP
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ComponentMetadata.hpp"
+#include "cppmicroservices/logservice/LogService.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+namespace metadata {
+
+/*
+ * Reads component metadata which was precompiled from the bundle manifest
+ * by the SCR code generator (option --metadata-out-file).
+ *
+ * The precompiled metadata has all defaults already resolved, so the
+ * components are created directly from the binary data without going through
+ * the @c AnyMap validation done by @c MetadataParserImplV1.
+ *
+ * See compendium/tools/SCRCodeGen/BinaryMetadataGenerator.hpp for the layout.
+ */
+class BinaryMetadataReader
+{
+public:
+  /*
+   * The bundle resource path of the precompiled metadata.
+   */
+  static const std::string RESOURCE_PATH;
+
+  /*
+   * The bundle resource path of the manifest the metadata must match.
+   */
+  static const std::string MANIFEST_PATH;
+
+  /*
+   * The key in the "scr" section of the manifest which tells DS that the
+   * bundle contains precompiled metadata. Bundles without it are not probed
+   * for the resource, which would re-open their resource container.
+   */
+  static const std::string MANIFEST_KEY;
+
+  /*
+   * The binary format version understood by this reader.
+   */
+  static constexpr std::uint32_t FORMAT_VERSION = 3;
+
+  /*
+   * @returns the 64-bit FNV-1a hash of the manifest read from @p manifest,
+   *          as recorded in the precompiled metadata by the code generator
+   */
+  static std::uint64_t HashManifest(std::istream& manifest);
+
+  /*
+   * @param in The stream containing the precompiled metadata
+   * @throws std::runtime_error if the stream does not start with a supported
+   *         header.
+   */
+  explicit BinaryMetadataReader(std::istream& in);
+
+  /*
+   * @returns the hash of the manifest file this metadata was created from
+   */
+  std::uint64_t GetManifestHash() const { return manifestHash; }
+
+  /*
+   * @returns the "version" of the "scr" section this metadata was created from
+   */
+  std::uint32_t GetManifestVersion() const { return manifestVersion; }
+
+  /*
+   * @returns the number of components in the precompiled metadata
+   */
+  std::uint32_t GetComponentCount() const { return componentCount; }
+
+  /*
+   * @brief Read the metadata of all components
+   * @param logger Logs the components the code generator found invalid,
+   *        which are skipped, and the warnings of the others, as
+   *        @c MetadataParserImplV1 does when it parses the manifest
+   * @returns the vector of shared_ptrs to the @c ComponentMetadata objects
+   * @throws std::runtime_error if the data is truncated or malformed.
+   */
+  std::vector<std::shared_ptr<ComponentMetadata>> ReadComponentsMetadata(
+    const std::shared_ptr<cppmicroservices::logservice::LogService>& logger);
+
+private:
+  std::shared_ptr<ComponentMetadata> ReadComponentMetadata();
+  std::unordered_map<std::string, cppmicroservices::Any> ReadProperties();
+  cppmicroservices::AnyMap ReadAnyMap();
+  cppmicroservices::Any ReadValue();
+  std::vector<std::string> ReadStrings();
+  std::string ReadString();
+  std::uint64_t ReadU64();
+  std::uint32_t ReadU32();
+  std::uint8_t ReadU8();
+
+  std::istream& in;
+  std::uint64_t manifestHash;
+  std::uint32_t manifestVersion;
+  std::uint32_t componentCount;
+};
+}
+}
+}
+
+#endif //BINARYMETADATAREADER_HPP
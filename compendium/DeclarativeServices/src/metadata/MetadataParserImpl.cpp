@@ -22,15 +22,13 @@
 
 #include "MetadataParserImpl.hpp"
 #include "ComponentMetadata.hpp"
+#include "MetadataRules.hpp"
 #include "Util.hpp"
 #include "cppmicroservices/Bundle.h"
 
-#include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include <iterator>
 
 using cppmicroservices::scrimpl::util::ObjectValidator;
-using cppmicroservices::service::component::ComponentConstants::
-  CONFIG_POLICY_IGNORE;
 
 namespace cppmicroservices {
 namespace scrimpl {
@@ -116,18 +114,15 @@ MetadataParserImplV1::CreateComponentMetadata(const AnyMap& metadata) const
     .AssignValueTo(compMetadata->implClassName);
 
   // component.immediate
-  compMetadata->immediate = true;
   const bool serviceSpecified =
     ObjectValidator(metadata, "service", /*isOptional=*/true).KeyExists();
   auto object = ObjectValidator(metadata, "immediate", /*isOptional=*/true);
-  const bool isImmediate =
-    (object.KeyExists()) ? object.GetValue<bool>() : !serviceSpecified;
-  if (!serviceSpecified && !isImmediate) {
-    throw std::runtime_error(
-      "Invalid value specified for the name 'immediate'.");
+  bool immediate = false;
+  if (object.KeyExists()) {
+    immediate = object.GetValue<bool>();
   }
-  compMetadata->immediate =
-    (!serviceSpecified || (serviceSpecified && isImmediate));
+  compMetadata->immediate = rules::ResolveImmediate(
+    serviceSpecified, object.KeyExists() ? &immediate : nullptr);
 
   // component.enabled
   ObjectValidator(metadata, "enabled", /*isOptional=*/true)
@@ -139,67 +134,35 @@ MetadataParserImplV1::CreateComponentMetadata(const AnyMap& metadata) const
     .AssignValueTo(compMetadata->name);
 
   // component.configuration-policy (Optional)
-  compMetadata->configurationPolicy = CONFIG_POLICY_IGNORE;
-  bool configPolicy = false;
   object =
     ObjectValidator(metadata, "configuration-policy", /*isOptional=*/true);
-  if (object.KeyExists()) {
-    object.AssignValueTo(compMetadata->configurationPolicy);
-    configPolicy = true;
-  }
+  const bool configPolicy = object.KeyExists();
+  object.AssignValueTo(compMetadata->configurationPolicy);
 
   // component.configuration-pid (Optional)
-  bool configPid = false;
   object = ObjectValidator(metadata, "configuration-pid", /*isOptional=*/true);
-  if (object.KeyExists()) {
-    configPid = true;
-    if (configPolicy ) {
-      const auto configPids =
-        object.GetValue<std::vector<cppmicroservices::Any>>();
-      std::transform(
-        std::begin(configPids),
-        std::end(configPids),
-        std::back_inserter(compMetadata->configurationPids),
-        [](const auto& configPid) {
-          return ObjectValidator(configPid).GetValue<std::string>();
-        });
-
-      //search for a configuration pid equal to $. If present replace with component name.
-      // Also search for duplicates pids. These are errors.
-      std::unordered_map<std::string, std::string> duplicatePids;
-      for (auto& pid : compMetadata->configurationPids) {
-        if (pid == "$") {
-          pid = compMetadata->name;
-        }
-
-        if (duplicatePids.find(pid) != duplicatePids.end()) {
-          std::string msg =
-            "configuration-pid error in the manifest. Duplicate pid detected. ";
-          msg.append(pid);
-          throw std::runtime_error(msg);
-        }
-        duplicatePids.emplace(pid, pid);
-      };
-    }
+  const bool configPid = object.KeyExists();
+  if (configPolicy && configPid) {
+    const auto configPids =
+      object.GetValue<std::vector<cppmicroservices::Any>>();
+    std::transform(std::begin(configPids),
+                   std::end(configPids),
+                   std::back_inserter(compMetadata->configurationPids),
+                   [](const auto& configPid) {
+                     return ObjectValidator(configPid).GetValue<std::string>();
+                   });
   }
-  /* In order to participate in ConfigurationAdmin both the configuration-policy
-     * and the configuration-pid must be present in the manifest.json file. 
-     * Otherwise the configuration-policy is set to ignore. If only one is present
-     * a Warning message is logged.
-     */
-  if ((configPolicy && !configPid) || (!configPolicy && configPid)) {
-    compMetadata->configurationPolicy = CONFIG_POLICY_IGNORE;
-    compMetadata->configurationPids.clear();
-    std::string msg = "Warning: configuration-policy has been set to ignore.";
-    msg.append(
-      " Both configuration-policy and configuration-pid must be present");
-    msg.append(" to participate in Configuration Admin. ");
-    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING, msg);
+  const auto warning =
+    rules::ResolveConfiguration(compMetadata->name,
+                                configPolicy,
+                                configPid,
+                                compMetadata->configurationPolicy,
+                                compMetadata->configurationPids);
+  if (!warning.empty()) {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                warning);
   }
 
-  if (compMetadata->configurationPolicy == CONFIG_POLICY_IGNORE) {
-    compMetadata->configurationPids.clear();
-  }
   // component.factory
   ObjectValidator(metadata, "factory", /*isOptional=*/true)
     .AssignValueTo(compMetadata->factoryComponentID);
@@ -255,10 +218,8 @@ MetadataParserImplV1::ParseAndGetComponentsMetadata(const AnyMap& scrmap) const
     try {
       componentsMetadata.emplace_back(CreateComponentMetadata(componentMap));
     } catch (std::exception& ex) {
-      std::string msg = std::string(ex.what());
-      msg +=
-        " Could not load the component with index: " + std::to_string(index);
-      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR, msg);
+      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
+                  rules::ComponentError(ex.what(), index));
     }
     ++index;
   }
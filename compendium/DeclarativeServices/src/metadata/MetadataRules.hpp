@@ -0,0 +1,227 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef METADATARULES_HPP
+#define METADATARULES_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * The choices, defaults and cross-field rules of the "scr" section of a
+ * bundle manifest.
+ *
+ * Shared by the runtime parser (MetadataParserImplV1) and the SCR code
+ * generator, which resolves the same rules at build time when it writes the
+ * precompiled metadata. Only depends on the standard library so that the
+ * code generator can include it without linking Declarative Services.
+ */
+namespace cppmicroservices {
+namespace scrimpl {
+namespace metadata {
+namespace rules {
+
+constexpr const char* DEFAULT_SERVICE_SCOPE = "singleton";
+constexpr const char* DEFAULT_CARDINALITY = "1..1";
+constexpr const char* DEFAULT_POLICY = "static";
+constexpr const char* DEFAULT_POLICY_OPTION = "reluctant";
+constexpr const char* DEFAULT_CONFIG_POLICY = "ignore";
+
+inline const std::vector<std::string>& ServiceScopes()
+{
+  static const std::vector<std::string> scopes = { "bundle",
+                                                   "prototype",
+                                                   "singleton" };
+  return scopes;
+}
+
+// The order matters, see GetCardinalityExtents
+inline const std::vector<std::string>& ReferenceCardinalities()
+{
+  static const std::vector<std::string> cardinalities = { "0..1",
+                                                          "1..1",
+                                                          "0..n",
+                                                          "1..n" };
+  return cardinalities;
+}
+
+inline const std::vector<std::string>& ReferencePolicies()
+{
+  static const std::vector<std::string> policies = { "static", "dynamic" };
+  return policies;
+}
+
+inline const std::vector<std::string>& ReferencePolicyOptions()
+{
+  static const std::vector<std::string> policyOptions = { "greedy",
+                                                          "reluctant" };
+  return policyOptions;
+}
+
+/*
+ * @returns the (minimum, maximum) number of services bound by a reference
+ *          with the given @p cardinality
+ * @throws std::out_of_range if @p cardinality is not one of
+ *         @c ReferenceCardinalities
+ */
+inline std::tuple<std::size_t, std::size_t> GetCardinalityExtents(
+  const std::string& cardinality)
+{
+  constexpr auto unbounded = std::numeric_limits<std::size_t>::max();
+  const auto& cardinalities = ReferenceCardinalities();
+  const auto it =
+    std::find(std::begin(cardinalities), std::end(cardinalities), cardinality);
+  switch (std::distance(std::begin(cardinalities), it)) {
+    case 0:
+      return std::make_tuple(0, 1);
+    case 1:
+      return std::make_tuple(1, 1);
+    case 2:
+      return std::make_tuple(0, unbounded);
+    case 3:
+      return std::make_tuple(1, unbounded);
+    default:
+      throw std::out_of_range(cardinality +
+                              " is not a valid ReferenceCardinality string");
+  }
+}
+
+/*
+ * @throws std::out_of_range if the lower-cased @p value is not one of
+ *         @p choices. An empty @p choices accepts any value.
+ */
+inline void ThrowIfNotChoice(const std::string& inValue,
+                             const std::vector<std::string>& choices)
+{
+  std::string value = inValue;
+  std::transform(
+    value.begin(), value.end(), value.begin(), [](unsigned char c) {
+      return static_cast<char>(std::tolower(c));
+    });
+  if (!choices.empty() &&
+      std::find(choices.begin(), choices.end(), value) == choices.end()) {
+    std::ostringstream stream;
+    stream << "Invalid value '" + value + "'. ";
+    stream << "The valid choices are : [";
+    for (auto c = std::begin(choices); c < std::end(choices) - 1; ++c) {
+      stream << *c << ", ";
+    }
+    stream << choices.back() << "].";
+    throw std::out_of_range(stream.str());
+  }
+}
+
+/*
+ * A component without a service is always immediate.
+ *
+ * @param immediate the "immediate" value of the component, or nullptr if
+ *        the manifest does not specify it
+ * @throws std::runtime_error if a component without a service is explicitly
+ *         not immediate
+ */
+inline bool ResolveImmediate(bool serviceSpecified, const bool* immediate)
+{
+  const bool isImmediate = immediate ? *immediate : !serviceSpecified;
+  if (!serviceSpecified && !isImmediate) {
+    throw std::runtime_error(
+      "Invalid value specified for the name 'immediate'.");
+  }
+  return isImmediate;
+}
+
+/*
+ * Resolves "configuration-policy" and "configuration-pid" of the component
+ * named @p name.
+ *
+ * On entry @p policy holds the configuration-policy if @p policySpecified,
+ * and @p pids the configuration-pids if both are specified. On return a "$"
+ * pid is replaced by @p name, and the policy is @c DEFAULT_CONFIG_POLICY
+ * with no pids unless both were specified.
+ *
+ * @returns the warning to log if only one of the two was specified, or an
+ *          empty string
+ * @throws std::runtime_error on a duplicate pid
+ */
+inline std::string ResolveConfiguration(const std::string& name,
+                                        bool policySpecified,
+                                        bool pidSpecified,
+                                        std::string& policy,
+                                        std::vector<std::string>& pids)
+{
+  if (!policySpecified) {
+    policy = DEFAULT_CONFIG_POLICY;
+  }
+  if (policySpecified && pidSpecified) {
+    std::unordered_set<std::string> uniquePids;
+    for (auto& pid : pids) {
+      if (pid == "$") {
+        pid = name;
+      }
+      if (!uniquePids.insert(pid).second) {
+        throw std::runtime_error(
+          "configuration-pid error in the manifest. Duplicate pid detected. " +
+          pid);
+      }
+    }
+  }
+
+  /* In order to participate in ConfigurationAdmin both the configuration-policy
+   * and the configuration-pid must be present in the manifest.json file.
+   * Otherwise the configuration-policy is set to ignore. If only one is present
+   * a warning is returned.
+   */
+  std::string warning;
+  if (policySpecified != pidSpecified) {
+    policy = DEFAULT_CONFIG_POLICY;
+    warning = "Warning: configuration-policy has been set to ignore."
+              " Both configuration-policy and configuration-pid must be "
+              "present to participate in Configuration Admin. ";
+  }
+  if (policy == DEFAULT_CONFIG_POLICY) {
+    pids.clear();
+  }
+  return warning;
+}
+
+/*
+ * @returns the error logged for the component at @p index of the manifest
+ *          which could not be loaded because of @p what
+ */
+inline std::string ComponentError(const std::string& what, std::size_t index)
+{
+  return what +
+         " Could not load the component with index: " + std::to_string(index);
+}
+}
+}
+}
+}
+
+#endif //METADATARULES_HPP
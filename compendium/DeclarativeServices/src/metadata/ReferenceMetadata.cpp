@@ -20,8 +20,7 @@
 
   =============================================================================*/
 
-#include <limits>
-
+#include "MetadataRules.hpp"
 #include "ReferenceMetadata.hpp"
 #include "Util.hpp"
 
@@ -29,16 +28,12 @@ namespace cppmicroservices {
 namespace scrimpl {
 namespace metadata {
 
-const std::vector<std::string> ReferenceMetadata::Cardinalities = { "0..1",
-                                                                    "1..1",
-                                                                    "0..n",
-                                                                    "1..n" };
-const std::vector<std::string> ReferenceMetadata::Policies = { "static",
-                                                               "dynamic" };
-const std::vector<std::string> ReferenceMetadata::PolicyOptions = {
-  "greedy",
-  "reluctant"
-};
+const std::vector<std::string> ReferenceMetadata::Cardinalities =
+  rules::ReferenceCardinalities();
+const std::vector<std::string> ReferenceMetadata::Policies =
+  rules::ReferencePolicies();
+const std::vector<std::string> ReferenceMetadata::PolicyOptions =
+  rules::ReferencePolicyOptions();
 const std::vector<std::string> ReferenceMetadata::Scopes = {
   "bundle",
   "prototype",
@@ -48,40 +43,7 @@ const std::vector<std::string> ReferenceMetadata::Scopes = {
 std::tuple<std::size_t, std::size_t> GetReferenceCardinalityExtents(
   const std::string& cardinality)
 {
-  std::size_t minCardinality = 1;
-  std::size_t maxCardinality = 1;
-  auto cardinalities = ReferenceMetadata::Cardinalities;
-  auto it =
-    std::find(std::begin(cardinalities), std::end(cardinalities), cardinality);
-  if (it == std::end(cardinalities)) {
-    std::string msg =
-      cardinality + " is not a valid ReferenceCardinality string";
-    throw std::out_of_range(msg);
-  }
-  auto index = std::distance(std::begin(cardinalities), it);
-  switch (index) {
-    case 0: {
-      minCardinality = 0;
-      maxCardinality = 1;
-      break;
-    }
-    case 1: {
-      minCardinality = 1;
-      maxCardinality = 1;
-      break;
-    }
-    case 2: {
-      minCardinality = 0;
-      maxCardinality = std::numeric_limits<std::size_t>::max();
-      break;
-    }
-    case 3: {
-      minCardinality = 1;
-      maxCardinality = std::numeric_limits<std::size_t>::max();
-      break;
-    }
-  }
-  return std::make_tuple(minCardinality, maxCardinality);
+  return rules::GetCardinalityExtents(cardinality);
 }
 }
 }
@@ -29,6 +29,7 @@
 #include <tuple>
 #include <vector>
 
+#include "MetadataRules.hpp"
 #include "Util.hpp"
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/Constants.h"
@@ -46,9 +47,9 @@ struct ReferenceMetadata
 {
   // defaults for the data model
   ReferenceMetadata()
-    : cardinality("1..1")
-    , policy("static")
-    , policyOption("reluctant")
+    : cardinality(rules::DEFAULT_CARDINALITY)
+    , policy(rules::DEFAULT_POLICY)
+    , policyOption(rules::DEFAULT_POLICY_OPTION)
     , scope("bundle")
   {}
 
@@ -26,9 +26,8 @@ namespace cppmicroservices {
 namespace scrimpl {
 namespace metadata {
 
-const std::vector<std::string> ServiceMetadata::Scopes = { "bundle",
-                                                           "prototype",
-                                                           "singleton" };
+const std::vector<std::string> ServiceMetadata::Scopes =
+  rules::ServiceScopes();
 
 }
 }
@@ -28,6 +28,7 @@
 
 #include <iostream>
 
+#include "MetadataRules.hpp"
 #include "Util.hpp"
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/Constants.h"
@@ -42,7 +43,7 @@ namespace metadata {
 struct ServiceMetadata
 {
   ServiceMetadata()
-    : scope(cppmicroservices::Constants::SCOPE_SINGLETON)
+    : scope(rules::DEFAULT_SERVICE_SCOPE)
   {}
 
   std::vector<std::string> interfaces;
@@ -175,6 +175,7 @@ public:
                      std::vector<std::shared_ptr<ComponentConfiguration>>());
   MOCK_CONST_METHOD0(GetMetadata,
                      std::shared_ptr<const metadata::ComponentMetadata>());
+  MOCK_CONST_METHOD0(GetChangeCount, std::uint64_t(void));
 };
 
 class MockComponentRegistry : public ComponentRegistry
@@ -268,6 +269,7 @@ public:
   MOCK_CONST_METHOD0(GetBundle, cppmicroservices::Bundle(void));
   MOCK_CONST_METHOD0(GetId, unsigned long(void));
   MOCK_CONST_METHOD0(GetConfigState, ComponentState(void));
+  MOCK_CONST_METHOD0(GetChangeCount, std::uint64_t(void));
   MOCK_CONST_METHOD0(GetMetadata,
                      std::shared_ptr<const metadata::ComponentMetadata>(void));
 };
@@ -116,6 +116,30 @@ TEST_F(SCRLoggerTest, VerifyWithLoggerService)
   });
 }
 
+TEST_F(SCRLoggerTest, VerifyLevelQuery)
+{
+  auto bundleContext = GetFramework().GetBundleContext();
+  cppmicroservices::scrimpl::SCRLogger logger(bundleContext);
+  // without a LogService, messages are never built
+  EXPECT_FALSE(logger.IsLevelEnabled(SeverityLevel::LOG_ERROR));
+
+  auto mockLogger = std::make_shared<testing::NiceMock<MockLogger>>();
+  auto reg = bundleContext.RegisterService<LogService>(mockLogger);
+  EXPECT_TRUE(logger.IsLevelEnabled(SeverityLevel::LOG_DEBUG));
+  EXPECT_CALL(*mockLogger, Log(SeverityLevel::LOG_DEBUG, "lazy message"))
+    .Times(1);
+  logger.LogLazily(SeverityLevel::LOG_DEBUG,
+                   [] { return std::string("lazy message"); });
+  reg.Unregister();
+
+  bool built = false;
+  logger.LogLazily(SeverityLevel::LOG_DEBUG, [&built] {
+    built = true;
+    return std::string("discarded message");
+  });
+  EXPECT_FALSE(built);
+}
+
 TEST_F(SCRLoggerTest, VerifyLoggerServiceStaticBinding)
 {
   EXPECT_NO_THROW({
@@ -0,0 +1,241 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "../src/metadata/BinaryMetadataReader.hpp"
+#include "../src/metadata/MetadataParserImpl.hpp"
+#include "Mocks.hpp"
+#include "TestUtils.hpp"
+#include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
+#include "gtest/gtest.h"
+
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/BundleResource.h>
+#include <cppmicroservices/BundleResourceStream.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include <sstream>
+
+using cppmicroservices::service::component::ComponentConstants::
+  SERVICE_COMPONENT;
+
+namespace cppmicroservices {
+namespace scrimpl {
+namespace metadata {
+
+class BinaryMetadataReaderTest : public ::testing::TestWithParam<std::string>
+{
+protected:
+  BinaryMetadataReaderTest()
+    : framework(cppmicroservices::FrameworkFactory().NewFramework())
+  {}
+
+  void SetUp() override { framework.Start(); }
+
+  void TearDown() override
+  {
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  cppmicroservices::Framework framework;
+};
+
+// The precompiled metadata must describe the components exactly as the
+// runtime parser does when it reads the manifest.
+TEST_P(BinaryMetadataReaderTest, MatchesManifestParser)
+{
+  auto bundle =
+    test::InstallAndStartBundle(framework.GetBundleContext(), GetParam());
+  ASSERT_TRUE(static_cast<bool>(bundle));
+
+  auto resource = bundle.GetResource(BinaryMetadataReader::RESOURCE_PATH);
+  ASSERT_TRUE(resource.IsValid());
+  cppmicroservices::BundleResourceStream resStream(resource,
+                                                   std::ios_base::binary);
+  BinaryMetadataReader reader(resStream);
+  auto binaryMetadata =
+    reader.ReadComponentsMetadata(std::make_shared<FakeLogger>());
+
+  const auto& scrMap = cppmicroservices::ref_any_cast<AnyMap>(
+    bundle.GetHeaders().at(SERVICE_COMPONENT));
+  MetadataParserImplV1 parser(std::make_shared<FakeLogger>());
+  auto parsedMetadata = parser.ParseAndGetComponentsMetadata(scrMap);
+
+  // the metadata was generated from the manifest embedded in the bundle
+  auto manifest = bundle.GetResource(BinaryMetadataReader::MANIFEST_PATH);
+  ASSERT_TRUE(manifest.IsValid());
+  cppmicroservices::BundleResourceStream manifestStream(manifest,
+                                                        std::ios_base::binary);
+  EXPECT_EQ(reader.GetManifestHash(),
+            BinaryMetadataReader::HashManifest(manifestStream));
+  EXPECT_EQ(reader.GetManifestVersion(), 1u);
+  ASSERT_EQ(reader.GetComponentCount(), parsedMetadata.size());
+  ASSERT_EQ(binaryMetadata.size(), parsedMetadata.size());
+  for (size_t i = 0; i < parsedMetadata.size(); ++i) {
+    const auto& expected = *parsedMetadata[i];
+    const auto& actual = *binaryMetadata[i];
+    EXPECT_EQ(actual.name, expected.name);
+    EXPECT_EQ(actual.enabled, expected.enabled);
+    EXPECT_EQ(actual.immediate, expected.immediate);
+    EXPECT_EQ(actual.implClassName, expected.implClassName);
+    EXPECT_EQ(actual.configurationPolicy, expected.configurationPolicy);
+    EXPECT_EQ(actual.configurationPids, expected.configurationPids);
+    EXPECT_EQ(actual.factoryComponentID, expected.factoryComponentID);
+    EXPECT_EQ(actual.serviceMetadata.scope, expected.serviceMetadata.scope);
+    EXPECT_EQ(actual.serviceMetadata.interfaces,
+              expected.serviceMetadata.interfaces);
+    ASSERT_EQ(actual.refsMetadata.size(), expected.refsMetadata.size());
+    for (size_t j = 0; j < expected.refsMetadata.size(); ++j) {
+      const auto& expectedRef = expected.refsMetadata[j];
+      const auto& actualRef = actual.refsMetadata[j];
+      EXPECT_EQ(actualRef.name, expectedRef.name);
+      EXPECT_EQ(actualRef.interfaceName, expectedRef.interfaceName);
+      EXPECT_EQ(actualRef.target, expectedRef.target);
+      EXPECT_EQ(actualRef.cardinality, expectedRef.cardinality);
+      EXPECT_EQ(actualRef.policy, expectedRef.policy);
+      EXPECT_EQ(actualRef.policyOption, expectedRef.policyOption);
+      EXPECT_EQ(actualRef.scope, expectedRef.scope);
+      EXPECT_EQ(actualRef.minCardinality, expectedRef.minCardinality);
+      EXPECT_EQ(actualRef.maxCardinality, expectedRef.maxCardinality);
+    }
+    ASSERT_EQ(actual.properties.size(), expected.properties.size());
+    for (const auto& prop : expected.properties) {
+      ASSERT_EQ(actual.properties.count(prop.first), 1u);
+      EXPECT_EQ(actual.properties.at(prop.first).ToStringNoExcept(),
+                prop.second.ToStringNoExcept());
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(PrecompiledBundles,
+                         BinaryMetadataReaderTest,
+                         ::testing::Values("TestBundleDSTOI1",
+                                           "DSSpellChecker",
+                                           "TestBundleDSCA05"));
+
+TEST(BinaryMetadataReader, InvalidHeader)
+{
+  std::istringstream notMetadata("{ \"scr\" : {} }");
+  EXPECT_THROW(BinaryMetadataReader reader(notMetadata), std::runtime_error);
+
+  std::string unsupportedVersion("SCRM\x04\x00\x00\x00", 8);
+  std::istringstream futureMetadata(unsupportedVersion);
+  EXPECT_THROW(BinaryMetadataReader reader(futureMetadata), std::runtime_error);
+}
+
+TEST(BinaryMetadataReader, TruncatedData)
+{
+  // header announcing one component which is missing
+  std::string header("SCRM\x03\x00\x00\x00"
+                     "\x00\x00\x00\x00\x00\x00\x00\x00"
+                     "\x01\x00\x00\x00\x01\x00\x00\x00",
+                     24);
+  std::istringstream truncated(header);
+  BinaryMetadataReader reader(truncated);
+  EXPECT_EQ(reader.GetComponentCount(), 1u);
+  EXPECT_THROW(reader.ReadComponentsMetadata(std::make_shared<FakeLogger>()),
+               std::runtime_error);
+}
+
+// Components the code generator found invalid are skipped and logged like
+// the runtime parser does, the others are loaded with their warnings logged.
+TEST(BinaryMetadataReader, SkippedComponentsAndWarnings)
+{
+  std::string data("SCRM\x03\x00\x00\x00"
+                   "\x00\x00\x00\x00\x00\x00\x00\x00"
+                   "\x01\x00\x00\x00\x02\x00\x00\x00",
+                   24);
+  auto writeU32 = [&data](std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+      data.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+  };
+  auto writeString = [&data, &writeU32](const std::string& value) {
+    writeU32(static_cast<std::uint32_t>(value.size()));
+    data.append(value);
+  };
+  // an invalid component
+  data.push_back('\x00');
+  writeString("bad component.");
+  // a valid component with a warning
+  data.push_back('\x01');
+  writeU32(1);
+  writeString("a warning");
+  writeString("sample::Impl"); // name
+  writeString("sample::Impl"); // implementation-class
+  data.push_back('\x01');      // enabled
+  data.push_back('\x01');      // immediate
+  writeString("ignore");       // configuration-policy
+  writeU32(0);                 // configuration-pids
+  writeString("");             // factory
+  data.push_back('\x00');      // service
+  writeU32(0);                 // references
+  writeU32(0);                 // properties
+  writeU32(0);                 // factory-properties
+
+  auto logger = std::make_shared<MockLogger>();
+  EXPECT_CALL(*logger,
+              Log(logservice::SeverityLevel::LOG_ERROR,
+                  "bad component. Could not load the component with index: 0"))
+    .Times(1);
+  EXPECT_CALL(*logger, Log(logservice::SeverityLevel::LOG_WARNING, "a warning"))
+    .Times(1);
+
+  std::istringstream in(data);
+  BinaryMetadataReader reader(in);
+  EXPECT_EQ(reader.GetComponentCount(), 2u);
+  auto components = reader.ReadComponentsMetadata(logger);
+  ASSERT_EQ(components.size(), 1u);
+  EXPECT_EQ(components[0]->name, "sample::Impl");
+  EXPECT_TRUE(components[0]->immediate);
+  EXPECT_EQ(components[0]->configurationPolicy, "ignore");
+}
+
+TEST(BinaryMetadataReader, HashManifest)
+{
+  std::istringstream empty("");
+  EXPECT_EQ(BinaryMetadataReader::HashManifest(empty), 14695981039346656037ULL);
+
+  // a manifest differing in a single byte gets a different hash
+  std::istringstream manifest("{ \"scr\" : { \"version\" : 1 } }");
+  std::istringstream changedManifest("{ \"scr\" : { \"version\" : 2 } }");
+  EXPECT_NE(BinaryMetadataReader::HashManifest(manifest),
+            BinaryMetadataReader::HashManifest(changedManifest));
+
+  // the manifest is hashed in blocks, a manifest spanning several blocks
+  // hashes like the code generator hashes it byte by byte
+  std::string large(10000, 'x');
+  large[4096] = 'y';
+  std::uint64_t expected = 14695981039346656037ULL;
+  for (const auto c : large) {
+    expected ^= static_cast<unsigned char>(c);
+    expected *= 1099511628211ULL;
+  }
+  std::istringstream largeManifest(large);
+  EXPECT_EQ(BinaryMetadataReader::HashManifest(largeManifest), expected);
+}
+}
+}
+}
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <string>
@@ -420,6 +421,81 @@ TEST_F(ComponentContextImplTest, VerifyLocateServices)
   });
 }
 
+/**
+ * Binds and unbinds a service while other threads locate the services of the
+ * same reference. Readers must always see a consistent set of bound services.
+ */
+TEST_F(ComponentContextImplTest, VerifyLocateWhileBindingConcurrently)
+{
+  auto mockConfig = std::make_shared<MockComponentConfiguration>();
+  auto mockRefMgrFoo = std::make_shared<MockReferenceManager>();
+  auto context = GetFramework().GetBundleContext();
+  auto fooServ = std::make_shared<test::Foo>();
+  auto reg = context.RegisterService<test::Foo>(fooServ);
+  auto dynamicServ = std::make_shared<test::Foo>();
+  auto dynamicReg = context.RegisterService<test::Foo>(dynamicServ);
+  std::set<cppmicroservices::ServiceReferenceBase> refsSet = {
+    reg.GetReference()
+  };
+  EXPECT_CALL(*mockRefMgrFoo, GetBoundReferences())
+    .Times(1)
+    .WillRepeatedly(testing::Return(refsSet));
+  EXPECT_CALL(*mockRefMgrFoo, GetReferenceName())
+    .Times(1)
+    .WillRepeatedly(testing::Return("foo"));
+  EXPECT_CALL(*mockRefMgrFoo, GetReferenceScope())
+    .Times(1)
+    .WillRepeatedly(testing::Return(cppmicroservices::Constants::SCOPE_BUNDLE));
+  EXPECT_CALL(*mockConfig, GetBundle())
+    .WillRepeatedly(testing::Return(GetFramework()));
+  std::vector<std::shared_ptr<ReferenceManager>> depMgrs{ mockRefMgrFoo };
+  EXPECT_CALL(*mockConfig, GetAllDependencyManagers())
+    .Times(1)
+    .WillRepeatedly(testing::Return(depMgrs));
+  auto ctxt = std::make_shared<ComponentContextImpl>(mockConfig);
+  std::shared_ptr<ComponentContext> locator = ctxt;
+
+  std::atomic<bool> done(false);
+  std::vector<std::future<int>> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.push_back(std::async(std::launch::async, [&] {
+      int failures = 0;
+      while (!done) {
+        // services bound later are appended, the first one stays in front
+        if (locator->LocateService<test::Foo>("foo") != fooServ) {
+          ++failures;
+        }
+        auto services = locator->LocateServices<test::Foo>("foo");
+        if (services.empty() || services.size() > 2 ||
+            services.front() != fooServ ||
+            (services.size() == 2 && services.back() != dynamicServ)) {
+          ++failures;
+        }
+        if (locator->LocateService<test::Foo>("bar") != nullptr ||
+            !locator->LocateServices<test::Foo>("bar").empty()) {
+          ++failures;
+        }
+      }
+      return failures;
+    }));
+  }
+
+  for (int i = 0; i < 500; ++i) {
+    ASSERT_TRUE(ctxt->AddToBoundServicesCache("foo", dynamicReg.GetReference()));
+    ctxt->RemoveFromBoundServicesCache("foo", dynamicReg.GetReference());
+  }
+  done = true;
+  for (auto& reader : readers) {
+    EXPECT_EQ(reader.get(), 0);
+  }
+
+  EXPECT_EQ(locator->LocateServices<test::Foo>("foo"),
+            std::vector<std::shared_ptr<test::Foo>>({ fooServ }));
+  ctxt->Invalidate();
+  EXPECT_THROW(locator->LocateService<test::Foo>("foo"), ComponentException);
+  EXPECT_THROW(locator->LocateServices<test::Foo>("foo"), ComponentException);
+}
+
 TEST_F(ComponentContextImplTest, VerifyUsingBundle)
 {
   auto mockConfig =
@@ -75,6 +75,7 @@ public:
     std::vector<std::shared_ptr<ComponentConfiguration>>(void));
   MOCK_CONST_METHOD0(GetMetadata,
                      std::shared_ptr<const ComponentMetadata>(void));
+  MOCK_CONST_METHOD0(GetChangeCount, std::uint64_t(void));
 
 private:
   long mBundleId;
@@ -197,6 +198,40 @@ TEST_F(ComponentRegistryTest, VerifyRemoveComponentManagerByIdName)
   EXPECT_EQ(registry->Count(), 0ul);
 }
 
+TEST_F(ComponentRegistryTest, VerifyGetRemovedComponents)
+{
+  auto registry = GetRegistry();
+  auto mockCompMgr = std::make_shared<MockComponentManager>();
+  EXPECT_CALL(*mockCompMgr, GetBundleId())
+    .WillRepeatedly(testing::Return(121));
+  EXPECT_CALL(*mockCompMgr, GetName())
+    .WillRepeatedly(testing::Return(std::string("Foo")));
+  bool complete = false;
+  auto since = ComponentRegistry::GetChangeCount();
+  EXPECT_TRUE(registry->GetRemovedComponents(since, complete).empty());
+  EXPECT_TRUE(complete);
+
+  registry->AddComponentManager(mockCompMgr);
+  registry->RemoveComponentManager(121, "Foo");
+  auto removed = registry->GetRemovedComponents(since, complete);
+  ASSERT_EQ(removed.size(), 1ul);
+  EXPECT_EQ(removed.at(0), std::make_pair(121ul, std::string("Foo")));
+  EXPECT_TRUE(complete);
+
+  // the oldest removals are forgotten
+  for (std::size_t i = 0; i < ComponentRegistry::MAX_REMOVED_COMPONENTS; ++i) {
+    registry->AddComponentManager(mockCompMgr);
+    registry->RemoveComponentManager(121, "Foo");
+  }
+  removed = registry->GetRemovedComponents(since, complete);
+  EXPECT_EQ(removed.size(), ComponentRegistry::MAX_REMOVED_COMPONENTS);
+  EXPECT_FALSE(complete);
+  since = ComponentRegistry::GetChangeCount();
+  removed = registry->GetRemovedComponents(since, complete);
+  EXPECT_TRUE(removed.empty());
+  EXPECT_TRUE(complete);
+}
+
 TEST_F(ComponentRegistryTest, VerifyConcurrentAddsRemoves)
 {
   auto registry = GetRegistry();
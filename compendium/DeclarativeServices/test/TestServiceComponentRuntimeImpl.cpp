@@ -347,6 +347,97 @@ TEST_F(ServiceComponentRuntimeImplTest, DisableComponent)
 }
 
 // declaration of the standalone helper functions defined in ServiceComponentRuntimeImpl.cpp
+TEST_F(ServiceComponentRuntimeImplTest, QueryComponentDescriptionDTOs)
+{
+  auto registry = std::make_shared<ComponentRegistry>();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  ServiceComponentRuntimeImpl service(
+    GetFramework().GetBundleContext(), registry, fakeLogger);
+  auto activeConfig = std::make_shared<MockComponentConfiguration>();
+  EXPECT_CALL(*activeConfig, GetConfigState())
+    .WillRepeatedly(testing::Return(
+      service::component::runtime::dto::ComponentState::ACTIVE));
+
+  std::vector<std::shared_ptr<MockComponentManager>> mgrs;
+  std::vector<std::uint64_t> changeCounts(3, 0);
+  std::vector<std::string> names{ "a::One", "a::Two", "b::Three" };
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    auto mgr = std::make_shared<MockComponentManager>();
+    auto compDesc = std::make_shared<metadata::ComponentMetadata>();
+    compDesc->name = names[i];
+    EXPECT_CALL(*mgr, GetBundleId())
+      .WillRepeatedly(testing::Return(GetFramework().GetBundleId()));
+    EXPECT_CALL(*mgr, GetName()).WillRepeatedly(testing::Return(names[i]));
+    EXPECT_CALL(*mgr, GetMetadata()).WillRepeatedly(testing::Return(compDesc));
+    EXPECT_CALL(*mgr, GetChangeCount())
+      .WillRepeatedly(testing::ReturnPointee(&changeCounts[i]));
+    EXPECT_CALL(*mgr, GetComponentConfigurations())
+      .WillRepeatedly(testing::Return(
+        i == 2 ? std::vector<std::shared_ptr<ComponentConfiguration>>{
+                   activeConfig }
+               : std::vector<std::shared_ptr<ComponentConfiguration>>{}));
+    registry->AddComponentManager(mgr);
+    mgrs.push_back(mgr);
+  }
+
+  ComponentQuery query;
+  auto result = service.QueryComponentDescriptionDTOs(query);
+  EXPECT_EQ(result.total, 3u);
+  ASSERT_EQ(result.descriptions.size(), 3u);
+  EXPECT_EQ(result.descriptions.at(0).name, "a::One");
+  EXPECT_EQ(result.descriptions.at(2).name, "b::Three");
+  EXPECT_TRUE(result.removed.empty());
+  EXPECT_TRUE(result.complete);
+  const auto changeCount = result.changeCount;
+
+  // paging
+  query.offset = 1;
+  query.limit = 1;
+  result = service.QueryComponentDescriptionDTOs(query);
+  EXPECT_EQ(result.total, 3u);
+  ASSERT_EQ(result.descriptions.size(), 1u);
+  EXPECT_EQ(result.descriptions.at(0).name, "a::Two");
+
+  // filters
+  query = ComponentQuery();
+  query.namePrefix = "a::";
+  result = service.QueryComponentDescriptionDTOs(query);
+  EXPECT_EQ(result.total, 2u);
+  EXPECT_EQ(result.descriptions.size(), 2u);
+
+  query = ComponentQuery();
+  query.states = {
+    service::component::runtime::dto::ComponentState::ACTIVE
+  };
+  result = service.QueryComponentDescriptionDTOs(query);
+  ASSERT_EQ(result.descriptions.size(), 1u);
+  EXPECT_EQ(result.descriptions.at(0).name, "b::Three");
+
+  query = ComponentQuery();
+  query.bundleIds = { static_cast<unsigned long>(
+    GetFramework().GetBundleId() + 1) };
+  result = service.QueryComponentDescriptionDTOs(query);
+  EXPECT_EQ(result.total, 0u);
+  EXPECT_TRUE(result.descriptions.empty());
+
+  // changes since the first query
+  query = ComponentQuery();
+  query.changedSince = changeCount;
+  result = service.QueryComponentDescriptionDTOs(query);
+  EXPECT_EQ(result.total, 0u);
+  EXPECT_TRUE(result.removed.empty());
+
+  changeCounts[1] = ComponentRegistry::NextChangeCount();
+  registry->RemoveComponentManager(GetFramework().GetBundleId(), "b::Three");
+  result = service.QueryComponentDescriptionDTOs(query);
+  ASSERT_EQ(result.descriptions.size(), 1u);
+  EXPECT_EQ(result.descriptions.at(0).name, "a::Two");
+  ASSERT_EQ(result.removed.size(), 1u);
+  EXPECT_EQ(result.removed.at(0).second, "b::Three");
+  EXPECT_TRUE(result.complete);
+  EXPECT_GT(result.changeCount, changeCount);
+}
+
 framework::dto::BundleDTO ToDTO(const cppmicroservices::Bundle& bundle);
 framework::dto::ServiceReferenceDTO ToDTO(
   const cppmicroservices::ServiceReferenceBase& sRef);
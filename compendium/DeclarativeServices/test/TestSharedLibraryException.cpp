@@ -90,6 +90,34 @@ TEST_F(SharedLibraryExceptionTest, testDSBundleLoaderFailure)
                cppmicroservices::SharedLibraryException);
 }
 
+TEST_F(SharedLibraryExceptionTest, testDSBundleLoaderEntryPoints)
+{
+  using NewInstanceFuncPtr =
+    cppmicroservices::service::component::detail::ComponentInstance* (*)();
+  auto bundle = test::InstallAndStartBundle(GetFramework().GetBundleContext(),
+                                            "TestBundleDSTOI1");
+  auto logger = std::make_shared<cppmicroservices::scrimpl::FakeLogger>();
+
+  // the entry points are resolved once per bundle library and reused
+  auto first = cppmicroservices::scrimpl::GetComponentCreatorDeletors(
+    "sample::ServiceComponent", bundle, logger);
+  auto second = cppmicroservices::scrimpl::GetComponentCreatorDeletors(
+    "sample::ServiceComponent", bundle, logger);
+  auto firstNew = std::get<0>(first).target<NewInstanceFuncPtr>();
+  auto secondNew = std::get<0>(second).target<NewInstanceFuncPtr>();
+  ASSERT_NE(firstNew, nullptr);
+  ASSERT_NE(secondNew, nullptr);
+  EXPECT_EQ(*firstNew, *secondNew);
+
+  auto instance = std::get<0>(first)();
+  ASSERT_NE(instance, nullptr);
+  std::get<1>(first)(instance);
+
+  EXPECT_THROW(cppmicroservices::scrimpl::GetComponentCreatorDeletors(
+                 "sample::NoSuchComponent", bundle, logger),
+               std::runtime_error);
+}
+
 TEST_F(SharedLibraryExceptionTest, testDSBundleImmediateTrue)
 {
   testing::FLAGS_gtest_death_test_style = "threadsafe";
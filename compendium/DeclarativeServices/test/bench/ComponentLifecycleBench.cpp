@@ -0,0 +1,141 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "DSBenchmarkFixture.hpp"
+
+#include "TestInterfaces/Interfaces.hpp"
+
+#include <future>
+
+namespace {
+
+const std::string benchmarkLib = "BenchmarkDS";
+const std::string benchmarkClass = "sample::DSBenchmarkComponent";
+const std::string benchmarkInterface = "test::Interface1";
+
+void WaitAll(std::vector<std::shared_future<void>>& futures)
+{
+  for (auto& f : futures) {
+    f.get();
+  }
+  futures.clear();
+}
+}
+
+class ComponentLifecycleFixture : public test::DSBenchmarkFixture
+{};
+
+/// Benchmark enabling and then disabling state.range(0) components. Both are
+/// asynchronous, so real time is reported.
+BENCHMARK_DEFINE_F(ComponentLifecycleFixture, EnableDisable)
+(benchmark::State& state)
+{
+  const auto count = static_cast<std::size_t>(state.range(0));
+  auto bundles = InstallComponents(
+    benchmarkLib,
+    count,
+    test::MakeComponent(benchmarkClass, benchmarkInterface, true, false));
+  for (auto& b : bundles) {
+    b.Start();
+  }
+  const auto descriptions = GetDescriptions(bundles);
+
+  std::vector<std::shared_future<void>> futures;
+  for (auto _ : state) {
+    for (const auto& d : descriptions) {
+      futures.push_back(runtime->EnableComponent(d));
+    }
+    WaitAll(futures);
+
+    for (const auto& d : descriptions) {
+      futures.push_back(runtime->DisableComponent(d));
+    }
+    WaitAll(futures);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+
+  Uninstall(bundles);
+}
+
+/// Benchmark the time from bundle start until state.range(0) components are
+/// active, for immediate components and for delayed components which are
+/// activated by getting their service.
+class ActivationFixture : public test::DSBenchmarkFixture
+{
+protected:
+  void Run(benchmark::State& state, bool immediate)
+  {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto component =
+      test::MakeComponent(benchmarkClass, benchmarkInterface, immediate);
+    // delayed components are deactivated once their service is released
+    std::vector<std::shared_ptr<test::Interface1>> services;
+    for (auto _ : state) {
+      state.PauseTiming();
+      auto bundles = InstallComponents(benchmarkLib, count, component);
+      state.ResumeTiming();
+
+      for (auto& b : bundles) {
+        b.Start();
+      }
+      if (!immediate) {
+        for (const auto& ref : context.GetServiceReferences<test::Interface1>()) {
+          services.push_back(context.GetService(ref));
+        }
+      }
+
+      state.PauseTiming();
+      if (!AllActive(bundles)) {
+        state.SkipWithError("components were not activated");
+      }
+      services.clear();
+      Uninstall(bundles);
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+};
+
+BENCHMARK_DEFINE_F(ActivationFixture, ImmediateComponents)
+(benchmark::State& state)
+{
+  Run(state, true);
+}
+
+BENCHMARK_DEFINE_F(ActivationFixture, DelayedComponents)
+(benchmark::State& state)
+{
+  Run(state, false);
+}
+
+BENCHMARK_REGISTER_F(ComponentLifecycleFixture, EnableDisable)
+  ->RangeMultiplier(10)
+  ->Range(1, 100)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(ActivationFixture, ImmediateComponents)
+  ->RangeMultiplier(10)
+  ->Range(1, 100)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(ActivationFixture, DelayedComponents)
+  ->RangeMultiplier(10)
+  ->Range(1, 100)
+  ->UseRealTime();
@@ -0,0 +1,145 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "DSBenchmarkFixture.hpp"
+
+#include "../TestUtils.hpp"
+
+#include "cppmicroservices/FrameworkEvent.h"
+
+#include <chrono>
+
+namespace test {
+
+namespace {
+
+using cppmicroservices::Any;
+using cppmicroservices::AnyMap;
+
+AnyMap MakeMap()
+{
+  return AnyMap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+}
+}
+
+DSBenchmarkFixture::DSBenchmarkFixture(bool withConfigAdmin)
+  : withConfigAdmin(withConfigAdmin)
+{}
+
+void DSBenchmarkFixture::SetUp(const ::benchmark::State&)
+{
+  framework = std::make_shared<cppmicroservices::Framework>(
+    cppmicroservices::FrameworkFactory().NewFramework());
+  framework->Start();
+  context = framework->GetBundleContext();
+
+  InstallAndStartDS(context);
+  if (withConfigAdmin) {
+    InstallAndStartConfigAdmin(context);
+  }
+
+  auto sRef = context.GetServiceReference<scr::ServiceComponentRuntime>();
+  runtime = context.GetService<scr::ServiceComponentRuntime>(sRef);
+}
+
+void DSBenchmarkFixture::TearDown(const ::benchmark::State&)
+{
+  runtime.reset();
+  context = cppmicroservices::BundleContext();
+  framework->Stop();
+  framework->WaitForStop(std::chrono::milliseconds::zero());
+  framework.reset();
+}
+
+std::vector<cppmicroservices::Bundle> DSBenchmarkFixture::InstallComponents(
+  const std::string& libName,
+  std::size_t count,
+  const AnyMap& component)
+{
+  AnyMap scr = MakeMap();
+  scr["version"] = 1;
+  scr["components"] = std::vector<Any>{ component };
+
+  AnyMap manifests = MakeMap();
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto symbolicName = libName + "_" + std::to_string(i);
+    AnyMap manifest = MakeMap();
+    manifest["bundle.symbolic_name"] = symbolicName;
+    manifest["scr"] = scr;
+    manifests[symbolicName] = manifest;
+  }
+
+  return context.InstallBundles(GetTestPluginsPath() + US_LIB_PREFIX +
+                                  libName + US_LIB_POSTFIX + US_LIB_EXT,
+                                manifests);
+}
+
+void DSBenchmarkFixture::Uninstall(
+  std::vector<cppmicroservices::Bundle>& bundles)
+{
+  for (auto& b : bundles) {
+    b.Uninstall();
+  }
+  bundles.clear();
+}
+
+std::vector<scr::dto::ComponentDescriptionDTO>
+DSBenchmarkFixture::GetDescriptions(
+  const std::vector<cppmicroservices::Bundle>& bundles) const
+{
+  std::vector<scr::dto::ComponentDescriptionDTO> descriptions;
+  for (const auto& b : bundles) {
+    auto dtos = runtime->GetComponentDescriptionDTOs({ b });
+    descriptions.insert(descriptions.end(), dtos.begin(), dtos.end());
+  }
+  return descriptions;
+}
+
+bool DSBenchmarkFixture::AllActive(
+  const std::vector<cppmicroservices::Bundle>& bundles) const
+{
+  for (const auto& description : GetDescriptions(bundles)) {
+    auto configs = runtime->GetComponentConfigurationDTOs(description);
+    if (configs.empty() ||
+        configs.front().state != scr::dto::ComponentState::ACTIVE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+AnyMap MakeComponent(const std::string& implClass,
+                     const std::string& interfaceName,
+                     bool immediate,
+                     bool enabled)
+{
+  AnyMap service = MakeMap();
+  service["interfaces"] = std::vector<Any>{ interfaceName };
+
+  AnyMap component = MakeMap();
+  component["implementation-class"] = implClass;
+  component["immediate"] = immediate;
+  component["enabled"] = enabled;
+  component["service"] = service;
+  return component;
+}
+}
@@ -0,0 +1,95 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef DSBENCHMARKFIXTURE_HPP
+#define DSBENCHMARKFIXTURE_HPP
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace test {
+
+namespace scr = cppmicroservices::service::component::runtime;
+
+/**
+ * Starts a framework with DeclarativeServices and, optionally,
+ * ConfigurationAdmin for each benchmark.
+ *
+ * Component counts are simulated by installing one bundle per component from
+ * the same test bundle library, each with an injected manifest.
+ */
+class DSBenchmarkFixture : public ::benchmark::Fixture
+{
+public:
+  using benchmark::Fixture::SetUp;
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(const ::benchmark::State&) override;
+  void TearDown(const ::benchmark::State&) override;
+
+protected:
+  explicit DSBenchmarkFixture(bool withConfigAdmin = false);
+
+  /**
+   * Install \c count bundles from the test bundle library \c libName. Each
+   * bundle gets a manifest declaring the single component \c component.
+   */
+  std::vector<cppmicroservices::Bundle> InstallComponents(
+    const std::string& libName,
+    std::size_t count,
+    const cppmicroservices::AnyMap& component);
+
+  /// Uninstall bundles installed by InstallComponents.
+  static void Uninstall(std::vector<cppmicroservices::Bundle>& bundles);
+
+  /// Returns the descriptions of the components of \c bundles.
+  std::vector<scr::dto::ComponentDescriptionDTO> GetDescriptions(
+    const std::vector<cppmicroservices::Bundle>& bundles) const;
+
+  /// Returns true if all components of \c bundles have an active configuration.
+  bool AllActive(const std::vector<cppmicroservices::Bundle>& bundles) const;
+
+  std::shared_ptr<cppmicroservices::Framework> framework;
+  cppmicroservices::BundleContext context;
+  std::shared_ptr<scr::ServiceComponentRuntime> runtime;
+
+private:
+  const bool withConfigAdmin;
+};
+
+/// Returns a manifest entry for a component, to be passed to InstallComponents.
+cppmicroservices::AnyMap MakeComponent(const std::string& implClass,
+                                       const std::string& interfaceName,
+                                       bool immediate,
+                                       bool enabled = true);
+}
+
+#endif // DSBENCHMARKFIXTURE_HPP
@@ -0,0 +1,90 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "DSBenchmarkFixture.hpp"
+
+#include "../TestUtils.hpp"
+
+#include "cppmicroservices/cm/ConfigurationAdmin.hpp"
+
+#include "TestInterfaces/Interfaces.hpp"
+
+#include <future>
+
+namespace cm = cppmicroservices::service::cm;
+
+class FactoryComponentFixture : public test::DSBenchmarkFixture
+{
+public:
+  FactoryComponentFixture()
+    : test::DSBenchmarkFixture(true)
+  {}
+};
+
+/// Benchmark creating state.range(0) instances of a factory component by
+/// adding factory configurations through ConfigurationAdmin
+BENCHMARK_DEFINE_F(FactoryComponentFixture, CreateFactoryInstances)
+(benchmark::State& state)
+{
+  const auto count = static_cast<std::size_t>(state.range(0));
+  test::InstallAndStartBundle(context, "TestBundleDSCA20");
+  auto configAdmin = context.GetService<cm::ConfigurationAdmin>(
+    context.GetServiceReference<cm::ConfigurationAdmin>());
+
+  std::vector<std::shared_ptr<cm::Configuration>> configs;
+  std::vector<std::shared_future<void>> futures;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      auto config =
+        configAdmin->CreateFactoryConfiguration("sample::ServiceComponentCA20");
+      cppmicroservices::AnyMap props(
+        cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+      props["instance"] = static_cast<int>(i);
+      futures.push_back(config->Update(props));
+      configs.push_back(std::move(config));
+    }
+    for (auto& f : futures) {
+      f.get();
+    }
+    futures.clear();
+
+    state.PauseTiming();
+    if (context.GetServiceReferences<test::CAInterface>().size() != count) {
+      state.SkipWithError("factory instances were not created");
+    }
+    for (auto& config : configs) {
+      futures.push_back(config->Remove());
+    }
+    for (auto& f : futures) {
+      f.get();
+    }
+    futures.clear();
+    configs.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(FactoryComponentFixture, CreateFactoryInstances)
+  ->RangeMultiplier(10)
+  ->Range(1, 100)
+  ->UseRealTime();
@@ -0,0 +1,111 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "DSBenchmarkFixture.hpp"
+
+#include "cppmicroservices/Constants.h"
+
+#include "TestInterfaces/Interfaces.hpp"
+
+namespace {
+
+class Interface1Impl : public test::Interface1
+{
+public:
+  std::string Description() override { return "Interface1Impl"; }
+};
+
+/// A component with a greedy 0..1 reference to test::Interface1, using the
+/// implementation of the TestBundleDSDGOU test bundle.
+cppmicroservices::AnyMap MakeGreedyConsumer(const std::string& policy)
+{
+  auto component = test::MakeComponent(
+    "sample::ServiceComponentDynamicGreedyOptionalUnary",
+    "test::Interface2",
+    true);
+
+  cppmicroservices::AnyMap reference(
+    cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  reference["name"] = std::string("foo");
+  reference["cardinality"] = std::string("0..1");
+  reference["policy"] = policy;
+  reference["policy-option"] = std::string("greedy");
+  reference["interface"] = std::string("test::Interface1");
+
+  component["references"] = std::vector<cppmicroservices::Any>{ reference };
+  component["inject-references"] = false;
+  return component;
+}
+}
+
+class ReferenceRebindingFixture : public test::DSBenchmarkFixture
+{
+protected:
+  /// Each iteration registers a better ranked service, which all
+  /// state.range(0) components rebind to, and unregisters it again.
+  void Run(benchmark::State& state, const std::string& policy)
+  {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto bundles =
+      InstallComponents("TestBundleDSDGOU", count, MakeGreedyConsumer(policy));
+    for (auto& b : bundles) {
+      b.Start();
+    }
+
+    auto base = context.RegisterService<test::Interface1>(
+      std::make_shared<Interface1Impl>());
+    int ranking = 0;
+    for (auto _ : state) {
+      auto better = context.RegisterService<test::Interface1>(
+        std::make_shared<Interface1Impl>(),
+        { { cppmicroservices::Constants::SERVICE_RANKING,
+            cppmicroservices::Any(++ranking) } });
+      better.Unregister();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+
+    if (!AllActive(bundles)) {
+      state.SkipWithError("components are not active after rebinding");
+    }
+    base.Unregister();
+    Uninstall(bundles);
+  }
+};
+
+BENCHMARK_DEFINE_F(ReferenceRebindingFixture, DynamicGreedy)
+(benchmark::State& state)
+{
+  Run(state, "dynamic");
+}
+
+BENCHMARK_DEFINE_F(ReferenceRebindingFixture, StaticGreedy)
+(benchmark::State& state)
+{
+  Run(state, "static");
+}
+
+BENCHMARK_REGISTER_F(ReferenceRebindingFixture, DynamicGreedy)
+  ->RangeMultiplier(10)
+  ->Range(1, 100);
+BENCHMARK_REGISTER_F(ReferenceRebindingFixture, StaticGreedy)
+  ->RangeMultiplier(10)
+  ->Range(1, 100);
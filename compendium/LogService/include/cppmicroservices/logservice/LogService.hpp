@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <exception>
 #include <string>
+#include <utility>
 
 namespace cppmicroservices {
 namespace logservice {
@@ -112,6 +113,46 @@ public:
                    SeverityLevel level,
                    const std::string& message,
                    const std::exception_ptr ex) = 0;
+
+  /**
+   * Returns whether messages of the given severity are written anywhere.
+   * Callers can use this to skip building messages which would be
+   * discarded. The default implementation returns \c true.
+   * @param level The severity to check.
+   * @return \c false if messages of this severity are discarded.
+   */
+  virtual bool IsLevelEnabled(SeverityLevel /*level*/) const { return true; }
+
+  /**
+   * Logs the message returned by \c messageFn if the given severity is
+   * enabled. \c messageFn is not called otherwise.
+   * @param level The severity of the message.
+   * @param messageFn A callable returning the message as a \c std::string.
+   */
+  template<class MessageFn>
+  void LogLazily(SeverityLevel level, MessageFn&& messageFn)
+  {
+    if (IsLevelEnabled(level)) {
+      Log(level, std::forward<MessageFn>(messageFn)());
+    }
+  }
+
+  /**
+   * Logs the message returned by \c messageFn together with an exception if
+   * the given severity is enabled. \c messageFn is not called otherwise.
+   * @param level The severity of the message.
+   * @param messageFn A callable returning the message as a \c std::string.
+   * @param ex The exception that reflects the condition or nullptr.
+   */
+  template<class MessageFn>
+  void LogLazily(SeverityLevel level,
+                 MessageFn&& messageFn,
+                 const std::exception_ptr ex)
+  {
+    if (IsLevelEnabled(level)) {
+      Log(level, std::forward<MessageFn>(messageFn)(), ex);
+    }
+  }
 };
 
 } // namespace logservice
@@ -7,7 +7,8 @@ namespace impl {
 void Activator::Start(cppmicroservices::BundleContext bc)
 {
   auto svc = std::make_shared<cppmicroservices::logservice::LogServiceImpl>(
-    "cppmicroservices::logservice");
+    "cppmicroservices::logservice",
+    LogServiceConfig::FromProperties(bc.GetProperties()));
   bc.RegisterService<cppmicroservices::logservice::LogService>(std::move(svc));
 }
 
@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <cctype>
 #include <sstream>
 
+#include "spdlog/async_logger.h"
+#include "spdlog/details/thread_pool.h"
+#include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
 
@@ -33,16 +38,211 @@ std::string GetServiceReferenceInfo(const ServiceReferenceBase& sr)
   return stream.str();
 }
 
+namespace {
+
+const std::string PROPERTY_PREFIX = "org.cppmicroservices.logservice.";
+
+const Any* FindProperty(const AnyMap& properties, const std::string& name)
+{
+  auto iter = properties.find(PROPERTY_PREFIX + name);
+  return iter == properties.end() ? nullptr : &iter->second;
+}
+
+std::string ToLower(std::string value)
+{
+  std::transform(value.begin(), value.end(), value.begin(), [](char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return value;
+}
+
+bool GetStringProperty(const AnyMap& properties,
+                       const std::string& name,
+                       std::string& value)
+{
+  auto prop = FindProperty(properties, name);
+  if (prop && prop->Type() == typeid(std::string)) {
+    value = ref_any_cast<std::string>(*prop);
+    return true;
+  }
+  return false;
+}
+
+void GetBoolProperty(const AnyMap& properties,
+                     const std::string& name,
+                     bool& value)
+{
+  std::string str;
+  auto prop = FindProperty(properties, name);
+  if (prop && prop->Type() == typeid(bool)) {
+    value = ref_any_cast<bool>(*prop);
+  } else if (GetStringProperty(properties, name, str)) {
+    str = ToLower(str);
+    if (str == "true" || str == "false") {
+      value = (str == "true");
+    }
+  }
+}
+
+/// Reads a non-negative integer given as an int or as a string
+bool GetIntProperty(const AnyMap& properties,
+                    const std::string& name,
+                    long long& value)
+{
+  std::string str;
+  auto prop = FindProperty(properties, name);
+  if (prop && prop->Type() == typeid(int)) {
+    if (ref_any_cast<int>(*prop) >= 0) {
+      value = ref_any_cast<int>(*prop);
+      return true;
+    }
+  } else if (GetStringProperty(properties, name, str) && !str.empty() &&
+             std::all_of(str.begin(), str.end(), [](char c) {
+               return std::isdigit(static_cast<unsigned char>(c));
+             })) {
+    try {
+      value = std::stoll(str);
+      return true;
+    } catch (const std::out_of_range&) {
+    }
+  }
+  return false;
+}
+
+spdlog::level::level_enum ToSpdlogLevel(SeverityLevel level)
+{
+  switch (level) {
+    case SeverityLevel::LOG_DEBUG:
+      return spdlog::level::debug;
+    case SeverityLevel::LOG_INFO:
+      return spdlog::level::info;
+    case SeverityLevel::LOG_WARNING:
+      return spdlog::level::warn;
+    case SeverityLevel::LOG_ERROR:
+      return spdlog::level::err;
+  }
+  return spdlog::level::off;
+}
+}
+
+LogServiceConfig LogServiceConfig::FromProperties(const AnyMap& properties)
+{
+  LogServiceConfig config;
+
+  std::string str;
+  if (GetStringProperty(properties, "level", str)) {
+    str = ToLower(str);
+    if (str == "debug") {
+      config.level = SeverityLevel::LOG_DEBUG;
+    } else if (str == "info") {
+      config.level = SeverityLevel::LOG_INFO;
+    } else if (str == "warning") {
+      config.level = SeverityLevel::LOG_WARNING;
+    } else if (str == "error") {
+      config.level = SeverityLevel::LOG_ERROR;
+    }
+  }
+
+  GetBoolProperty(properties, "async", config.async);
+
+  long long value = 0;
+  if (GetIntProperty(properties, "async.queue_size", value) && value > 0) {
+    config.queueSize = static_cast<std::size_t>(value);
+  }
+  if (GetStringProperty(properties, "async.overflow", str)) {
+    str = ToLower(str);
+    if (str == "block" || str == "discard_oldest") {
+      config.discardOldest = (str == "discard_oldest");
+    }
+  }
+  if (GetIntProperty(properties, "flush_interval_ms", value)) {
+    config.flushInterval = std::chrono::milliseconds(value);
+  }
+
+  GetStringProperty(properties, "file", config.file);
+  if (GetIntProperty(properties, "file.max_size", value) && value > 0) {
+    config.maxFileSize = static_cast<std::size_t>(value);
+  }
+  if (GetIntProperty(properties, "file.max_files", value)) {
+    config.maxFiles = static_cast<std::size_t>(value);
+  }
+
+  return config;
+}
+
 LogServiceImpl::LogServiceImpl(const std::string& loggerName)
+  : LogServiceImpl(loggerName, LogServiceConfig{})
+{}
+
+LogServiceImpl::LogServiceImpl(const std::string& loggerName,
+                               const LogServiceConfig& config)
+  : m_StopFlusher(false)
 {
-  auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-  m_Logger = std::make_shared<spdlog::logger>(loggerName, std::move(sink));
+  spdlog::sink_ptr sink;
+  if (config.file.empty()) {
+    sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+  } else {
+    sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+      config.file, config.maxFileSize, config.maxFiles);
+  }
+
+  if (config.async) {
+    m_ThreadPool =
+      std::make_shared<spdlog::details::thread_pool>(config.queueSize, 1);
+    m_Logger = std::make_shared<spdlog::async_logger>(
+      loggerName,
+      std::move(sink),
+      m_ThreadPool,
+      config.discardOldest ? spdlog::async_overflow_policy::overrun_oldest
+                           : spdlog::async_overflow_policy::block);
+  } else {
+    m_Logger = std::make_shared<spdlog::logger>(loggerName, std::move(sink));
+  }
   m_Logger->set_pattern("[%T] [%P:%t] %n (%^%l%$): %v");
-  m_Logger->set_level(spdlog::level::trace);
+  m_Logger->set_level(ToSpdlogLevel(config.level));
+  m_Logger->flush_on(spdlog::level::err);
+
+  // The console sink of a synchronous logger writes through on every
+  // message, so only asynchronous and file loggers need periodic flushing.
+  if (config.flushInterval.count() > 0 &&
+      (config.async || !config.file.empty())) {
+    m_Flusher =
+      std::thread(&LogServiceImpl::RunFlusher, this, config.flushInterval);
+  }
+}
+
+LogServiceImpl::~LogServiceImpl()
+{
+  if (m_Flusher.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_FlusherMutex);
+      m_StopFlusher = true;
+    }
+    m_FlusherCondition.notify_one();
+    m_Flusher.join();
+  }
+
+  // Queued messages keep the asynchronous logger alive. Destroying the
+  // thread pool writes them and joins the worker thread.
+  m_Logger->flush();
+  m_Logger.reset();
+  m_ThreadPool.reset();
+}
+
+void LogServiceImpl::RunFlusher(std::chrono::milliseconds interval)
+{
+  std::unique_lock<std::mutex> lock(m_FlusherMutex);
+  while (!m_FlusherCondition.wait_for(
+    lock, interval, [this] { return m_StopFlusher; })) {
+    m_Logger->flush();
+  }
 }
 
 void LogServiceImpl::Log(SeverityLevel level, const std::string& message)
 {
+  if (!IsLevelEnabled(level)) {
+    return;
+  }
   switch (level) {
     case SeverityLevel::LOG_DEBUG: {
       m_Logger->debug(message);
@@ -67,6 +267,9 @@ void LogServiceImpl::Log(SeverityLevel level,
                          const std::string& message,
                          const std::exception_ptr ex)
 {
+  if (!IsLevelEnabled(level)) {
+    return;
+  }
   std::string full_message = message;
   full_message = message + GetExceptionMessage(ex);
   LogServiceImpl::Log(level, full_message);
@@ -76,6 +279,9 @@ void LogServiceImpl::Log(const ServiceReferenceBase& sr,
                          SeverityLevel level,
                          const std::string& message)
 {
+  if (!IsLevelEnabled(level)) {
+    return;
+  }
   std::string full_message = message;
   full_message = message + GetServiceReferenceInfo(sr);
   LogServiceImpl::Log(level, full_message);
@@ -86,15 +292,28 @@ void LogServiceImpl::Log(const ServiceReferenceBase& sr,
                          const std::string& message,
                          const std::exception_ptr ex)
 {
+  if (!IsLevelEnabled(level)) {
+    return;
+  }
   std::string full_message = message;
   full_message =
     message + GetServiceReferenceInfo(sr) + GetExceptionMessage(ex);
   LogServiceImpl::Log(level, full_message);
 }
 
+bool LogServiceImpl::IsLevelEnabled(SeverityLevel level) const
+{
+  return m_Logger->should_log(ToSpdlogLevel(level));
+}
+
 void LogServiceImpl::AddSink(spdlog::sink_ptr& sink)
 {
   m_Logger->sinks().push_back(sink);
 }
+
+void LogServiceImpl::Flush()
+{
+  m_Logger->flush();
+}
 }
 }
@@ -20,8 +20,14 @@
 
  =============================================================================*/
 
+#include "cppmicroservices/AnyMap.h"
 #include "cppmicroservices/logservice/LogService.hpp"
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace sinks {
 class sink;
 }
@@ -29,15 +35,62 @@ class sink;
 namespace spdlog {
 class logger;
 using sink_ptr = std::shared_ptr<sinks::sink>;
+namespace details {
+class thread_pool;
+}
 }
 
 namespace cppmicroservices {
 namespace logservice {
+
+/**
+ * Configuration of a LogServiceImpl. The bundle activator reads it from these
+ * framework properties:
+ *
+ * - org.cppmicroservices.logservice.level: "debug" (the default), "info",
+ *   "warning" or "error". Messages of a lower severity are discarded.
+ * - org.cppmicroservices.logservice.async: if true, messages are queued and
+ *   written by a background thread.
+ * - org.cppmicroservices.logservice.async.queue_size: the number of messages
+ *   the queue holds, 8192 by default.
+ * - org.cppmicroservices.logservice.async.overflow: "block" (the default)
+ *   makes callers wait while the queue is full, "discard_oldest" overwrites
+ *   the oldest queued message.
+ * - org.cppmicroservices.logservice.flush_interval_ms: how often buffered
+ *   messages are flushed, 1000 by default. 0 turns periodic flushing off.
+ *   Errors are always flushed immediately.
+ * - org.cppmicroservices.logservice.file: write to this file instead of the
+ *   standard output.
+ * - org.cppmicroservices.logservice.file.max_size: the size in bytes at
+ *   which the file is rotated, 10 MiB by default.
+ * - org.cppmicroservices.logservice.file.max_files: the number of rotated
+ *   files which are kept, 3 by default.
+ *
+ * Values of the wrong type or out of range are ignored. Numbers and booleans
+ * can also be given as strings.
+ */
+struct LogServiceConfig
+{
+  SeverityLevel level = SeverityLevel::LOG_DEBUG;
+  bool async = false;
+  std::size_t queueSize = 8192;
+  bool discardOldest = false;
+  std::chrono::milliseconds flushInterval{ 1000 };
+  std::string file;
+  std::size_t maxFileSize = 10 * 1024 * 1024;
+  std::size_t maxFiles = 3;
+
+  static LogServiceConfig FromProperties(const AnyMap& properties);
+};
+
 class LogServiceImpl final : public LogService
 {
 public:
   LogServiceImpl(const std::string& loggerName);
-  ~LogServiceImpl() = default;
+  LogServiceImpl(const std::string& loggerName, const LogServiceConfig& config);
+
+  /// Flushes and, in asynchronous mode, writes all queued messages.
+  ~LogServiceImpl();
 
   /**
    * Logs a message.
@@ -78,14 +131,31 @@ public:
            const std::string& message,
            const std::exception_ptr ex) override;
 
+  bool IsLevelEnabled(SeverityLevel level) const override;
+
   /**
    * Registers a sink to the logger for introspection of contents. This is not a publicly available
    * function and should only be used for testing. This is NOT thread-safe.
    */
   void AddSink(spdlog::sink_ptr& sink);
 
+  /**
+   * Writes buffered messages. In asynchronous mode, this only queues a
+   * request to flush.
+   */
+  void Flush();
+
 private:
+  void RunFlusher(std::chrono::milliseconds interval);
+
+  // the thread pool of an asynchronous logger must outlive the logger
+  std::shared_ptr<spdlog::details::thread_pool> m_ThreadPool;
   std::shared_ptr<::spdlog::logger> m_Logger;
+
+  std::mutex m_FlusherMutex;
+  std::condition_variable m_FlusherCondition;
+  bool m_StopFlusher;
+  std::thread m_Flusher;
 };
 }
 }
@@ -9,14 +9,17 @@
 #include <cppmicroservices/util/FileSystem.h>
 
 #include <chrono>
+#include <cstdlib>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <ostream>
 #include <regex>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <spdlog/sinks/ostream_sink.h>
 #include <spdlog/spdlog.h>
@@ -33,6 +36,23 @@ static const std::string log_preamble(
 static const std::string svcRef_preamble("ServiceReference: ");
 static const std::string exception_preamble("Exception logged: ");
 
+// Creates a new directory below the system temporary directory.
+static std::string MakeTestDirectory(const std::string& name)
+{
+#if defined(_WIN32)
+  const char* tmp = std::getenv("TEMP");
+#else
+  const char* tmp = std::getenv("TMPDIR");
+#endif
+  std::string dir = (tmp && *tmp) ? tmp : "/tmp";
+  dir += cppmicroservices::util::DIR_SEP;
+  dir += name + "_" +
+         std::to_string(
+           std::chrono::steady_clock::now().time_since_epoch().count());
+  cppmicroservices::util::MakePath(dir);
+  return dir;
+}
+
 class LogServiceImplTests : public ::testing::Test
 {
 public:
@@ -235,3 +255,152 @@ TEST_F(LogServiceImplTests, ThreadSafety)
   std::ptrdiff_t num_found = std::distance(regex_iter_begin, regex_iter_end);
   ASSERT_TRUE(num_found == iterations);
 }
+
+namespace {
+std::shared_ptr<ls::LogServiceImpl> MakeLogger(
+  const ls::LogServiceConfig& config,
+  std::ostringstream& oss)
+{
+  auto impl = std::make_shared<ls::LogServiceImpl>(
+    "cppmicroservices::testing::logservice", config);
+  spdlog::sink_ptr sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(oss);
+  sink->set_pattern(sinkFormat);
+  impl->AddSink(sink);
+  return impl;
+}
+
+std::ptrdiff_t CountMatches(const std::string& text, const std::string& regex)
+{
+  std::regex regexp(regex);
+  return std::distance(
+    std::sregex_iterator(text.begin(), text.end(), regexp),
+    std::sregex_iterator());
+}
+}
+
+TEST(LogServiceConfigTests, FromProperties)
+{
+  auto defaults = ls::LogServiceConfig::FromProperties(
+    cppmicroservices::AnyMap(cppmicroservices::AnyMap::UNORDERED_MAP));
+  EXPECT_EQ(ls::SeverityLevel::LOG_DEBUG, defaults.level);
+  EXPECT_FALSE(defaults.async);
+  EXPECT_TRUE(defaults.file.empty());
+
+  cppmicroservices::AnyMap props(
+    cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  props["org.cppmicroservices.logservice.level"] = std::string("Warning");
+  props["org.cppmicroservices.logservice.async"] = std::string("true");
+  props["org.cppmicroservices.logservice.async.queue_size"] = 16;
+  props["org.cppmicroservices.logservice.async.overflow"] =
+    std::string("discard_oldest");
+  props["org.cppmicroservices.logservice.flush_interval_ms"] =
+    std::string("0");
+  props["org.cppmicroservices.logservice.file"] = std::string("test.log");
+  props["org.cppmicroservices.logservice.file.max_size"] = 4096;
+  props["org.cppmicroservices.logservice.file.max_files"] = 1;
+  auto config = ls::LogServiceConfig::FromProperties(props);
+  EXPECT_EQ(ls::SeverityLevel::LOG_WARNING, config.level);
+  EXPECT_TRUE(config.async);
+  EXPECT_EQ(16u, config.queueSize);
+  EXPECT_TRUE(config.discardOldest);
+  EXPECT_EQ(0, config.flushInterval.count());
+  EXPECT_EQ("test.log", config.file);
+  EXPECT_EQ(4096u, config.maxFileSize);
+  EXPECT_EQ(1u, config.maxFiles);
+
+  // invalid values are ignored
+  props["org.cppmicroservices.logservice.level"] = std::string("verbose");
+  props["org.cppmicroservices.logservice.async.queue_size"] = -1;
+  props["org.cppmicroservices.logservice.file.max_size"] = std::string("1k");
+  config = ls::LogServiceConfig::FromProperties(props);
+  EXPECT_EQ(defaults.level, config.level);
+  EXPECT_EQ(defaults.queueSize, config.queueSize);
+  EXPECT_EQ(defaults.maxFileSize, config.maxFileSize);
+}
+
+TEST(LogServiceConfigTests, LevelFiltering)
+{
+  ls::LogServiceConfig config;
+  config.level = ls::SeverityLevel::LOG_WARNING;
+  std::ostringstream oss;
+  auto logger = MakeLogger(config, oss);
+
+  EXPECT_TRUE(logger->IsLevelEnabled(ls::SeverityLevel::LOG_ERROR));
+  EXPECT_TRUE(logger->IsLevelEnabled(ls::SeverityLevel::LOG_WARNING));
+  EXPECT_FALSE(logger->IsLevelEnabled(ls::SeverityLevel::LOG_INFO));
+  EXPECT_FALSE(logger->IsLevelEnabled(ls::SeverityLevel::LOG_DEBUG));
+
+  logger->Log(ls::SeverityLevel::LOG_DEBUG, "Filtered debug message");
+  logger->Log(cppmicroservices::ServiceReferenceU{},
+              ls::SeverityLevel::LOG_INFO,
+              "Filtered info message");
+  logger->Log(ls::SeverityLevel::LOG_WARNING, "Kept warning message");
+
+  bool built = false;
+  logger->LogLazily(ls::SeverityLevel::LOG_DEBUG, [&built] {
+    built = true;
+    return std::string("Lazy debug message");
+  });
+  EXPECT_FALSE(built);
+  logger->LogLazily(ls::SeverityLevel::LOG_ERROR,
+                    [] { return std::string("Lazy error message"); });
+
+  const auto text = oss.str();
+  EXPECT_EQ(0, CountMatches(text, "Filtered"));
+  EXPECT_EQ(1, CountMatches(text, log_preamble + "Kept warning message"));
+  EXPECT_EQ(1, CountMatches(text, log_preamble + "Lazy error message"));
+}
+
+TEST(LogServiceConfigTests, AsyncLogging)
+{
+  ls::LogServiceConfig config;
+  config.async = true;
+  config.queueSize = 8;
+  std::ostringstream oss;
+  auto logger = MakeLogger(config, oss);
+
+  const int threadCount = 4;
+  const int messageCount = 100;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threadCount; ++i) {
+    threads.emplace_back([&logger]() {
+      for (int j = 0; j < messageCount; ++j) {
+        logger->Log(ls::SeverityLevel::LOG_INFO, "Test async log calls");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // destroying the service writes all queued messages
+  logger.reset();
+  EXPECT_EQ(threadCount * messageCount,
+            CountMatches(oss.str(), log_preamble + "Test async log calls"));
+}
+
+TEST(LogServiceConfigTests, RotatingFile)
+{
+  const std::string dir = MakeTestDirectory("usLogServiceTests");
+  const std::string base = dir + cppmicroservices::util::DIR_SEP + "rotating";
+  const std::string file = base + ".log";
+  const std::string rotated = base + ".1.log";
+
+  ls::LogServiceConfig config;
+  config.file = file;
+  config.maxFileSize = 1024;
+  config.maxFiles = 1;
+  config.flushInterval = std::chrono::milliseconds::zero();
+  {
+    ls::LogServiceImpl logger("cppmicroservices::testing::logservice",
+                              config);
+    for (int i = 0; i < 100; ++i) {
+      logger.Log(ls::SeverityLevel::LOG_INFO, "Test rotating file sink");
+    }
+  }
+
+  EXPECT_TRUE(cppmicroservices::util::Exists(file));
+  EXPECT_TRUE(cppmicroservices::util::Exists(rotated));
+  EXPECT_FALSE(cppmicroservices::util::Exists(base + ".2.log"));
+  cppmicroservices::util::RemoveDirectoryRecursive(dir);
+}
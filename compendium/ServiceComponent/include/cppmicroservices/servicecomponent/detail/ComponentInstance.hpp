@@ -95,6 +95,29 @@ public:
   virtual bool DoesModifiedMethodExist() = 0;
 };
 
+/**
+ * An entry in the table of component entry points generated by the SCR code
+ * generator. The runtime reads the whole table once when the bundle's shared
+ * library is loaded, instead of looking up the creator and deleter functions
+ * of each component by name.
+ */
+struct ComponentSymbol
+{
+  /// The component name with "::" replaced by "_", as used in the names of
+  /// the generated NewInstance_ and DeleteInstance_ functions.
+  const char* name;
+  ComponentInstance* (*newInstance)();
+  void (*deleteInstance)(ComponentInstance*);
+};
+
+/**
+ * Prefix of the generated function returning a bundle's component symbol
+ * table. The function name is this prefix followed by the bundle's symbolic
+ * name and has the signature
+ * @code const ComponentSymbol* (std::size_t* count) @endcode
+ */
+#define US_SCR_COMPONENT_SYMBOLS_PREFIX _us_scr_component_symbols_
+
 }
 }
 }
@@ -0,0 +1,154 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef ComponentQuery_hpp
+#define ComponentQuery_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cppmicroservices/servicecomponent/ServiceComponentExport.h"
+#include "dto/ComponentConfigurationDTO.hpp"
+#include "dto/ComponentDescriptionDTO.hpp"
+
+namespace cppmicroservices {
+namespace service {
+namespace component {
+namespace runtime {
+
+/**
+ * \ingroup gr_servicecomponentruntime
+ *
+ * Selects the components returned by
+ * {@link ServiceComponentRuntime#QueryComponentDescriptionDTOs} and
+ * {@link ServiceComponentRuntime#QueryComponentConfigurationDTOs}.
+ *
+ * <p>
+ * A component is selected if it matches all criteria. Selected components
+ * are ordered by bundle id and name, then \c offset and \c limit are
+ * applied.
+ */
+struct US_ServiceComponent_EXPORT ComponentQuery
+{
+  /**
+   * The ids of the bundles whose components are selected. Components of all
+   * active bundles are selected if empty.
+   */
+  std::vector<unsigned long> bundleIds;
+
+  /**
+   * Only components whose name starts with this prefix are selected.
+   */
+  std::string namePrefix;
+
+  /**
+   * Only components with at least one component configuration in one of
+   * these states are selected. Components are selected regardless of their
+   * state if empty.
+   */
+  std::vector<dto::ComponentState> states;
+
+  /**
+   * Only components which changed after this change count are selected,
+   * see {@link ComponentQueryResult#changeCount}. A component changes when
+   * it is enabled or disabled, when one of its component configurations is
+   * created, changes its state, its configuration or its bound services.
+   * All components are selected if zero.
+   */
+  std::uint64_t changedSince = 0;
+
+  /**
+   * The number of selected components to skip.
+   */
+  std::size_t offset = 0;
+
+  /**
+   * The maximum number of components returned, or zero for no limit.
+   */
+  std::size_t limit = 0;
+
+  /**
+   * Whether the properties of the services bound to, or targeted by, the
+   * references of component configurations are returned. Copying them is
+   * the most expensive part of a query, pollers which only watch states
+   * should set this to \c false.
+   */
+  bool serviceProperties = true;
+};
+
+/**
+ * \ingroup gr_servicecomponentruntime
+ *
+ * The result of a {@link ComponentQuery}.
+ */
+struct US_ServiceComponent_EXPORT ComponentQueryResult
+{
+  /**
+   * The descriptions of the returned components, ordered by bundle id and
+   * name.
+   */
+  std::vector<dto::ComponentDescriptionDTO> descriptions;
+
+  /**
+   * The component configurations of the returned components. Only filled
+   * by {@link ServiceComponentRuntime#QueryComponentConfigurationDTOs}.
+   */
+  std::vector<dto::ComponentConfigurationDTO> configurations;
+
+  /**
+   * The number of selected components before \c offset and \c limit were
+   * applied.
+   */
+  std::size_t total = 0;
+
+  /**
+   * The change count of the runtime when the query started. Passing it as
+   * {@link ComponentQuery#changedSince} of the next query returns the
+   * components which changed in between.
+   */
+  std::uint64_t changeCount = 0;
+
+  /**
+   * The bundle ids and names of the components which were removed after
+   * {@link ComponentQuery#changedSince}. Empty if \c changedSince is zero.
+   * A component which was removed and then added again is listed here and
+   * returned as well.
+   */
+  std::vector<std::pair<unsigned long, std::string>> removed;
+
+  /**
+   * \c false if the runtime no longer knows about all components removed
+   * after {@link ComponentQuery#changedSince}, because too many were
+   * removed since then or the runtime was restarted. The caller must then
+   * query all components again.
+   */
+  bool complete = true;
+};
+}
+}
+}
+} // namespaces
+
+#endif /* ComponentQuery_hpp */
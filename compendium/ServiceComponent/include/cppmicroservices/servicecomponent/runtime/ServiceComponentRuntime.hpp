@@ -28,6 +28,7 @@
 
 #include <cppmicroservices/Bundle.h>
 
+#include "ComponentQuery.hpp"
 #include "cppmicroservices/servicecomponent/ServiceComponentExport.h"
 #include "dto/ComponentConfigurationDTO.hpp"
 #include "dto/ComponentDescriptionDTO.hpp"
@@ -183,6 +184,46 @@ public:
    */
   virtual std::shared_future<void> DisableComponent(
     const dto::ComponentDescriptionDTO& description) = 0;
+
+  /**
+   * Returns the descriptions of the components selected by a query.
+   *
+   * <p>
+   * Unlike {@link #GetComponentDescriptionDTOs}, only the selected
+   * components are converted to DTOs, so monitoring tools can page through
+   * large numbers of components or poll for the ones which changed.
+   *
+   * <p>
+   * The default implementation filters the result of
+   * {@link #GetComponentDescriptionDTOs}. It does not track changes: it
+   * returns all selected components with a change count of zero, and
+   * reports an incomplete result if {@link ComponentQuery#changedSince} is
+   * set.
+   *
+   * @param query Selects the components.
+   * @return The descriptions of the selected components, their total number
+   *         and the change count to pass to the next query.
+   */
+  virtual ComponentQueryResult QueryComponentDescriptionDTOs(
+    const ComponentQuery& query) const;
+
+  /**
+   * Returns the descriptions and the component configurations of the
+   * components selected by a query.
+   *
+   * <p>
+   * The default implementation filters the result of
+   * {@link #GetComponentDescriptionDTOs} and calls
+   * {@link #GetComponentConfigurationDTOs} for each selected component.
+   *
+   * @param query Selects the components.
+   * @return The descriptions and the component configurations of the
+   *         selected components, their total number and the change count
+   *         to pass to the next query.
+   * @see #QueryComponentDescriptionDTOs
+   */
+  virtual ComponentQueryResult QueryComponentConfigurationDTOs(
+    const ComponentQuery& query) const;
 };
 
 }
@@ -22,13 +22,108 @@
 
 #include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
 
+#include <algorithm>
+#include <tuple>
+
 namespace cppmicroservices {
 namespace service {
 namespace component {
 namespace runtime {
 
+namespace {
+
+// Selects the descriptions of a query from all descriptions of the runtime.
+// The configurations of the selected components are appended to
+// result.configurations if withConfigurations is true.
+void SelectComponents(const ServiceComponentRuntime& runtime,
+                      const ComponentQuery& query,
+                      bool withConfigurations,
+                      ComponentQueryResult& result)
+{
+  // changes are not tracked, every query returns all selected components
+  result.changeCount = 0;
+  result.complete = (query.changedSince == 0);
+  result.total = 0;
+
+  auto descriptions = runtime.GetComponentDescriptionDTOs();
+  std::sort(descriptions.begin(),
+            descriptions.end(),
+            [](const dto::ComponentDescriptionDTO& lhs,
+               const dto::ComponentDescriptionDTO& rhs) {
+              return std::tie(lhs.bundle.id, lhs.name) <
+                     std::tie(rhs.bundle.id, rhs.name);
+            });
+
+  for (auto& description : descriptions) {
+    if (!query.bundleIds.empty() &&
+        std::find(query.bundleIds.begin(),
+                  query.bundleIds.end(),
+                  description.bundle.id) == query.bundleIds.end()) {
+      continue;
+    }
+    if (description.name.compare(
+          0, query.namePrefix.size(), query.namePrefix) != 0) {
+      continue;
+    }
+    std::vector<dto::ComponentConfigurationDTO> configs;
+    if (!query.states.empty() || withConfigurations) {
+      configs = runtime.GetComponentConfigurationDTOs(description);
+    }
+    if (!query.states.empty() &&
+        std::none_of(
+          configs.begin(),
+          configs.end(),
+          [&query](const dto::ComponentConfigurationDTO& config) {
+            return std::find(query.states.begin(),
+                             query.states.end(),
+                             config.state) != query.states.end();
+          })) {
+      continue;
+    }
+    if (result.total >= query.offset &&
+        (query.limit == 0 || result.descriptions.size() < query.limit)) {
+      if (withConfigurations) {
+        for (auto& config : configs) {
+          if (!query.serviceProperties) {
+            for (auto& ref : config.satisfiedReferences) {
+              for (auto& service : ref.boundServices) {
+                service.properties.clear();
+              }
+            }
+            for (auto& ref : config.unsatisfiedReferences) {
+              for (auto& service : ref.targetServices) {
+                service.properties.clear();
+              }
+            }
+          }
+          result.configurations.push_back(std::move(config));
+        }
+      }
+      result.descriptions.push_back(std::move(description));
+    }
+    ++result.total;
+  }
+}
+}
+
 ServiceComponentRuntime::~ServiceComponentRuntime() noexcept {}
 
+ComponentQueryResult ServiceComponentRuntime::QueryComponentDescriptionDTOs(
+  const ComponentQuery& query) const
+{
+  ComponentQueryResult result;
+  SelectComponents(*this, query, false, result);
+  return result;
+}
+
+ComponentQueryResult ServiceComponentRuntime::QueryComponentConfigurationDTOs(
+  const ComponentQuery& query) const
+{
+  ComponentQueryResult result;
+  SelectComponents(*this, query, true, result);
+  return result;
+}
+
 }
 }
 }
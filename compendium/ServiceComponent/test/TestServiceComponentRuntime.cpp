@@ -0,0 +1,182 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
+
+using cppmicroservices::service::component::runtime::ComponentQuery;
+using cppmicroservices::service::component::runtime::ServiceComponentRuntime;
+using cppmicroservices::service::component::runtime::dto::
+  ComponentConfigurationDTO;
+using cppmicroservices::service::component::runtime::dto::
+  ComponentDescriptionDTO;
+using cppmicroservices::service::component::runtime::dto::ComponentState;
+using cppmicroservices::framework::dto::ServiceReferenceDTO;
+using cppmicroservices::service::component::runtime::dto::
+  SatisfiedReferenceDTO;
+
+namespace {
+
+// A runtime which only implements the required methods, used to test the
+// default implementations of the query methods.
+class FakeServiceComponentRuntime final : public ServiceComponentRuntime
+{
+public:
+  std::vector<ComponentDescriptionDTO> GetComponentDescriptionDTOs(
+    const std::vector<cppmicroservices::Bundle>&) const override
+  {
+    std::vector<ComponentDescriptionDTO> descriptions;
+    for (auto& component : components) {
+      ComponentDescriptionDTO description = {};
+      description.bundle.id = component.bundleId;
+      description.name = component.name;
+      descriptions.push_back(description);
+    }
+    return descriptions;
+  }
+
+  ComponentDescriptionDTO GetComponentDescriptionDTO(
+    const cppmicroservices::Bundle&,
+    const std::string&) const override
+  {
+    return {};
+  }
+
+  std::vector<ComponentConfigurationDTO> GetComponentConfigurationDTOs(
+    const ComponentDescriptionDTO& description) const override
+  {
+    for (auto& component : components) {
+      if (component.bundleId == description.bundle.id &&
+          component.name == description.name) {
+        ServiceReferenceDTO service = {};
+        service.properties["key"] = std::string("value");
+        SatisfiedReferenceDTO ref = {};
+        ref.boundServices.push_back(service);
+        ComponentConfigurationDTO config = {};
+        config.state = component.state;
+        config.satisfiedReferences.push_back(ref);
+        return { config };
+      }
+    }
+    return {};
+  }
+
+  bool IsComponentEnabled(const ComponentDescriptionDTO&) const override
+  {
+    return true;
+  }
+
+  std::shared_future<void> EnableComponent(
+    const ComponentDescriptionDTO&) override
+  {
+    return {};
+  }
+
+  std::shared_future<void> DisableComponent(
+    const ComponentDescriptionDTO&) override
+  {
+    return {};
+  }
+
+  struct Component
+  {
+    unsigned long bundleId;
+    std::string name;
+    ComponentState state;
+  };
+
+  std::vector<Component> components;
+};
+
+TEST(ServiceComponentRuntimeTest, DefaultQueryComponentDescriptionDTOs)
+{
+  FakeServiceComponentRuntime runtime;
+  runtime.components = { { 2, "b.Two", ComponentState::ACTIVE },
+                         { 1, "a.Three", ComponentState::SATISFIED },
+                         { 2, "a.One", ComponentState::ACTIVE },
+                         { 1, "a.Four", ComponentState::ACTIVE } };
+
+  // ordered by bundle id and name
+  auto result = runtime.QueryComponentDescriptionDTOs(ComponentQuery());
+  ASSERT_EQ(result.descriptions.size(), 4u);
+  EXPECT_EQ(result.total, 4u);
+  EXPECT_TRUE(result.complete);
+  EXPECT_EQ(result.descriptions[0].name, "a.Four");
+  EXPECT_EQ(result.descriptions[1].name, "a.Three");
+  EXPECT_EQ(result.descriptions[2].name, "a.One");
+  EXPECT_EQ(result.descriptions[3].name, "b.Two");
+  EXPECT_TRUE(result.configurations.empty());
+
+  ComponentQuery query;
+  query.bundleIds = { 2 };
+  query.namePrefix = "a.";
+  result = runtime.QueryComponentDescriptionDTOs(query);
+  ASSERT_EQ(result.descriptions.size(), 1u);
+  EXPECT_EQ(result.descriptions[0].name, "a.One");
+
+  query = ComponentQuery();
+  query.states = { ComponentState::ACTIVE };
+  query.offset = 1;
+  query.limit = 1;
+  result = runtime.QueryComponentDescriptionDTOs(query);
+  EXPECT_EQ(result.total, 3u);
+  ASSERT_EQ(result.descriptions.size(), 1u);
+  EXPECT_EQ(result.descriptions[0].name, "a.One");
+
+  // changes are not tracked, the caller has to take all components
+  query = ComponentQuery();
+  query.changedSince = 1;
+  result = runtime.QueryComponentDescriptionDTOs(query);
+  EXPECT_EQ(result.descriptions.size(), 4u);
+  EXPECT_EQ(result.changeCount, 0u);
+  EXPECT_FALSE(result.complete);
+}
+
+TEST(ServiceComponentRuntimeTest, DefaultQueryComponentConfigurationDTOs)
+{
+  FakeServiceComponentRuntime runtime;
+  runtime.components = { { 1, "One", ComponentState::ACTIVE },
+                         { 1, "Two", ComponentState::SATISFIED } };
+
+  ComponentQuery query;
+  query.states = { ComponentState::SATISFIED };
+  auto result = runtime.QueryComponentConfigurationDTOs(query);
+  ASSERT_EQ(result.descriptions.size(), 1u);
+  ASSERT_EQ(result.configurations.size(), 1u);
+  EXPECT_EQ(result.configurations[0].state, ComponentState::SATISFIED);
+  auto& services = result.configurations[0].satisfiedReferences[0].boundServices;
+  ASSERT_EQ(services.size(), 1u);
+  EXPECT_EQ(services[0].properties.size(), 1u);
+
+  query.serviceProperties = false;
+  result = runtime.QueryComponentConfigurationDTOs(query);
+  ASSERT_EQ(result.configurations.size(), 1u);
+  auto& bound = result.configurations[0].satisfiedReferences[0].boundServices;
+  ASSERT_EQ(bound.size(), 1u);
+  EXPECT_TRUE(bound[0].properties.empty());
+}
+}
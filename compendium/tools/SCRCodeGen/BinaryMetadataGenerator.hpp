@@ -0,0 +1,463 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+#ifndef BINARYMETADATAGENERATOR_HPP
+#define BINARYMETADATAGENERATOR_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "MetadataRules.hpp"
+#include "json/json.h"
+
+namespace codegen {
+
+namespace rules = cppmicroservices::scrimpl::metadata::rules;
+
+/**
+ * Serializes the "scr" section of a bundle manifest into the compact binary
+ * format read by Declarative Services at bundle start
+ * (see DeclarativeServices/src/metadata/BinaryMetadataReader.hpp).
+ *
+ * All defaults and derived values (component name, immediate, configuration
+ * policy and pids, reference cardinality) are resolved here, at build time,
+ * with the rules the runtime JSON parser uses (MetadataRules.hpp). Like the
+ * runtime parser, a component which cannot be loaded is recorded with its
+ * error and skipped by DS; the other components are still loaded.
+ *
+ * Layout (all integers little-endian):
+ *   magic "SCRM" | u32 format version | u64 manifest hash | u32 scr version |
+ *   u32 component count followed by the components. Each component starts
+ *   with a u8 status: 0 is followed by the error message, 1 by the warnings
+ *   and the component data. Strings are a u32 length followed by the bytes,
+ *   values are a u8 type tag followed by the value.
+ */
+class BinaryMetadataGenerator
+{
+public:
+  static constexpr std::uint32_t FormatVersion = 3;
+
+  enum ValueTag : std::uint8_t
+  {
+    TagBool = 1,
+    TagInt = 2,
+    TagDouble = 3,
+    TagString = 4,
+    TagArray = 5,
+    TagObject = 6
+  };
+
+  /**
+   * @param scr The "scr" section of the manifest
+   * @param manifestHash The HashManifest value of the manifest file, which
+   *        DS compares with the manifest embedded in the bundle to detect
+   *        stale metadata.
+   * @throws std::runtime_error if the "components" are not a non-empty array
+   *         of objects, which makes DS reject the whole manifest.
+   */
+  BinaryMetadataGenerator(const Json::Value& scr, std::uint64_t manifestHash)
+  {
+    Generate(scr, manifestHash);
+  }
+
+  const std::string& GetString() const { return mBuffer; }
+
+  /**
+   * @returns the errors of the skipped components and the warnings DS logs
+   *          when it loads the metadata
+   */
+  const std::vector<std::string>& GetDiagnostics() const
+  {
+    return mDiagnostics;
+  }
+
+  /**
+   * 64-bit FNV-1a hash of the manifest file contents. Must match
+   * BinaryMetadataReader::HashManifest in Declarative Services.
+   */
+  static std::uint64_t HashManifest(const std::string& manifest)
+  {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const auto c : manifest) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+private:
+  void Generate(const Json::Value& scr, std::uint64_t manifestHash)
+  {
+    const auto& components = scr["components"];
+    if (!components.isArray() || components.empty()) {
+      throw std::runtime_error(
+        "Invalid value for the name 'components'. Expected non-empty array");
+    }
+    for (const auto& component : components) {
+      if (!component.isObject() || component.empty()) {
+        throw std::runtime_error(
+          "Invalid value in 'components'. Expected non-empty JSON object");
+      }
+    }
+
+    mBuffer.append("SCRM", 4);
+    WriteU32(FormatVersion);
+    WriteU64(manifestHash);
+    WriteU32(static_cast<std::uint32_t>(scr["version"].asInt()));
+    WriteU32(static_cast<std::uint32_t>(components.size()));
+    std::size_t index = 0;
+    for (const auto& component : components) {
+      // write the component on its own so that an error discards only the
+      // partially written component
+      std::string written;
+      written.swap(mBuffer);
+      std::vector<std::string> warnings;
+      std::string error;
+      try {
+        WriteComponent(component, warnings);
+      } catch (const std::exception& ex) {
+        error = ex.what();
+      }
+      std::string componentData;
+      componentData.swap(mBuffer);
+      mBuffer.swap(written);
+      if (error.empty()) {
+        WriteU8(1);
+        WriteStrings(warnings);
+        mBuffer.append(componentData);
+        mDiagnostics.insert(
+          mDiagnostics.end(), warnings.begin(), warnings.end());
+      } else {
+        WriteU8(0);
+        WriteString(error);
+        mDiagnostics.push_back(rules::ComponentError(error, index));
+      }
+      ++index;
+    }
+  }
+
+  void WriteComponent(const Json::Value& component,
+                      std::vector<std::string>& warnings)
+  {
+    const auto implClassName =
+      GetString(component, "implementation-class", true);
+    const bool serviceSpecified = component.isMember("service");
+    bool immediate = false;
+    if (component.isMember("immediate")) {
+      immediate = GetBool(component, "immediate");
+    }
+    const bool isImmediate = rules::ResolveImmediate(
+      serviceSpecified, component.isMember("immediate") ? &immediate : nullptr);
+    const bool enabled =
+      component.isMember("enabled") ? GetBool(component, "enabled") : true;
+    auto name = GetString(component, "name", false);
+    if (name.empty()) {
+      name = implClassName;
+    }
+
+    const bool configPolicySpecified =
+      component.isMember("configuration-policy");
+    const bool configPidSpecified = component.isMember("configuration-pid");
+    std::string configPolicy;
+    std::vector<std::string> configPids;
+    if (configPolicySpecified) {
+      configPolicy = GetString(component, "configuration-policy", true);
+    }
+    if (configPolicySpecified && configPidSpecified) {
+      for (const auto& pid : GetArray(component, "configuration-pid")) {
+        configPids.push_back(AsString(pid, "configuration-pid"));
+      }
+    }
+    auto warning = rules::ResolveConfiguration(name,
+                                               configPolicySpecified,
+                                               configPidSpecified,
+                                               configPolicy,
+                                               configPids);
+    if (!warning.empty()) {
+      warnings.push_back(std::move(warning));
+    }
+
+    WriteString(name);
+    WriteString(implClassName);
+    WriteU8(enabled ? 1 : 0);
+    WriteU8(isImmediate ? 1 : 0);
+    WriteString(configPolicy);
+    WriteStrings(configPids);
+    WriteString(GetString(component, "factory", false));
+
+    // service
+    WriteU8(serviceSpecified ? 1 : 0);
+    if (serviceSpecified) {
+      const auto& service = GetObject(component, "service");
+      std::vector<std::string> interfaces;
+      for (const auto& interface : GetArray(service, "interfaces")) {
+        interfaces.push_back(AsString(interface, "interfaces"));
+      }
+      WriteString(GetChoice(service,
+                            "scope",
+                            rules::DEFAULT_SERVICE_SCOPE,
+                            rules::ServiceScopes()));
+      WriteStrings(interfaces);
+    }
+
+    // references
+    const auto references = component.isMember("references")
+                              ? GetArray(component, "references")
+                              : Json::Value(Json::arrayValue);
+    WriteU32(static_cast<std::uint32_t>(references.size()));
+    for (const auto& reference : references) {
+      if (!reference.isObject() || reference.empty()) {
+        throw std::runtime_error(
+          "Invalid value in 'references'. Expected non-empty JSON object");
+      }
+      const auto cardinality = GetChoice(reference,
+                                         "cardinality",
+                                         rules::DEFAULT_CARDINALITY,
+                                         rules::ReferenceCardinalities());
+      // the runtime parser rejects a cardinality which only matches a choice
+      // ignoring case
+      rules::GetCardinalityExtents(cardinality);
+      WriteString(GetString(reference, "name", true));
+      WriteString(GetString(reference, "interface", true));
+      WriteString(GetString(reference, "target", false));
+      WriteString(cardinality);
+      WriteString(GetChoice(reference,
+                            "policy",
+                            rules::DEFAULT_POLICY,
+                            rules::ReferencePolicies()));
+      WriteString(GetChoice(reference,
+                            "policy-option",
+                            rules::DEFAULT_POLICY_OPTION,
+                            rules::ReferencePolicyOptions()));
+    }
+
+    WriteObject(component, "properties");
+    WriteObject(component, "factory-properties");
+  }
+
+  // Writes the JSON object member "name" of "parent" (or an empty object)
+  void WriteObject(const Json::Value& parent, const std::string& name)
+  {
+    if (!parent.isMember(name)) {
+      WriteU32(0);
+      return;
+    }
+    WriteMembers(GetObject(parent, name));
+  }
+
+  void WriteMembers(const Json::Value& object)
+  {
+    std::vector<std::string> names;
+    for (const auto& memberName : object.getMemberNames()) {
+      if (IsRepresentable(object[memberName])) {
+        names.push_back(memberName);
+      }
+    }
+    WriteU32(static_cast<std::uint32_t>(names.size()));
+    for (const auto& memberName : names) {
+      WriteString(memberName);
+      WriteValue(object[memberName]);
+    }
+  }
+
+  // The framework drops JSON values which have no cppmicroservices::Any
+  // representation (null and integers that do not fit an int).
+  static bool IsRepresentable(const Json::Value& value)
+  {
+    switch (value.type()) {
+      case Json::nullValue:
+        return false;
+      case Json::intValue:
+      case Json::uintValue:
+        return value.isInt();
+      default:
+        return true;
+    }
+  }
+
+  void WriteValue(const Json::Value& value)
+  {
+    switch (value.type()) {
+      case Json::booleanValue:
+        WriteU8(TagBool);
+        WriteU8(value.asBool() ? 1 : 0);
+        break;
+      case Json::intValue:
+      case Json::uintValue:
+        WriteU8(TagInt);
+        WriteU32(static_cast<std::uint32_t>(value.asInt()));
+        break;
+      case Json::realValue: {
+        WriteU8(TagDouble);
+        const double d = value.asDouble();
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &d, sizeof(bits));
+        WriteU32(static_cast<std::uint32_t>(bits));
+        WriteU32(static_cast<std::uint32_t>(bits >> 32));
+        break;
+      }
+      case Json::stringValue:
+        WriteU8(TagString);
+        WriteString(StripLocalization(value.asString()));
+        break;
+      case Json::arrayValue: {
+        WriteU8(TagArray);
+        std::vector<const Json::Value*> elements;
+        for (const auto& element : value) {
+          if (IsRepresentable(element)) {
+            elements.push_back(&element);
+          }
+        }
+        WriteU32(static_cast<std::uint32_t>(elements.size()));
+        for (const auto* element : elements) {
+          WriteValue(*element);
+        }
+        break;
+      }
+      case Json::objectValue:
+        WriteU8(TagObject);
+        WriteMembers(value);
+        break;
+      default:
+        throw std::runtime_error("Unsupported JSON value in the manifest");
+    }
+  }
+
+  // The framework does not support attribute localization and removes a
+  // leading '%' from every string value in the manifest.
+  static std::string StripLocalization(std::string value)
+  {
+    if (!value.empty() && value[0] == '%') {
+      value.erase(0, 1);
+    }
+    return value;
+  }
+
+  static std::string AsString(const Json::Value& value, const std::string& name)
+  {
+    if (!value.isString() || value.asString().empty()) {
+      throw std::runtime_error("Invalid value for the name '" + name +
+                               "'. Expected non-empty string");
+    }
+    return StripLocalization(value.asString());
+  }
+
+  static std::string GetString(const Json::Value& parent,
+                               const std::string& name,
+                               bool mandatory)
+  {
+    if (!parent.isMember(name)) {
+      if (mandatory) {
+        throw std::runtime_error("Mandatory name '" + name +
+                                 "' missing from the manifest");
+      }
+      return std::string();
+    }
+    return AsString(parent[name], name);
+  }
+
+  static bool GetBool(const Json::Value& parent, const std::string& name)
+  {
+    if (!parent[name].isBool()) {
+      throw std::runtime_error("Invalid value for the name '" + name +
+                               "'. Expected boolean");
+    }
+    return parent[name].asBool();
+  }
+
+  static Json::Value GetArray(const Json::Value& parent,
+                              const std::string& name)
+  {
+    const auto& value = parent[name];
+    if (!value.isArray() || value.empty()) {
+      throw std::runtime_error("Invalid value for the name '" + name +
+                               "'. Expected non-empty array");
+    }
+    return value;
+  }
+
+  static const Json::Value& GetObject(const Json::Value& parent,
+                                      const std::string& name)
+  {
+    const auto& value = parent[name];
+    if (!value.isObject() || value.empty()) {
+      throw std::runtime_error("Invalid value for the name '" + name +
+                               "'. Expected non-empty JSON object");
+    }
+    return value;
+  }
+
+  // Returns parent[name], or defaultValue if it is absent
+  static std::string GetChoice(const Json::Value& parent,
+                               const std::string& name,
+                               const std::string& defaultValue,
+                               const std::vector<std::string>& choices)
+  {
+    if (!parent.isMember(name)) {
+      return defaultValue;
+    }
+    auto value = AsString(parent[name], name);
+    rules::ThrowIfNotChoice(value, choices);
+    return value;
+  }
+
+  void WriteU8(std::uint8_t value)
+  {
+    mBuffer.push_back(static_cast<char>(value));
+  }
+
+  void WriteU32(std::uint32_t value)
+  {
+    for (int shift = 0; shift < 32; shift += 8) {
+      mBuffer.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+  }
+
+  void WriteU64(std::uint64_t value)
+  {
+    for (int shift = 0; shift < 64; shift += 8) {
+      mBuffer.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+  }
+
+  void WriteString(const std::string& value)
+  {
+    WriteU32(static_cast<std::uint32_t>(value.size()));
+    mBuffer.append(value);
+  }
+
+  void WriteStrings(const std::vector<std::string>& values)
+  {
+    WriteU32(static_cast<std::uint32_t>(values.size()));
+    for (const auto& value : values) {
+      WriteString(value);
+    }
+  }
+
+  std::string mBuffer;
+  std::vector<std::string> mDiagnostics;
+};
+
+} // namespace codegen
+#endif
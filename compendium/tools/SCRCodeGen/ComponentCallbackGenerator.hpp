@@ -23,6 +23,7 @@
 #define COMPONENTCALLBACKGENERATOR_HPP
 
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 #if defined(USING_GTEST)
@@ -144,6 +145,30 @@ private:
                  << "}" << std::endl
                  << std::endl;
     }
+    SubstituteSymbolTable();
+  }
+
+  // Generate the table of all creator and deleter functions in this bundle,
+  // so the runtime can resolve them with a single symbol lookup per bundle.
+  // The table is only generated when the bundle's symbolic name is known.
+  void SubstituteSymbolTable()
+  {
+    mStrStream << "#if defined(US_BUNDLE_NAME)" << std::endl
+               << R"(extern "C" US_ABI_EXPORT const scd::ComponentSymbol* US_CONCAT(US_SCR_COMPONENT_SYMBOLS_PREFIX, US_BUNDLE_NAME)(std::size_t* count))" << std::endl
+               << "{" << std::endl
+               << "  static const scd::ComponentSymbol symbols[] = {" << std::endl;
+    for (auto it = mComponentInfos.begin(); it != mComponentInfos.end(); ++it)
+    {
+      mStrStream << util::Substitute(R"(    { "{0}", &NewInstance_{0}, &DeleteInstance_{0} })"
+                                     , datamodel::GetComponentNameStr(*it))
+                 << (std::next(it) != mComponentInfos.end() ? "," : "")
+                 << std::endl;
+    }
+    mStrStream << "  };" << std::endl
+               << "  *count = sizeof(symbols) / sizeof(symbols[0]);" << std::endl
+               << "  return symbols;" << std::endl
+               << "}" << std::endl
+               << "#endif" << std::endl;
   }
 
   const std::vector<std::string> mHeaderIncludes;
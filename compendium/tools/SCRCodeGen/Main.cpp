@@ -27,6 +27,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <unordered_map>
 
@@ -39,9 +40,11 @@
 #else
 #  define FRIEND_TEST(x, y)
 #endif
+#include "BinaryMetadataGenerator.hpp"
 #include "ComponentCallbackGenerator.hpp"
 #include "ComponentInfo.hpp"
 #include "Util.hpp"
+using codegen::BinaryMetadataGenerator;
 using codegen::ComponentCallbackGenerator;
 using codegen::util::JsonValueValidator;
 using codegen::util::ParseManifestOrThrow;
@@ -101,7 +104,12 @@ int main(int argc, const char** argv, char**)
     std::ifstream manifestFile(manifestFilePath,
                                std::ifstream::binary | std::ifstream::in);
     checkFileOpenOrThrow(manifestFile);
-    const auto root = ParseManifestOrThrow(manifestFile);
+    // keep the manifest contents, the precompiled metadata records their hash
+    const std::string manifestContents(
+      (std::istreambuf_iterator<char>(manifestFile)),
+      std::istreambuf_iterator<char>());
+    std::istringstream manifestStream(manifestContents);
+    const auto root = ParseManifestOrThrow(manifestStream);
     const auto scr =
       JsonValueValidator(root, "scr", Json::ValueType::objectValue)();
     const auto version =
@@ -110,6 +118,26 @@ int main(int argc, const char** argv, char**)
     const auto componentInfos = manifestParser->ParseAndGetComponentInfos(scr);
     ComponentCallbackGenerator compGen(includeHeaderPaths, componentInfos);
     WriteToFile(outFilePath, compGen.GetString());
+
+    // --metadata-out-file is optional. When given, the component metadata is
+    // also written in the binary format Declarative Services loads instead
+    // of parsing the manifest at runtime. DS only looks for it in bundles
+    // whose manifest sets "precompiled_metadata" to true.
+    if (std::find(std::begin(args), std::end(args), "--metadata-out-file") !=
+        args.end()) {
+      it = findOrThrow("--metadata-out-file");
+      if (!scr.get("precompiled_metadata", false).asBool()) {
+        throw std::runtime_error(
+          "--metadata-out-file requires \"precompiled_metadata\" : true in "
+          "the \"scr\" section of the manifest");
+      }
+      BinaryMetadataGenerator metadataGen(
+        scr, BinaryMetadataGenerator::HashManifest(manifestContents));
+      for (const auto& diagnostic : metadataGen.GetDiagnostics()) {
+        std::cerr << diagnostic << std::endl;
+      }
+      WriteToFile(*it, metadataGen.GetString());
+    }
   } catch (const std::exception& ex) {
     std::cerr << ex.what() << std::endl;
     returnCode = FailureReturnCode;
@@ -75,6 +75,16 @@ extern "C" US_ABI_EXPORT void DeleteInstance_DSSpellCheck_SpellCheckImpl(scd::Co
   delete componentInstance;
 }
 
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentSymbol* US_CONCAT(US_SCR_COMPONENT_SYMBOLS_PREFIX, US_BUNDLE_NAME)(std::size_t* count)
+{
+  static const scd::ComponentSymbol symbols[] = {
+    { "DSSpellCheck_SpellCheckImpl", &NewInstance_DSSpellCheck_SpellCheckImpl, &DeleteInstance_DSSpellCheck_SpellCheckImpl }
+  };
+  *count = sizeof(symbols) / sizeof(symbols[0]);
+  return symbols;
+}
+#endif
 )manifestsrc";
 #endif
 
@@ -101,6 +111,16 @@ extern "C" US_ABI_EXPORT void DeleteInstance_DSSpellCheck_SpellCheckImpl(scd::Co
   delete componentInstance;
 }
 
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentSymbol* US_CONCAT(US_SCR_COMPONENT_SYMBOLS_PREFIX, US_BUNDLE_NAME)(std::size_t* count)
+{
+  static const scd::ComponentSymbol symbols[] = {
+    { "DSSpellCheck_SpellCheckImpl", &NewInstance_DSSpellCheck_SpellCheckImpl, &DeleteInstance_DSSpellCheck_SpellCheckImpl }
+  };
+  *count = sizeof(symbols) / sizeof(symbols[0]);
+  return symbols;
+}
+#endif
 )manifestsrc";
 
 const std::string REF_MULT_COMPS = R"manifestsrc(
@@ -139,6 +159,17 @@ extern "C" US_ABI_EXPORT void DeleteInstance_Foo_Impl2(scd::ComponentInstance* c
   delete componentInstance;
 }
 
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentSymbol* US_CONCAT(US_SCR_COMPONENT_SYMBOLS_PREFIX, US_BUNDLE_NAME)(std::size_t* count)
+{
+  static const scd::ComponentSymbol symbols[] = {
+    { "Foo_Impl1", &NewInstance_Foo_Impl1, &DeleteInstance_Foo_Impl1 },
+    { "Foo_Impl2", &NewInstance_Foo_Impl2, &DeleteInstance_Foo_Impl2 }
+  };
+  *count = sizeof(symbols) / sizeof(symbols[0]);
+  return symbols;
+}
+#endif
 )manifestsrc";
 
 const std::string REF_MULT_COMPS_SAME_IMPL = R"manifestsrc(
@@ -177,6 +208,17 @@ extern "C" US_ABI_EXPORT void DeleteInstance_FooImpl2(scd::ComponentInstance* co
   delete componentInstance;
 }
 
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentSymbol* US_CONCAT(US_SCR_COMPONENT_SYMBOLS_PREFIX, US_BUNDLE_NAME)(std::size_t* count)
+{
+  static const scd::ComponentSymbol symbols[] = {
+    { "FooImpl1", &NewInstance_FooImpl1, &DeleteInstance_FooImpl1 },
+    { "FooImpl2", &NewInstance_FooImpl2, &DeleteInstance_FooImpl2 }
+  };
+  *count = sizeof(symbols) / sizeof(symbols[0]);
+  return symbols;
+}
+#endif
 )manifestsrc";
 
 } // namespace codegen
@@ -22,6 +22,7 @@
 
 #include <regex>
 
+#include "../BinaryMetadataGenerator.hpp"
 #include "../ComponentCallbackGenerator.hpp"
 #include "../ManifestParser.hpp"
 #include "../ManifestParserFactory.hpp"
@@ -810,4 +811,181 @@ INSTANTIATE_TEST_SUITE_P(
       true)  
       ));
 
+// The precompiled metadata starts with the magic, the format version, the
+// manifest hash, the scr version and the number of components, all
+// little-endian.
+TEST(BinaryMetadataGeneratorTest, TestHeader)
+{
+  auto scr = GetManifestSCRData(manifest_mult_comp);
+  BinaryMetadataGenerator metadataGen(scr, 0x0807060504030201ULL);
+  const auto& data = metadataGen.GetString();
+  ASSERT_GT(data.size(), 24u);
+  EXPECT_EQ(data.substr(0, 4), "SCRM");
+  EXPECT_EQ(data.substr(4, 4),
+            std::string("\x03\x00\x00\x00", 4));
+  EXPECT_EQ(data.substr(8, 8),
+            std::string("\x01\x02\x03\x04\x05\x06\x07\x08", 8));
+  EXPECT_EQ(data.substr(16, 4),
+            std::string("\x01\x00\x00\x00", 4));
+  EXPECT_EQ(data.substr(20, 4),
+            std::string(1, static_cast<char>(scr["components"].size())) +
+              std::string(3, '\0'));
+}
+
+// Defaults are resolved at build time: the component name defaults to the
+// implementation class and a "$" configuration-pid to the component name.
+TEST(BinaryMetadataGeneratorTest, TestDefaultsResolved)
+{
+  auto scr = GetManifestSCRData(R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                "implementation-class": "sample::Impl",
+                "configuration-policy" : "optional",
+                "configuration-pid" : ["$"]
+              }]
+            }
+  })manifest");
+  BinaryMetadataGenerator metadataGen(scr, 0);
+  const auto& data = metadataGen.GetString();
+
+  const std::string implClass = "sample::Impl";
+  const std::string lengthPrefixed =
+    std::string(1, static_cast<char>(implClass.size())) + std::string(3, '\0') +
+    implClass;
+  // name, implementation class and configuration-pid
+  std::string::size_type count = 0;
+  for (auto pos = data.find(lengthPrefixed); pos != std::string::npos;
+       pos = data.find(lengthPrefixed, pos + 1)) {
+    ++count;
+  }
+  EXPECT_EQ(count, 3u);
+}
+
+// Like the runtime parser, an invalid component is recorded with its error
+// and skipped while the other components are kept.
+TEST(BinaryMetadataGeneratorTest, TestInvalidComponents)
+{
+  const auto invalidComponents = {
+    // a component without a service must be immediate
+    R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                "implementation-class": "sample::Impl",
+                "immediate" : false
+              }]
+            }
+  })manifest",
+    R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                "implementation-class": "sample::Impl",
+                "references": [{
+                  "name": "foo",
+                  "interface": "test::Foo",
+                  "cardinality": "2..n"
+                }]
+              }]
+            }
+  })manifest",
+    R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                "implementation-class": "sample::Impl",
+                "configuration-policy" : "optional",
+                "configuration-pid" : ["sample::Impl", "$"]
+              }]
+            }
+  })manifest"
+  };
+  for (const auto* manifest : invalidComponents) {
+    BinaryMetadataGenerator metadataGen(GetManifestSCRData(manifest), 0);
+    const auto& data = metadataGen.GetString();
+    ASSERT_GT(data.size(), 25u);
+    // status 0, followed by the error message
+    EXPECT_EQ(data[24], '\x00');
+    ASSERT_EQ(metadataGen.GetDiagnostics().size(), 1u);
+    EXPECT_NE(metadataGen.GetDiagnostics()[0].find(
+                "Could not load the component with index: 0"),
+              std::string::npos);
+  }
+
+  BinaryMetadataGenerator metadataGen(GetManifestSCRData(R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                "implementation-class": "sample::Bad",
+                "immediate" : false
+              },
+              {
+                "implementation-class": "sample::Good"
+              }]
+            }
+  })manifest"), 0);
+  const auto& data = metadataGen.GetString();
+  EXPECT_EQ(data.substr(20, 4), std::string("\x02\x00\x00\x00", 4));
+  EXPECT_EQ(data.find("sample::Bad"), std::string::npos);
+  EXPECT_NE(data.find("sample::Good"), std::string::npos);
+  ASSERT_EQ(metadataGen.GetDiagnostics().size(), 1u);
+  EXPECT_NE(metadataGen.GetDiagnostics()[0].find("index: 0"),
+            std::string::npos);
+
+  // components which are not objects make the whole manifest invalid
+  EXPECT_THROW(BinaryMetadataGenerator(GetManifestSCRData(R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [ "sample::Impl" ]
+            }
+  })manifest"), 0),
+               std::runtime_error);
+  EXPECT_THROW(BinaryMetadataGenerator(GetManifestSCRData(R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": []
+            }
+  })manifest"), 0),
+               std::runtime_error);
+}
+
+// A lone configuration-policy or configuration-pid leaves the component
+// ignoring Configuration Admin and is recorded as a warning DS logs.
+TEST(BinaryMetadataGeneratorTest, TestConfigurationWarning)
+{
+  const auto manifests = { R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                "implementation-class": "sample::Impl",
+                "configuration-policy" : "require"
+              }]
+            }
+  })manifest",
+                           R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                "implementation-class": "sample::Impl",
+                "configuration-pid" : ["sample::Impl"]
+              }]
+            }
+  })manifest" };
+  for (const auto* manifest : manifests) {
+    BinaryMetadataGenerator metadataGen(GetManifestSCRData(manifest), 0);
+    const auto& data = metadataGen.GetString();
+    ASSERT_GT(data.size(), 25u);
+    // status 1 and one warning
+    EXPECT_EQ(data[24], '\x01');
+    EXPECT_EQ(data.substr(25, 4), std::string("\x01\x00\x00\x00", 4));
+    ASSERT_EQ(metadataGen.GetDiagnostics().size(), 1u);
+    EXPECT_EQ(metadataGen.GetDiagnostics()[0].find(
+                "Warning: configuration-policy has been set to ignore."),
+              0u);
+    EXPECT_EQ(data.find("require"), std::string::npos);
+    EXPECT_NE(data.find("ignore"), std::string::npos);
+  }
+}
+
 } // namespace codegen
@@ -217,7 +217,6 @@ public:
      *
      * @see Constants#BUNDLE_ACTIVATIONPOLICY
      * @see #Start(uint32_t)
-     * @note This option is reserved for future use and not supported yet.
      */
     START_ACTIVATION_POLICY = 0x00000002
   };
@@ -388,7 +387,9 @@ public:
     * @throws std::invalid_argument if handle or symname is empty
     * @throws std::invalid_argument if this bundle is not initialized
     *
-    * @pre  Bundle is already started and active
+    * @pre  Bundle is already started and active, or waits for its
+    *       \link Constants#ACTIVATION_LAZY lazy activation\endlink, which
+    *       this call triggers
     *
     * @post The symbol(s) associated with the bundle gets fetched if the library is loaded
     * @post If the symbol does not exist, the API returns nullptr 
@@ -633,6 +634,12 @@ public:
    *    <em>Started with eager activation</em> if not set. When the Framework is
    *    restarted and this bundle's autostart setting is not <em>Stopped</em>,
    *    this bundle must be automatically started.
+   * -# If the Framework has been started and this bundle's start level is
+   *    above the Framework's active start level (see
+   *    Framework::GetBundleStartLevel and Framework::GetStartLevel), then a
+   *    \c std::runtime_error is thrown if the {@link #START_TRANSIENT} option
+   *    is set. Otherwise, this method returns immediately and this bundle is
+   *    started when the Framework reaches its start level.
    * -# If this bundle's state is not \c STATE_RESOLVED, an attempt is made to
    *    resolve this bundle. If the Framework cannot resolve this bundle, a
    *    \c std::runtime_error is thrown.
@@ -30,6 +30,8 @@
 #include "cppmicroservices/ServiceInterface.h"
 #include "cppmicroservices/ServiceRegistration.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 namespace cppmicroservices {
@@ -462,7 +464,8 @@ public:
         "The service interface class has no "
         "CPPMICROSERVICES_DECLARE_SERVICE_INTERFACE macro");
     using BaseVectorT = std::vector<ServiceReferenceU>;
-    BaseVectorT serviceRefs = GetServiceReferences(clazz, filter);
+    BaseVectorT serviceRefs =
+      GetServiceReferences(clazz, filter, InterfaceIdCache<S>());
     std::vector<ServiceReference<S>> result;
     for (BaseVectorT::const_iterator i = serviceRefs.begin();
          i != serviceRefs.end();
@@ -528,7 +531,8 @@ public:
       throw ServiceException(
         "The service interface class has no "
         "CPPMICROSERVICES_DECLARE_SERVICE_INTERFACE macro");
-    return ServiceReference<S>(GetServiceReference(clazz));
+    return ServiceReference<S>(
+      GetServiceReference(clazz, InterfaceIdCache<S>()));
   }
 
   /**
@@ -694,6 +698,34 @@ public:
   ListenerToken AddServiceListener(const ServiceListener& listener,
                                    const std::string& filter = std::string());
 
+  /**
+   * Adds the specified <code>listener</code> with the specified
+   * <code>filter</code> to the context bundle's list of listeners, opting
+   * in to asynchronous delivery of service events.
+   *
+   * <p>
+   * If the framework was launched with the
+   * Constants#FRAMEWORK_SERVICE_EVENT_DELIVERY property set to
+   * Constants#FRAMEWORK_SERVICE_EVENT_DELIVERY_ASYNC, the <code>listener</code>
+   * is called on a framework thread instead of the thread which fired the
+   * event. It receives events one at a time, in the order they were fired.
+   * Otherwise, this method behaves exactly like AddServiceListener().
+   *
+   * @param listener Any callable object.
+   * @param filter The filter criteria.
+   * @returns a ListenerToken object which can be used to remove the
+   *          <code>listener</code> from the list of registered listeners.
+   * @throws std::invalid_argument If <code>filter</code> contains an
+   *         invalid filter string that cannot be parsed.
+   * @throws std::runtime_error If this BundleContext is no
+   *         longer valid.
+   * @see AddServiceListener()
+   * @see Framework::GetServiceEventDeliveryStats()
+   */
+  ListenerToken AddAsyncServiceListener(
+    const ServiceListener& listener,
+    const std::string& filter = std::string());
+
   /**
    * Removes the specified <code>listener</code> from the context bundle's
    * list of listeners.
@@ -1147,6 +1179,27 @@ private:
   // to log diagnostic information.
   std::shared_ptr<detail::LogSink> GetLogSink() const;
 
+  // Not for use by clients of the Framework.
+  // The framework interns interface id strings to integers. The template
+  // lookups remember the interned id of their interface id string in a
+  // per-type static, so that only the first lookup of a type hashes it.
+  static constexpr std::uint32_t UNRESOLVED_INTERFACE_ID = UINT32_MAX;
+
+  template<class S>
+  static std::atomic<std::uint32_t>& InterfaceIdCache()
+  {
+    static std::atomic<std::uint32_t> id{ UNRESOLVED_INTERFACE_ID };
+    return id;
+  }
+
+  std::vector<ServiceReferenceU> GetServiceReferences(
+    const std::string& clazz,
+    const std::string& filter,
+    std::atomic<std::uint32_t>& interfaceId);
+  ServiceReferenceU GetServiceReference(
+    const std::string& clazz,
+    std::atomic<std::uint32_t>& interfaceId);
+
   ListenerToken AddServiceListener(const ServiceListener& delegate,
                                    void* data,
                                    const std::string& filter);
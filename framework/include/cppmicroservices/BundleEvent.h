@@ -154,8 +154,6 @@ public:
      * The bundle has a \link Constants#ACTIVATION_LAZY lazy activation policy\endlink
      * and is waiting to be activated. It is now in the \link Bundle::STATE_STARTING
      * BUNDLE_STARTING\endlink state and has a valid \c BundleContext.
-     *
-     * @note This identifier is reserved for future use and not supported yet.
      */
     BUNDLE_LAZY_ACTIVATION = 0x00000200
 
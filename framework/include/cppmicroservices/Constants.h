@@ -196,14 +196,21 @@ US_Framework_EXPORT extern const std::string
  *
  * A bundle with the lazy activation policy that is started with the
  * {@link Bundle#START_ACTIVATION_POLICY START_ACTIVATION_POLICY} option
- * will wait in the {@link Bundle#STATE_STARTING STATE_STARTING} state until its
- * library is loaded. The bundle will then be activated.
+ * will wait in the {@link Bundle#STATE_STARTING STATE_STARTING} state, without
+ * its library being loaded, until its activation is triggered by
+ * - a request for a service the bundle registered with a service factory
+ *   (as Declarative Services does on behalf of the bundle),
+ * - a Bundle#GetSymbol call on the bundle, or
+ * - a Bundle#Start call without the \c START_ACTIVATION_POLICY option.
+ *
+ * The bundle is then activated: its library is loaded and its activator
+ * is started.
  *
  * The activation policy value is specified as in the
  * bundle.activation_policy manifest header like:
  *
  * <pre>
- *       bundle: { activation_policy: "lazy" }
+ *       "bundle.activation_policy": "lazy"
  * </pre>
  *
  * @see #BUNDLE_ACTIVATIONPOLICY
@@ -212,6 +219,38 @@ US_Framework_EXPORT extern const std::string
  */
 US_Framework_EXPORT extern const std::string ACTIVATION_LAZY; // = "lazy";
 
+/**
+ * Manifest header listing the symbolic names of the bundles a bundle
+ * depends on, as a string or an array of strings.
+ *
+ * Framework::StartBundles starts a bundle after the bundles it depends on,
+ * and Framework::StopBundles as well as the framework shutdown stop it
+ * before them. The header does not cause any bundle to be installed or
+ * started.
+ *
+ * The header value may be retrieved from the \c AnyMap object
+ * returned by the \c Bundle::GetHeaders() method.
+ */
+US_Framework_EXPORT extern const std::string
+  BUNDLE_DEPENDENCIES; // = "bundle.dependencies";
+
+/**
+ * Manifest header specifying the start level of a bundle. The value must be
+ * an int greater than zero, the default is 1.
+ *
+ * A bundle is only started once the active start level of the framework is
+ * at least its start level. Bundles with a higher start level are started
+ * later, when the framework moves to their start level.
+ *
+ * The header value may be retrieved from the \c AnyMap object
+ * returned by the \c Bundle::GetHeaders() method.
+ *
+ * @see Framework::SetStartLevel(unsigned int)
+ * @see Framework::SetBundleStartLevel(const Bundle&, unsigned int)
+ */
+US_Framework_EXPORT extern const std::string
+  BUNDLE_STARTLEVEL; // = "bundle.start_level";
+
 /**
  * Framework environment property identifying the Framework version.
  *
@@ -309,6 +348,95 @@ US_Framework_EXPORT extern const std::string
 US_Framework_EXPORT extern const std::string
   FRAMEWORK_LOG; // = "org.cppmicroservices.framework.log";
 
+/**
+ * Framework launching property specifying how service events are delivered
+ * to service listeners added with BundleContext::AddAsyncServiceListener.
+ * The value must be a std::string, either
+ * #FRAMEWORK_SERVICE_EVENT_DELIVERY_SYNC (the default) or
+ * #FRAMEWORK_SERVICE_EVENT_DELIVERY_ASYNC.
+ *
+ * Service listeners added with BundleContext::AddServiceListener are always
+ * called synchronously.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_SERVICE_EVENT_DELIVERY; // = "org.cppmicroservices.framework.service.event.delivery";
+
+/**
+ * Service event delivery configuration declaring that all service listeners
+ * are called synchronously by the thread firing the event.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_SERVICE_EVENT_DELIVERY_SYNC; // = "sync";
+
+/**
+ * Service event delivery configuration declaring that listeners added with
+ * BundleContext::AddAsyncServiceListener are called on framework threads.
+ * Each such listener receives its events one at a time and in the order they
+ * were fired, but the thread firing an event does not wait for it to be
+ * delivered. This is not OSGi compliant: by the time the listener is called
+ * for a ServiceEvent::SERVICE_UNREGISTERING event, the service may already
+ * be gone.
+ *
+ * This configuration has no effect if the framework is built without
+ * threading support.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_SERVICE_EVENT_DELIVERY_ASYNC; // = "async";
+
+/**
+ * Framework launching property specifying the number of threads which
+ * deliver service events asynchronously. The value must be an int, the
+ * default is 1.
+ *
+ * @see #FRAMEWORK_SERVICE_EVENT_DELIVERY_ASYNC
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_SERVICE_EVENT_DELIVERY_THREADS; // = "org.cppmicroservices.framework.service.event.delivery.threads";
+
+/**
+ * Framework launching property specifying the number of threads which stop
+ * the active bundles when the framework is shut down. The value must be an
+ * int, the default is 1. See Framework::StopBundles for how bundle
+ * dependencies order the stopping of bundles.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_SHUTDOWN_THREADS; // = "org.cppmicroservices.framework.shutdown.threads";
+
+/**
+ * Framework launching property specifying the start level the framework
+ * moves to when it is started. The value must be an int greater than zero,
+ * the default is 1. FrameworkEvent::FRAMEWORK_STARTED is fired once the
+ * bundles up to this start level have been started.
+ *
+ * @see Framework::SetStartLevel(unsigned int)
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_BEGINNING_STARTLEVEL; // = "org.cppmicroservices.framework.startlevel.beginning";
+
+/**
+ * Framework launching property specifying the number of threads which start
+ * or stop the bundles of a start level when the active start level of the
+ * framework changes. The value must be an int, the default is 1. See
+ * Framework::StartBundles for how bundle dependencies order the starting of
+ * bundles.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_STARTLEVEL_THREADS; // = "org.cppmicroservices.framework.startlevel.threads";
+
+/**
+ * Framework launching property specifying a file the framework writes trace
+ * events to, in the Chrome trace event format. The value must be a
+ * std::string. If set, the file is created when the framework is
+ * initialized and completed when it is stopped. The events record bundle
+ * installation, activation and deactivation, service listener calls and,
+ * if present, Declarative Services and Configuration Admin activity, with
+ * the thread they ran on. The file can be opened in chrome://tracing or
+ * Perfetto. Tracing is shared by all frameworks of the process, the last
+ * framework initialized with this property wins.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_TRACE_FILE; // = "org.cppmicroservices.framework.trace.file";
+
 /**
  * Framework environment property identifying the Framework's universally
  * unique identifier (UUID). A UUID represents a 128-bit value. A new UUID
@@ -27,15 +27,95 @@
 #include "cppmicroservices/FrameworkConfig.h"
 
 #include <chrono>
+#include <cstdint>
+#include <exception>
 #include <map>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace cppmicroservices {
 
 class FrameworkEvent;
 class FrameworkPrivate;
 
+/**
+ * \ingroup MicroServices
+ *
+ * Counters describing the asynchronous delivery of service events.
+ *
+ * @see Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY
+ * @see BundleContext::AddAsyncServiceListener
+ */
+struct ServiceEventDeliveryStats
+{
+  /// Number of events queued for asynchronous listeners.
+  std::uint64_t queued = 0;
+  /// Number of queued events which have been delivered.
+  std::uint64_t delivered = 0;
+  /// Number of queued events which have not been delivered yet.
+  std::uint64_t pending = 0;
+  /// The highest number of pending events seen so far.
+  std::uint64_t maxPending = 0;
+};
+
+/**
+ * \ingroup MicroServices
+ *
+ * A snapshot of one performance counter.
+ *
+ * @see Framework::GetPerformanceCounters
+ */
+struct PerformanceCounterValue
+{
+  /// Number of recorded events.
+  std::uint64_t count = 0;
+  /// Sum of the amounts of the events, e.g. bytes or notified listeners.
+  std::uint64_t amount = 0;
+  /// Total time of the timed events.
+  std::chrono::nanoseconds duration{ 0 };
+  /// The longest timed event.
+  std::chrono::nanoseconds maxDuration{ 0 };
+};
+
+/**
+ * \ingroup MicroServices
+ *
+ * Performance counter snapshots, by counter name.
+ */
+using PerformanceCounters = std::map<std::string, PerformanceCounterValue>;
+
+/**
+ * \ingroup MicroServices
+ *
+ * Write performance counters as a JSON object, mapping counter names to
+ * objects with the <code>count</code>, <code>amount</code>,
+ * <code>duration_ns</code> and <code>max_duration_ns</code> members.
+ *
+ * @param os The output stream.
+ * @param counters The counters to write.
+ * @return \c os
+ */
+US_Framework_EXPORT std::ostream& performance_counters_to_json(
+  std::ostream& os,
+  const PerformanceCounters& counters);
+
+/**
+ * \ingroup MicroServices
+ *
+ * The outcome of starting or stopping a bundle with
+ * Framework::StartBundles or Framework::StopBundles.
+ */
+struct BundleOperationResult
+{
+  /// The bundle which was started or stopped.
+  Bundle bundle;
+  /// How long starting or stopping the bundle took.
+  std::chrono::nanoseconds duration{ 0 };
+  /// The exception thrown while starting or stopping the bundle, if any.
+  std::exception_ptr exception;
+};
+
 /**
  * \ingroup MicroServices
  *
@@ -241,6 +321,196 @@ public:
   std::string GetLocation() const;
 #endif
 
+  /**
+   * Returns the counters of the asynchronous service event delivery since
+   * this Framework was last initialized. All counters are zero if
+   * asynchronous delivery is disabled or no asynchronous service listener
+   * received an event yet.
+   *
+   * @return The service event delivery counters.
+   * @see Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY
+   */
+  ServiceEventDeliveryStats GetServiceEventDeliveryStats() const;
+
+  /**
+   * Returns the number of service listeners registered in this Framework,
+   * by the object class their filter is restricted to. A listener whose
+   * filter names several object classes is counted for each of them.
+   * Listeners which receive events for any object class, e.g. because they
+   * have no filter or their filter is too complex to be indexed, are
+   * counted under the empty string.
+   *
+   * @return The number of service listeners, by object class.
+   */
+  std::map<std::string, std::size_t> GetServiceListenerCounts() const;
+
+  /**
+   * Returns a snapshot of the performance counters.
+   *
+   * <p>
+   * Counters are only recorded if CppMicroServices was configured with
+   * the <code>US_ENABLE_PERF_COUNTERS</code> CMake option, otherwise the
+   * returned map is empty. The counters are shared by all frameworks of
+   * the process. The framework records
+   * - <code>bundle.install</code>: bundle installations and their duration.
+   * - <code>bundle.start</code>, <code>bundle.stop</code>: bundle
+   *   activations and deactivations and their duration.
+   * - <code>bundle.resource.extract</code>: resource extractions, their
+   *   duration and the extracted bytes as amount.
+   * - <code>ldap.evaluate</code>: LDAP filter evaluations.
+   * - <code>service.registry.lookup</code>: service reference lookups, their
+   *   duration and the number of references found as amount.
+   * - <code>service.listener.dispatch</code>: service events, the time
+   *   taken to dispatch them and the number of receiving listeners as
+   *   amount.
+   * - <code>service.listener.call</code>: service listener calls and their
+   *   duration.
+   *
+   * Other libraries, like Declarative Services, may add their own counters.
+   *
+   * @return The performance counters, by name.
+   * @see performance_counters_to_json
+   */
+  PerformanceCounters GetPerformanceCounters() const;
+
+  /**
+   * Reset all performance counters to zero.
+   *
+   * @see GetPerformanceCounters
+   */
+  void ResetPerformanceCounters();
+
+  /**
+   * Start a set of bundles concurrently.
+   *
+   * <p>
+   * Each bundle is started as if by calling Bundle::Start(uint32_t) with
+   * \c options, on one of up to \c threads threads. A bundle whose
+   * Constants::BUNDLE_DEPENDENCIES manifest header names other bundles of
+   * the set is started after these have been started. Otherwise, bundles
+   * are started in bundle id order, as threads become available.
+   *
+   * <p>
+   * Exceptions thrown when starting a bundle do not prevent the other
+   * bundles from being started; they are reported in the returned results.
+   *
+   * @param bundles The bundles to start.
+   * @param options The options passed to Bundle::Start(uint32_t).
+   * @param threads The maximum number of threads starting bundles. If zero,
+   *        the number of hardware threads is used.
+   * @return The outcome for each bundle, in the order of \c bundles.
+   * @throws std::invalid_argument If one of the bundles is invalid or not
+   *         installed in this Framework.
+   * @see StopBundles
+   */
+  std::vector<BundleOperationResult> StartBundles(
+    const std::vector<Bundle>& bundles,
+    uint32_t options = 0,
+    std::size_t threads = 0);
+
+  /**
+   * Stop a set of bundles concurrently.
+   *
+   * <p>
+   * Each bundle is stopped as if by calling Bundle::Stop(uint32_t) with
+   * \c options, on one of up to \c threads threads. A bundle named in the
+   * Constants::BUNDLE_DEPENDENCIES manifest header of other bundles of the
+   * set is stopped after these have been stopped. Otherwise, bundles are
+   * stopped in reverse bundle id order, as threads become available.
+   *
+   * @param bundles The bundles to stop.
+   * @param options The options passed to Bundle::Stop(uint32_t).
+   * @param threads The maximum number of threads stopping bundles. If zero,
+   *        the number of hardware threads is used.
+   * @return The outcome for each bundle, in the order of \c bundles.
+   * @throws std::invalid_argument If one of the bundles is invalid or not
+   *         installed in this Framework.
+   * @see StartBundles
+   * @see Constants::FRAMEWORK_SHUTDOWN_THREADS
+   */
+  std::vector<BundleOperationResult> StopBundles(
+    const std::vector<Bundle>& bundles,
+    uint32_t options = 0,
+    std::size_t threads = 0);
+
+  /**
+   * Returns the active start level of this Framework.
+   *
+   * <p>
+   * The active start level is 0 until the Framework is started, when it
+   * moves to Constants::FRAMEWORK_BEGINNING_STARTLEVEL, and 0 again once
+   * the Framework has been stopped.
+   *
+   * @return The active start level of this Framework.
+   * @see SetStartLevel
+   */
+  unsigned int GetStartLevel() const;
+
+  /**
+   * Modify the active start level of this Framework.
+   *
+   * <p>
+   * The start level is changed asynchronously, one level at a time, on a
+   * framework thread and this method returns immediately. When raising the
+   * start level, the bundles whose start level is reached and which are
+   * marked to be started (see Bundle::Start(uint32_t)) are started. When
+   * lowering it, the active bundles whose start level is above the new one
+   * are stopped transiently. The bundles of one start level are started or
+   * stopped concurrently by up to Constants::FRAMEWORK_STARTLEVEL_THREADS
+   * threads. Exceptions thrown by bundles are reported as
+   * FrameworkEvent::FRAMEWORK_ERROR events.
+   *
+   * <p>
+   * A FrameworkEvent::FRAMEWORK_STARTLEVEL_CHANGED event is fired once the
+   * requested start level has been reached. Requests are processed in the
+   * order they were made.
+   *
+   * <p>
+   * This allows the bundles needed first to be started with
+   * Constants::FRAMEWORK_BEGINNING_STARTLEVEL, before
+   * FrameworkEvent::FRAMEWORK_STARTED is fired, and the remaining bundles to
+   * be started in the background afterwards.
+   *
+   * @param startLevel The requested start level.
+   * @throws std::invalid_argument If \c startLevel is 0.
+   * @throws std::logic_error If this Framework is not active.
+   * @see GetStartLevel
+   */
+  void SetStartLevel(unsigned int startLevel);
+
+  /**
+   * Returns the start level of a bundle installed in this Framework.
+   *
+   * @param bundle The bundle.
+   * @return The start level of \c bundle, 0 for the system bundle.
+   * @throws std::invalid_argument If \c bundle is invalid or not installed
+   *         in this Framework.
+   * @see Constants::BUNDLE_STARTLEVEL
+   */
+  unsigned int GetBundleStartLevel(const Bundle& bundle) const;
+
+  /**
+   * Assign a start level to a bundle installed in this Framework.
+   *
+   * <p>
+   * If the bundle is marked to be started and the new start level is not
+   * above the active start level of this Framework, the bundle is started.
+   * If the bundle is active and the new start level is above the active
+   * start level, the bundle is stopped transiently. Both happen
+   * asynchronously, as described in SetStartLevel.
+   *
+   * <p>
+   * The start level is not persisted: the bundle gets the start level of
+   * its Constants::BUNDLE_STARTLEVEL manifest header when it is installed
+   * again.
+   *
+   * @param bundle The bundle.
+   * @param startLevel The new start level of \c bundle.
+   * @throws std::invalid_argument If \c startLevel is 0, or \c bundle is
+   *         invalid, the system bundle or not installed in this Framework.
+   */
+  void SetBundleStartLevel(const Bundle& bundle, unsigned int startLevel);
+
 private:
   // Framework instances are exclusively constructed by the FrameworkFactory class
   friend class FrameworkFactory;
@@ -86,6 +86,16 @@ public:
      */
     FRAMEWORK_ERROR = 0x00000002,
 
+    /**
+     * A Framework::SetStartLevel operation has completed.
+     *
+     * <p>
+     * This event is fired when the Framework has completed changing the
+     * active start level initiated by a call to Framework::SetStartLevel.
+     * The source of this event is the System Bundle.
+     */
+    FRAMEWORK_STARTLEVEL_CHANGED = 0x00000008,
+
     /**
      * A warning has occurred.
      *
@@ -186,6 +196,7 @@ public:
    * <ul>
    * <li>{@link #FRAMEWORK_STARTED}
    * <li>{@link #FRAMEWORK_ERROR}
+   * <li>{@link #FRAMEWORK_STARTLEVEL_CHANGED}
    * <li>{@link #FRAMEWORK_WARNING}
    * <li>{@link #FRAMEWORK_INFO}
    * <li>{@link #FRAMEWORK_STOPPED}
@@ -25,10 +25,13 @@
 
 #include <chrono>
 #include <map>
+#include <optional>
+#include <utility>
 
 #include "cppmicroservices/LDAPFilter.h"
 #include "cppmicroservices/ServiceReference.h"
 #include "cppmicroservices/ServiceTrackerCustomizer.h"
+#include "cppmicroservices/detail/QuiescentPtr.h"
 
 namespace cppmicroservices {
 
@@ -100,6 +103,21 @@ public:
   using TrackingMap =
     std::unordered_map<ServiceReference<S>, std::shared_ptr<TrackedParamType>>;
 
+  /**
+   * An immutable list of the services tracked by a
+   * <code>ServiceTracker</code>, see GetSnapshot().
+   */
+  struct TrackedSnapshot
+  {
+    /// The tracking count when the snapshot was taken, see GetTrackingCount().
+    int trackingCount;
+
+    /// The tracked services, the one with the highest ranking first.
+    std::vector<
+      std::pair<ServiceReference<S>, std::shared_ptr<TrackedParamType>>>
+      services;
+  };
+
   /**
    * Automatically closes the <code>ServiceTracker</code>
    */
@@ -274,7 +292,8 @@ public:
 
   /**
    * Return a list of <code>ServiceReference</code>s for all services being
-   * tracked by this <code>ServiceTracker</code>.
+   * tracked by this <code>ServiceTracker</code>, the one with the highest
+   * ranking first.
    *
    * @return A list of <code>ServiceReference</code> objects.
    */
@@ -316,13 +335,10 @@ public:
 
   /**
    * Return a list of service objects for all services being tracked by this
-   * <code>ServiceTracker</code>.
+   * <code>ServiceTracker</code>, the one with the highest ranking first.
    *
    * <p>
-   * This implementation calls GetServiceReferences() to get the list
-   * of references for the tracked services and then calls
-   * GetService(const ServiceReference&) for each reference to get the
-   * tracked service object.
+   * This implementation copies the service objects from GetSnapshot().
    *
    * @return A list of service objects or an empty list if no services
    *         are being tracked.
@@ -342,6 +358,69 @@ public:
    */
   virtual std::shared_ptr<TrackedParamType> GetService() const;
 
+  /**
+   * A scoped, non-owning handle to the service object returned by
+   * GetService().
+   *
+   * While the cached service of the tracker is valid, obtaining and using
+   * the handle neither takes a lock nor changes a reference count. The
+   * service object stays valid for as long as the handle exists, even if
+   * the service is removed from the tracker meanwhile.
+   *
+   * A handle must not outlive the tracker it was obtained from and should
+   * be released quickly: a replaced cache entry is freed by the tracker
+   * once the handles obtained before the replacement are released.
+   */
+  class BorrowedService
+  {
+  public:
+    BorrowedService(BorrowedService&&) noexcept = default;
+    BorrowedService& operator=(BorrowedService&&) = delete;
+
+    /// Returns the service object or <code>nullptr</code>.
+    TrackedParamType* Get() const noexcept { return service; }
+    TrackedParamType* operator->() const noexcept { return service; }
+    TrackedParamType& operator*() const noexcept { return *service; }
+    explicit operator bool() const noexcept { return service != nullptr; }
+
+  private:
+    friend class ServiceTracker<S, T>;
+
+    BorrowedService(detail::QuiescentReadGuard readGuard,
+                    TrackedParamType* borrowed) noexcept
+      : guard(std::move(readGuard))
+      , service(borrowed)
+    {}
+
+    explicit BorrowedService(std::shared_ptr<TrackedParamType> object) noexcept
+      : service(object.get())
+      , owned(std::move(object))
+    {}
+
+    std::optional<detail::QuiescentReadGuard> guard;
+    TrackedParamType* service;
+    /// set if the service was not borrowed from the cache
+    std::shared_ptr<TrackedParamType> owned;
+  };
+
+  /**
+   * Borrows the service object which GetService() returns, for the
+   * duration of a scope:
+   *
+   * \code
+   * if (auto service = tracker.Borrow()) {
+   *   service->DoSomething();
+   * }
+   * \endcode
+   *
+   * This is the cheapest way to access the tracked service repeatedly from
+   * many threads.
+   *
+   * @return A handle to the service object which is empty if no services
+   *         are being tracked.
+   */
+  BorrowedService Borrow() const;
+
   /**
    * Remove a service from this <code>ServiceTracker</code>.
    *
@@ -383,6 +462,22 @@ public:
    */
   virtual int GetTrackingCount() const;
 
+  /**
+   * Returns the services being tracked by this <code>ServiceTracker</code>
+   * together with the tracking count at which they were collected.
+   *
+   * <p>
+   * The snapshot is built once after the tracked services change and then
+   * shared by all callers, so calling this method repeatedly neither
+   * allocates nor waits for the tracker's lock. Compare
+   * <code>trackingCount</code> with a previously collected value, or the
+   * returned pointers, to detect changes.
+   *
+   * @return The tracked services. The snapshot is empty and its tracking
+   *         count is -1 if this <code>ServiceTracker</code> is not open.
+   */
+  std::shared_ptr<const TrackedSnapshot> GetSnapshot() const;
+
   /**
    * Return a sorted map of the <code>ServiceReference</code>s and
    * service objects for all services being tracked by this
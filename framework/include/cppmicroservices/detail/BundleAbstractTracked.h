@@ -28,12 +28,15 @@
 #include "cppmicroservices/detail/WaitCondition.h"
 
 #include <atomic>
+#include <memory>
 #include <vector>
 
 namespace cppmicroservices {
 
 namespace detail {
 
+class LogSink;
+
 /**
  * This class is not intended to be used directly. It is exported to support
  * the CppMicroServices bundle system.
@@ -286,6 +289,9 @@ private:
 
   BundleContext bc;
 
+  /// The log sink of the framework of <code>bc</code>
+  std::shared_ptr<LogSink> sink;
+
   bool CustomizerAddingFinal(S item,
                              const std::shared_ptr<TrackedParamType>& custom);
 };
@@ -53,7 +53,7 @@ public:
   LogSink& operator=(const LogSink&) = delete;
   ~LogSink() = default;
 
-  bool Enabled() { return _enable; }
+  bool Enabled() const noexcept { return _enable; }
 
   void Log(const std::string& msg)
   {
@@ -109,12 +109,39 @@ private:
   LogSink& _sink;
 };
 
+/**
+ * Turns a log statement into a void expression, so that DIAG_LOG can be the
+ * second operand of a conditional operator. Its operator& binds more loosely
+ * than the operator<< calls of the statement.
+ */
+struct LogVoidify
+{
+  void operator&(const LogMsg&) const noexcept {}
+};
+
 } // namespace detail
 
 } // namespace cppmicroservices
 
 // Write a log line using a <code>LogSink</code> reference.
-#define DIAG_LOG(log_sink)                                                     \
-  cppmicroservices::detail::LogMsg(log_sink, __FILE__, __LINE__, __FUNCTION__)
+//
+// A disabled sink costs a single branch: neither the message nor the stream
+// arguments are evaluated. The sink expression is evaluated twice when the
+// sink is enabled. Without US_ENABLE_DIAG_LOG, log statements are compiled
+// out.
+#ifdef US_ENABLE_DIAG_LOG
+#  define DIAG_LOG(log_sink)                                                   \
+    !(log_sink).Enabled()                                                      \
+      ? (void)0                                                                \
+      : cppmicroservices::detail::LogVoidify() &                               \
+          cppmicroservices::detail::LogMsg(                                    \
+            log_sink, __FILE__, __LINE__, __FUNCTION__)
+#else
+#  define DIAG_LOG(log_sink)                                                   \
+    true ? (void)0                                                             \
+         : cppmicroservices::detail::LogVoidify() &                            \
+             cppmicroservices::detail::LogMsg(                                 \
+               log_sink, __FILE__, __LINE__, __FUNCTION__)
+#endif
 
 #endif // CPPMICROSERVICES_LOG_H
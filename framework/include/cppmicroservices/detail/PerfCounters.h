@@ -0,0 +1,165 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_PERFCOUNTERS_H
+#define CPPMICROSERVICES_PERFCOUNTERS_H
+
+#include "cppmicroservices/FrameworkConfig.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace cppmicroservices {
+
+namespace detail {
+
+/**
+ * A named performance counter, shared by all frameworks of the process.
+ *
+ * Counters are updated with relaxed atomic operations: a snapshot of a
+ * counter which is being updated may be slightly inconsistent.
+ */
+class US_Framework_EXPORT PerfCounter
+{
+public:
+  explicit PerfCounter(std::string name);
+
+  PerfCounter(const PerfCounter&) = delete;
+  PerfCounter& operator=(const PerfCounter&) = delete;
+
+  const std::string& GetName() const { return name; }
+
+  /// Record one event, adding \c amount (bytes, listeners, ...).
+  void Add(std::uint64_t amount) noexcept
+  {
+    count.fetch_add(1, std::memory_order_relaxed);
+    if (amount != 0) {
+      this->amount.fetch_add(amount, std::memory_order_relaxed);
+    }
+  }
+
+  /// Record one event which took \c duration.
+  void Add(std::uint64_t amount, std::chrono::nanoseconds duration) noexcept
+  {
+    Add(amount);
+    const auto ns = static_cast<std::uint64_t>(duration.count());
+    nanos.fetch_add(ns, std::memory_order_relaxed);
+    auto max = maxNanos.load(std::memory_order_relaxed);
+    while (ns > max && !maxNanos.compare_exchange_weak(
+                         max, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  void Reset() noexcept;
+
+  std::atomic<std::uint64_t> count;
+  std::atomic<std::uint64_t> amount;
+  std::atomic<std::uint64_t> nanos;
+  std::atomic<std::uint64_t> maxNanos;
+
+private:
+  const std::string name;
+};
+
+/**
+ * Returns the counter called \c name, creating it on first use. The
+ * counter lives until the process exits.
+ */
+US_Framework_EXPORT PerfCounter& GetPerfCounter(const char* name);
+
+/// Call \c fn for each counter created so far, in name order.
+US_Framework_EXPORT void ForEachPerfCounter(
+  const std::function<void(PerfCounter&)>& fn);
+
+/**
+ * Adds the time between its construction and destruction to a counter.
+ */
+class ScopedPerfTimer
+{
+public:
+  explicit ScopedPerfTimer(PerfCounter& counter)
+    : counter(counter)
+    , amount(0)
+    , start(std::chrono::steady_clock::now())
+  {}
+
+  ScopedPerfTimer(const ScopedPerfTimer&) = delete;
+  ScopedPerfTimer& operator=(const ScopedPerfTimer&) = delete;
+
+  ~ScopedPerfTimer()
+  {
+    counter.Add(amount, std::chrono::steady_clock::now() - start);
+  }
+
+  void SetAmount(std::uint64_t a) noexcept { amount = a; }
+
+private:
+  PerfCounter& counter;
+  std::uint64_t amount;
+  const std::chrono::steady_clock::time_point start;
+};
+
+} // namespace detail
+
+} // namespace cppmicroservices
+
+// The macros below compile to nothing unless US_ENABLE_PERF_COUNTERS is
+// defined. Arguments are not evaluated then. Each call site looks its counter
+// up once.
+#ifdef US_ENABLE_PERF_COUNTERS
+
+// Count one event called name, adding amount to the counter.
+#  define US_PERF_COUNT(name, amount)                                          \
+    do {                                                                       \
+      static ::cppmicroservices::detail::PerfCounter& us_perf_counter =        \
+        ::cppmicroservices::detail::GetPerfCounter(name);                      \
+      us_perf_counter.Add(amount);                                             \
+    } while (false)
+
+// Time the rest of the enclosing scope as one event called name. The
+// timer variable var can be passed to US_PERF_AMOUNT.
+#  define US_PERF_TIMER(var, name)                                             \
+    static ::cppmicroservices::detail::PerfCounter& var##_counter =            \
+      ::cppmicroservices::detail::GetPerfCounter(name);                        \
+    ::cppmicroservices::detail::ScopedPerfTimer var(var##_counter)
+
+// Set the amount the timer var adds to its counter.
+#  define US_PERF_AMOUNT(var, amount) var.SetAmount(amount)
+
+#else
+
+#  define US_PERF_COUNT(name, amount)                                          \
+    do {                                                                       \
+    } while (false)
+#  define US_PERF_TIMER(var, name)                                             \
+    do {                                                                       \
+    } while (false)
+#  define US_PERF_AMOUNT(var, amount)                                          \
+    do {                                                                       \
+    } while (false)
+
+#endif
+
+#endif // CPPMICROSERVICES_PERFCOUNTERS_H
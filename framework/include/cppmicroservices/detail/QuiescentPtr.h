@@ -0,0 +1,288 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef CPPMICROSERVICES_DETAIL_QUIESCENTPTR_H
+#define CPPMICROSERVICES_DETAIL_QUIESCENTPTR_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices {
+
+namespace detail {
+
+/**
+ * The reader slots of a QuiescentPtr.
+ *
+ * Readers count themselves in one of several slots, picked per thread, so
+ * that threads reading concurrently do not write to the same cache line.
+ * The slots come in two sets; readers use the set selected by the parity of
+ * the current epoch. A writer advances the epoch once the set of the other
+ * parity is empty. A value replaced in epoch \c e can only be in use by
+ * readers which entered before the epoch advanced to <code>e + 2</code>, so
+ * it is freed by the first writer which finds the epoch there. Readers
+ * never free anything.
+ */
+class QuiescentState
+{
+public:
+  static constexpr std::size_t SLOTS = 8;
+
+  QuiescentState()
+    : epoch(0)
+  {}
+
+  QuiescentState(const QuiescentState&) = delete;
+  QuiescentState& operator=(const QuiescentState&) = delete;
+
+  virtual ~QuiescentState() = default;
+
+protected:
+  /**
+   * Advances the epoch as far as the readers allow. Must be called with
+   * \c mutex held.
+   *
+   * @return The current epoch.
+   */
+  unsigned long Advance_unlocked() const
+  {
+    // two steps at most: the second one checks the readers of the current
+    // epoch
+    for (int i = 0; i < 2; ++i) {
+      const auto e = epoch.load();
+      if (!IsEmpty((e + 1) & 1)) {
+        break;
+      }
+      epoch.store(e + 1);
+    }
+    return epoch.load();
+  }
+
+  mutable std::atomic<unsigned long> epoch;
+  mutable std::mutex mutex; ///< serializes writers
+
+private:
+  friend class QuiescentReadGuard;
+
+  struct alignas(64) Slot
+  {
+    std::atomic<std::size_t> readers{ 0 };
+  };
+
+  /// Returns the slot index of the calling thread.
+  static std::size_t ThreadSlot() noexcept
+  {
+    static std::atomic<std::size_t> next{ 0 };
+    thread_local const std::size_t slot =
+      next.fetch_add(1, std::memory_order_relaxed) % SLOTS;
+    return slot;
+  }
+
+  std::atomic<std::size_t>* Enter() const noexcept
+  {
+    // Pairs with the writer, which replaces the value before it checks the
+    // slots: a reader it does not see loads the new value.
+    auto& slot = slots[epoch.load() & 1][ThreadSlot()];
+    slot.readers.fetch_add(1);
+    return &slot.readers;
+  }
+
+  bool IsEmpty(unsigned long parity) const noexcept
+  {
+    for (const auto& slot : slots[parity]) {
+      if (slot.readers.load() != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  mutable Slot slots[2][SLOTS];
+};
+
+/**
+ * Announces a reader of a QuiescentPtr for as long as it exists.
+ */
+class QuiescentReadGuard
+{
+public:
+  explicit QuiescentReadGuard(const QuiescentState* state) noexcept
+    : readers(state->Enter())
+  {}
+
+  QuiescentReadGuard(QuiescentReadGuard&& other) noexcept
+    : readers(other.readers)
+  {
+    other.readers = nullptr;
+  }
+
+  QuiescentReadGuard(const QuiescentReadGuard&) = delete;
+  QuiescentReadGuard& operator=(const QuiescentReadGuard&) = delete;
+  QuiescentReadGuard& operator=(QuiescentReadGuard&&) = delete;
+
+  ~QuiescentReadGuard()
+  {
+    if (readers) {
+      readers->fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+private:
+  std::atomic<std::size_t>* readers;
+};
+
+/**
+ * Publishes an immutable value which readers access without taking a lock
+ * and without touching a reference count.
+ *
+ * Readers announce themselves in a reader slot, load the current pointer
+ * and leave again when their ReadGuard is destroyed. Writers are
+ * serialized by a mutex. Replaced values are freed by later writers, or by
+ * Reclaim(), once the readers which may still use them have left; readers
+ * which keep overlapping do not hold them back, since new readers count
+ * themselves in the other set of slots. Until then a replaced value stays
+ * alive, so guards should be short-lived.
+ */
+template<class T>
+class QuiescentPtr final : public QuiescentState
+{
+public:
+  /**
+   * Keeps the value which was current on construction alive. Must not
+   * outlive the QuiescentPtr it was obtained from.
+   */
+  class ReadGuard : public QuiescentReadGuard
+  {
+  public:
+    explicit ReadGuard(const QuiescentPtr* ptr)
+      : QuiescentReadGuard(ptr)
+      , value(ptr->current.load())
+    {}
+
+    /// Returns the guarded value or nullptr if there was none.
+    const T* Get() const noexcept { return value; }
+
+  private:
+    const T* value;
+  };
+
+  QuiescentPtr()
+    : current(nullptr)
+  {}
+
+  ReadGuard Read() const { return ReadGuard(this); }
+
+  /// Replaces the current value, which may be null.
+  void Reset(std::unique_ptr<const T> value = nullptr)
+  {
+    std::vector<std::shared_ptr<const void>> freed;
+    {
+      std::lock_guard<std::mutex> l(mutex);
+      freed = Reset_unlocked(std::move(value));
+    }
+  }
+
+  /**
+   * Replaces the current value if \c pred returns \c true. \c pred is
+   * called while holding the writer lock, so a writer which changes the
+   * condition before calling Reset() cannot be overtaken.
+   *
+   * @return \c true if the value was replaced.
+   */
+  template<class Pred>
+  bool ResetIf(Pred&& pred, std::unique_ptr<const T> value)
+  {
+    std::vector<std::shared_ptr<const void>> freed;
+    {
+      std::lock_guard<std::mutex> l(mutex);
+      if (!pred()) {
+        return false;
+      }
+      freed = Reset_unlocked(std::move(value));
+    }
+    return true;
+  }
+
+  /**
+   * Frees the replaced values which no reader can use anymore. Takes the
+   * writer lock, unless there is nothing to free.
+   */
+  void Reclaim()
+  {
+    if (!hasRetired.load()) {
+      return;
+    }
+    std::vector<std::shared_ptr<const void>> freed;
+    {
+      std::lock_guard<std::mutex> l(mutex);
+      freed = TakeRetired_unlocked();
+    }
+  }
+
+private:
+  std::vector<std::shared_ptr<const void>> Reset_unlocked(
+    std::unique_ptr<const T> value)
+  {
+    current.store(value.get());
+    if (owned) {
+      retired.emplace_back(epoch.load(), std::move(owned));
+      hasRetired.store(true);
+    }
+    owned = std::move(value);
+    return TakeRetired_unlocked();
+  }
+
+  /// Takes the values which are free, to be destroyed outside the lock.
+  std::vector<std::shared_ptr<const void>> TakeRetired_unlocked()
+  {
+    std::vector<std::shared_ptr<const void>> taken;
+    if (retired.empty()) {
+      return taken;
+    }
+    const auto e = Advance_unlocked();
+    auto iter = retired.begin();
+    while (iter != retired.end() && iter->first + 2 <= e) {
+      taken.push_back(std::move(iter->second));
+      ++iter;
+    }
+    retired.erase(retired.begin(), iter);
+    hasRetired.store(!retired.empty());
+    return taken;
+  }
+
+  std::atomic<const T*> current;
+  std::atomic<bool> hasRetired{ false };
+
+  std::unique_ptr<const T> owned;
+  /// replaced values with the epoch they were replaced in, oldest first
+  std::vector<std::pair<unsigned long, std::shared_ptr<const void>>> retired;
+};
+
+} // namespace detail
+
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_DETAIL_QUIESCENTPTR_H
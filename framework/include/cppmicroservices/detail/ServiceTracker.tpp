@@ -27,6 +27,7 @@
 #include "cppmicroservices/detail/ServiceTrackerPrivate.h"
 #include "cppmicroservices/detail/TrackedService.h"
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 #include <string>
@@ -134,6 +135,7 @@ void ServiceTracker<S,T>::Open()
                                + e.what());
     }
     d->trackedService.Store(t);
+    d->snapshot.Store(nullptr); /* services of a previous Open() */
   }
   /* Call tracked outside of synchronized region */
   t->TrackInitial(); /* process the initial references */
@@ -161,7 +163,7 @@ void ServiceTracker<S,T>::Close()
       return;
     }
 
-    DIAG_LOG(*d->context.GetLogSink())
+    DIAG_LOG(*d->sink)
       << "ServiceTracker<S,TTT>::close:" << d->filter;
     outgoing->Close();
 
@@ -185,10 +187,9 @@ void ServiceTracker<S,T>::Close()
     outgoing->Untrack(ref, ServiceEvent());
   }
   
-  if (d->context.GetLogSink()->Enabled()) {
-    if (!d->cachedReference.Load().GetBundle() &&
-        d->cachedService.Load() == nullptr) {
-      DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::close[cached cleared]:"
+  if (d->sink->Enabled()) {
+    if (d->cached.Read().Get() == nullptr) {
+      DIAG_LOG(*d->sink) << "ServiceTracker<S,TTT>::close[cached cleared]:"
                     << d->filter;
     }
   }
@@ -254,14 +255,11 @@ std::vector<ServiceReference<S>>
 ServiceTracker<S,T>::GetServiceReferences() const
 {
   std::vector<ServiceReference<S>> refs;
-  auto t = d->Tracked();
-  if (!t)
-  { /* if ServiceTracker is not open */
-    return refs;
-  }
+  auto snapshot = GetSnapshot();
+  refs.reserve(snapshot->services.size());
+  for (auto& entry : snapshot->services)
   {
-    auto l = t->Lock(); US_UNUSED(l);
-    d->GetServiceReferences_unlocked(refs, t.get());
+    refs.push_back(entry.first);
   }
   return refs;
 }
@@ -270,14 +268,18 @@ template<class S, class T>
 ServiceReference<S>
 ServiceTracker<S,T>::GetServiceReference() const
 {
-  ServiceReference<S> reference = d->cachedReference.Load();
-  if (reference.GetBundle())
   {
-    DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::getServiceReference[cached]:"
-                  << d->filter;
-    return reference;
+    auto cached = d->cached.Read();
+    if (cached.Get())
+    {
+      DIAG_LOG(*d->sink) << "ServiceTracker<S,TTT>::getServiceReference[cached]:"
+                    << d->filter;
+      return cached.Get()->reference;
+    }
   }
-  DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::getServiceReference:" << d->filter;
+  DIAG_LOG(*d->sink) << "ServiceTracker<S,TTT>::getServiceReference:" << d->filter;
+  auto t = d->Tracked();
+  const int trackingCount = t ? t->GetTrackingCount() : -1;
   auto references = GetServiceReferences();
   std::size_t length = references.size();
   if (length == 0)
@@ -341,7 +343,7 @@ ServiceTracker<S,T>::GetServiceReference() const
     }
   }
 
-  d->cachedReference.Store(*selectedRef);
+  d->SetCached(t.get(), trackingCount, *selectedRef, nullptr);
   return *selectedRef;
 }
 
@@ -361,19 +363,11 @@ template<class S, class T>
 std::vector<std::shared_ptr<typename ServiceTracker<S,T>::TrackedParamType>> ServiceTracker<S,T>::GetServices() const
 {
   std::vector<std::shared_ptr<TrackedParamType>> services;
-  auto t = d->Tracked();
-  if (!t)
-  { /* if ServiceTracker is not open */
-    return services;
-  }
+  auto snapshot = GetSnapshot();
+  services.reserve(snapshot->services.size());
+  for (auto& entry : snapshot->services)
   {
-    auto l = t->Lock(); US_UNUSED(l);
-    std::vector<ServiceReference<S>> references;
-    d->GetServiceReferences_unlocked(references, t.get());
-    for(auto& ref : references)
-    {
-      services.push_back(t->GetCustomizedObject_unlocked(ref));
-    }
+    services.push_back(entry.second);
   }
   return services;
 }
@@ -382,15 +376,22 @@ template<class S, class T>
 std::shared_ptr<typename ServiceTracker<S,T>::TrackedParamType>
 ServiceTracker<S,T>::GetService() const
 {
-  auto service = d->cachedService.Load();
-  if (service)
   {
-    DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::getService[cached]:"
-                  << d->filter;
-    return service;
+    auto cached = d->cached.Read();
+    if (cached.Get() && cached.Get()->service)
+    {
+      DIAG_LOG(*d->sink) << "ServiceTracker<S,TTT>::getService[cached]:"
+                    << d->filter;
+      return cached.Get()->service;
+    }
   }
-  DIAG_LOG(*d->context.GetLogSink()) << "ServiceTracker<S,TTT>::getService:" << d->filter;
+  DIAG_LOG(*d->sink) << "ServiceTracker<S,TTT>::getService:" << d->filter;
+  // free cache entries replaced while handles were borrowed, which would
+  // otherwise wait for the next change of the tracked services
+  d->cached.Reclaim();
 
+  auto t = d->Tracked();
+  const int trackingCount = t ? t->GetTrackingCount() : -1;
   try
   {
     auto reference = GetServiceReference();
@@ -398,8 +399,11 @@ ServiceTracker<S,T>::GetService() const
     {
       return std::shared_ptr<TrackedParamType>();
     }
-    service = GetService(reference);
-    d->cachedService.Store(service);
+    auto service = GetService(reference);
+    if (service)
+    {
+      d->SetCached(t.get(), trackingCount, reference, service);
+    }
     return service;
   }
   catch (const ServiceException&)
@@ -408,6 +412,29 @@ ServiceTracker<S,T>::GetService() const
   }
 }
 
+template<class S, class T>
+typename ServiceTracker<S,T>::BorrowedService
+ServiceTracker<S,T>::Borrow() const
+{
+  {
+    auto cached = d->cached.Read();
+    if (cached.Get() && cached.Get()->service)
+    {
+      auto service = cached.Get()->service.get();
+      return BorrowedService(std::move(cached), service);
+    }
+  }
+  // Fill the cache and try again. If the tracked services changed in the
+  // meantime, hold on to the service object instead.
+  auto service = GetService();
+  auto cached = d->cached.Read();
+  if (service && cached.Get() && cached.Get()->service == service)
+  {
+    return BorrowedService(std::move(cached), service.get());
+  }
+  return BorrowedService(std::move(service));
+}
+
 template<class S, class T>
 void ServiceTracker<S,T>::Remove(const ServiceReference<S>& reference)
 {
@@ -438,7 +465,47 @@ int ServiceTracker<S,T>::GetTrackingCount() const
   { /* if ServiceTracker is not open */
     return -1;
   }
-  return (t->Lock(), t->GetTrackingCount());
+  return t->GetTrackingCount();
+}
+
+template<class S, class T>
+std::shared_ptr<const typename ServiceTracker<S,T>::TrackedSnapshot>
+ServiceTracker<S,T>::GetSnapshot() const
+{
+  auto snapshot = d->snapshot.Load();
+  if (snapshot)
+  {
+    return snapshot;
+  }
+
+  auto t = d->Tracked();
+  if (!t)
+  { /* if ServiceTracker is not open */
+    return std::make_shared<const TrackedSnapshot>(TrackedSnapshot{ -1, {} });
+  }
+
+  auto l = t->Lock(); US_UNUSED(l);
+  snapshot = d->snapshot.Load();
+  if (snapshot)
+  { /* built by another thread meanwhile */
+    return snapshot;
+  }
+  TrackingMap tracked;
+  t->CopyEntries_unlocked(tracked);
+  auto newSnapshot = std::make_shared<TrackedSnapshot>();
+  newSnapshot->trackingCount = t->GetTrackingCount();
+  newSnapshot->services.assign(tracked.begin(), tracked.end());
+  /* highest ranking first, the natural order of ServiceReference */
+  using Entry = typename decltype(newSnapshot->services)::value_type;
+  std::sort(newSnapshot->services.begin(),
+            newSnapshot->services.end(),
+            [](const Entry& a, const Entry& b) { return b.first < a.first; });
+  d->snapshot.Store(newSnapshot);
+  if (d->Tracked() != t)
+  { /* reopened meanwhile, do not publish the old services */
+    d->snapshot.Store(nullptr);
+  }
+  return newSnapshot;
 }
 
 template<class S, class T>
@@ -26,6 +26,8 @@
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/LDAPFilter.h"
 #include "cppmicroservices/ServiceReference.h"
+#include "cppmicroservices/detail/Log.h"
+#include "cppmicroservices/detail/QuiescentPtr.h"
 #include "cppmicroservices/detail/Threads.h"
 
 namespace cppmicroservices {
@@ -76,14 +78,23 @@ public:
     const std::string& className,
     const std::string& filterString);
 
-  void GetServiceReferences_unlocked(std::vector<ServiceReference<S>>& refs,
-                                     TrackedService<S, TTT>* t) const;
+  /**
+   * Returns the log sink of the framework of <code>context</code>, or an
+   * empty sink if <code>context</code> is no longer valid.
+   */
+  static std::shared_ptr<LogSink> GetLogSink(const BundleContext& context);
 
   /**
    * The Bundle Context used by this <code>ServiceTracker</code>.
    */
   BundleContext context;
 
+  /**
+   * The log sink of the framework of <code>context</code>, looked up once
+   * so that disabled diagnostics are cheap on hot paths.
+   */
+  std::shared_ptr<LogSink> sink;
+
   /**
    * The filter used by this <code>ServiceTracker</code> which specifies the
    * search criteria for the services to track.
@@ -147,14 +158,38 @@ public:
   void Modified();
 
   /**
-   * Cached ServiceReference for getServiceReference.
+   * The service selected by GetServiceReference and GetService. The
+   * service object is empty if only the reference has been selected.
+   */
+  struct CachedService
+  {
+    ServiceReference<S> reference;
+    std::shared_ptr<TrackedParamType> service;
+  };
+
+  /**
+   * Cached ServiceReference and service object for GetServiceReference and
+   * GetService, readable without locking.
+   */
+  mutable QuiescentPtr<CachedService> cached;
+
+  /**
+   * Cached snapshot of the tracked services, rebuilt by GetSnapshot after
+   * Modified() cleared it.
    */
-  mutable Atomic<ServiceReference<S>> cachedReference;
+  mutable Atomic<
+    std::shared_ptr<const typename ServiceTracker<S, T>::TrackedSnapshot>>
+    snapshot;
 
   /**
-   * Cached service object for GetService.
+   * Caches <code>reference</code> and <code>service</code> unless the
+   * services tracked by <code>t</code> changed since
+   * <code>trackingCount</code> was read.
    */
-  mutable Atomic<std::shared_ptr<TrackedParamType>> cachedService;
+  void SetCached(TrackedService<S, TTT>* t,
+                 int trackingCount,
+                 const ServiceReference<S>& reference,
+                 const std::shared_ptr<TrackedParamType>& service) const;
 
 private:
   inline ServiceTracker<S, T>* q_func()
@@ -41,8 +41,8 @@ ServiceTrackerPrivate<S,TTT>::ServiceTrackerPrivate(
     const ServiceReference<S>& reference,
     ServiceTrackerCustomizer<S,T>* customizer
     )
-  : context(std::move(context)), customizer(customizer), listenerToken(), trackReference(reference),
-    trackedService(), cachedReference(), cachedService(), q_ptr(st)
+  : context(std::move(context)), sink(GetLogSink(this->context)), customizer(customizer), listenerToken(), trackReference(reference),
+    trackedService(), cached(), snapshot(), q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   std::stringstream ss;
@@ -71,9 +71,8 @@ ServiceTrackerPrivate<S,TTT>::ServiceTrackerPrivate(
     const std::string& clazz,
     ServiceTrackerCustomizer<S,T>* customizer
     )
-  : context(std::move(context)), customizer(customizer), listenerToken(), trackClass(clazz),
-    trackReference(), trackedService(), cachedReference(),
-    cachedService(), q_ptr(st)
+  : context(std::move(context)), sink(GetLogSink(this->context)), customizer(customizer), listenerToken(), trackClass(clazz),
+    trackReference(), trackedService(), cached(), snapshot(), q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   this->listenerFilter = std::string("(") + cppmicroservices::Constants::OBJECTCLASS + "="
@@ -101,9 +100,9 @@ ServiceTrackerPrivate<S,TTT>::ServiceTrackerPrivate(
     const LDAPFilter& filter,
     ServiceTrackerCustomizer<S,T>* customizer
     )
-  : context(context), filter(filter), customizer(customizer),
+  : context(context), sink(GetLogSink(context)), filter(filter), customizer(customizer),
     listenerFilter(filter.ToString()), listenerToken(), trackReference(),
-    trackedService(), cachedReference(), cachedService(), q_ptr(st)
+    trackedService(), cached(), snapshot(), q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   if (!context)
@@ -116,6 +115,24 @@ template<class S, class TTT>
 ServiceTrackerPrivate<S,TTT>::~ServiceTrackerPrivate()
 = default;
 
+template<class S, class TTT>
+std::shared_ptr<LogSink> ServiceTrackerPrivate<S,TTT>::GetLogSink(
+  const BundleContext& context)
+{
+  try
+  {
+    if (context)
+    {
+      return context.GetLogSink();
+    }
+  }
+  catch (const std::exception&)
+  {
+    // the tracker cannot be opened with an invalid context anyway
+  }
+  return std::make_shared<LogSink>(nullptr);
+}
+
 template<class S, class TTT>
 std::vector<ServiceReference<S> > ServiceTrackerPrivate<S,TTT>::GetInitialReferences(
   const std::string& className, const std::string& filterString)
@@ -135,27 +152,36 @@ std::vector<ServiceReference<S> > ServiceTrackerPrivate<S,TTT>::GetInitialRefere
 }
 
 template<class S, class TTT>
-void ServiceTrackerPrivate<S,TTT>::GetServiceReferences_unlocked(std::vector<ServiceReference<S> >& refs, detail::TrackedService<S,TTT>* t) const
+std::shared_ptr<detail::TrackedService<S,TTT>> ServiceTrackerPrivate<S,TTT>::Tracked() const
 {
-  if (t->Size_unlocked() == 0)
-  {
-    return;
-  }
-  t->GetTracked_unlocked(refs);
+  return trackedService.Load();
 }
 
 template<class S, class TTT>
-std::shared_ptr<detail::TrackedService<S,TTT>> ServiceTrackerPrivate<S,TTT>::Tracked() const
+void ServiceTrackerPrivate<S,TTT>::Modified()
 {
-  return trackedService.Load();
+  cached.Reset(); /* clear cached value */
+  snapshot.Store(nullptr); /* clear cached value */
+  DIAG_LOG(*sink) << "ServiceTracker::Modified(): " << filter;
 }
 
 template<class S, class TTT>
-void ServiceTrackerPrivate<S,TTT>::Modified()
+void ServiceTrackerPrivate<S,TTT>::SetCached(
+  TrackedService<S,TTT>* t,
+  int trackingCount,
+  const ServiceReference<S>& reference,
+  const std::shared_ptr<TrackedParamType>& service) const
 {
-  cachedReference.Store(ServiceReference<S>()); /* clear cached value */
-  cachedService.Store(std::shared_ptr<TrackedParamType>()); /* clear cached value */
-  DIAG_LOG(*context.GetLogSink()) << "ServiceTracker::Modified(): " << filter;
+  if (!t)
+  { /* if ServiceTracker is not open */
+    return;
+  }
+  // TrackedService increments the tracking count before Modified() clears
+  // the cache, so a stale value is never published after the clear.
+  cached.ResetIf(
+    [t, trackingCount] { return t->GetTrackingCount() == trackingCount; },
+    std::unique_ptr<const CachedService>(
+      new CachedService{ reference, service }));
 }
 
 } // namespace detail
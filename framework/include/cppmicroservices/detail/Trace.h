@@ -0,0 +1,126 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_TRACE_H
+#define CPPMICROSERVICES_TRACE_H
+
+#include "cppmicroservices/FrameworkConfig.h"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace cppmicroservices {
+
+namespace detail {
+
+/**
+ * Writes trace events to a file, in the JSON array form of the Chrome
+ * trace event format. The file can be loaded in chrome://tracing or
+ * Perfetto.
+ */
+class US_Framework_EXPORT TraceSink
+{
+public:
+  /**
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit TraceSink(const std::string& path);
+
+  /// Terminates the JSON array and closes the file.
+  ~TraceSink();
+
+  TraceSink(const TraceSink&) = delete;
+  TraceSink& operator=(const TraceSink&) = delete;
+
+  /// Write a complete event. Write errors are ignored.
+  void Write(const char* category,
+             const std::string& name,
+             std::chrono::steady_clock::time_point start,
+             std::chrono::steady_clock::time_point end) noexcept;
+
+private:
+  std::mutex mutex;
+  std::ofstream out;
+  const std::chrono::steady_clock::time_point origin;
+  bool empty;
+};
+
+/// Returns the active trace sink, or nullptr if tracing is off.
+US_Framework_EXPORT std::shared_ptr<TraceSink> GetTraceSink() noexcept;
+
+/**
+ * Make \c sink the active trace sink of the process, or turn tracing off
+ * if \c sink is nullptr.
+ */
+US_Framework_EXPORT void SetTraceSink(std::shared_ptr<TraceSink> sink) noexcept;
+
+/**
+ * Traces its lifetime as one event, if tracing is on when it is created.
+ */
+class ScopedTrace
+{
+public:
+  explicit ScopedTrace(const char* category)
+    : category(category)
+    , sink(GetTraceSink())
+  {
+    if (sink) {
+      start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ScopedTrace(const ScopedTrace&) = delete;
+  ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+  ~ScopedTrace()
+  {
+    if (sink) {
+      sink->Write(category, name, start, std::chrono::steady_clock::now());
+    }
+  }
+
+  explicit operator bool() const noexcept { return sink != nullptr; }
+
+  void SetName(std::string n) { name = std::move(n); }
+
+private:
+  const char* const category;
+  const std::shared_ptr<TraceSink> sink;
+  std::chrono::steady_clock::time_point start;
+  std::string name;
+};
+
+} // namespace detail
+
+} // namespace cppmicroservices
+
+// Trace the rest of the enclosing block as an event of the given category.
+// The name expression is only evaluated if tracing is on.
+#define US_TRACE_SCOPE(var, category, name)                                    \
+  ::cppmicroservices::detail::ScopedTrace var(category);                       \
+  if (var)                                                                     \
+  var.SetName(name)
+
+#endif // CPPMICROSERVICES_TRACE_H
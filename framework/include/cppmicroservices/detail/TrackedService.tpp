@@ -67,7 +67,7 @@ void TrackedService<S,TTT>::ServiceChanged(const ServiceEvent& event)
 
     reference = event.GetServiceReference<S>();
 
-    DIAG_LOG(*serviceTracker->d->context.GetLogSink())
+    DIAG_LOG(*serviceTracker->d->sink)
       << "TrackedService::ServiceChanged[" << event.GetType()
       << "]: " << reference;
     if (!reference) {
@@ -322,6 +322,9 @@ void* Bundle::GetSymbol(void* handle, const std::string& symname) const
       "Error : Either bundle or inputs supplied are invalid!");
   }
 
+  // Looking up a symbol activates a bundle waiting for its lazy activation
+  d->TriggerLazyActivation();
+
   if (STATE_ACTIVE != GetState()) {
     throw std::runtime_error("Bundle is not started and active!");
   }
@@ -31,6 +31,7 @@
 #include "BundlePrivate.h"
 #include "BundleRegistry.h"
 #include "CoreBundleContext.h"
+#include "ServiceHolder.h"
 #include "ServiceReferenceBasePrivate.h"
 #include "ServiceRegistry.h"
 
@@ -51,6 +52,26 @@ std::shared_ptr<BundlePrivate> GetAndCheckBundlePrivate(
 
   return b;
 }
+
+// Resolve the interned id of clazz, using and filling the id cached by
+// the template lookups. Returns false if clazz has never been interned,
+// in which case nothing was ever registered under it. Interned ids never
+// change, so the cache needs no ordering beyond its own atomicity.
+bool ResolveInterfaceId(const std::string& clazz,
+                        std::atomic<std::uint32_t>& cache,
+                        std::uint32_t unresolved,
+                        InterfaceId& id)
+{
+  id = cache.load(std::memory_order_relaxed);
+  if (id != unresolved) {
+    return true;
+  }
+  if (!FindInterfaceId(clazz, id)) {
+    return false;
+  }
+  cache.store(id, std::memory_order_relaxed);
+  return true;
+}
 }
 
 BundleContext::BundleContext(std::shared_ptr<BundleContextPrivate> ctx)
@@ -225,48 +246,43 @@ ServiceReferenceU BundleContext::GetServiceReference(const std::string& clazz)
   return b->coreCtx->services.Get(b.get(), clazz);
 }
 
-/* @brief Private helper struct used to facilitate the shared_ptr aliasing constructor
- *        in BundleContext::GetService method. The aliasing constructor helps automate
- *        the call to UngetService method.
- *
- *        Service consumers can simply call GetService to obtain a shared_ptr to the
- *        service object and not worry about calling UngetService when they are done.
- *        The UngetService is called when all instances of the returned shared_ptr object
- *        go out of scope.
- */
-template<class S>
-struct ServiceHolder
-{
-  const std::weak_ptr<BundlePrivate> b;
-  const ServiceReferenceBase sref;
-  const std::shared_ptr<S> service;
-
-  ServiceHolder(const std::shared_ptr<BundlePrivate>& b,
-                const ServiceReferenceBase& sr,
-                std::shared_ptr<S> s)
-    : b(b)
-    , sref(sr)
-    , service(std::move(s))
-  {}
-
-  ~ServiceHolder()
-  {
-    try {
-      sref.d.load()->UngetService(b.lock(), true);
-    } catch (...) {
-      // Make sure that we don't crash if the shared_ptr service object outlives
-      // the BundlePrivate or CoreBundleContext objects.
-      if (!b.expired()) {
-        DIAG_LOG(*b.lock()->coreCtx->sink)
-          << "UngetService threw an exception. " << util::GetLastExceptionStr();
-      }
-      // don't throw exceptions from the destructor. For an explanation, see:
-      // https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md
-      // Following this rule means that a FrameworkEvent isn't an option here
-      // since it contains an exception object which clients could throw.
-    }
+std::vector<ServiceReferenceU> BundleContext::GetServiceReferences(
+  const std::string& clazz,
+  const std::string& filter,
+  std::atomic<std::uint32_t>& interfaceId)
+{
+  if (!d) {
+    throw std::runtime_error("The bundle context is no longer valid");
+  }
+
+  d->CheckValid();
+  auto b = GetAndCheckBundlePrivate(d);
+
+  std::vector<ServiceReferenceBase> refs;
+  InterfaceId id;
+  if (ResolveInterfaceId(clazz, interfaceId, UNRESOLVED_INTERFACE_ID, id)) {
+    b->coreCtx->services.Get(id, clazz, filter, b.get(), refs);
+  }
+  return std::vector<ServiceReferenceU>(refs.begin(), refs.end());
+}
+
+ServiceReferenceU BundleContext::GetServiceReference(
+  const std::string& clazz,
+  std::atomic<std::uint32_t>& interfaceId)
+{
+  if (!d) {
+    throw std::runtime_error("The bundle context is no longer valid");
+  }
+
+  d->CheckValid();
+  auto b = GetAndCheckBundlePrivate(d);
+
+  InterfaceId id;
+  if (!ResolveInterfaceId(clazz, interfaceId, UNRESOLVED_INTERFACE_ID, id)) {
+    return ServiceReferenceBase();
   }
-};
+  return b->coreCtx->services.Get(b.get(), id, clazz);
+}
 
 std::shared_ptr<void> BundleContext::GetService(
   const ServiceReferenceBase& reference)
@@ -283,8 +299,21 @@ std::shared_ptr<void> BundleContext::GetService(
   d->CheckValid();
   auto b = GetAndCheckBundlePrivate(d);
 
-  std::shared_ptr<ServiceHolder<void>> h(new ServiceHolder<void>(
-    b, reference, reference.d.load()->GetService(b.get())));
+  // Services registered without a ServiceFactory share one holder per bundle,
+  // so getting a service which is already in use neither allocates nor locks
+  // the registration.
+  auto refPrivate = reference.d.load();
+  std::shared_ptr<SingletonServiceHolder> singleton;
+  if (refPrivate->GetSingletonService(b, singleton)) {
+    if (!singleton) {
+      return nullptr;
+    }
+    return std::shared_ptr<void>(
+      singleton, refPrivate->GetSingletonInterface(singleton->service));
+  }
+
+  std::shared_ptr<ServiceHolder<void>> h(
+    new ServiceHolder<void>(b, reference, refPrivate->GetService(b.get())));
   return std::shared_ptr<void>(h, h->service.get());
 }
 
@@ -303,6 +332,14 @@ InterfaceMapConstPtr BundleContext::GetService(
   d->CheckValid();
   auto b = GetAndCheckBundlePrivate(d);
 
+  std::shared_ptr<SingletonServiceHolder> singleton;
+  if (reference.d.load()->GetSingletonService(b, singleton)) {
+    if (!singleton) {
+      return nullptr;
+    }
+    return InterfaceMapConstPtr(singleton, singleton->service.get());
+  }
+
   auto serviceInterfaceMap =
     reference.d.load()->GetServiceInterfaceMap(b.get());
   std::shared_ptr<ServiceHolder<const InterfaceMap>> h(
@@ -323,6 +360,21 @@ ListenerToken BundleContext::AddServiceListener(const ServiceListener& delegate,
   return b->coreCtx->listeners.AddServiceListener(d, delegate, nullptr, filter);
 }
 
+ListenerToken BundleContext::AddAsyncServiceListener(
+  const ServiceListener& delegate,
+  const std::string& filter)
+{
+  if (!d) {
+    throw std::runtime_error("The bundle context is no longer valid");
+  }
+
+  d->CheckValid();
+  auto b = GetAndCheckBundlePrivate(d);
+
+  return b->coreCtx->listeners.AddServiceListener(
+    d, delegate, nullptr, filter, true);
+}
+
 void BundleContext::RemoveServiceListener(const ServiceListener& delegate)
 {
   if (!d) {
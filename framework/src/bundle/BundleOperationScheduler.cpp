@@ -0,0 +1,235 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "BundleOperationScheduler.h"
+
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/detail/Threads.h"
+#include "cppmicroservices/detail/WaitCondition.h"
+
+#include "BundlePrivate.h"
+
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+namespace cppmicroservices {
+
+namespace {
+
+std::vector<std::string> GetDependencies(const BundlePrivate& b)
+{
+  std::vector<std::string> names;
+  const auto& headers = b.GetHeaders();
+  auto iter = headers.find(Constants::BUNDLE_DEPENDENCIES);
+  if (iter == headers.end()) {
+    return names;
+  }
+  if (iter->second.Type() == typeid(std::string)) {
+    names.push_back(ref_any_cast<std::string>(iter->second));
+  } else if (iter->second.Type() == typeid(std::vector<Any>)) {
+    for (const auto& name : ref_any_cast<std::vector<Any>>(iter->second)) {
+      if (name.Type() == typeid(std::string)) {
+        names.push_back(ref_any_cast<std::string>(name));
+      }
+    }
+  }
+  return names;
+}
+
+class BundleOperationScheduler
+  : public detail::MultiThreaded<detail::MutexLockingStrategy<>,
+                                 detail::WaitCondition>
+{
+public:
+  BundleOperationScheduler(
+    const std::vector<std::shared_ptr<BundlePrivate>>& bundles,
+    const std::function<void(BundlePrivate&)>& operation,
+    bool reverse)
+    : bundles(bundles)
+    , operation(operation)
+    , waitCount(bundles.size(), 0)
+    , dependents(bundles.size())
+    , done(bundles.size(), false)
+    , order{ reverse }
+    , ready(order)
+    , remaining(bundles.size())
+    , running(0)
+    , results(bundles.size())
+  {
+    std::unordered_map<std::string, std::vector<std::size_t>> bySymbolicName;
+    for (std::size_t i = 0; i < bundles.size(); ++i) {
+      bySymbolicName[bundles[i]->symbolicName].push_back(i);
+      results[i].bundle = MakeBundle(bundles[i]);
+    }
+
+    for (std::size_t i = 0; i < bundles.size(); ++i) {
+      for (const auto& name : GetDependencies(*bundles[i])) {
+        auto iter = bySymbolicName.find(name);
+        if (iter == bySymbolicName.end()) {
+          continue;
+        }
+        for (auto j : iter->second) {
+          if (j == i) {
+            continue;
+          }
+          // when stopping, the dependency waits for the dependent
+          auto waiting = reverse ? j : i;
+          auto waitedFor = reverse ? i : j;
+          dependents[waitedFor].push_back(waiting);
+          ++waitCount[waiting];
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < bundles.size(); ++i) {
+      if (waitCount[i] == 0) {
+        ready.push(i);
+      }
+    }
+  }
+
+  /**
+   * Operate on bundles until all are done.
+   */
+  void Run()
+  {
+    auto l = this->Lock();
+    while (true) {
+      this->Wait(
+        l, [this] { return remaining == 0 || !ready.empty() || Stalled(); });
+      if (remaining == 0) {
+        return;
+      }
+      if (ready.empty()) {
+        BreakCycle();
+      }
+
+      auto i = ready.top();
+      ready.pop();
+      ++running;
+      l.UnLock();
+
+      auto begin = std::chrono::steady_clock::now();
+      try {
+        operation(*bundles[i]);
+      } catch (...) {
+        results[i].exception = std::current_exception();
+      }
+      results[i].duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - begin);
+
+      l.Lock();
+      --running;
+      --remaining;
+      done[i] = true;
+      for (auto d : dependents[i]) {
+        // a bundle released by BreakCycle does not wait anymore
+        if (waitCount[d] > 0 && --waitCount[d] == 0) {
+          ready.push(d);
+        }
+      }
+      this->NotifyAll();
+    }
+  }
+
+  std::vector<BundleOperationResult> TakeResults()
+  {
+    return std::move(results);
+  }
+
+private:
+  struct Order
+  {
+    bool reverse;
+
+    // std::priority_queue pops the greatest element first
+    bool operator()(std::size_t a, std::size_t b) const
+    {
+      return reverse ? a < b : a > b;
+    }
+  };
+
+  /**
+   * Nothing is ready and nothing is running, but bundles remain: they wait
+   * for each other.
+   */
+  bool Stalled() const { return running == 0 && remaining > 0; }
+
+  void BreakCycle()
+  {
+    std::size_t next = bundles.size();
+    for (std::size_t i = 0; i < bundles.size(); ++i) {
+      if (!done[i] && waitCount[i] > 0 &&
+          (next == bundles.size() || order(next, i))) {
+        next = i;
+      }
+    }
+    waitCount[next] = 0;
+    ready.push(next);
+  }
+
+  const std::vector<std::shared_ptr<BundlePrivate>>& bundles;
+  const std::function<void(BundlePrivate&)>& operation;
+
+  std::vector<std::size_t> waitCount;
+  std::vector<std::vector<std::size_t>> dependents;
+  std::vector<bool> done;
+  const Order order;
+  std::priority_queue<std::size_t, std::vector<std::size_t>, Order> ready;
+  std::size_t remaining;
+  std::size_t running;
+
+  std::vector<BundleOperationResult> results;
+};
+}
+
+std::vector<BundleOperationResult> RunBundleOperations(
+  const std::vector<std::shared_ptr<BundlePrivate>>& bundles,
+  const std::function<void(BundlePrivate&)>& operation,
+  bool reverse,
+  std::size_t threads)
+{
+  BundleOperationScheduler scheduler(bundles, operation, reverse);
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+  threads = std::min(threads, bundles.size());
+  std::vector<std::thread> workers;
+  for (std::size_t i = 1; i < threads; ++i) {
+    workers.emplace_back([&scheduler] { scheduler.Run(); });
+  }
+  scheduler.Run();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+#else
+  US_UNUSED(threads);
+  scheduler.Run();
+#endif
+
+  return scheduler.TakeResults();
+}
+}
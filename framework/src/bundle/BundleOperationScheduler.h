@@ -0,0 +1,61 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CPPMICROSERVICES_BUNDLEOPERATIONSCHEDULER_H
+#define CPPMICROSERVICES_BUNDLEOPERATIONSCHEDULER_H
+
+#include "cppmicroservices/Framework.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace cppmicroservices {
+
+class BundlePrivate;
+
+/**
+ * Run an operation (starting or stopping) on a set of bundles, using up to
+ * \c threads threads.
+ *
+ * Bundles declaring dependencies in their Constants::BUNDLE_DEPENDENCIES
+ * manifest header are ordered after the bundles with those symbolic names,
+ * if these are part of the set: with \c reverse set to \c false, a bundle is
+ * only operated on once all bundles it depends on are done; with \c reverse
+ * set to \c true, once all bundles depending on it are done. Otherwise,
+ * bundles are operated on in the order of \c bundles (reversed if
+ * \c reverse is set). Dependency cycles are broken in the same order.
+ *
+ * With a single thread, all operations are run by the calling thread.
+ *
+ * @return The result of the operation for each bundle, in the order of
+ *         \c bundles.
+ */
+std::vector<BundleOperationResult> RunBundleOperations(
+  const std::vector<std::shared_ptr<BundlePrivate>>& bundles,
+  const std::function<void(BundlePrivate&)>& operation,
+  bool reverse,
+  std::size_t threads);
+}
+
+#endif // CPPMICROSERVICES_BUNDLEOPERATIONSCHEDULER_H
@@ -36,6 +36,8 @@
 #include "cppmicroservices/SecurityException.h"
 #include "cppmicroservices/ServiceRegistration.h"
 #include "cppmicroservices/SharedLibraryException.h"
+#include "cppmicroservices/detail/PerfCounters.h"
+#include "cppmicroservices/detail/Trace.h"
 
 #include "cppmicroservices/util/Error.h"
 #include "cppmicroservices/util/FileSystem.h"
@@ -98,7 +100,10 @@ void BundlePrivate::Stop(uint32_t options)
 
 std::exception_ptr BundlePrivate::Stop0()
 {
+  US_PERF_TIMER(timer, "bundle.stop");
+  US_TRACE_SCOPE(trace, "bundle", "stop " + symbolicName);
   wasStarted = state == Bundle::STATE_ACTIVE;
+  lazyActivationPending = false;
   state = Bundle::STATE_STOPPING;
   operation = OP_DEACTIVATING;
 
@@ -205,6 +210,7 @@ void BundlePrivate::SetStateInstalled(bool sendEvent)
     ctx->Invalidate();
   }
 
+  lazyActivationPending = false;
   state = Bundle::STATE_INSTALLED;
   if (sendEvent) {
     operation = OP_UNRESOLVING;
@@ -228,6 +234,7 @@ void BundlePrivate::FinalizeActivation()
     }
     // INTENTIONALLY FALLS THROUGH - in case of lazy activation.
     case Bundle::STATE_RESOLVED: {
+      lazyActivationPending = false;
       state = Bundle::STATE_STARTING;
       operation = OP_ACTIVATING;
 
@@ -377,10 +384,95 @@ void BundlePrivate::Start(uint32_t options)
     SetAutostartSetting(options);
   }
 
+  const auto activeLevel = coreCtx->startLevels.GetActiveStartLevel();
+  if (activeLevel != 0 && startLevel > activeLevel) {
+    if ((options & Bundle::START_TRANSIENT) != 0) {
+      throw std::runtime_error(
+        "Bundle #" + util::ToString(id) + " (location=" + location +
+        ") cannot be started transiently: its start level " +
+        util::ToString(startLevel.load()) +
+        " is above the active start level " + util::ToString(activeLevel));
+    }
+    // started once the framework reaches the bundle's start level
+    return;
+  }
+
+  if ((options & Bundle::START_ACTIVATION_POLICY) != 0 &&
+      HasLazyActivationPolicy()) {
+    StartLazily();
+    return;
+  }
+
   FinalizeActivation();
   return;
 }
 
+bool BundlePrivate::HasLazyActivationPolicy() const
+{
+  const auto& headers = GetHeaders();
+  auto policy = headers.find(Constants::BUNDLE_ACTIVATIONPOLICY);
+  return policy != headers.end() &&
+         policy->second.Type() == typeid(std::string) &&
+         ref_any_cast<std::string>(policy->second) ==
+           Constants::ACTIVATION_LAZY;
+}
+
+void BundlePrivate::StartLazily()
+{
+  switch (GetUpdatedState()) {
+    case Bundle::STATE_INSTALLED: {
+      std::rethrow_exception(resolveFailException);
+    }
+    case Bundle::STATE_RESOLVED: {
+      state = Bundle::STATE_STARTING;
+
+      std::shared_ptr<BundleContextPrivate> null_expected;
+      std::shared_ptr<BundleContextPrivate> ctx(new BundleContextPrivate(this));
+      bundleContext.CompareExchange(null_expected, ctx);
+
+      lazyActivationPending = true;
+      coreCtx->listeners.BundleChanged(
+        BundleEvent(BundleEvent::BUNDLE_LAZY_ACTIVATION,
+                    MakeBundle(this->shared_from_this())));
+      break;
+    }
+    case Bundle::STATE_STARTING:
+    case Bundle::STATE_ACTIVE:
+      // already waiting for activation, being activated or active
+      break;
+    case Bundle::STATE_STOPPING:
+      throw std::runtime_error("Bundle #" + util::ToString(id) +
+                               " (location=" + location +
+                               "), start called from BundleActivator::Stop");
+    case Bundle::STATE_UNINSTALLED:
+      throw std::logic_error("Bundle #" + util::ToString(id) + " (location=" +
+                             location + ") is in UNINSTALLED state");
+  }
+}
+
+void BundlePrivate::TriggerLazyActivation()
+{
+  if (!lazyActivationPending) {
+    return;
+  }
+
+  try {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    // the bundle may have been activated or stopped meanwhile
+    if (lazyActivationPending) {
+      FinalizeActivation();
+    }
+  } catch (...) {
+    coreCtx->listeners.SendFrameworkEvent(
+      FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                     MakeBundle(this->shared_from_this()),
+                     "Lazy activation of bundle #" + util::ToString(id) +
+                       " (location=" + location + ") failed",
+                     std::current_exception()));
+  }
+}
+
 const AnyMap& BundlePrivate::GetHeaders() const
 {
   return bundleManifest.GetHeaders();
@@ -388,6 +480,8 @@ const AnyMap& BundlePrivate::GetHeaders() const
 
 std::exception_ptr BundlePrivate::Start0()
 {
+  US_PERF_TIMER(timer, "bundle.start");
+  US_TRACE_SCOPE(trace, "bundle", "start " + symbolicName);
   // res is used to signal that start did not complete in a normal way
   std::exception_ptr res;
   auto const thisBundle = MakeBundle(this->shared_from_this());
@@ -587,6 +681,8 @@ BundlePrivate::BundlePrivate(CoreBundleContext* coreCtx)
   , destroyActivatorHook(nullptr)
   , bactivator(nullptr, nullptr)
   , operation(static_cast<uint8_t>(OP_IDLE))
+  , lazyActivationPending(false)
+  , startLevel(0)
   , resolveFailException()
   , wasStarted(false)
   , aborted(static_cast<uint8_t>(Aborted::NONE))
@@ -612,6 +708,8 @@ BundlePrivate::BundlePrivate(CoreBundleContext* coreCtx,
   , destroyActivatorHook(nullptr)
   , bactivator(nullptr, nullptr)
   , operation(OP_IDLE)
+  , lazyActivationPending(false)
+  , startLevel(1)
   , resolveFailException()
   , wasStarted(false)
   , aborted(static_cast<uint8_t>(Aborted::NONE))
@@ -671,6 +769,17 @@ BundlePrivate::BundlePrivate(CoreBundleContext* coreCtx,
     }
   }
 
+  if (bundleManifest.Contains(Constants::BUNDLE_STARTLEVEL)) {
+    Any levelAny = bundleManifest.GetValue(Constants::BUNDLE_STARTLEVEL);
+    if (levelAny.Type() != typeid(int) || ref_any_cast<int>(levelAny) < 1) {
+      throw std::invalid_argument(std::string("The Json value for ") +
+                                  Constants::BUNDLE_STARTLEVEL + " for bundle " +
+                                  symbolicName + " (location=" + location +
+                                  ") must be an integer greater than zero");
+    }
+    startLevel = static_cast<unsigned int>(ref_any_cast<int>(levelAny));
+  }
+
   if (!bundleManifest.Contains(Constants::BUNDLE_SYMBOLICNAME)) {
     throw std::invalid_argument(
       Constants::BUNDLE_SYMBOLICNAME +
@@ -145,6 +145,25 @@ public:
   // Performs the actual activation.
   void FinalizeActivation();
 
+  /**
+   * Check if the bundle declares the lazy activation policy in its
+   * manifest.
+   */
+  bool HasLazyActivationPolicy() const;
+
+  /**
+   * Move a resolved bundle with the lazy activation policy to the
+   * STATE_STARTING state, without loading its library or calling its
+   * activator.
+   */
+  void StartLazily();
+
+  /**
+   * Activate the bundle if it is waiting for its lazy activation to be
+   * triggered. Failures are reported as framework events.
+   */
+  void TriggerLazyActivation();
+
   virtual void Uninstall();
 
   virtual std::string GetLocation() const;
@@ -223,6 +242,17 @@ public:
   // like enums yet, so we use the underlying primitive type here.
   std::atomic<uint8_t> operation;
 
+  /**
+   * Set while the bundle waits in the STATE_STARTING state for its lazy
+   * activation to be triggered.
+   */
+  std::atomic<bool> lazyActivationPending;
+
+  /**
+   * The start level of the bundle, 0 for the system bundle.
+   */
+  std::atomic<unsigned int> startLevel;
+
   /** Saved exception of resolve failure. */
   std::exception_ptr resolveFailException;
 
@@ -27,6 +27,8 @@
 #include "cppmicroservices/BundleEvent.h"
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/GetBundleContext.h"
+#include "cppmicroservices/detail/PerfCounters.h"
+#include "cppmicroservices/detail/Trace.h"
 
 #include "cppmicroservices/util/Error.h"
 #include "cppmicroservices/util/String.h"
@@ -146,6 +148,8 @@ std::vector<Bundle> BundleRegistry::Install(
   using namespace std::chrono_literals;
 
   CheckIllegalState();
+  US_PERF_TIMER(timer, "bundle.install");
+  US_TRACE_SCOPE(trace, "bundle", "install " + location);
 
   // Grab the lock for the BundleRegistry object so that we can
   // read into the map without any data races
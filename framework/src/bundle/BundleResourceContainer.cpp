@@ -28,6 +28,7 @@
 #include "cppmicroservices/BundleResource.h"
 #include "cppmicroservices/GetBundleContext.h"
 #include "cppmicroservices/detail/Log.h"
+#include "cppmicroservices/detail/PerfCounters.h"
 
 #include <cassert>
 #include <climits>
@@ -137,8 +138,11 @@ std::unique_ptr<void, void (*)(void*)> BundleResourceContainer::GetData(
 {
   OpenAndInitializeContainer();
   std::unique_lock<std::mutex> l(m_ZipFileStreamMutex);
+  US_PERF_TIMER(timer, "bundle.resource.extract");
+  std::size_t size = 0;
   void* data = mz_zip_reader_extract_to_heap(
-    const_cast<mz_zip_archive*>(&m_ZipArchive), index, nullptr, 0);
+    const_cast<mz_zip_archive*>(&m_ZipArchive), index, &size, 0);
+  US_PERF_AMOUNT(timer, size);
   return { data, ::free };
 }
 
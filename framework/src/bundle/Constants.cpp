@@ -42,6 +42,8 @@ const std::string BUNDLE_SYMBOLICNAME = "bundle.symbolic_name";
 const std::string BUNDLE_MANIFESTVERSION = "bundle.manifest_version";
 const std::string BUNDLE_ACTIVATIONPOLICY = "bundle.activation_policy";
 const std::string ACTIVATION_LAZY = "lazy";
+const std::string BUNDLE_DEPENDENCIES = "bundle.dependencies";
+const std::string BUNDLE_STARTLEVEL = "bundle.start_level";
 const std::string FRAMEWORK_VERSION = "org.cppmicroservices.framework.version";
 const std::string FRAMEWORK_VENDOR = "org.cppmicroservices.framework.vendor";
 const std::string FRAMEWORK_STORAGE = "org.cppmicroservices.framework.storage";
@@ -53,6 +55,20 @@ const std::string FRAMEWORK_THREADING_SUPPORT =
 const std::string FRAMEWORK_THREADING_SINGLE = "single";
 const std::string FRAMEWORK_THREADING_MULTI = "multi";
 const std::string FRAMEWORK_LOG = "org.cppmicroservices.framework.log";
+const std::string FRAMEWORK_SERVICE_EVENT_DELIVERY =
+  "org.cppmicroservices.framework.service.event.delivery";
+const std::string FRAMEWORK_SERVICE_EVENT_DELIVERY_SYNC = "sync";
+const std::string FRAMEWORK_SERVICE_EVENT_DELIVERY_ASYNC = "async";
+const std::string FRAMEWORK_SERVICE_EVENT_DELIVERY_THREADS =
+  "org.cppmicroservices.framework.service.event.delivery.threads";
+const std::string FRAMEWORK_SHUTDOWN_THREADS =
+  "org.cppmicroservices.framework.shutdown.threads";
+const std::string FRAMEWORK_BEGINNING_STARTLEVEL =
+  "org.cppmicroservices.framework.startlevel.beginning";
+const std::string FRAMEWORK_STARTLEVEL_THREADS =
+  "org.cppmicroservices.framework.startlevel.threads";
+const std::string FRAMEWORK_TRACE_FILE =
+  "org.cppmicroservices.framework.trace.file";
 const std::string FRAMEWORK_UUID = "org.cppmicroservices.framework.uuid";
 const std::string FRAMEWORK_WORKING_DIR =
   "org.cppmicroservices.framework.working.dir";
@@ -98,6 +98,7 @@ CoreBundleContext::CoreBundleContext(
   , serviceHooks(this)
   , bundleHooks(this)
   , bundleRegistry(this)
+  , startLevels(this)
   , firstInit(true)
   , initCount(0)
   , libraryLoadOptions(0)
@@ -127,6 +128,15 @@ void CoreBundleContext::Init()
   DIAG_LOG(*sink) << "initializing";
   initCount++;
 
+  auto traceFileProp = frameworkProperties.find(Constants::FRAMEWORK_TRACE_FILE);
+  if (traceFileProp != frameworkProperties.end() &&
+      traceFileProp->second.Type() == typeid(std::string) &&
+      !ref_any_cast<std::string>(traceFileProp->second).empty()) {
+    traceSink = std::make_shared<detail::TraceSink>(
+      ref_any_cast<std::string>(traceFileProp->second));
+    detail::SetTraceSink(traceSink);
+  }
+
   auto storageCleanProp =
     frameworkProperties.find(Constants::FRAMEWORK_STORAGE_CLEAN);
   if (firstInit && storageCleanProp != frameworkProperties.end() &&
@@ -237,6 +247,14 @@ void CoreBundleContext::Uninit1()
 
   dataStorage.clear();
   storage->Close();
+
+  if (traceSink) {
+    // the file is completed once the last traced scope using it ends
+    if (detail::GetTraceSink() == traceSink) {
+      detail::SetTraceSink(nullptr);
+    }
+    traceSink.reset();
+  }
 }
 
 std::string CoreBundleContext::GetDataStorage(long id) const
@@ -45,6 +45,7 @@ as specified in the OSGi R4.2 specifications.
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/detail/Log.h"
 #include "cppmicroservices/detail/Threads.h"
+#include "cppmicroservices/detail/Trace.h"
 
 #include "BundleHooks.h"
 #include "BundleRegistry.h"
@@ -53,6 +54,7 @@ as specified in the OSGi R4.2 specifications.
 #include "ServiceHooks.h"
 #include "ServiceListeners.h"
 #include "ServiceRegistry.h"
+#include "StartLevelManager.h"
 
 #include <map>
 #include <ostream>
@@ -98,6 +100,11 @@ public:
   */
   std::shared_ptr<detail::LogSink> sink;
 
+  /**
+   * The trace sink created for Constants::FRAMEWORK_TRACE_FILE, if any.
+   */
+  std::shared_ptr<detail::TraceSink> traceSink;
+
   /**
    * A LogService for logging framework messages via
    * a default or user-provided LogService that are intended to be
@@ -145,6 +152,11 @@ public:
    */
   BundleRegistry bundleRegistry;
 
+  /**
+   * The active start level and the thread changing it.
+   */
+  StartLevelManager startLevels;
+
   bool firstInit;
 
   /**
@@ -0,0 +1,342 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "StartLevelManager.h"
+
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/FrameworkEvent.h"
+
+#include "BundleOperationScheduler.h"
+#include "BundlePrivate.h"
+#include "CoreBundleContext.h"
+#include "FrameworkPrivate.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace cppmicroservices {
+
+namespace {
+
+unsigned int GetPositiveIntProperty(const CoreBundleContext* coreCtx,
+                                    const std::string& key)
+{
+  auto iter = coreCtx->frameworkProperties.find(key);
+  if (iter != coreCtx->frameworkProperties.end() &&
+      iter->second.Type() == typeid(int) &&
+      ref_any_cast<int>(iter->second) > 0) {
+    return static_cast<unsigned int>(ref_any_cast<int>(iter->second));
+  }
+  return 1;
+}
+
+bool IsActive(const BundlePrivate& b)
+{
+  return ((Bundle::STATE_ACTIVE | Bundle::STATE_STARTING) & b.state) != 0;
+}
+
+void StartBundle(BundlePrivate& b)
+{
+  // Changing the start level must not change the autostart setting of a
+  // bundle
+  uint32_t options = Bundle::START_TRANSIENT;
+  if (Bundle::START_ACTIVATION_POLICY == b.GetAutostartSetting()) {
+    options |= Bundle::START_ACTIVATION_POLICY;
+  }
+  b.Start(options);
+}
+
+void StopBundle(BundlePrivate& b)
+{
+  if (IsActive(b)) {
+    b.Stop(Bundle::StopOptions::STOP_TRANSIENT);
+  }
+}
+}
+
+StartLevelManager::StartLevelManager(CoreBundleContext* coreCtx)
+  : coreCtx(coreCtx)
+  , activeLevel(0)
+  , closing(false)
+  , accepting(false)
+{}
+
+StartLevelManager::~StartLevelManager()
+{
+  {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    accepting = false;
+    requests.clear();
+  }
+  closing = true;
+  this->NotifyAll();
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+unsigned int StartLevelManager::GetActiveStartLevel() const
+{
+  return activeLevel;
+}
+
+void StartLevelManager::Open(
+  const std::vector<std::shared_ptr<BundlePrivate>>& bundles)
+{
+  std::thread t;
+  {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    if (!accepting && worker.get_id() != std::this_thread::get_id()) {
+      t.swap(worker);
+    }
+  }
+  // left over from a Close called by the worker thread
+  if (t.joinable()) {
+    t.join();
+  }
+
+  closing = false;
+  const auto beginningLevel = GetPositiveIntProperty(
+    coreCtx, Constants::FRAMEWORK_BEGINNING_STARTLEVEL);
+  for (auto level = activeLevel + 1; level <= beginningLevel; ++level) {
+    std::vector<std::shared_ptr<BundlePrivate>> levelBundles;
+    for (const auto& b : bundles) {
+      if (b->startLevel == level) {
+        levelBundles.push_back(b);
+      }
+    }
+    activeLevel = level;
+    StartLevel(std::move(levelBundles));
+  }
+
+  auto l = this->Lock();
+  US_UNUSED(l);
+  accepting = true;
+}
+
+void StartLevelManager::Close()
+{
+  std::thread t;
+  {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    accepting = false;
+    requests.clear();
+    // Closed from a bundle started or stopped by the worker thread: it
+    // returns once the current request is done, but cannot join itself. It
+    // is joined when the framework is launched again or destroyed.
+    if (worker.get_id() != std::this_thread::get_id()) {
+      t.swap(worker);
+    }
+  }
+  closing = true;
+  this->NotifyAll();
+
+  if (t.joinable()) {
+    t.join();
+  }
+
+  // Bundles which were started before the framework was launched may have a
+  // start level above the active one. They are stopped with the first level.
+  auto level = activeLevel.load();
+  for (const auto& b : coreCtx->bundleRegistry.GetActiveBundles()) {
+    level = std::max(level, b->startLevel.load());
+  }
+  const auto threads =
+    GetPositiveIntProperty(coreCtx, Constants::FRAMEWORK_SHUTDOWN_THREADS);
+  for (; level > 0; --level) {
+    StopLevel(level, threads);
+  }
+  activeLevel = 0;
+}
+
+void StartLevelManager::SetStartLevel(unsigned int level)
+{
+  if (level == 0) {
+    throw std::invalid_argument("The start level must be greater than zero");
+  }
+  Post([this, level] {
+    MoveTo(level);
+    if (!closing) {
+      coreCtx->listeners.SendFrameworkEvent(
+        FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_STARTLEVEL_CHANGED,
+                       MakeBundle(coreCtx->systemBundle->shared_from_this()),
+                       std::string()));
+    }
+  });
+}
+
+void StartLevelManager::SetBundleStartLevel(
+  const std::shared_ptr<BundlePrivate>& b,
+  unsigned int level)
+{
+  if (level == 0) {
+    throw std::invalid_argument("The start level must be greater than zero");
+  }
+  b->startLevel = level;
+  try {
+    Post([this, b] { UpdateBundle(b); });
+  } catch (const std::logic_error&) {
+    // the framework is not active, the bundle is started or stopped when
+    // the framework moves to its start level
+  }
+}
+
+void StartLevelManager::Post(std::function<void()> request)
+{
+  {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    if (!accepting) {
+      throw std::logic_error("The framework is not active");
+    }
+#ifdef US_ENABLE_THREADING_SUPPORT
+    requests.push_back(std::move(request));
+    if (!worker.joinable()) {
+      worker = std::thread([this] { Run(); });
+    }
+#endif
+  }
+#ifdef US_ENABLE_THREADING_SUPPORT
+  this->Notify();
+#else
+  request();
+#endif
+}
+
+void StartLevelManager::Run()
+{
+  auto l = this->Lock();
+  while (true) {
+    this->Wait(l, [this] { return !accepting || !requests.empty(); });
+    if (!accepting) {
+      return;
+    }
+    auto request = std::move(requests.front());
+    requests.pop_front();
+
+    l.UnLock();
+    request();
+    l.Lock();
+  }
+}
+
+void StartLevelManager::MoveTo(unsigned int level)
+{
+  while (!closing) {
+    const auto current = activeLevel.load();
+    if (current < level) {
+      std::vector<std::shared_ptr<BundlePrivate>> levelBundles;
+      for (const auto& b : coreCtx->bundleRegistry.GetBundles()) {
+        if (b->id != 0 && b->startLevel == current + 1 &&
+            b->GetAutostartSetting() != -1) {
+          levelBundles.push_back(b);
+        }
+      }
+      activeLevel = current + 1;
+      StartLevel(std::move(levelBundles));
+    } else if (current > level) {
+      StopLevel(
+        current,
+        GetPositiveIntProperty(coreCtx, Constants::FRAMEWORK_STARTLEVEL_THREADS));
+    } else {
+      break;
+    }
+  }
+}
+
+void StartLevelManager::StartLevel(
+  std::vector<std::shared_ptr<BundlePrivate>> bundles)
+{
+  bundles.erase(std::remove_if(bundles.begin(),
+                               bundles.end(),
+                               [](const std::shared_ptr<BundlePrivate>& b) {
+                                 return IsActive(*b);
+                               }),
+                bundles.end());
+  if (bundles.empty()) {
+    return;
+  }
+  RunReportingErrors(
+    bundles,
+    StartBundle,
+    false,
+    GetPositiveIntProperty(coreCtx, Constants::FRAMEWORK_STARTLEVEL_THREADS));
+}
+
+void StartLevelManager::StopLevel(unsigned int level, std::size_t threads)
+{
+  // Lower the active start level first, so that the bundles of this level
+  // are not started again meanwhile.
+  activeLevel = std::min(activeLevel.load(), level - 1);
+  std::vector<std::shared_ptr<BundlePrivate>> levelBundles;
+  for (const auto& b : coreCtx->bundleRegistry.GetActiveBundles()) {
+    if (b->startLevel >= level) {
+      levelBundles.push_back(b);
+    }
+  }
+  if (levelBundles.empty()) {
+    return;
+  }
+  RunReportingErrors(levelBundles, StopBundle, true, threads);
+}
+
+void StartLevelManager::UpdateBundle(const std::shared_ptr<BundlePrivate>& b)
+{
+  if (b->state == Bundle::STATE_UNINSTALLED) {
+    return;
+  }
+  if (b->startLevel <= activeLevel) {
+    if (!IsActive(*b) && b->GetAutostartSetting() != -1) {
+      RunReportingErrors({ b }, StartBundle, false, 1);
+    }
+  } else if (IsActive(*b)) {
+    RunReportingErrors({ b }, StopBundle, true, 1);
+  }
+}
+
+void StartLevelManager::RunReportingErrors(
+  const std::vector<std::shared_ptr<BundlePrivate>>& bundles,
+  void (*operation)(BundlePrivate&),
+  bool reverse,
+  std::size_t threads)
+{
+  // Errors are published as they occur, not once the whole level is done
+  RunBundleOperations(
+    bundles,
+    [this, operation](BundlePrivate& b) {
+      try {
+        operation(b);
+      } catch (...) {
+        coreCtx->listeners.SendFrameworkEvent(
+          FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                         MakeBundle(b.shared_from_this()),
+                         std::string(),
+                         std::current_exception()));
+      }
+    },
+    reverse,
+    threads);
+}
+}
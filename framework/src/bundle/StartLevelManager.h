@@ -0,0 +1,118 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_STARTLEVELMANAGER_H
+#define CPPMICROSERVICES_STARTLEVELMANAGER_H
+
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/detail/Threads.h"
+#include "cppmicroservices/detail/WaitCondition.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace cppmicroservices {
+
+class BundlePrivate;
+class CoreBundleContext;
+
+/**
+ * Keeps track of the active start level of the framework and moves it up or
+ * down, one level at a time, starting or stopping the bundles of each level
+ * with RunBundleOperations.
+ *
+ * Changes requested through the Framework API are run in order on a
+ * background thread, which is created on the first request. The launch and
+ * shutdown of the framework change the start level on the calling thread.
+ */
+class StartLevelManager
+  : private detail::MultiThreaded<detail::MutexLockingStrategy<>,
+                                  detail::WaitCondition>
+{
+public:
+  explicit StartLevelManager(CoreBundleContext* coreCtx);
+  ~StartLevelManager();
+
+  StartLevelManager(const StartLevelManager&) = delete;
+  StartLevelManager& operator=(const StartLevelManager&) = delete;
+
+  unsigned int GetActiveStartLevel() const;
+
+  /**
+   * Move from start level 0 to the beginning start level, starting the
+   * given bundles once their start level is reached. Afterwards, requests
+   * are accepted.
+   */
+  void Open(const std::vector<std::shared_ptr<BundlePrivate>>& bundles);
+
+  /**
+   * Discard pending requests, wait for the one in progress and move to
+   * start level 0, stopping all active bundles with up to
+   * Constants::FRAMEWORK_SHUTDOWN_THREADS threads. When called from the
+   * worker thread, the worker is joined by the next Open or the destructor.
+   */
+  void Close();
+
+  /**
+   * Request a change of the active start level.
+   *
+   * @throws std::logic_error If the framework is not active.
+   */
+  void SetStartLevel(unsigned int level);
+
+  /**
+   * Change the start level of a bundle and, if the framework is active,
+   * request the bundle to be started or stopped accordingly.
+   */
+  void SetBundleStartLevel(const std::shared_ptr<BundlePrivate>& b,
+                           unsigned int level);
+
+private:
+  void Post(std::function<void()> request);
+  void Run();
+
+  void MoveTo(unsigned int level);
+  void StartLevel(std::vector<std::shared_ptr<BundlePrivate>> bundles);
+  void StopLevel(unsigned int level, std::size_t threads);
+  void UpdateBundle(const std::shared_ptr<BundlePrivate>& b);
+  void RunReportingErrors(
+    const std::vector<std::shared_ptr<BundlePrivate>>& bundles,
+    void (*operation)(BundlePrivate&),
+    bool reverse,
+    std::size_t threads);
+
+  CoreBundleContext* const coreCtx;
+  std::atomic<unsigned int> activeLevel;
+  /// set while a level change is to be abandoned between two levels
+  std::atomic<bool> closing;
+
+  bool accepting;
+  std::deque<std::function<void()>> requests;
+  std::thread worker;
+};
+}
+
+#endif // CPPMICROSERVICES_STARTLEVELMANAGER_H
@@ -0,0 +1,170 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ServiceEventDispatcher.h"
+
+#include <algorithm>
+
+namespace cppmicroservices {
+
+ServiceEventDispatcher::ServiceEventDispatcher()
+  : stopped(false)
+  , dropped(false)
+  , queued(0)
+  , delivered(0)
+  , pending(0)
+  , maxPending(0)
+{}
+
+ServiceEventDispatcher::~ServiceEventDispatcher()
+{
+  // Only left with worker threads if Stop was called from a delivery. Each
+  // worker keeps the dispatcher alive, so this runs on the last worker to
+  // exit, after all the others have returned from Run.
+  for (auto& t : workers) {
+    if (t.get_id() == std::this_thread::get_id()) {
+      // the calling thread is exiting and does not touch the dispatcher again
+      t.detach();
+    } else {
+      t.join();
+    }
+  }
+}
+
+void ServiceEventDispatcher::Start(std::size_t threads)
+{
+  auto l = this->Lock();
+  US_UNUSED(l);
+  for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i) {
+    workers.emplace_back([self = shared_from_this()] { self->Run(); });
+  }
+}
+
+bool ServiceEventDispatcher::Post(const std::shared_ptr<Queue>& queue,
+                                  std::function<void()> delivery)
+{
+  {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    if (stopped) {
+      return false;
+    }
+    queue->deliveries.push_back(std::move(delivery));
+    if (!queue->scheduled) {
+      queue->scheduled = true;
+      ready.push_back(queue);
+    }
+
+    // Count the delivery before a worker can take it, so that pending
+    // never goes below zero. Only Post raises maxPending, and it does so
+    // with the lock held.
+    ++queued;
+    const auto backlog = ++pending;
+    if (backlog > maxPending.load(std::memory_order_relaxed)) {
+      maxPending.store(backlog, std::memory_order_relaxed);
+    }
+  }
+  this->Notify();
+  return true;
+}
+
+void ServiceEventDispatcher::Stop()
+{
+  std::vector<std::thread> threads;
+  {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    stopped = true;
+    const auto self = std::this_thread::get_id();
+    if (std::any_of(workers.begin(),
+                    workers.end(),
+                    [self](const std::thread& t) { return t.get_id() == self; })) {
+      // Stopped from a delivery, which may be tearing down whatever the
+      // remaining deliveries refer to: drop them instead of running them.
+      // A worker cannot join itself, so the threads are joined by a later
+      // call from another thread, or when the dispatcher is destroyed.
+      dropped = true;
+      for (auto& queue : ready) {
+        pending -= queue->deliveries.size();
+        queue->deliveries.clear();
+        queue->scheduled = false;
+      }
+      ready.clear();
+    } else {
+      threads.swap(workers);
+    }
+  }
+  this->NotifyAll();
+
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+ServiceEventDeliveryStats ServiceEventDispatcher::GetStats() const
+{
+  ServiceEventDeliveryStats stats;
+  stats.queued = queued;
+  stats.delivered = delivered;
+  stats.pending = pending;
+  stats.maxPending = maxPending;
+  return stats;
+}
+
+void ServiceEventDispatcher::Run()
+{
+  auto l = this->Lock();
+  while (true) {
+    this->Wait(l, [this] { return stopped || !ready.empty(); });
+    if (ready.empty()) {
+      // stopped, and all queues have been drained
+      return;
+    }
+
+    auto queue = ready.front();
+    ready.pop_front();
+    std::deque<std::function<void()>> deliveries;
+    deliveries.swap(queue->deliveries);
+
+    l.UnLock();
+    for (auto& delivery : deliveries) {
+      if (dropped) {
+        --pending;
+        continue;
+      }
+      delivery();
+      --pending;
+      ++delivered;
+    }
+    l.Lock();
+
+    // Deliveries posted meanwhile go to the back of the ready list, so one
+    // busy listener cannot starve the others.
+    if (queue->deliveries.empty()) {
+      queue->scheduled = false;
+    } else {
+      ready.push_back(queue);
+    }
+  }
+}
+}
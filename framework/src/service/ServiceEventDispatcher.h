@@ -0,0 +1,116 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CPPMICROSERVICES_SERVICEEVENTDISPATCHER_H
+#define CPPMICROSERVICES_SERVICEEVENTDISPATCHER_H
+
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/detail/Threads.h"
+#include "cppmicroservices/detail/WaitCondition.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace cppmicroservices {
+
+/**
+ * Runs the asynchronous deliveries of service events on a fixed set of
+ * worker threads.
+ *
+ * Each asynchronous service listener owns a Queue. Deliveries posted to the
+ * same queue run one at a time and in the order they were posted, so a
+ * listener sees the events of a service in the order they were fired.
+ * Deliveries posted to different queues run concurrently.
+ */
+class ServiceEventDispatcher
+  : public std::enable_shared_from_this<ServiceEventDispatcher>
+  , private detail::MultiThreaded<detail::MutexLockingStrategy<>,
+                                  detail::WaitCondition>
+{
+public:
+  /**
+   * The pending deliveries of a single listener. A queue is either idle,
+   * waiting in the ready list of the dispatcher or being drained by exactly
+   * one worker thread.
+   */
+  struct Queue
+  {
+    std::deque<std::function<void()>> deliveries;
+    bool scheduled = false;
+  };
+
+  ServiceEventDispatcher();
+  ~ServiceEventDispatcher();
+
+  ServiceEventDispatcher(const ServiceEventDispatcher&) = delete;
+  ServiceEventDispatcher& operator=(const ServiceEventDispatcher&) = delete;
+
+  /**
+   * Start the worker threads. Each of them keeps the dispatcher alive until
+   * it exits, so Stop must be called to release the dispatcher.
+   */
+  void Start(std::size_t threads);
+
+  /**
+   * Append a delivery to a queue.
+   *
+   * @return \c false if the dispatcher has been stopped, in which case the
+   *         delivery was not queued and the caller must run it itself.
+   */
+  bool Post(const std::shared_ptr<Queue>& queue,
+            std::function<void()> delivery);
+
+  /**
+   * Run the deliveries which are still queued and join the worker threads.
+   * Afterwards, Post always returns \c false. When called from a delivery,
+   * the deliveries which are still queued are dropped instead and the
+   * worker threads are left to a later call from another thread, or to the
+   * destructor.
+   */
+  void Stop();
+
+  ServiceEventDeliveryStats GetStats() const;
+
+private:
+  void Run();
+
+  bool stopped;
+  std::atomic<bool> dropped;
+  std::deque<std::shared_ptr<Queue>> ready;
+  std::vector<std::thread> workers;
+
+  // Raised by Post with the lock held; lowered by the workers as they
+  // finish deliveries. Atomic so that GetStats need not take the lock.
+  std::atomic<std::uint64_t> queued;
+  std::atomic<std::uint64_t> delivered;
+  std::atomic<std::uint64_t> pending;
+  std::atomic<std::uint64_t> maxPending;
+};
+}
+
+#endif // CPPMICROSERVICES_SERVICEEVENTDISPATCHER_H
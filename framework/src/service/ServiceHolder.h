@@ -0,0 +1,121 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_SERVICEHOLDER_H
+#define CPPMICROSERVICES_SERVICEHOLDER_H
+
+#include "cppmicroservices/ServiceReferenceBase.h"
+#include "cppmicroservices/detail/Log.h"
+#include "cppmicroservices/util/Error.h"
+
+#include "BundlePrivate.h"
+#include "CoreBundleContext.h"
+#include "ServiceReferenceBasePrivate.h"
+
+#include <memory>
+
+namespace cppmicroservices {
+
+/* @brief Private helper struct used to facilitate the shared_ptr aliasing constructor
+ *        in BundleContext::GetService method. The aliasing constructor helps automate
+ *        the call to UngetService method.
+ *
+ *        Service consumers can simply call GetService to obtain a shared_ptr to the
+ *        service object and not worry about calling UngetService when they are done.
+ *        The UngetService is called when all instances of the returned shared_ptr object
+ *        go out of scope.
+ */
+template<class S>
+struct ServiceHolder
+{
+  const std::weak_ptr<BundlePrivate> b;
+  const ServiceReferenceBase sref;
+  const std::shared_ptr<S> service;
+
+  ServiceHolder(const std::shared_ptr<BundlePrivate>& b,
+                const ServiceReferenceBase& sr,
+                std::shared_ptr<S> s)
+    : b(b)
+    , sref(sr)
+    , service(std::move(s))
+  {}
+
+  ~ServiceHolder()
+  {
+    try {
+      sref.d.load()->UngetService(b.lock(), true);
+    } catch (...) {
+      // Make sure that we don't crash if the shared_ptr service object outlives
+      // the BundlePrivate or CoreBundleContext objects.
+      if (!b.expired()) {
+        DIAG_LOG(*b.lock()->coreCtx->sink)
+          << "UngetService threw an exception. " << util::GetLastExceptionStr();
+      }
+      // don't throw exceptions from the destructor. For an explanation, see:
+      // https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md
+      // Following this rule means that a FrameworkEvent isn't an option here
+      // since it contains an exception object which clients could throw.
+    }
+  }
+};
+
+/* @brief Private helper struct shared by all service objects a bundle got from
+ *        BundleContext::GetService for a service which is not registered with a
+ *        service factory.
+ *
+ *        The service objects handed out alias the holder, and the registration
+ *        only keeps a weak reference to it. Handing out another service object
+ *        while the holder exists therefore neither allocates nor locks the
+ *        registration. The holder accounts for one use of the service in the
+ *        dependents of the registration, which it ungets when the last service
+ *        object is released; the next GetService call creates a new holder.
+ */
+struct SingletonServiceHolder
+{
+  const std::weak_ptr<BundlePrivate> b;
+  const ServiceReferenceBase sref;
+  const InterfaceMapConstPtr service;
+
+  SingletonServiceHolder(const std::shared_ptr<BundlePrivate>& b,
+                         const ServiceReferenceBase& sr,
+                         InterfaceMapConstPtr s)
+    : b(b)
+    , sref(sr)
+    , service(std::move(s))
+  {}
+
+  ~SingletonServiceHolder()
+  {
+    try {
+      sref.d.load()->UngetSingletonService(*this);
+    } catch (...) {
+      // see ~ServiceHolder
+      if (!b.expired()) {
+        DIAG_LOG(*b.lock()->coreCtx->sink)
+          << "UngetService threw an exception. " << util::GetLastExceptionStr();
+      }
+    }
+  }
+};
+}
+
+#endif // CPPMICROSERVICES_SERVICEHOLDER_H
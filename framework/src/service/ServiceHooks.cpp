@@ -22,6 +22,7 @@
 
 #include "ServiceHooks.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "cppmicroservices/Bundle.h"
@@ -34,14 +35,23 @@
 
 #include "BundleContextPrivate.h"
 #include "CoreBundleContext.h"
+#include "FrameworkPrivate.h"
 #include "ServiceReferenceBasePrivate.h"
 
 namespace cppmicroservices {
 
+ServiceHooks::HookCache::HookCache(const std::string& interfaceId)
+  : interfaceId(InternInterfaceId(interfaceId))
+  , version(0)
+  , size(0)
+{}
+
 ServiceHooks::ServiceHooks(CoreBundleContext* coreCtx)
   : coreCtx(coreCtx)
   , listenerHookTracker()
   , bOpen(false)
+  , findHooks(us_service_interface_iid<ServiceFindHook>())
+  , eventListenerHooks(us_service_interface_iid<ServiceEventListenerHook>())
 {}
 
 ServiceHooks::~ServiceHooks()
@@ -102,6 +112,18 @@ void ServiceHooks::Close()
     listenerHookTracker.reset();
   }
 
+  // Release the uses of the hook services which the snapshots hold.
+  for (auto cache : { &findHooks, &eventListenerHooks }) {
+    ++cache->version;
+    std::shared_ptr<const HookSnapshot> outdated;
+    cache->snapshot.Lock(), outdated.swap(cache->snapshot.value);
+    if (outdated) {
+      for (const auto& hook : outdated->hooks) {
+        hook.first.d.load()->UngetService(coreCtx->systemBundle, true);
+      }
+    }
+  }
+
   bOpen = false;
 }
 
@@ -110,40 +132,152 @@ bool ServiceHooks::IsOpen() const
   return bOpen;
 }
 
+void ServiceHooks::ServicesChanged_unlocked(
+  const std::vector<InterfaceId>& classes)
+{
+  for (auto cache : { &findHooks, &eventListenerHooks }) {
+    if (std::find(classes.begin(), classes.end(), cache->interfaceId) ==
+        classes.end()) {
+      continue;
+    }
+    auto iter = coreCtx->services.classServices.find(cache->interfaceId);
+    cache->size =
+      iter != coreCtx->services.classServices.end() ? iter->second.size() : 0;
+    ++cache->version;
+
+    // The next snapshot carries over the service objects of the hooks which
+    // are still registered, so that their use is only counted once. Drop
+    // the service objects of unregistered hooks right away, their bundles
+    // may be about to be stopped.
+    std::shared_ptr<const HookSnapshot> outdated;
+    cache->snapshot.Lock(), outdated = cache->snapshot.value;
+    if (!outdated) {
+      continue;
+    }
+    auto pruned = std::make_shared<HookSnapshot>();
+    pruned->version = outdated->version;
+    if (iter != coreCtx->services.classServices.end()) {
+      for (const auto& hook : outdated->hooks) {
+        if (std::any_of(iter->second.begin(),
+                        iter->second.end(),
+                        [&hook](const ServiceRegistrationBase& reg) {
+                          return reg.GetReference() == hook.first;
+                        })) {
+          pruned->hooks.push_back(hook);
+        }
+      }
+    }
+    auto l = cache->snapshot.Lock();
+    US_UNUSED(l);
+    if (cache->snapshot.value == outdated) {
+      cache->snapshot.value = std::move(pruned);
+    }
+  }
+}
+
+std::shared_ptr<const ServiceHooks::HookSnapshot> ServiceHooks::GetHookSnapshot(
+  HookCache& cache,
+  bool registryLocked)
+{
+  const auto version = cache.version.load();
+  std::shared_ptr<const HookSnapshot> previous;
+  {
+    auto l = cache.snapshot.Lock();
+    US_UNUSED(l);
+    if (cache.snapshot.value && cache.snapshot.value->version == version) {
+      return cache.snapshot.value;
+    }
+    previous = cache.snapshot.value;
+  }
+
+  std::vector<ServiceRegistrationBase> srl;
+  if (registryLocked) {
+    coreCtx->services.Get_unlocked(cache.interfaceId, srl);
+  } else {
+    coreCtx->services.Get(cache.interfaceId, srl);
+  }
+  std::sort(srl.begin(), srl.end());
+
+  // Each hook service is gotten once, when it first appears in a snapshot,
+  // and carried over from the previous snapshot after that.
+  auto snapshot = std::make_shared<HookSnapshot>();
+  snapshot->version = version;
+  snapshot->hooks.reserve(srl.size());
+  std::vector<ServiceReferenceBase> gotten;
+  for (auto srIter = srl.rbegin(), srEnd = srl.rend(); srIter != srEnd;
+       ++srIter) {
+    ServiceReferenceBase sr = srIter->GetReference();
+    std::shared_ptr<void> service;
+    if (previous) {
+      auto hook = std::find_if(
+        previous->hooks.begin(),
+        previous->hooks.end(),
+        [&sr](const HookSnapshot::Hook& h) { return h.first == sr; });
+      if (hook != previous->hooks.end()) {
+        service = hook->second;
+      }
+    }
+    if (!service) {
+      service = sr.d.load()->GetService(coreCtx->systemBundle.get());
+      if (service) {
+        gotten.push_back(sr);
+      }
+    }
+    if (service) {
+      snapshot->hooks.emplace_back(sr, std::move(service));
+    }
+  }
+
+  bool published = false;
+  {
+    auto l = cache.snapshot.Lock();
+    US_UNUSED(l);
+    if (cache.version == version &&
+        (!cache.snapshot.value || cache.snapshot.value->version != version)) {
+      cache.snapshot.value = snapshot;
+      published = true;
+    }
+  }
+  // A snapshot which is not cached is not carried over either, so give
+  // back the uses it added.
+  if (!published) {
+    for (const auto& sr : gotten) {
+      sr.d.load()->UngetService(coreCtx->systemBundle, true);
+    }
+  }
+  return snapshot;
+}
+
 void ServiceHooks::FilterServiceReferences(
   BundleContextPrivate* context,
   const std::string& service,
   const std::string& filter,
   std::vector<ServiceReferenceBase>& refs)
 {
-  std::vector<ServiceRegistrationBase> srl;
-  coreCtx->services.Get_unlocked(us_service_interface_iid<ServiceFindHook>(),
-                                 srl);
-  if (!srl.empty()) {
+  if (findHooks.size == 0) {
+    return;
+  }
+
+  auto snapshot = GetHookSnapshot(findHooks, true);
+  if (!snapshot->hooks.empty()) {
     ShrinkableVector<ServiceReferenceBase> filtered(refs);
 
-    auto selfBundle = GetBundleContext().GetBundle();
-    std::sort(srl.begin(), srl.end());
-    for (auto fhrIter = srl.rbegin(), fhrEnd = srl.rend(); fhrIter != fhrEnd;
-         ++fhrIter) {
-      ServiceReference<ServiceFindHook> sr = fhrIter->GetReference();
-      auto fh = std::static_pointer_cast<ServiceFindHook>(
-        sr.d.load()->GetService(GetPrivate(selfBundle).get()));
-      if (fh) {
-        try {
-          fh->Find(MakeBundleContext(context->shared_from_this()),
-                   service,
-                   filter,
-                   filtered);
-        } catch (...) {
-          std::string message("Failed to call find hook # " +
-                              sr.GetProperty(Constants::SERVICE_ID).ToString());
-          coreCtx->listeners.SendFrameworkEvent(
-            FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_WARNING,
-                           GetBundleContext().GetBundle(),
-                           message,
-                           std::current_exception()));
-        }
+    for (const auto& hook : snapshot->hooks) {
+      auto fh = std::static_pointer_cast<ServiceFindHook>(hook.second);
+      try {
+        fh->Find(MakeBundleContext(context->shared_from_this()),
+                 service,
+                 filter,
+                 filtered);
+      } catch (...) {
+        std::string message(
+          "Failed to call find hook # " +
+          hook.first.GetProperty(Constants::SERVICE_ID).ToString());
+        coreCtx->listeners.SendFrameworkEvent(
+          FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_WARNING,
+                         GetBundleContext().GetBundle(),
+                         message,
+                         std::current_exception()));
       }
     }
   }
@@ -153,11 +287,12 @@ void ServiceHooks::FilterServiceEventReceivers(
   const ServiceEvent& evt,
   ServiceListeners::ServiceListenerEntries& receivers)
 {
-  std::vector<ServiceRegistrationBase> eventListenerHooks;
-  coreCtx->services.Get(us_service_interface_iid<ServiceEventListenerHook>(),
-                        eventListenerHooks);
-  if (!eventListenerHooks.empty()) {
-    std::sort(eventListenerHooks.begin(), eventListenerHooks.end());
+  if (eventListenerHooks.size == 0) {
+    return;
+  }
+
+  auto snapshot = GetHookSnapshot(eventListenerHooks, false);
+  if (!snapshot->hooks.empty()) {
     std::map<BundleContext, std::vector<ServiceListenerHook::ListenerInfo>>
       listeners;
     for (auto& sle : receivers) {
@@ -176,26 +311,19 @@ void ServiceHooks::FilterServiceEventReceivers(
                   ShrinkableVector<ServiceListenerHook::ListenerInfo>>
       filtered(shrinkableListeners);
 
-    auto selfBundle = GetBundleContext().GetBundle();
-    for (auto sriIter = eventListenerHooks.rbegin(),
-              sriEnd = eventListenerHooks.rend();
-         sriIter != sriEnd;
-         ++sriIter) {
-      ServiceReference<ServiceEventListenerHook> sr = sriIter->GetReference();
-      auto elh = std::static_pointer_cast<ServiceEventListenerHook>(
-        sr.d.load()->GetService(GetPrivate(selfBundle).get()));
-      if (elh) {
-        try {
-          elh->Event(evt, filtered);
-        } catch (...) {
-          std::string message("Failed to call event hook  # " +
-                              sr.GetProperty(Constants::SERVICE_ID).ToString());
-          coreCtx->listeners.SendFrameworkEvent(
-            FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_WARNING,
-                           GetBundleContext().GetBundle(),
-                           message,
-                           std::current_exception()));
-        }
+    for (const auto& hook : snapshot->hooks) {
+      auto elh = std::static_pointer_cast<ServiceEventListenerHook>(hook.second);
+      try {
+        elh->Event(evt, filtered);
+      } catch (...) {
+        std::string message(
+          "Failed to call event hook  # " +
+          hook.first.GetProperty(Constants::SERVICE_ID).ToString());
+        coreCtx->listeners.SendFrameworkEvent(
+          FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_WARNING,
+                         GetBundleContext().GetBundle(),
+                         message,
+                         std::current_exception()));
       }
     }
     receivers.clear();
@@ -26,6 +26,7 @@
 #include "cppmicroservices/ServiceTracker.h"
 #include "cppmicroservices/detail/WaitCondition.h"
 
+#include "InterfaceId.h"
 #include "ServiceListeners.h"
 
 namespace cppmicroservices {
@@ -38,11 +39,55 @@ class ServiceHooks
 {
 
 private:
+  /**
+   * The hook services of one kind, sorted by ranking (highest first),
+   * together with the service objects they resolved to. The system bundle
+   * holds one use of each hook service in a cached snapshot.
+   */
+  struct HookSnapshot
+  {
+    using Hook = std::pair<ServiceReferenceBase, std::shared_ptr<void>>;
+
+    std::uint64_t version;
+    std::vector<Hook> hooks;
+  };
+
+  /**
+   * The cached snapshot of the hook services of one kind. The version is
+   * incremented whenever a hook service of this kind is registered,
+   * unregistered or changes its ranking, and the snapshot is rebuilt the
+   * next time it is needed.
+   */
+  struct HookCache
+  {
+    HookCache(const std::string& interfaceId);
+
+    const InterfaceId interfaceId;
+    std::atomic<std::uint64_t> version;
+    std::atomic<std::size_t> size;
+    struct : public detail::MultiThreaded<>
+    {
+      std::shared_ptr<const HookSnapshot> value;
+    } snapshot;
+  };
+
   CoreBundleContext* coreCtx;
   std::unique_ptr<ServiceTracker<ServiceListenerHook>> listenerHookTracker;
 
   std::atomic<bool> bOpen;
 
+  HookCache findHooks;
+  HookCache eventListenerHooks;
+
+  /**
+   * Get the current snapshot of the hook services cached by \c cache.
+   *
+   * @param registryLocked \c true if the caller holds the lock of the
+   *        service registry.
+   */
+  std::shared_ptr<const HookSnapshot> GetHookSnapshot(HookCache& cache,
+                                                      bool registryLocked);
+
   virtual std::shared_ptr<ServiceListenerHook> AddingService(
     const ServiceReference<ServiceListenerHook>& reference);
   virtual void ModifiedService(
@@ -62,6 +107,13 @@ public:
 
   bool IsOpen() const;
 
+  /**
+   * Called by the service registry, with its lock held, after services
+   * with the given interfaces have been registered, unregistered or
+   * re-ranked.
+   */
+  void ServicesChanged_unlocked(const std::vector<InterfaceId>& classes);
+
   void FilterServiceReferences(BundleContextPrivate* context,
                                const std::string& service,
                                const std::string& filter,
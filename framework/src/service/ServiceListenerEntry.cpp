@@ -53,9 +53,12 @@ public:
                            const ServiceListener& l,
                            void* data,
                            ListenerTokenId tokenId,
-                           const std::string& filter)
+                           const std::string& filter,
+                           bool async)
     : ServiceListenerHook::ListenerInfoData(context, l, data, tokenId, filter)
     , ldap()
+    , deliveryQueue(async ? std::make_shared<ServiceEventDispatcher::Queue>()
+                          : nullptr)
     , hashValue(0)
   {
     if (!filter.empty()) {
@@ -88,6 +91,8 @@ public:
    */
   LDAPExpr::LocalCache local_cache;
 
+  const std::shared_ptr<ServiceEventDispatcher::Queue> deliveryQueue;
+
   std::size_t hashValue;
 };
 
@@ -122,9 +127,10 @@ ServiceListenerEntry::ServiceListenerEntry(
   const ServiceListener& l,
   void* data,
   ListenerTokenId tokenId,
-  const std::string& filter)
+  const std::string& filter,
+  bool async)
   : ServiceListenerHook::ListenerInfo(
-      new ServiceListenerEntryData(context, l, data, tokenId, filter))
+      new ServiceListenerEntryData(context, l, data, tokenId, filter, async))
 {}
 
 const LDAPExpr& ServiceListenerEntry::GetLDAPExpr() const
@@ -142,6 +148,12 @@ void ServiceListenerEntry::CallDelegate(const ServiceEvent& event) const
   d->listener(event);
 }
 
+const std::shared_ptr<ServiceEventDispatcher::Queue>&
+ServiceListenerEntry::GetDeliveryQueue() const
+{
+  return static_cast<ServiceListenerEntryData*>(d.get())->deliveryQueue;
+}
+
 bool ServiceListenerEntry::operator==(const ServiceListenerEntry& other) const
 {
   return (d->tokenId == other.d->tokenId) &&
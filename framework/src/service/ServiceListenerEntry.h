@@ -28,6 +28,7 @@
 #include "cppmicroservices/ServiceListenerHook.h"
 
 #include "LDAPExpr.h"
+#include "ServiceEventDispatcher.h"
 #include "Utils.h"
 
 namespace cppmicroservices {
@@ -57,7 +58,8 @@ public:
                        const ServiceListener& l,
                        void* data,
                        ListenerTokenId tokenId,
-                       const std::string& filter = "");
+                       const std::string& filter = "",
+                       bool async = false);
 
   const LDAPExpr& GetLDAPExpr() const;
 
@@ -65,6 +67,13 @@ public:
 
   void CallDelegate(const ServiceEvent& event) const;
 
+  /**
+   * The queue of events waiting to be delivered to this listener, or
+   * \c nullptr if events are delivered synchronously.
+   */
+  const std::shared_ptr<ServiceEventDispatcher::Queue>& GetDeliveryQueue()
+    const;
+
   bool operator==(const ServiceListenerEntry& other) const;
   bool operator<(const ServiceListenerEntry& other) const;
 
@@ -32,6 +32,8 @@ US_MSVC_PUSH_DISABLE_WARNING(
 #include "cppmicroservices/ListenerFunctors.h"
 #include "cppmicroservices/SecurityException.h"
 #include "cppmicroservices/SharedLibraryException.h"
+#include "cppmicroservices/detail/PerfCounters.h"
+#include "cppmicroservices/detail/Trace.h"
 #include "cppmicroservices/util/Error.h"
 #include "cppmicroservices/util/String.h"
 
@@ -41,22 +43,93 @@ US_MSVC_PUSH_DISABLE_WARNING(
 #include "CoreBundleContext.h"
 #include "Properties.h"
 #include "ServiceReferenceBasePrivate.h"
+#include "ServiceRegistrationBasePrivate.h"
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 
 namespace cppmicroservices {
 
+namespace {
+std::size_t GetAsyncDeliveryThreads(
+  const std::unordered_map<std::string, Any>& props)
+{
+#ifdef US_ENABLE_THREADING_SUPPORT
+  auto delivery = props.find(Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY);
+  if (delivery == props.end() ||
+      delivery->second.Type() != typeid(std::string) ||
+      ref_any_cast<std::string>(delivery->second) !=
+        Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY_ASYNC) {
+    return 0;
+  }
+  auto threads =
+    props.find(Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY_THREADS);
+  if (threads != props.end() && threads->second.Type() == typeid(int)) {
+    return static_cast<std::size_t>(
+      std::max(ref_any_cast<int>(threads->second), 1));
+  }
+  return 1;
+#else
+  US_UNUSED(props);
+  return 0;
+#endif
+}
+
+std::string GetTraceName(const ServiceListenerEntry& l)
+{
+  try {
+    return "service listener of " +
+           l.GetBundleContext().GetBundle().GetSymbolicName();
+  } catch (...) {
+    // the bundle context has been invalidated meanwhile
+    return "service listener";
+  }
+}
+
+template<class Cache>
+void EraseFromCache(Cache& cache,
+                    const typename Cache::key_type& key,
+                    const ServiceListenerEntry& sle)
+{
+  auto iter = cache.find(key);
+  if (iter != cache.end()) {
+    iter->second.erase(sle);
+    if (iter->second.empty()) {
+      cache.erase(iter);
+    }
+  }
+}
+}
+
 ServiceListeners::ServiceListeners(CoreBundleContext* coreCtx)
   : listenerId(0)
   , coreCtx(coreCtx)
+  , asyncDeliveryThreads(
+      GetAsyncDeliveryThreads(coreCtx->frameworkProperties))
 {
   hashedServiceKeys.push_back(Constants::OBJECTCLASS);
   hashedServiceKeys.push_back(Constants::SERVICE_ID);
 }
 
+ServiceListeners::~ServiceListeners()
+{
+  std::shared_ptr<ServiceEventDispatcher> d;
+  dispatcher.Lock(), d.swap(dispatcher.value);
+  if (d) {
+    d->Stop();
+  }
+}
+
 void ServiceListeners::Clear()
 {
+  // Deliver the events which are still queued before dropping the listeners
+  std::shared_ptr<ServiceEventDispatcher> d;
+  dispatcher.Lock(), d.swap(dispatcher.value);
+  if (d) {
+    d->Stop();
+  }
+
   bundleListenerMap.Lock(), bundleListenerMap.value.clear();
   {
     auto l = this->Lock();
@@ -64,8 +137,8 @@ void ServiceListeners::Clear()
     serviceSet.clear();
     hashedServiceKeys.clear();
     complicatedListeners.clear();
-    cache[0].clear();
-    cache[1].clear();
+    classCache.clear();
+    serviceIdCache.clear();
   }
 
   frameworkListenerMap.Lock(), frameworkListenerMap.value.clear();
@@ -80,7 +153,8 @@ ListenerToken ServiceListeners::AddServiceListener(
   const std::shared_ptr<BundleContextPrivate>& context,
   const ServiceListener& listener,
   void* data,
-  const std::string& filter)
+  const std::string& filter,
+  bool async)
 {
   // The following condition is true only if the listener is a non-static member function.
   // If so, the existing listener is replaced with the new listener.
@@ -89,7 +163,12 @@ ListenerToken ServiceListeners::AddServiceListener(
   }
 
   auto token = MakeListenerToken();
-  ServiceListenerEntry sle(context, listener, data, token.Id(), filter);
+  ServiceListenerEntry sle(context,
+                           listener,
+                           data,
+                           token.Id(),
+                           filter,
+                           async && asyncDeliveryThreads > 0);
   {
     auto l = this->Lock();
     US_UNUSED(l);
@@ -397,6 +476,7 @@ void ServiceListeners::ServiceChanged(ServiceListenerEntries& receivers,
                                       const ServiceEvent& evt,
                                       ServiceListenerEntries& matchBefore)
 {
+  US_PERF_TIMER(timer, "service.listener.dispatch");
   int n = 0;
 
   if (!matchBefore.empty()) {
@@ -407,20 +487,57 @@ void ServiceListeners::ServiceChanged(ServiceListenerEntries& receivers,
 
   for (auto const& l : receivers) {
     if (!l.IsRemoved()) {
-      try {
-        ++n;
-        l.CallDelegate(evt);
-      } catch (...) {
-        std::string message("Service listener in " +
-                            l.GetBundleContext().GetBundle().GetSymbolicName() +
-                            " threw an exception!");
-        SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
-                                          l.GetBundleContext().GetBundle(),
-                                          message,
-                                          std::current_exception()));
+      ++n;
+      if (const auto& queue = l.GetDeliveryQueue()) {
+        auto d = GetDispatcher();
+        if (d->Post(queue, [this, l, evt] {
+              // the listener may have been removed while the event was queued
+              if (!l.IsRemoved()) {
+                DeliverServiceEvent(l, evt);
+              }
+            })) {
+          continue;
+        }
       }
+      DeliverServiceEvent(l, evt);
     }
   }
+  US_PERF_AMOUNT(timer, n);
+}
+
+void ServiceListeners::DeliverServiceEvent(const ServiceListenerEntry& l,
+                                           const ServiceEvent& evt)
+{
+  US_PERF_TIMER(timer, "service.listener.call");
+  US_TRACE_SCOPE(trace, "service", GetTraceName(l));
+  try {
+    l.CallDelegate(evt);
+  } catch (...) {
+    std::string message("Service listener in " +
+                        l.GetBundleContext().GetBundle().GetSymbolicName() +
+                        " threw an exception!");
+    SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                      l.GetBundleContext().GetBundle(),
+                                      message,
+                                      std::current_exception()));
+  }
+}
+
+std::shared_ptr<ServiceEventDispatcher> ServiceListeners::GetDispatcher()
+{
+  auto l = dispatcher.Lock();
+  US_UNUSED(l);
+  if (!dispatcher.value) {
+    dispatcher.value = std::make_shared<ServiceEventDispatcher>();
+    dispatcher.value->Start(asyncDeliveryThreads);
+  }
+  return dispatcher.value;
+}
+
+ServiceEventDeliveryStats ServiceListeners::GetServiceEventDeliveryStats() const
+{
+  auto d = (dispatcher.Lock(), dispatcher.value);
+  return d ? d->GetStats() : ServiceEventDeliveryStats();
 }
 
 void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt,
@@ -444,24 +561,32 @@ void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt,
       if (receivers.count(sse) == 0)
         continue;
       const LDAPExpr& ldapExpr = sse.GetLDAPExpr();
-      if (ldapExpr.IsNull() || ldapExpr.Evaluate(props, false)) {
+      if (ldapExpr.IsNull()) {
+        set.insert(sse);
+        continue;
+      }
+      US_PERF_COUNT("ldap.evaluate", 0);
+      if (ldapExpr.Evaluate(props, false)) {
         set.insert(sse);
       }
     }
 
-    // Check the cache
-    const auto c = any_cast<std::vector<std::string>>(
-      props->Value_unlocked(Constants::OBJECTCLASS));
-    for (auto& objClass : c) {
-      AddToSet_unlocked(set, receivers, OBJECTCLASS_IX, objClass);
+    // Check the cache. The object classes of the service are interned
+    // when it is registered.
+    for (auto objClass : ref.d.load()->registration->interfaceIds) {
+      auto iter = classCache.find(objClass);
+      if (iter != classCache.end()) {
+        AddToSet_unlocked(set, receivers, iter->second);
+      }
     }
 
     auto service_id =
       any_cast<long>(props->Value_unlocked(Constants::SERVICE_ID));
-    AddToSet_unlocked(set,
-                      receivers,
-                      SERVICE_ID_IX,
-                      cppmicroservices::util::ToString((service_id)));
+    auto iter =
+      serviceIdCache.find(cppmicroservices::util::ToString((service_id)));
+    if (iter != serviceIdCache.end()) {
+      AddToSet_unlocked(set, receivers, iter->second);
+    }
   }
 }
 
@@ -478,17 +603,38 @@ ServiceListeners::GetListenerInfoCollection() const
   return result;
 }
 
+std::map<std::string, std::size_t> ServiceListeners::GetServiceListenerCounts()
+  const
+{
+  std::map<std::string, std::size_t> counts;
+  auto l = this->Lock();
+  US_UNUSED(l);
+  for (const auto& sle : serviceSet) {
+    const auto& cache = sle.GetLocalCache();
+    if (cache.empty() || cache[OBJECTCLASS_IX].empty()) {
+      ++counts[std::string()];
+      continue;
+    }
+    for (const auto& objectClass : cache[OBJECTCLASS_IX]) {
+      ++counts[objectClass];
+    }
+  }
+  return counts;
+}
+
 void ServiceListeners::RemoveFromCache_unlocked(const ServiceListenerEntry& sle)
 {
   if (!sle.GetLocalCache().empty()) {
     for (std::size_t i = 0; i < hashedServiceKeys.size(); ++i) {
-      CacheType& keymap = cache[i];
       std::vector<std::string>& filters = sle.GetLocalCache()[i];
       for (auto const& filter : filters) {
-        std::set<ServiceListenerEntry>& sles = keymap[filter];
-        sles.erase(sle);
-        if (sles.empty()) {
-          keymap.erase(filter);
+        if (i == OBJECTCLASS_IX) {
+          InterfaceId objClass;
+          if (FindInterfaceId(filter, objClass)) {
+            EraseFromCache(classCache, objClass, sle);
+          }
+        } else {
+          EraseFromCache(serviceIdCache, filter, sle);
         }
       }
     }
@@ -506,12 +652,12 @@ void ServiceListeners::CheckSimple_unlocked(const ServiceListenerEntry& sle)
     if (sle.GetLDAPExpr().IsSimple(hashedServiceKeys, local_cache, false)) {
       sle.GetLocalCache() = local_cache;
       for (std::size_t i = 0; i < hashedServiceKeys.size(); ++i) {
-        for (std::vector<std::string>::const_iterator it =
-               local_cache[i].begin();
-             it != local_cache[i].end();
-             ++it) {
-          std::set<ServiceListenerEntry>& sles = cache[i][*it];
-          sles.insert(sle);
+        for (auto const& filter : local_cache[i]) {
+          if (i == OBJECTCLASS_IX) {
+            classCache[InternInterfaceId(filter)].insert(sle);
+          } else {
+            serviceIdCache[filter].insert(sle);
+          }
         }
       }
     } else {
@@ -523,18 +669,11 @@ void ServiceListeners::CheckSimple_unlocked(const ServiceListenerEntry& sle)
 void ServiceListeners::AddToSet_unlocked(
   ServiceListenerEntries& set,
   const ServiceListenerEntries& receivers,
-  int cache_ix,
-  const std::string& val)
+  const std::set<ServiceListenerEntry>& entries)
 {
-  const auto cacheItr = cache[cache_ix].find(val);
-  if (cacheItr != cache[cache_ix].end()) {
-    std::set<ServiceListenerEntry>& l = cache[cache_ix][val];
-    if (!l.empty()) {
-      for (const ServiceListenerEntry& entry : l) {
-        if (receivers.count(entry)) {
-          set.insert(entry);
-        }
-      }
+  for (const ServiceListenerEntry& entry : entries) {
+    if (receivers.count(entry)) {
+      set.insert(entry);
     }
   }
 }
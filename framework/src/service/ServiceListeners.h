@@ -26,9 +26,12 @@
 #include "cppmicroservices/GlobalConfig.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include "InterfaceId.h"
+#include "ServiceEventDispatcher.h"
 #include "ServiceListenerEntry.h"
 
 #include <list>
+#include <map>
 #include <mutex>
 #include <set>
 #include <string>
@@ -61,6 +64,8 @@ public:
 
   using CacheType =
     std::unordered_map<std::string, std::set<ServiceListenerEntry>>;
+  using ClassCacheType =
+    std::unordered_map<InterfaceId, std::set<ServiceListenerEntry>>;
   using ServiceListenerEntries = std::unordered_set<ServiceListenerEntry>;
 
   using FrameworkListenerEntry = std::tuple<FrameworkListener, void*>;
@@ -83,15 +88,28 @@ private:
   /* Service listeners with complicated or empty filters */
   std::list<ServiceListenerEntry> complicatedListeners;
 
-  /* Service listeners with "simple" filters are cached. */
-  CacheType cache[2];
+  /* Service listeners with "simple" filters are cached, by interned
+   * object class and by service id. */
+  ClassCacheType classCache;
+  CacheType serviceIdCache;
 
   ServiceListenerEntries serviceSet;
 
   CoreBundleContext* coreCtx;
 
+  /* Number of threads delivering events to asynchronous listeners, or zero
+   * if all events are delivered synchronously. */
+  const std::size_t asyncDeliveryThreads;
+
+  /* Created when the first event for an asynchronous listener is fired. */
+  struct : public MultiThreaded<>
+  {
+    std::shared_ptr<ServiceEventDispatcher> value;
+  } dispatcher;
+
 public:
   ServiceListeners(CoreBundleContext* coreCtx);
+  ~ServiceListeners();
 
   void Clear();
 
@@ -103,6 +121,7 @@ public:
    * @param listener The service listener to add.
    * @param data Additional data to distinguish ServiceListener objects.
    * @param filter An LDAP filter string to check when a service is modified.
+   * @param async Whether the listener opts in to asynchronous delivery.
    * @returns a ListenerToken object that corresponds to the listener.
    * @exception org.osgi.framework.InvalidSyntaxException
    * If the filter is not a correct LDAP expression.
@@ -111,7 +130,8 @@ public:
     const std::shared_ptr<BundleContextPrivate>& context,
     const ServiceListener& listener,
     void* data,
-    const std::string& filter);
+    const std::string& filter,
+    bool async = false);
 
   /**
    * Remove service listener from current framework. Silently ignore
@@ -230,7 +250,27 @@ public:
   std::vector<ServiceListenerHook::ListenerInfo> GetListenerInfoCollection()
     const;
 
+  ServiceEventDeliveryStats GetServiceEventDeliveryStats() const;
+
+  /**
+   * Count the service listeners by the object class they are cached for.
+   *
+   * @see Framework::GetServiceListenerCounts
+   */
+  std::map<std::string, std::size_t> GetServiceListenerCounts() const;
+
 private:
+  /**
+   * Call a service listener, reporting exceptions as framework events.
+   */
+  void DeliverServiceEvent(const ServiceListenerEntry& l,
+                           const ServiceEvent& evt);
+
+  /**
+   * Get the dispatcher for asynchronous listeners, creating it if needed.
+   */
+  std::shared_ptr<ServiceEventDispatcher> GetDispatcher();
+
   /**
    * Factory method that returns an unique ListenerToken object.
    * Called by methods which add listeners.
@@ -251,8 +291,7 @@ private:
 
   void AddToSet_unlocked(ServiceListenerEntries& set,
                          const ServiceListenerEntries& receivers,
-                         int cache_ix,
-                         const std::string& val);
+                         const std::set<ServiceListenerEntry>& entries);
 
   /**
    * Removes service listeners registered using the legacy
@@ -55,6 +55,7 @@ void ServiceReferenceBase::SetInterfaceId(const std::string& interfaceId)
     d = new ServiceReferenceBasePrivate(d.load()->registration);
   }
   d.load()->interfaceId = interfaceId;
+  d.load()->singletonInterface = nullptr;
 }
 
 ServiceReferenceBase::operator bool() const
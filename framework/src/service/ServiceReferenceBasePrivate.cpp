@@ -31,9 +31,11 @@
 
 #include "BundlePrivate.h"
 #include "CoreBundleContext.h"
+#include "ServiceHolder.h"
 #include "ServiceRegistrationBasePrivate.h"
 #include "ServiceRegistry.h"
 
+#include <algorithm>
 #include <cassert>
 
 US_MSVC_DISABLE_WARNING(
@@ -49,6 +51,7 @@ ServiceReferenceBasePrivate::ServiceReferenceBasePrivate(
   ServiceRegistrationBasePrivate* reg)
   : ref(1)
   , registration(reg)
+  , singletonInterface(nullptr)
 {
   if (registration)
     ++registration->ref;
@@ -66,6 +69,11 @@ InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceFromFactory(
   const std::shared_ptr<ServiceFactory>& factory)
 {
   assert(factory && "Factory service pointer is nullptr");
+  // The first request for a service of a bundle waiting for its lazy
+  // activation activates it.
+  if (auto owner = registration->bundle.lock()) {
+    owner->TriggerLazyActivation();
+  }
   InterfaceMapConstPtr s;
   try {
     InterfaceMapConstPtr smap =
@@ -162,6 +170,65 @@ std::shared_ptr<void> ServiceReferenceBasePrivate::GetService(
   return ExtractInterface(GetServiceInterfaceMap(bundle), interfaceId);
 }
 
+bool ServiceReferenceBasePrivate::GetSingletonService(
+  const std::shared_ptr<BundlePrivate>& bundle,
+  std::shared_ptr<SingletonServiceHolder>& holder)
+{
+  holder.reset();
+  if (!registration->available)
+    return true;
+  if (registration->hasServiceFactory)
+    return false;
+
+  // The bundle already uses the service: share its holder.
+  holder = registration->FindSingletonServiceHolder(bundle.get());
+  if (holder)
+    return true;
+
+  auto l = registration->Lock();
+  US_UNUSED(l);
+  if (!registration->available)
+    return true;
+  // an empty service object is handed out without counting a use of it
+  if (!registration->service || registration->service->empty())
+    return false;
+
+  holder = registration->FindSingletonServiceHolder(bundle.get());
+  if (holder)
+    return true;
+
+  // A previous holder whose last service object has been released may not
+  // have ungotten its use yet; it still does so when it is destroyed.
+  holder = std::make_shared<SingletonServiceHolder>(
+    bundle, registration->reference, registration->service);
+  ++registration->dependents[bundle.get()];
+  registration->AddSingletonServiceHolder_unlocked(bundle.get(), holder);
+  return true;
+}
+
+void ServiceReferenceBasePrivate::UngetSingletonService(
+  const SingletonServiceHolder& holder)
+{
+  {
+    auto l = registration->Lock();
+    US_UNUSED(l);
+    if (!registration->UncountSingletonServiceHolder_unlocked(&holder))
+      return;
+  }
+  UngetService(holder.b.lock(), true);
+}
+
+void* ServiceReferenceBasePrivate::GetSingletonInterface(
+  const InterfaceMapConstPtr& service)
+{
+  auto iface = singletonInterface.load(std::memory_order_acquire);
+  if (!iface) {
+    iface = ExtractInterface(service, interfaceId).get();
+    singletonInterface.store(iface, std::memory_order_release);
+  }
+  return iface;
+}
+
 InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceInterfaceMap(
   BundlePrivate* bundle)
 {
@@ -384,6 +451,7 @@ bool ServiceReferenceBasePrivate::UngetService(
       }
       registration->bundleServiceInstance.erase(bundle.get());
       registration->dependents.erase(bundle.get());
+      registration->RemoveSingletonServiceHolder_unlocked(bundle.get());
     }
   }
 
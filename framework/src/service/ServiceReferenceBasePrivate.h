@@ -36,6 +36,7 @@ class BundlePrivate;
 class PropertiesHandle;
 class ServiceRegistrationBasePrivate;
 class ServiceReferenceBasePrivate;
+struct SingletonServiceHolder;
 
 /**
  * \ingroup MicroServices
@@ -61,6 +62,41 @@ public:
 
   InterfaceMapConstPtr GetServiceInterfaceMap(BundlePrivate* bundle);
 
+  /**
+   * Get the service object of a service which is not registered with a
+   * service factory. All service objects handed out to a bundle share one
+   * holder, which accounts for a single use of the service while any of
+   * them is held. Getting a service which the bundle already uses only
+   * shares the existing holder, without allocating or locking the
+   * registration.
+   *
+   * @param bundle requester of service.
+   * @param holder set to the holder of the service object or null if the
+   *        service is not available.
+   * @return false if the service is registered with a service factory or
+   *         its service object is empty, in which case \c holder is not set.
+   */
+  bool GetSingletonService(const std::shared_ptr<BundlePrivate>& bundle,
+                           std::shared_ptr<SingletonServiceHolder>& holder);
+
+  /**
+   * Unget the use of the service a singleton service holder accounts for,
+   * if it still does.
+   *
+   * @param holder The holder whose last service object has been released.
+   */
+  void UngetSingletonService(const SingletonServiceHolder& holder);
+
+  /**
+   * Get the interface of this reference from the service object of a
+   * service which is not registered with a service factory. The lookup
+   * is only done once.
+   *
+   * @param service The service object of the registration of this reference.
+   * @return The interface pointer or \c nullptr.
+   */
+  void* GetSingletonInterface(const InterfaceMapConstPtr& service);
+
   /**
     * Get new service instance.
     *
@@ -116,6 +152,13 @@ public:
    */
   std::string interfaceId;
 
+  /**
+   * Cached result of GetSingletonInterface. The service object of a
+   * registration does not change, so the cache is only reset along
+   * with the interface id.
+   */
+  std::atomic<void*> singletonInterface;
+
 private:
   InterfaceMapConstPtr GetServiceFromFactory(
     BundlePrivate* bundle,
@@ -177,9 +177,9 @@ void ServiceRegistrationBase::SetProperties(const ServiceProperties& props)
     d->properties = Properties(std::move(propsCopy));
   }
   if (old_rank != new_rank) {
-    auto classes = any_cast<std::vector<std::string>>(objectClasses);
     if (auto bundle = d->bundle.lock()) {
-      bundle->coreCtx->services.UpdateServiceRegistrationOrder(classes);
+      bundle->coreCtx->services.UpdateServiceRegistrationOrder(
+        d->interfaceIds);
     }
   }
 
@@ -302,6 +302,7 @@ void ServiceRegistrationBase::Unregister()
 
     d->bundle.reset();
     d->dependents.clear();
+    d->ClearSingletonServiceHolders_unlocked();
     d->service.reset();
     d->prototypeServiceInstances.clear();
     d->bundleServiceInstance.clear();
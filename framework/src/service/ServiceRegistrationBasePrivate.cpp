@@ -22,8 +22,11 @@
 
 #include "ServiceRegistrationBasePrivate.h"
 #include "BundlePrivate.h"
+#include "ServiceHolder.h"
 
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #ifdef _MSC_VER
 #  pragma warning(push)
@@ -32,6 +35,20 @@
 
 namespace cppmicroservices {
 
+namespace {
+std::vector<InterfaceId> InternServiceInterfaceIds(
+  const InterfaceMapConstPtr& service)
+{
+  std::vector<std::string> interfaceIds;
+  if (service) {
+    for (const auto& i : *service) {
+      interfaceIds.push_back(i.first);
+    }
+  }
+  return InternInterfaceIds(interfaceIds);
+}
+}
+
 ServiceRegistrationBasePrivate::ServiceRegistrationBasePrivate(
   BundlePrivate* bundle_,
   InterfaceMapConstPtr service,
@@ -43,6 +60,10 @@ ServiceRegistrationBasePrivate::ServiceRegistrationBasePrivate(
   , properties(std::move(props))
   , available(true)
   , unregistering(false)
+  , hasServiceFactory(this->service &&
+                      this->service->find("org.cppmicroservices.factory") !=
+                        this->service->end())
+  , interfaceIds(InternServiceInterfaceIds(this->service))
 {
   // The reference counter is initialized to 0 because it will be
   // incremented by the "reference" member.
@@ -62,6 +83,114 @@ bool ServiceRegistrationBasePrivate::IsUsedByBundle(BundlePrivate* bundle) const
           prototypeServiceInstances.end());
 }
 
+std::shared_ptr<SingletonServiceHolder>
+ServiceRegistrationBasePrivate::FindSingletonServiceHolder(
+  BundlePrivate* bundle) const
+{
+  auto holders = singletonServiceHolders.Read();
+  if (!holders.Get())
+    return nullptr;
+  for (auto node = holders.Get()->head.get(); node; node = node->next.get()) {
+    if (node->bundle == bundle) {
+      return node->holder.lock();
+    }
+  }
+  return nullptr;
+}
+
+namespace {
+
+/**
+ * Copies the newest entry of every bundle but \c skip, dropping the entries
+ * of holders which are gone.
+ */
+std::unique_ptr<ServiceRegistrationBasePrivate::SingletonServiceHolders>
+CompactSingletonServiceHolders(
+  const ServiceRegistrationBasePrivate::SingletonServiceHolders* holders,
+  BundlePrivate* skip)
+{
+  using Node = ServiceRegistrationBasePrivate::SingletonServiceHolderNode;
+  std::unique_ptr<ServiceRegistrationBasePrivate::SingletonServiceHolders>
+    compacted(new ServiceRegistrationBasePrivate::SingletonServiceHolders{
+      nullptr, 0, 0 });
+  if (!holders)
+    return compacted;
+
+  std::vector<const Node*> kept;
+  std::unordered_set<BundlePrivate*> seen;
+  for (auto node = holders->head.get(); node; node = node->next.get()) {
+    if (node->bundle != skip && seen.insert(node->bundle).second &&
+        !node->holder.expired()) {
+      kept.push_back(node);
+    }
+  }
+  for (auto iter = kept.rbegin(); iter != kept.rend(); ++iter) {
+    compacted->head = std::make_shared<const Node>(
+      Node{ (*iter)->bundle, (*iter)->holder, std::move(compacted->head) });
+  }
+  compacted->size = compacted->compactedSize = kept.size();
+  return compacted;
+}
+}
+
+void ServiceRegistrationBasePrivate::AddSingletonServiceHolder_unlocked(
+  BundlePrivate* bundle,
+  const std::shared_ptr<SingletonServiceHolder>& holder)
+{
+  countedSingletonServiceHolders[holder.get()] = bundle;
+
+  std::unique_ptr<SingletonServiceHolders> holders;
+  {
+    // writers are serialized by the registration lock
+    auto current = singletonServiceHolders.Read();
+    if (current.Get() &&
+        current.Get()->size < 2 * current.Get()->compactedSize + 8) {
+      holders.reset(new SingletonServiceHolders(*current.Get()));
+    } else {
+      // drop the entries which are hidden or gone once they dominate
+      holders = CompactSingletonServiceHolders(current.Get(), nullptr);
+    }
+  }
+  holders->head = std::make_shared<const SingletonServiceHolderNode>(
+    SingletonServiceHolderNode{ bundle, holder, std::move(holders->head) });
+  ++holders->size;
+  singletonServiceHolders.Reset(std::move(holders));
+}
+
+bool ServiceRegistrationBasePrivate::UncountSingletonServiceHolder_unlocked(
+  const SingletonServiceHolder* holder)
+{
+  return countedSingletonServiceHolders.erase(holder) != 0;
+}
+
+void ServiceRegistrationBasePrivate::RemoveSingletonServiceHolder_unlocked(
+  BundlePrivate* bundle)
+{
+  for (auto iter = countedSingletonServiceHolders.begin();
+       iter != countedSingletonServiceHolders.end();) {
+    if (iter->second == bundle) {
+      iter = countedSingletonServiceHolders.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  std::unique_ptr<SingletonServiceHolders> holders;
+  {
+    auto current = singletonServiceHolders.Read();
+    if (!current.Get())
+      return;
+    holders = CompactSingletonServiceHolders(current.Get(), bundle);
+  }
+  singletonServiceHolders.Reset(std::move(holders));
+}
+
+void ServiceRegistrationBasePrivate::ClearSingletonServiceHolders_unlocked()
+{
+  countedSingletonServiceHolders.clear();
+  singletonServiceHolders.Reset();
+}
+
 InterfaceMapConstPtr ServiceRegistrationBasePrivate::GetInterfaces() const
 {
   return (this->Lock(), service);
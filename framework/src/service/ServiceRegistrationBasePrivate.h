@@ -25,8 +25,10 @@
 
 #include "cppmicroservices/ServiceInterface.h"
 #include "cppmicroservices/ServiceReference.h"
+#include "cppmicroservices/detail/QuiescentPtr.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include "InterfaceId.h"
 #include "Properties.h"
 
 #include <atomic>
@@ -35,6 +37,7 @@ namespace cppmicroservices {
 
 class BundlePrivate;
 class ServiceRegistrationBase;
+struct SingletonServiceHolder;
 
 /**
  * \ingroup MicroServices
@@ -69,6 +72,26 @@ public:
   using BundleToServicesMap =
     std::unordered_map<BundlePrivate*, std::list<InterfaceMapConstPtr>>;
 
+  /**
+   * An immutable list of the singleton service holders of the bundles using
+   * the service. A newer entry for a bundle hides older ones.
+   */
+  struct SingletonServiceHolderNode
+  {
+    BundlePrivate* bundle;
+    std::weak_ptr<SingletonServiceHolder> holder;
+    std::shared_ptr<const SingletonServiceHolderNode> next;
+  };
+
+  struct SingletonServiceHolders
+  {
+    std::shared_ptr<const SingletonServiceHolderNode> head;
+    /// number of entries, including hidden and expired ones
+    std::size_t size;
+    /// number of entries after the list was last compacted
+    std::size_t compactedSize;
+  };
+
   ServiceRegistrationBasePrivate(const ServiceRegistrationBasePrivate&) =
     delete;
   ServiceRegistrationBasePrivate& operator=(
@@ -90,6 +113,21 @@ public:
    */
   BundleToServiceMap bundleServiceInstance;
 
+  /**
+   * Holders of the service object shared by all shared_ptrs a bundle got
+   * from BundleContext::GetService, if the service is not registered with
+   * a service factory. Entries are added under the registration lock and
+   * read without it.
+   */
+  detail::QuiescentPtr<SingletonServiceHolders> singletonServiceHolders;
+
+  /**
+   * The singleton service holders which account for one use in dependents,
+   * with the bundle they were handed out to.
+   */
+  std::unordered_map<const SingletonServiceHolder*, BundlePrivate*>
+    countedSingletonServiceHolders;
+
   /**
    * Bundle registering this service.
    */
@@ -118,6 +156,17 @@ public:
    */
   std::atomic<bool> unregistering;
 
+  /**
+   * Is the service object a service factory.
+   */
+  const bool hasServiceFactory;
+
+  /**
+   * The interned interface ids of the service object, in the same order
+   * as the class names in the Constants::OBJECTCLASS property.
+   */
+  const std::vector<InterfaceId> interfaceIds;
+
   ServiceRegistrationBasePrivate(BundlePrivate* bundle,
                                  InterfaceMapConstPtr service,
                                  Properties&& props);
@@ -132,6 +181,42 @@ public:
    */
   bool IsUsedByBundle(BundlePrivate* bundle) const;
 
+  /**
+   * Get the singleton service holder of a bundle without locking.
+   *
+   * @return The holder or null if the bundle does not hold the service.
+   */
+  std::shared_ptr<SingletonServiceHolder> FindSingletonServiceHolder(
+    BundlePrivate* bundle) const;
+
+  /**
+   * Add the singleton service holder of a bundle, which accounts for one
+   * use of the service. Must be called with the lock held.
+   */
+  void AddSingletonServiceHolder_unlocked(
+    BundlePrivate* bundle,
+    const std::shared_ptr<SingletonServiceHolder>& holder);
+
+  /**
+   * Stop counting the use of a singleton service holder. Must be called
+   * with the lock held.
+   *
+   * @return \c true if the holder still accounted for a use.
+   */
+  bool UncountSingletonServiceHolder_unlocked(
+    const SingletonServiceHolder* holder);
+
+  /**
+   * Remove the singleton service holders of a bundle, which then no longer
+   * account for a use of the service. Must be called with the lock held.
+   */
+  void RemoveSingletonServiceHolder_unlocked(BundlePrivate* bundle);
+
+  /**
+   * Remove all singleton service holders. Must be called with the lock held.
+   */
+  void ClearSingletonServiceHolders_unlocked();
+
   InterfaceMapConstPtr GetInterfaces() const;
 
   std::shared_ptr<void> GetService(const std::string& interfaceId) const;
@@ -24,12 +24,12 @@
 
 #include "cppmicroservices/PrototypeServiceFactory.h"
 #include "cppmicroservices/ServiceFactory.h"
+#include "cppmicroservices/detail/PerfCounters.h"
 
 #include "BundlePrivate.h"
 #include "CoreBundleContext.h"
 #include "ServiceRegistrationBasePrivate.h"
 
-#include <cassert>
 #include <iterator>
 #include <stdexcept>
 
@@ -117,11 +117,12 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(
     US_UNUSED(l);
     services.insert(std::make_pair(res, classes));
     serviceRegistrations.push_back(res);
-    for (auto& clazz : classes) {
+    for (auto clazz : res.d->interfaceIds) {
       auto& s = classServices[clazz];
       auto ip = std::lower_bound(s.rbegin(), s.rend(), res);
       s.insert(ip.base(), res);
     }
+    core->serviceHooks.ServicesChanged_unlocked(res.d->interfaceIds);
   }
 
   ServiceReferenceBase r = res.GetReference(std::string());
@@ -134,14 +135,15 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(
 }
 
 void ServiceRegistry::UpdateServiceRegistrationOrder(
-  const std::vector<std::string>& classes)
+  const std::vector<InterfaceId>& classes)
 {
   auto l = this->Lock();
   US_UNUSED(l);
-  for (auto& clazz : classes) {
+  for (auto clazz : classes) {
     auto& s = classServices[clazz];
     std::sort(s.rbegin(), s.rend());
   }
+  core->serviceHooks.ServicesChanged_unlocked(classes);
 }
 
 void ServiceRegistry::Get(
@@ -154,6 +156,23 @@ void ServiceRegistry::Get(
 void ServiceRegistry::Get_unlocked(
   const std::string& clazz,
   std::vector<ServiceRegistrationBase>& serviceRegs) const
+{
+  InterfaceId id;
+  if (FindInterfaceId(clazz, id)) {
+    Get_unlocked(id, serviceRegs);
+  }
+}
+
+void ServiceRegistry::Get(
+  InterfaceId clazz,
+  std::vector<ServiceRegistrationBase>& serviceRegs) const
+{
+  this->Lock(), Get_unlocked(clazz, serviceRegs);
+}
+
+void ServiceRegistry::Get_unlocked(
+  InterfaceId clazz,
+  std::vector<ServiceRegistrationBase>& serviceRegs) const
 {
   auto i = classServices.find(clazz);
   if (i != classServices.end()) {
@@ -163,12 +182,23 @@ void ServiceRegistry::Get_unlocked(
 
 ServiceReferenceBase ServiceRegistry::Get(BundlePrivate* bundle,
                                           const std::string& clazz) const
+{
+  InterfaceId id;
+  if (!FindInterfaceId(clazz, id)) {
+    return ServiceReferenceBase();
+  }
+  return Get(bundle, id, clazz);
+}
+
+ServiceReferenceBase ServiceRegistry::Get(BundlePrivate* bundle,
+                                          InterfaceId id,
+                                          const std::string& clazz) const
 {
   auto l = this->Lock();
   US_UNUSED(l);
   try {
     std::vector<ServiceReferenceBase> srs;
-    Get_unlocked(clazz, "", bundle, srs);
+    Get_unlocked(id, clazz, "", bundle, srs);
     DIAG_LOG(*core->sink) << "get service ref " << clazz << " for bundle "
                           << bundle->symbolicName << " = " << srs.size()
                           << " refs";
@@ -190,60 +220,101 @@ void ServiceRegistry::Get(const std::string& clazz,
   this->Lock(), Get_unlocked(clazz, filter, bundle, res);
 }
 
+void ServiceRegistry::Get(InterfaceId id,
+                          const std::string& clazz,
+                          const std::string& filter,
+                          BundlePrivate* bundle,
+                          std::vector<ServiceReferenceBase>& res) const
+{
+  this->Lock(), Get_unlocked(id, clazz, filter, bundle, res);
+}
+
 void ServiceRegistry::Get_unlocked(const std::string& clazz,
                                    const std::string& filter,
                                    BundlePrivate* bundle,
                                    std::vector<ServiceReferenceBase>& res) const
 {
-  std::vector<ServiceRegistrationBase>::const_iterator s;
-  std::vector<ServiceRegistrationBase>::const_iterator send;
-  std::vector<ServiceRegistrationBase> v;
+  if (!clazz.empty()) {
+    InterfaceId id;
+    if (FindInterfaceId(clazz, id)) {
+      Get_unlocked(id, clazz, filter, bundle, res);
+    }
+    return;
+  }
+
+  US_PERF_TIMER(timer, "service.registry.lookup");
   LDAPExpr ldap;
-  if (clazz.empty()) {
-    if (!filter.empty()) {
-      ldap = LDAPExpr(filter);
-      LDAPExpr::ObjectClassSet matched;
-      if (ldap.GetMatchedObjectClasses(matched)) {
-        v.clear();
-        for (auto& className : matched) {
-          auto i = classServices.find(className);
-          if (i != classServices.end()) {
-            std::copy(
-              i->second.begin(), i->second.end(), std::back_inserter(v));
-          }
+  if (!filter.empty()) {
+    ldap = LDAPExpr(filter);
+    LDAPExpr::ObjectClassSet matched;
+    if (ldap.GetMatchedObjectClasses(matched)) {
+      std::vector<ServiceRegistrationBase> v;
+      for (auto& className : matched) {
+        InterfaceId id;
+        if (!FindInterfaceId(className, id)) {
+          continue;
         }
-        if (!v.empty()) {
-          s = v.begin();
-          send = v.end();
-        } else {
-          return;
+        auto i = classServices.find(id);
+        if (i != classServices.end()) {
+          std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
         }
-      } else {
-        s = serviceRegistrations.begin();
-        send = serviceRegistrations.end();
       }
-    } else {
-      s = serviceRegistrations.begin();
-      send = serviceRegistrations.end();
-    }
-  } else {
-    auto it = classServices.find(clazz);
-    if (it != classServices.end()) {
-      s = it->second.begin();
-      send = it->second.end();
-    } else {
+      if (!v.empty()) {
+        GetReferences_unlocked(
+          v.begin(), v.end(), clazz, filter, ldap, bundle, res);
+      }
+      US_PERF_AMOUNT(timer, res.size());
       return;
     }
-    if (!filter.empty()) {
-      ldap = LDAPExpr(filter);
-    }
   }
+  GetReferences_unlocked(serviceRegistrations.begin(),
+                         serviceRegistrations.end(),
+                         clazz,
+                         filter,
+                         ldap,
+                         bundle,
+                         res);
+  US_PERF_AMOUNT(timer, res.size());
+}
 
+void ServiceRegistry::Get_unlocked(InterfaceId id,
+                                   const std::string& clazz,
+                                   const std::string& filter,
+                                   BundlePrivate* bundle,
+                                   std::vector<ServiceReferenceBase>& res) const
+{
+  US_PERF_TIMER(timer, "service.registry.lookup");
+  auto it = classServices.find(id);
+  if (it == classServices.end()) {
+    return;
+  }
+  LDAPExpr ldap;
+  if (!filter.empty()) {
+    ldap = LDAPExpr(filter);
+  }
+  GetReferences_unlocked(
+    it->second.begin(), it->second.end(), clazz, filter, ldap, bundle, res);
+  US_PERF_AMOUNT(timer, res.size());
+}
+
+void ServiceRegistry::GetReferences_unlocked(
+  std::vector<ServiceRegistrationBase>::const_iterator s,
+  std::vector<ServiceRegistrationBase>::const_iterator send,
+  const std::string& clazz,
+  const std::string& filter,
+  const LDAPExpr& ldap,
+  BundlePrivate* bundle,
+  std::vector<ServiceReferenceBase>& res) const
+{
   for (; s != send; ++s) {
     ServiceReferenceBase sri = s->GetReference(clazz);
 
-    if (filter.empty() ||
-        ldap.Evaluate(PropertiesHandle(s->d->properties, true), false)) {
+    if (filter.empty()) {
+      res.push_back(sri);
+      continue;
+    }
+    US_PERF_COUNT("ldap.evaluate", 0);
+    if (ldap.Evaluate(PropertiesHandle(s->d->properties, true), false)) {
       res.push_back(sri);
     }
   }
@@ -269,20 +340,11 @@ void ServiceRegistry::RemoveServiceRegistration(
 void ServiceRegistry::RemoveServiceRegistration_unlocked(
   const ServiceRegistrationBase& sr)
 {
-  std::vector<std::string> classes;
-  {
-    auto l2 = sr.d->properties.Lock();
-    US_UNUSED(l2);
-    assert(sr.d->properties.Value_unlocked(Constants::OBJECTCLASS).Type() ==
-           typeid(std::vector<std::string>));
-    classes = ref_any_cast<std::vector<std::string>>(
-      sr.d->properties.Value_unlocked(Constants::OBJECTCLASS));
-  }
   services.erase(sr);
   serviceRegistrations.erase(
     std::remove(serviceRegistrations.begin(), serviceRegistrations.end(), sr),
     serviceRegistrations.end());
-  for (auto& clazz : classes) {
+  for (auto clazz : sr.d->interfaceIds) {
     auto& s = classServices[clazz];
     if (s.size() > 1) {
       s.erase(std::remove(s.begin(), s.end(), sr), s.end());
@@ -290,6 +352,7 @@ void ServiceRegistry::RemoveServiceRegistration_unlocked(
       classServices.erase(clazz);
     }
   }
+  core->serviceHooks.ServicesChanged_unlocked(sr.d->interfaceIds);
 }
 
 void ServiceRegistry::GetRegisteredByBundle(
@@ -27,10 +27,13 @@
 #include "cppmicroservices/ServiceRegistration.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include "InterfaceId.h"
+
 namespace cppmicroservices {
 
 class CoreBundleContext;
 class BundlePrivate;
+class LDAPExpr;
 class Properties;
 
 /**
@@ -61,7 +64,7 @@ public:
   using MapServiceClasses =
     std::unordered_map<ServiceRegistrationBase, std::vector<std::string>>;
   using MapClassServices =
-    std::unordered_map<std::string, std::vector<ServiceRegistrationBase>>;
+    std::unordered_map<InterfaceId, std::vector<ServiceRegistrationBase>>;
 
   /**
    * All registered services in the current framework.
@@ -73,7 +76,7 @@ public:
   std::vector<ServiceRegistrationBase> serviceRegistrations;
 
   /**
-   * Mapping of classname to registered service.
+   * Mapping of interned classname to registered service.
    * The List of registered services are ordered with the highest
    * ranked service first.
    */
@@ -109,9 +112,9 @@ public:
    * Reorder registered services. Call this method if the ranking for
    * a service registration has changed
    *
-   * @param classes is the list of classes whose entries need to be reordered
+   * @param classes is the list of interned classes whose entries need to be reordered
    */
-  void UpdateServiceRegistrationOrder(const std::vector<std::string>& classes);
+  void UpdateServiceRegistrationOrder(const std::vector<InterfaceId>& classes);
 
   /**
    * Get all services implementing a certain class.
@@ -123,6 +126,16 @@ public:
   void Get(const std::string& clazz,
            std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+  /**
+   * Get all services implementing a certain interned class.
+   * Only used internally by the framework.
+   *
+   * @param clazz The interned class name of the requested service.
+   * @return A sorted list of {@link ServiceRegistrationPrivate} objects.
+   */
+  void Get(InterfaceId clazz,
+           std::vector<ServiceRegistrationBase>& serviceRegs) const;
+
   /**
    * Get a service implementing a certain class.
    *
@@ -133,6 +146,18 @@ public:
   ServiceReferenceBase Get(BundlePrivate* bundle,
                            const std::string& clazz) const;
 
+  /**
+   * Get a service implementing a certain interned class.
+   *
+   * @param bundle The bundle requesting reference
+   * @param id The interned class name of the requested service.
+   * @param clazz The class name of the requested service.
+   * @return A {@link ServiceReference} object.
+   */
+  ServiceReferenceBase Get(BundlePrivate* bundle,
+                           InterfaceId id,
+                           const std::string& clazz) const;
+
   /**
    * Get all services implementing a certain class and then
    * filter these with a property filter.
@@ -147,6 +172,22 @@ public:
            BundlePrivate* bundle,
            std::vector<ServiceReferenceBase>& serviceRefs) const;
 
+  /**
+   * Get all services implementing a certain interned class and then
+   * filter these with a property filter.
+   *
+   * @param id The interned class name of requested service.
+   * @param clazz The class name of requested service.
+   * @param filter The property filter.
+   * @param bundle The bundle requesting reference.
+   * @return A list of {@link ServiceReference} object.
+   */
+  void Get(InterfaceId id,
+           const std::string& clazz,
+           const std::string& filter,
+           BundlePrivate* bundle,
+           std::vector<ServiceReferenceBase>& serviceRefs) const;
+
   /**
    * Remove a registered service.
    *
@@ -182,10 +223,28 @@ private:
   void Get_unlocked(const std::string& clazz,
                     std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+  void Get_unlocked(InterfaceId clazz,
+                    std::vector<ServiceRegistrationBase>& serviceRegs) const;
+
   void Get_unlocked(const std::string& clazz,
                     const std::string& filter,
                     BundlePrivate* bundle,
                     std::vector<ServiceReferenceBase>& serviceRefs) const;
+
+  void Get_unlocked(InterfaceId id,
+                    const std::string& clazz,
+                    const std::string& filter,
+                    BundlePrivate* bundle,
+                    std::vector<ServiceReferenceBase>& serviceRefs) const;
+
+  void GetReferences_unlocked(
+    std::vector<ServiceRegistrationBase>::const_iterator,
+    std::vector<ServiceRegistrationBase>::const_iterator,
+    const std::string&,
+    const std::string&,
+    const LDAPExpr&,
+    BundlePrivate*,
+    std::vector<ServiceReferenceBase>&) const;
 };
 }
 
@@ -23,9 +23,15 @@
 #include "cppmicroservices/Framework.h"
 
 #include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/detail/PerfCounters.h"
 
+#include "BundleOperationScheduler.h"
 #include "FrameworkPrivate.h"
 
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
 namespace cppmicroservices {
 
 namespace {
@@ -34,6 +40,65 @@ FrameworkPrivate* pimpl(const std::shared_ptr<BundlePrivate>& p)
 {
   return static_cast<FrameworkPrivate*>(p.get());
 }
+
+std::vector<std::shared_ptr<BundlePrivate>> GetBundlePrivates(
+  const CoreBundleContext* coreCtx,
+  const std::vector<Bundle>& bundles)
+{
+  std::vector<std::shared_ptr<BundlePrivate>> result;
+  result.reserve(bundles.size());
+  for (const auto& bundle : bundles) {
+    auto b = GetPrivate(bundle);
+    if (!b) {
+      throw std::invalid_argument("invalid bundle");
+    }
+    if (b->coreCtx != coreCtx) {
+      throw std::invalid_argument("Bundle #" + std::to_string(b->id) +
+                                  " is not installed in this framework");
+    }
+    result.push_back(std::move(b));
+  }
+  return result;
+}
+
+/**
+ * Run an operation on bundles in bundle id order, returning the results in
+ * the order of \c bundles.
+ */
+std::vector<BundleOperationResult> RunInBundleIdOrder(
+  const std::vector<std::shared_ptr<BundlePrivate>>& bundles,
+  const std::function<void(BundlePrivate&)>& operation,
+  bool reverse,
+  std::size_t threads)
+{
+  std::vector<std::size_t> positions(bundles.size());
+  std::iota(positions.begin(), positions.end(), 0);
+  std::stable_sort(positions.begin(),
+                   positions.end(),
+                   [&bundles](std::size_t a, std::size_t b) {
+                     return bundles[a]->id < bundles[b]->id;
+                   });
+
+  std::vector<std::shared_ptr<BundlePrivate>> sorted;
+  sorted.reserve(bundles.size());
+  for (auto pos : positions) {
+    sorted.push_back(bundles[pos]);
+  }
+
+  auto sortedResults = RunBundleOperations(sorted, operation, reverse, threads);
+  std::vector<BundleOperationResult> results(bundles.size());
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    results[positions[i]] = std::move(sortedResults[i]);
+  }
+  return results;
+}
+
+std::size_t GetThreadCount(std::size_t threads)
+{
+  return threads != 0
+           ? threads
+           : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
 }
 
 Framework::Framework(const Framework&) = default;
@@ -62,6 +127,87 @@ Framework::Framework(const std::shared_ptr<FrameworkPrivate>& d)
   : Bundle(d)
 {}
 
+ServiceEventDeliveryStats Framework::GetServiceEventDeliveryStats() const
+{
+  return d->coreCtx->listeners.GetServiceEventDeliveryStats();
+}
+
+std::map<std::string, std::size_t> Framework::GetServiceListenerCounts() const
+{
+  return d->coreCtx->listeners.GetServiceListenerCounts();
+}
+
+PerformanceCounters Framework::GetPerformanceCounters() const
+{
+  PerformanceCounters counters;
+  detail::ForEachPerfCounter([&counters](detail::PerfCounter& counter) {
+    auto& value = counters[counter.GetName()];
+    value.count = counter.count.load(std::memory_order_relaxed);
+    value.amount = counter.amount.load(std::memory_order_relaxed);
+    value.duration = std::chrono::nanoseconds(
+      counter.nanos.load(std::memory_order_relaxed));
+    value.maxDuration = std::chrono::nanoseconds(
+      counter.maxNanos.load(std::memory_order_relaxed));
+  });
+  return counters;
+}
+
+void Framework::ResetPerformanceCounters()
+{
+  detail::ForEachPerfCounter(
+    [](detail::PerfCounter& counter) { counter.Reset(); });
+}
+
+std::vector<BundleOperationResult> Framework::StartBundles(
+  const std::vector<Bundle>& bundles,
+  uint32_t options,
+  std::size_t threads)
+{
+  return RunInBundleIdOrder(
+    GetBundlePrivates(d->coreCtx, bundles),
+    [options](BundlePrivate& b) { b.Start(options); },
+    false,
+    GetThreadCount(threads));
+}
+
+std::vector<BundleOperationResult> Framework::StopBundles(
+  const std::vector<Bundle>& bundles,
+  uint32_t options,
+  std::size_t threads)
+{
+  return RunInBundleIdOrder(
+    GetBundlePrivates(d->coreCtx, bundles),
+    [options](BundlePrivate& b) { b.Stop(options); },
+    true,
+    GetThreadCount(threads));
+}
+
+unsigned int Framework::GetStartLevel() const
+{
+  return d->coreCtx->startLevels.GetActiveStartLevel();
+}
+
+void Framework::SetStartLevel(unsigned int startLevel)
+{
+  d->coreCtx->startLevels.SetStartLevel(startLevel);
+}
+
+unsigned int Framework::GetBundleStartLevel(const Bundle& bundle) const
+{
+  return GetBundlePrivates(d->coreCtx, { bundle }).front()->startLevel;
+}
+
+void Framework::SetBundleStartLevel(const Bundle& bundle,
+                                    unsigned int startLevel)
+{
+  auto b = GetBundlePrivates(d->coreCtx, { bundle }).front();
+  if (b->id == 0) {
+    throw std::invalid_argument(
+      "The start level of the system bundle cannot be changed");
+  }
+  d->coreCtx->startLevels.SetBundleStartLevel(b, startLevel);
+}
+
 void Framework::Init()
 {
   pimpl(d)->Init();
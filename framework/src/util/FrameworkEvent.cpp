@@ -104,6 +104,8 @@ std::ostream& operator<<(std::ostream& os, FrameworkEvent::Type eventType)
       return os << "STARTED";
     case FrameworkEvent::Type::FRAMEWORK_ERROR:
       return os << "ERROR";
+    case FrameworkEvent::Type::FRAMEWORK_STARTLEVEL_CHANGED:
+      return os << "STARTLEVEL_CHANGED";
     case FrameworkEvent::Type::FRAMEWORK_WARNING:
       return os << "WARNING";
     case FrameworkEvent::Type::FRAMEWORK_INFO:
@@ -188,26 +188,13 @@ void FrameworkPrivate::Start(uint32_t)
     bundlesToStart = coreCtx->storage->GetStartOnLaunchBundles();
   }
 
-  // Start bundles according to their autostart setting.
+  // Move to the beginning start level, starting bundles according to their
+  // autostart setting once their start level is reached.
+  std::vector<std::shared_ptr<BundlePrivate>> bundles;
   for (auto i : bundlesToStart) {
-    auto b = coreCtx->bundleRegistry.GetBundle(i);
-    try {
-      const int32_t autostartSetting = b->barchive->GetAutostartSetting();
-      // Launch must not change the autostart setting of a bundle
-      int option = Bundle::START_TRANSIENT;
-      if (Bundle::START_ACTIVATION_POLICY == autostartSetting) {
-        // Transient start according to the bundles activation policy.
-        option |= Bundle::START_ACTIVATION_POLICY;
-      }
-      b->Start(option);
-    } catch (...) {
-      coreCtx->listeners.SendFrameworkEvent(
-        FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
-                       MakeBundle(b->shared_from_this()),
-                       std::string(),
-                       std::current_exception()));
-    }
+    bundles.push_back(coreCtx->bundleRegistry.GetBundle(i));
   }
+  coreCtx->startLevels.Open(bundles);
 
   {
     auto l = Lock();
@@ -298,24 +285,9 @@ void FrameworkPrivate::ShutdownDone_unlocked(bool restart)
 
 void FrameworkPrivate::StopAllBundles()
 {
-  // Stop all active bundles, in reverse bundle ID order
-  auto activeBundles = coreCtx->bundleRegistry.GetActiveBundles();
-  for (auto iter = activeBundles.rbegin(); iter != activeBundles.rend();
-       ++iter) {
-    auto b = *iter;
-    try {
-      if (((Bundle::STATE_ACTIVE | Bundle::STATE_STARTING) & b->state) != 0) {
-        // Stop bundle without changing its autostart setting.
-        b->Stop(Bundle::StopOptions::STOP_TRANSIENT);
-      }
-    } catch (...) {
-      coreCtx->listeners.SendFrameworkEvent(
-        FrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
-                                      MakeBundle(b),
-                                      std::string(),
-                                      std::current_exception())));
-    }
-  }
+  // Move down to start level 0, stopping all active bundles level by level,
+  // in reverse registry order unless bundles declare dependencies
+  coreCtx->startLevels.Close();
 
   auto allBundles = coreCtx->bundleRegistry.GetBundles();
 
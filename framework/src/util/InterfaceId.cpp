@@ -0,0 +1,179 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "InterfaceId.h"
+
+#include "cppmicroservices/detail/Threads.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace cppmicroservices {
+
+namespace {
+
+// An interned string. Nodes are immutable once they are published.
+struct Node
+{
+  Node(const std::string& name,
+       std::size_t hash,
+       InterfaceId id,
+       const Node* next)
+    : name(name)
+    , hash(hash)
+    , id(id)
+    , next(next)
+  {}
+
+  const std::string name;
+  const std::size_t hash;
+  const InterfaceId id;
+  const Node* const next;
+};
+
+// A hash table whose buckets only ever grow by publishing a new head node,
+// so it can be read without a lock while a writer inserts.
+struct Buckets
+{
+  explicit Buckets(std::size_t size)
+    : mask(size - 1)
+    , heads(new std::atomic<const Node*>[size])
+  {
+    for (std::size_t i = 0; i < size; ++i) {
+      heads[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  const Node* Find(const std::string& name, std::size_t hash) const
+  {
+    for (auto node = heads[hash & mask].load(std::memory_order_acquire);
+         node != nullptr;
+         node = node->next) {
+      if (node->hash == hash && node->name == name) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  void Insert(const std::string& name, std::size_t hash, InterfaceId id)
+  {
+    auto& head = heads[hash & mask];
+    nodes.emplace_back(
+      new Node(name, hash, id, head.load(std::memory_order_relaxed)));
+    head.store(nodes.back().get(), std::memory_order_release);
+  }
+
+  const std::size_t mask;
+  const std::unique_ptr<std::atomic<const Node*>[]> heads;
+  std::vector<std::unique_ptr<const Node>> nodes;
+  // readers may still walk the smaller tables this one replaced
+  std::unique_ptr<Buckets> replaced;
+};
+
+/*
+ * Interface ids are looked up on every service lookup, so reads do not
+ * take the lock. Writers insert under the lock and replace the buckets
+ * with twice as many once they are full. Replaced buckets are kept, their
+ * total size is smaller than that of the current ones.
+ */
+struct InterfaceIdTable : detail::MultiThreaded<>
+{
+  InterfaceIdTable()
+    : buckets(new Buckets(64))
+  {}
+
+  const Node* Find(const std::string& name, std::size_t hash) const
+  {
+    return current.load(std::memory_order_acquire)->Find(name, hash);
+  }
+
+  InterfaceId Intern_unlocked(const std::string& name, std::size_t hash)
+  {
+    if (auto node = buckets->Find(name, hash)) {
+      return node->id;
+    }
+    const auto id = static_cast<InterfaceId>(count++);
+    if (count > buckets->mask + 1) {
+      std::unique_ptr<Buckets> grown(new Buckets(2 * (buckets->mask + 1)));
+      for (const auto& node : buckets->nodes) {
+        grown->Insert(node->name, node->hash, node->id);
+      }
+      grown->replaced = std::move(buckets);
+      buckets = std::move(grown);
+    }
+    buckets->Insert(name, hash, id);
+    current.store(buckets.get(), std::memory_order_release);
+    return id;
+  }
+
+  std::unique_ptr<Buckets> buckets;
+  std::atomic<const Buckets*> current{ buckets.get() };
+  std::size_t count = 0;
+};
+
+InterfaceIdTable& GetInterfaceIdTable()
+{
+  // Intentionally leaked: frameworks (and their registries) may be
+  // destroyed during static destruction, after a function local static
+  // table would be gone.
+  static auto* table = new InterfaceIdTable;
+  return *table;
+}
+}
+
+InterfaceId InternInterfaceId(const std::string& interfaceId)
+{
+  auto& table = GetInterfaceIdTable();
+  const auto hash = std::hash<std::string>()(interfaceId);
+  if (auto node = table.Find(interfaceId, hash)) {
+    return node->id;
+  }
+  auto l = table.Lock();
+  US_UNUSED(l);
+  return table.Intern_unlocked(interfaceId, hash);
+}
+
+std::vector<InterfaceId> InternInterfaceIds(
+  const std::vector<std::string>& interfaceIds)
+{
+  std::vector<InterfaceId> result;
+  result.reserve(interfaceIds.size());
+  for (const auto& interfaceId : interfaceIds) {
+    result.push_back(InternInterfaceId(interfaceId));
+  }
+  return result;
+}
+
+bool FindInterfaceId(const std::string& interfaceId, InterfaceId& id)
+{
+  auto node = GetInterfaceIdTable().Find(
+    interfaceId, std::hash<std::string>()(interfaceId));
+  if (node == nullptr) {
+    return false;
+  }
+  id = node->id;
+  return true;
+}
+}
@@ -0,0 +1,69 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CPPMICROSERVICES_INTERFACEID_H
+#define CPPMICROSERVICES_INTERFACEID_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cppmicroservices {
+
+/**
+ * A service interface id string (see us_service_interface_iid) interned to
+ * an integer. Equal strings are interned to equal integers, which stay the
+ * same for the lifetime of the process, so the framework can key its internal
+ * tables by InterfaceId and only deal with the string at the API boundary.
+ */
+using InterfaceId = std::uint32_t;
+
+/**
+ * Intern an interface id string.
+ *
+ * @param interfaceId The interface id string.
+ * @return The InterfaceId for the string, which is created if the string
+ *         has not been interned before.
+ */
+InterfaceId InternInterfaceId(const std::string& interfaceId);
+
+/**
+ * Intern the interface id strings of \c interfaceIds.
+ */
+std::vector<InterfaceId> InternInterfaceIds(
+  const std::vector<std::string>& interfaceIds);
+
+/**
+ * Look up the InterfaceId of an interface id string without interning it.
+ * Strings which have never been interned cannot be the key of anything, so
+ * lookups with arbitrary strings need not grow the table. Lookups do not
+ * take a lock, they run concurrently with interning.
+ *
+ * @param interfaceId The interface id string.
+ * @param id Set to the InterfaceId of the string, if there is one.
+ * @return \c true if the string has been interned before.
+ */
+bool FindInterfaceId(const std::string& interfaceId, InterfaceId& id);
+}
+
+#endif // CPPMICROSERVICES_INTERFACEID_H
@@ -24,6 +24,7 @@
 
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/ServiceReference.h"
+#include "cppmicroservices/detail/PerfCounters.h"
 
 #include "LDAPExpr.h"
 #include "Properties.h"
@@ -74,12 +75,14 @@ LDAPFilter::operator bool() const
 
 bool LDAPFilter::Match(const ServiceReferenceBase& reference) const
 {
+  US_PERF_COUNT("ldap.evaluate", 0);
   return ((d) ? d->ldapExpr.Evaluate(reference.d.load()->GetProperties(), false)
               : false);
 }
 
 bool LDAPFilter::Match(const Bundle& bundle) const
 {
+  US_PERF_COUNT("ldap.evaluate", 0);
   return ((d)
             ? d->ldapExpr.Evaluate(
                 PropertiesHandle(Properties(bundle.GetHeaders()), false), false)
@@ -88,6 +91,7 @@ bool LDAPFilter::Match(const Bundle& bundle) const
 
 bool LDAPFilter::Match(const AnyMap& dictionary) const
 {
+  US_PERF_COUNT("ldap.evaluate", 0);
   return ((d) ? d->ldapExpr.Evaluate(
                   PropertiesHandle(Properties(dictionary), false), false)
               : false);
@@ -95,6 +99,7 @@ bool LDAPFilter::Match(const AnyMap& dictionary) const
 
 bool LDAPFilter::MatchCase(const AnyMap& dictionary) const
 {
+  US_PERF_COUNT("ldap.evaluate", 0);
   return ((d) ? d->ldapExpr.Evaluate(
                   PropertiesHandle(Properties(dictionary), false), true)
               : false);
@@ -0,0 +1,113 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/detail/PerfCounters.h"
+
+#include "cppmicroservices/Any.h"
+#include "cppmicroservices/Framework.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace cppmicroservices {
+
+namespace detail {
+
+namespace {
+
+struct PerfCounterRegistry
+{
+  std::mutex mutex;
+  // map nodes are never moved, references to counters stay valid
+  std::map<std::string, PerfCounter> counters;
+};
+
+PerfCounterRegistry& GetRegistry()
+{
+  // intentionally leaked, counters may be used during static destruction
+  static auto* registry = new PerfCounterRegistry();
+  return *registry;
+}
+}
+
+PerfCounter::PerfCounter(std::string name)
+  : count(0)
+  , amount(0)
+  , nanos(0)
+  , maxNanos(0)
+  , name(std::move(name))
+{}
+
+void PerfCounter::Reset() noexcept
+{
+  count = 0;
+  amount = 0;
+  nanos = 0;
+  maxNanos = 0;
+}
+
+PerfCounter& GetPerfCounter(const char* name)
+{
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> l(registry.mutex);
+  auto iter = registry.counters.find(name);
+  if (iter == registry.counters.end()) {
+    iter = registry.counters
+             .emplace(std::piecewise_construct,
+                      std::forward_as_tuple(name),
+                      std::forward_as_tuple(name))
+             .first;
+  }
+  return iter->second;
+}
+
+void ForEachPerfCounter(const std::function<void(PerfCounter&)>& fn)
+{
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> l(registry.mutex);
+  for (auto& counter : registry.counters) {
+    fn(counter.second);
+  }
+}
+}
+
+std::ostream& performance_counters_to_json(std::ostream& os,
+                                           const PerformanceCounters& counters)
+{
+  os << '{';
+  bool first = true;
+  for (const auto& counter : counters) {
+    if (!first) {
+      os << ',';
+    }
+    first = false;
+    any_value_to_json(os, counter.first, 0, 0);
+    os << ":{\"count\":" << counter.second.count
+       << ",\"amount\":" << counter.second.amount
+       << ",\"duration_ns\":" << counter.second.duration.count()
+       << ",\"max_duration_ns\":" << counter.second.maxDuration.count()
+       << '}';
+  }
+  return os << '}';
+}
+}
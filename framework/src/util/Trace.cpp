@@ -0,0 +1,124 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/detail/Trace.h"
+
+#include "cppmicroservices/Any.h"
+
+#include <atomic>
+#include <iomanip>
+#include <stdexcept>
+
+#ifdef US_PLATFORM_WINDOWS
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace cppmicroservices {
+
+namespace detail {
+
+namespace {
+
+// set while a sink is active, so that disabled tracing costs one load
+std::atomic<bool> tracing{ false };
+std::shared_ptr<TraceSink> activeSink;
+
+unsigned long GetThreadNumber()
+{
+  // small numbers read better than hashed thread ids in trace viewers
+  static std::atomic<unsigned long> next{ 1 };
+  thread_local const unsigned long number = next++;
+  return number;
+}
+
+long GetProcessId()
+{
+#ifdef US_PLATFORM_WINDOWS
+  return static_cast<long>(_getpid());
+#else
+  return static_cast<long>(getpid());
+#endif
+}
+
+// Trace timestamps are in microseconds
+void WriteMicros(std::ostream& os, std::chrono::nanoseconds ns)
+{
+  const auto count = ns.count() < 0 ? 0 : ns.count();
+  os << count / 1000 << '.' << std::setw(3) << std::setfill('0')
+     << count % 1000;
+}
+}
+
+TraceSink::TraceSink(const std::string& path)
+  : out(path, std::ios_base::out | std::ios_base::trunc)
+  , origin(std::chrono::steady_clock::now())
+  , empty(true)
+{
+  if (!out) {
+    throw std::runtime_error("Cannot open trace file " + path);
+  }
+  out << "[";
+}
+
+TraceSink::~TraceSink()
+{
+  out << "\n]\n";
+}
+
+void TraceSink::Write(const char* category,
+                      const std::string& name,
+                      std::chrono::steady_clock::time_point start,
+                      std::chrono::steady_clock::time_point end) noexcept
+{
+  try {
+    std::lock_guard<std::mutex> l(mutex);
+    out << (empty ? "\n" : ",\n") << "{\"name\":";
+    any_value_to_json(out, name, 0, 0);
+    out << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"ts\":";
+    WriteMicros(out, start - origin);
+    out << ",\"dur\":";
+    WriteMicros(out, end - start);
+    out << ",\"pid\":" << GetProcessId() << ",\"tid\":" << GetThreadNumber()
+        << "}";
+    empty = false;
+  } catch (...) {
+    // tracing must not disturb the traced code
+  }
+}
+
+std::shared_ptr<TraceSink> GetTraceSink() noexcept
+{
+  if (!tracing.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return std::atomic_load(&activeSink);
+}
+
+void SetTraceSink(std::shared_ptr<TraceSink> sink) noexcept
+{
+  tracing = sink != nullptr;
+  std::atomic_store(&activeSink, std::move(sink));
+}
+}
+}
@@ -5,6 +5,7 @@
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/FrameworkFactory.h>
 #include <cppmicroservices/ServiceTracker.h>
+#include <cppmicroservices/detail/Log.h>
 
 #include <chrono>
 #include <unordered_set>
@@ -190,6 +191,159 @@ BENCHMARK_DEFINE_F(ServiceTrackerFixture,
   }
 }
 
+/// Benchmark getting the cached service of a tracker, which logs a
+/// diagnostic message if the framework log is enabled (it is not here)
+BENCHMARK_DEFINE_F(ServiceTrackerFixture, GetCachedService)
+(benchmark::State& state)
+{
+  using namespace benchmark::test;
+  using namespace cppmicroservices;
+
+  auto fc = framework->GetBundleContext();
+  auto serviceReg = fc.RegisterService<Foo>(std::make_shared<FooImpl>());
+  ServiceTracker<Foo> fooTracker(fc);
+  fooTracker.Open();
+  benchmark::DoNotOptimize(fooTracker.GetService());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fooTracker.GetService());
+  }
+
+  fooTracker.Close();
+}
+
+/// Benchmark listing the services of a tracker which tracks state.range(0)
+/// services, either as a new vector or as the shared snapshot
+BENCHMARK_DEFINE_F(ServiceTrackerFixture, GetServices)
+(benchmark::State& state)
+{
+  using namespace benchmark::test;
+  using namespace cppmicroservices;
+
+  auto fc = framework->GetBundleContext();
+  std::vector<ServiceRegistration<Foo>> regs;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    regs.push_back(fc.RegisterService<Foo>(std::make_shared<FooImpl>()));
+  }
+  ServiceTracker<Foo> fooTracker(fc);
+  fooTracker.Open();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fooTracker.GetServices());
+  }
+
+  fooTracker.Close();
+}
+
+BENCHMARK_DEFINE_F(ServiceTrackerFixture, GetSnapshot)
+(benchmark::State& state)
+{
+  using namespace benchmark::test;
+  using namespace cppmicroservices;
+
+  auto fc = framework->GetBundleContext();
+  std::vector<ServiceRegistration<Foo>> regs;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    regs.push_back(fc.RegisterService<Foo>(std::make_shared<FooImpl>()));
+  }
+  ServiceTracker<Foo> fooTracker(fc);
+  fooTracker.Open();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fooTracker.GetSnapshot());
+  }
+
+  fooTracker.Close();
+}
+
+namespace {
+
+/// Tracks a single registered service for the multi-threaded benchmarks
+/// below. Set up and torn down by the first benchmark thread.
+struct SharedTracker
+{
+  SharedTracker()
+    : framework(cppmicroservices::FrameworkFactory().NewFramework())
+  {
+    using namespace benchmark::test;
+    framework.Start();
+    auto fc = framework.GetBundleContext();
+    serviceReg = fc.RegisterService<Foo>(std::make_shared<FooImpl>());
+    tracker =
+      std::make_unique<cppmicroservices::ServiceTracker<Foo>>(fc);
+    tracker->Open();
+  }
+
+  ~SharedTracker()
+  {
+    tracker.reset();
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  cppmicroservices::Framework framework;
+  cppmicroservices::ServiceRegistration<benchmark::test::Foo> serviceReg;
+  std::unique_ptr<cppmicroservices::ServiceTracker<benchmark::test::Foo>>
+    tracker;
+};
+
+std::unique_ptr<SharedTracker> sharedTracker;
+}
+
+/// Benchmark getting the cached service of a tracker from several threads
+static void GetCachedServiceThreaded(benchmark::State& state)
+{
+  if (state.thread_index() == 0) {
+    sharedTracker = std::make_unique<SharedTracker>();
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sharedTracker->tracker->GetService());
+  }
+
+  if (state.thread_index() == 0) {
+    sharedTracker.reset();
+  }
+}
+
+/// Benchmark borrowing the cached service of a tracker from several
+/// threads. Compare with GetCachedServiceThreaded.
+static void BorrowCachedService(benchmark::State& state)
+{
+  if (state.thread_index() == 0) {
+    sharedTracker = std::make_unique<SharedTracker>();
+  }
+
+  for (auto _ : state) {
+    auto service = sharedTracker->tracker->Borrow();
+    benchmark::DoNotOptimize(service.Get());
+  }
+
+  if (state.thread_index() == 0) {
+    sharedTracker.reset();
+  }
+}
+
+/// A log statement like the ones in ServiceTracker::GetService, with a
+/// disabled sink. Compare with NoDiagLog.
+static void DisabledDiagLog(benchmark::State& state)
+{
+  cppmicroservices::detail::LogSink sink(&std::clog, false);
+  const std::string filter("(objectclass=benchmark::test::Foo)");
+
+  for (auto _ : state) {
+    DIAG_LOG(sink) << "ServiceTracker<S,TTT>::getService[cached]:" << filter;
+    benchmark::ClobberMemory();
+  }
+}
+
+static void NoDiagLog(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::ClobberMemory();
+  }
+}
+
 static void CloseServiceTracker(benchmark::State& state)
 {
   using namespace std::chrono;
@@ -228,6 +382,17 @@ BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithBundleContext)
   ->UseManualTime();
 BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithInterfaceName)
   ->UseManualTime();
+BENCHMARK_REGISTER_F(ServiceTrackerFixture, GetCachedService);
+BENCHMARK(GetCachedServiceThreaded)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BorrowCachedService)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_REGISTER_F(ServiceTrackerFixture, GetServices)
+  ->RangeMultiplier(10)
+  ->Range(1, 1000);
+BENCHMARK_REGISTER_F(ServiceTrackerFixture, GetSnapshot)
+  ->RangeMultiplier(10)
+  ->Range(1, 1000);
+BENCHMARK(DisabledDiagLog);
+BENCHMARK(NoDiagLog);
 BENCHMARK(CloseServiceTracker)
   ->RangeMultiplier(2)
   ->Range(1000, 1000000);
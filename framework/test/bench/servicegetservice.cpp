@@ -0,0 +1,113 @@
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/ServiceFactory.h>
+#include <cppmicroservices/ServiceReference.h>
+
+#include <chrono>
+
+#include "benchmark/benchmark.h"
+
+#include "fooservice.h"
+
+namespace {
+
+// Returns the same object to every bundle, but being a ServiceFactory
+// it forces BundleContext::GetService through the general code path.
+class FooFactory : public cppmicroservices::ServiceFactory
+{
+public:
+  cppmicroservices::InterfaceMapConstPtr GetService(
+    const cppmicroservices::Bundle&,
+    const cppmicroservices::ServiceRegistrationBase&) override
+  {
+    return cppmicroservices::MakeInterfaceMap<benchmark::test::Foo>(foo);
+  }
+
+  void UngetService(const cppmicroservices::Bundle&,
+                    const cppmicroservices::ServiceRegistrationBase&,
+                    const cppmicroservices::InterfaceMapConstPtr&) override
+  {}
+
+private:
+  std::shared_ptr<benchmark::test::FooImpl> foo =
+    std::make_shared<benchmark::test::FooImpl>();
+};
+
+class GetServiceFixture : public ::benchmark::Fixture
+{
+public:
+  using benchmark::Fixture::SetUp;
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(const ::benchmark::State&)
+  {
+    using namespace cppmicroservices;
+    using namespace benchmark::test;
+
+    framework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+    framework->Start();
+    auto context = framework->GetBundleContext();
+    singletonRef =
+      context.RegisterService<Foo>(std::make_shared<FooImpl>()).GetReference();
+    factoryRef =
+      context.RegisterService<Foo>(ToFactory(std::make_shared<FooFactory>()))
+        .GetReference();
+  }
+
+  void TearDown(const ::benchmark::State&)
+  {
+    using namespace std::chrono;
+
+    singletonRef = nullptr;
+    factoryRef = nullptr;
+    framework->Stop();
+    framework->WaitForStop(milliseconds::zero());
+  }
+
+  ~GetServiceFixture() = default;
+
+  std::shared_ptr<cppmicroservices::Framework> framework;
+  cppmicroservices::ServiceReference<benchmark::test::Foo> singletonRef;
+  cppmicroservices::ServiceReference<benchmark::test::Foo> factoryRef;
+};
+}
+
+// The bundle already uses the service: shares its holder without allocating
+// or locking the registration.
+BENCHMARK_DEFINE_F(GetServiceFixture, GetSingletonServiceInUse)
+(benchmark::State& state)
+{
+  auto context = framework->GetBundleContext();
+  auto inUse = context.GetService(singletonRef);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(context.GetService(singletonRef));
+  }
+}
+
+// Every call starts and ends a use of the service.
+BENCHMARK_DEFINE_F(GetServiceFixture, GetSingletonServiceFirstUse)
+(benchmark::State& state)
+{
+  auto context = framework->GetBundleContext();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(context.GetService(singletonRef));
+  }
+}
+
+// The general code path, which every service used to take.
+BENCHMARK_DEFINE_F(GetServiceFixture, GetFactoryServiceInUse)
+(benchmark::State& state)
+{
+  auto context = framework->GetBundleContext();
+  auto inUse = context.GetService(factoryRef);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(context.GetService(factoryRef));
+  }
+}
+
+// Register benchmark functions
+BENCHMARK_REGISTER_F(GetServiceFixture, GetSingletonServiceInUse);
+BENCHMARK_REGISTER_F(GetServiceFixture, GetSingletonServiceFirstUse);
+BENCHMARK_REGISTER_F(GetServiceFixture, GetFactoryServiceInUse);
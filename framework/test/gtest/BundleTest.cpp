@@ -31,6 +31,7 @@
 #include "cppmicroservices/GetBundleContext.h"
 #include "cppmicroservices/ListenerToken.h"
 #include "cppmicroservices/ServiceEvent.h"
+#include "cppmicroservices/ServiceFactory.h"
 
 #include "cppmicroservices/util/FileSystem.h"
 #include "cppmicroservices/util/String.h"
@@ -688,6 +689,89 @@ TEST_F(BundleTest, TestBundleStartOptions)
     cppmicroservices::Bundle::StartOptions::START_ACTIVATION_POLICY));
 }
 
+#if defined(US_BUILD_SHARED_LIBS)
+namespace {
+struct LazyTestService
+{
+  virtual ~LazyTestService() = default;
+};
+
+class LazyTestFactory : public ServiceFactory
+{
+public:
+  InterfaceMapConstPtr GetService(const Bundle&,
+                                  const ServiceRegistrationBase&) override
+  {
+    return MakeInterfaceMap<LazyTestService>(
+      std::make_shared<LazyTestService>());
+  }
+
+  void UngetService(const Bundle&,
+                    const ServiceRegistrationBase&,
+                    const InterfaceMapConstPtr&) override
+  {}
+};
+}
+
+TEST_F(BundleTest, TestBundleLazyActivation)
+{
+  AnyMap manifest(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  manifest["bundle.symbolic_name"] = std::string("TestBundleA");
+  manifest["bundle.activator"] = true;
+  manifest[Constants::BUNDLE_ACTIVATIONPOLICY] = Constants::ACTIVATION_LAZY;
+  AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  manifests["TestBundleA"] = manifest;
+
+  auto bundle = InstallLib(context, "TestBundleA", manifests);
+  TestBundleListener listener;
+  auto token = context.AddBundleListener(std::bind(
+    &TestBundleListener::BundleChanged, &listener, std::placeholders::_1));
+
+  // The activation policy is only honored when asked for.
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  ASSERT_EQ(Bundle::STATE_STARTING, bundle.GetState());
+  ASSERT_TRUE(bundle.GetBundleContext());
+  ASSERT_FALSE(
+    context.GetServiceReference("cppmicroservices::TestBundleAService"));
+
+  // Starting it again lazily has no effect.
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  ASSERT_EQ(Bundle::STATE_STARTING, bundle.GetState());
+
+  // The first request for a service factory registered by the bundle
+  // activates it.
+  bundle.GetBundleContext().RegisterService<LazyTestService>(
+    ToFactory(std::make_shared<LazyTestFactory>()));
+  auto ref = context.GetServiceReference<LazyTestService>();
+  ASSERT_TRUE(ref);
+  ASSERT_EQ(Bundle::STATE_STARTING, bundle.GetState());
+  ASSERT_TRUE(context.GetService(ref));
+  ASSERT_EQ(Bundle::STATE_ACTIVE, bundle.GetState());
+  ASSERT_TRUE(
+    context.GetServiceReference("cppmicroservices::TestBundleAService"));
+
+  std::vector<BundleEvent> events;
+  events.emplace_back(BundleEvent::BUNDLE_RESOLVED, bundle);
+  events.emplace_back(BundleEvent::BUNDLE_LAZY_ACTIVATION, bundle);
+  events.emplace_back(BundleEvent::BUNDLE_STARTING, bundle);
+  events.emplace_back(BundleEvent::BUNDLE_STARTED, bundle);
+  ASSERT_TRUE(listener.CheckListenerEvents(events));
+
+  // A stopped lazy bundle goes back to RESOLVED and an eager start
+  // activates it immediately.
+  bundle.Stop();
+  ASSERT_EQ(Bundle::STATE_RESOLVED, bundle.GetState());
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  ASSERT_EQ(Bundle::STATE_STARTING, bundle.GetState());
+  bundle.Stop();
+  ASSERT_EQ(Bundle::STATE_RESOLVED, bundle.GetState());
+  bundle.Start();
+  ASSERT_EQ(Bundle::STATE_ACTIVE, bundle.GetState());
+
+  context.RemoveListener(std::move(token));
+}
+#endif
+
 TEST_F(BundleTest, TestBundleLessThanOperator)
 {
 
@@ -21,8 +21,10 @@ limitations under the License.
 =============================================================================*/
 
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <mutex>
+#include <sstream>
 #include <thread>
 #include <type_traits>
 
@@ -36,6 +38,8 @@ limitations under the License.
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/SecurityException.h"
+#include "cppmicroservices/detail/PerfCounters.h"
+#include "cppmicroservices/detail/Trace.h"
 #include "cppmicroservices/logservice/LogService.hpp"
 #include "cppmicroservices/util/FileSystem.h"
 
@@ -518,6 +522,182 @@ TEST(Framework, LifeCycle)
             Bundle::STATE_ACTIVE); // "Check framework is not active"
 }
 
+TEST(FrameworkTest, StartAndStopBundles)
+{
+  auto f = FrameworkFactory().NewFramework();
+  f.Start();
+  auto context = f.GetBundleContext();
+
+  std::vector<Bundle> bundles{
+    cppmicroservices::testing::InstallLib(context, "TestBundleA"),
+    cppmicroservices::testing::InstallLib(context, "TestBundleStartFail"),
+    cppmicroservices::testing::InstallLib(context, "TestBundleH")
+  };
+
+  auto results = f.StartBundles(bundles, 0, 2);
+  ASSERT_EQ(results.size(), bundles.size());
+  for (std::size_t i = 0; i < bundles.size(); ++i) {
+    ASSERT_EQ(results[i].bundle, bundles[i]);
+    ASSERT_GT(results[i].duration.count(), 0);
+  }
+  ASSERT_EQ(results[0].exception, nullptr);
+  ASSERT_NE(results[1].exception, nullptr);
+  ASSERT_EQ(results[2].exception, nullptr);
+  ASSERT_EQ(bundles[0].GetState(), Bundle::STATE_ACTIVE);
+  ASSERT_EQ(bundles[1].GetState(), Bundle::STATE_RESOLVED);
+  ASSERT_EQ(bundles[2].GetState(), Bundle::STATE_ACTIVE);
+
+  results = f.StopBundles(bundles);
+  ASSERT_EQ(results.size(), bundles.size());
+  for (std::size_t i = 0; i < bundles.size(); ++i) {
+    ASSERT_EQ(results[i].bundle, bundles[i]);
+    ASSERT_EQ(results[i].exception, nullptr);
+    ASSERT_EQ(bundles[i].GetState(), Bundle::STATE_RESOLVED);
+  }
+
+  ASSERT_THROW(f.StartBundles({ Bundle() }), std::invalid_argument);
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(FrameworkTest, PerformanceCounters)
+{
+  auto f = FrameworkFactory().NewFramework();
+  f.Start();
+  f.ResetPerformanceCounters();
+
+  auto& counter = detail::GetPerfCounter("test.counter");
+  counter.Add(3);
+  counter.Add(2, std::chrono::milliseconds(1));
+  auto counters = f.GetPerformanceCounters();
+  ASSERT_EQ(counters.count("test.counter"), 1u);
+  const auto value = counters["test.counter"];
+  ASSERT_EQ(value.count, 2u);
+  ASSERT_EQ(value.amount, 5u);
+  ASSERT_EQ(value.duration, std::chrono::milliseconds(1));
+  ASSERT_EQ(value.maxDuration, std::chrono::milliseconds(1));
+
+  std::ostringstream json;
+  performance_counters_to_json(json, { { "test.counter", value } });
+  ASSERT_EQ(json.str(),
+            "{\"test.counter\":{\"count\":2,\"amount\":5,"
+            "\"duration_ns\":1000000,\"max_duration_ns\":1000000}}");
+
+#ifdef US_ENABLE_PERF_COUNTERS
+  auto bundle =
+    cppmicroservices::testing::InstallLib(f.GetBundleContext(), "TestBundleA");
+  bundle.Start();
+  counters = f.GetPerformanceCounters();
+  ASSERT_GE(counters["bundle.install"].count, 1u);
+  ASSERT_EQ(counters["bundle.start"].count, 1u);
+  ASSERT_GT(counters["bundle.start"].duration.count(), 0);
+#endif
+
+  f.ResetPerformanceCounters();
+  ASSERT_EQ(f.GetPerformanceCounters()["test.counter"].count, 0u);
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(FrameworkTest, TraceFile)
+{
+  TempDir dir(MakeUniqueTempDirectory());
+  const auto traceFile = dir.Path + util::DIR_SEP + "trace.json";
+  FrameworkConfiguration configuration;
+  configuration[Constants::FRAMEWORK_TRACE_FILE] = traceFile;
+
+  auto f = FrameworkFactory().NewFramework(configuration);
+  f.Start();
+  ASSERT_NE(detail::GetTraceSink(), nullptr);
+  auto bundle =
+    cppmicroservices::testing::InstallLib(f.GetBundleContext(), "TestBundleA");
+  bundle.Start();
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+  ASSERT_EQ(detail::GetTraceSink(), nullptr);
+
+  std::ifstream in(traceFile);
+  std::stringstream trace;
+  trace << in.rdbuf();
+  const auto events = trace.str();
+  ASSERT_EQ(events.front(), '[');
+  ASSERT_EQ(events.substr(events.size() - 2), "]\n");
+  ASSERT_NE(events.find("{\"name\":\"start TestBundleA\",\"cat\":\"bundle\","
+                        "\"ph\":\"X\""),
+            std::string::npos);
+  ASSERT_NE(events.find("{\"name\":\"stop TestBundleA\""), std::string::npos);
+}
+
+TEST(FrameworkTest, StartLevels)
+{
+  auto f = FrameworkFactory().NewFramework();
+  ASSERT_EQ(f.GetStartLevel(), 0u);
+  ASSERT_THROW(f.SetStartLevel(2), std::logic_error);
+
+  f.Start();
+  ASSERT_EQ(f.GetStartLevel(), 1u);
+  auto context = f.GetBundleContext();
+
+  std::mutex m;
+  std::condition_variable cv;
+  unsigned int changes = 0;
+  auto token = context.AddFrameworkListener([&](const FrameworkEvent& evt) {
+    if (evt.GetType() == FrameworkEvent::FRAMEWORK_STARTLEVEL_CHANGED) {
+      {
+        std::lock_guard<std::mutex> l(m);
+        ++changes;
+      }
+      cv.notify_all();
+    }
+  });
+  // Start level changes are asynchronous, wait for the event
+  auto setStartLevel = [&](unsigned int level) {
+    std::unique_lock<std::mutex> l(m);
+    const auto expected = changes + 1;
+    l.unlock();
+    f.SetStartLevel(level);
+    l.lock();
+    cv.wait(l, [&] { return changes == expected; });
+  };
+
+  auto bundleA = cppmicroservices::testing::InstallLib(context, "TestBundleA");
+  ASSERT_EQ(f.GetBundleStartLevel(f), 0u);
+  ASSERT_EQ(f.GetBundleStartLevel(bundleA), 1u);
+
+  f.SetBundleStartLevel(bundleA, 2);
+  ASSERT_EQ(f.GetBundleStartLevel(bundleA), 2u);
+  bundleA.Start();
+  ASSERT_NE(bundleA.GetState(), Bundle::STATE_ACTIVE);
+  ASSERT_THROW(bundleA.Start(Bundle::START_TRANSIENT), std::runtime_error);
+
+  setStartLevel(2);
+  ASSERT_EQ(f.GetStartLevel(), 2u);
+  ASSERT_EQ(bundleA.GetState(), Bundle::STATE_ACTIVE);
+
+  setStartLevel(1);
+  ASSERT_EQ(f.GetStartLevel(), 1u);
+  ASSERT_EQ(bundleA.GetState(), Bundle::STATE_RESOLVED);
+
+  // Requests are processed in order, the bundle is started before the
+  // start level change is reported
+  f.SetBundleStartLevel(bundleA, 1);
+  setStartLevel(1);
+  ASSERT_EQ(bundleA.GetState(), Bundle::STATE_ACTIVE);
+
+  ASSERT_THROW(f.SetStartLevel(0), std::invalid_argument);
+  ASSERT_THROW(f.SetBundleStartLevel(bundleA, 0), std::invalid_argument);
+  ASSERT_THROW(f.SetBundleStartLevel(f, 2), std::invalid_argument);
+  ASSERT_THROW(f.GetBundleStartLevel(Bundle()), std::invalid_argument);
+
+  context.RemoveListener(std::move(token));
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+  ASSERT_EQ(f.GetStartLevel(), 0u);
+  ASSERT_EQ(bundleA.GetState(), Bundle::STATE_INSTALLED);
+}
+
 #ifdef US_ENABLE_THREADING_SUPPORT
 
 TEST(FrameworkTest, ConcurrentFrameworkStart)
@@ -0,0 +1,200 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "InterfaceId.h"
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppmicroservices;
+
+// The interning table is process wide, so every test uses names which
+// no other test interns.
+
+TEST(InterfaceIdTest, FindMissDoesNotIntern)
+{
+  const std::string name = "InterfaceIdTest::NeverInterned";
+  InterfaceId id = 42;
+  ASSERT_FALSE(FindInterfaceId(name, id));
+  ASSERT_EQ(id, 42u) << "A miss must not touch the out parameter";
+  ASSERT_FALSE(FindInterfaceId(name, id))
+    << "Lookups must not intern the string";
+  ASSERT_FALSE(FindInterfaceId("", id));
+}
+
+TEST(InterfaceIdTest, StableIds)
+{
+  const std::string name = "InterfaceIdTest::Stable";
+  const auto id = InternInterfaceId(name);
+  ASSERT_EQ(InternInterfaceId(name), id);
+
+  InterfaceId found;
+  ASSERT_TRUE(FindInterfaceId(name, found));
+  ASSERT_EQ(found, id);
+
+  // grow the table well past its initial bucket count; ids interned
+  // before the growth must not change
+  std::vector<InterfaceId> ids;
+  for (int i = 0; i < 1000; ++i) {
+    ids.push_back(
+      InternInterfaceId("InterfaceIdTest::Stable" + std::to_string(i)));
+  }
+  ASSERT_EQ(std::set<InterfaceId>(ids.begin(), ids.end()).size(), ids.size());
+  ASSERT_EQ(ids.end(), std::find(ids.begin(), ids.end(), id));
+
+  ASSERT_TRUE(FindInterfaceId(name, found));
+  ASSERT_EQ(found, id);
+  for (int i = 0; i < 1000; ++i) {
+    const auto other = "InterfaceIdTest::Stable" + std::to_string(i);
+    ASSERT_TRUE(FindInterfaceId(other, found));
+    ASSERT_EQ(found, ids[i]);
+    ASSERT_EQ(InternInterfaceId(other), ids[i]);
+  }
+
+  ASSERT_EQ(InternInterfaceIds({ name, "InterfaceIdTest::Stable7", name }),
+            std::vector<InterfaceId>({ id, ids[7], id }));
+}
+
+TEST(InterfaceIdTest, ConcurrentInterningOfSameName)
+{
+  const std::string name = "InterfaceIdTest::Same";
+  const int threadCount = 8;
+  std::vector<InterfaceId> ids(threadCount);
+  std::vector<int> failures(threadCount, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&ids, &failures, &name, t] {
+      ids[t] = InternInterfaceId(name);
+      for (int i = 0; i < 1000; ++i) {
+        InterfaceId found;
+        if (!FindInterfaceId(name, found) || found != ids[t] ||
+            InternInterfaceId(name) != ids[t]) {
+          ++failures[t];
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  InterfaceId id;
+  ASSERT_TRUE(FindInterfaceId(name, id));
+  for (int t = 0; t < threadCount; ++t) {
+    ASSERT_EQ(failures[t], 0);
+    ASSERT_EQ(ids[t], id);
+  }
+}
+
+TEST(InterfaceIdTest, ConcurrentInterningOfDifferentNames)
+{
+  // every thread interns its own names, growing the table while the
+  // other threads look up theirs
+  const int threadCount = 8;
+  const int namesPerThread = 500;
+  std::vector<std::vector<InterfaceId>> ids(threadCount);
+  std::vector<int> failures(threadCount, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&ids, &failures, t] {
+      auto name = [t](int i) {
+        return "InterfaceIdTest::Different" + std::to_string(t) + "_" +
+               std::to_string(i);
+      };
+      for (int i = 0; i < namesPerThread; ++i) {
+        ids[t].push_back(InternInterfaceId(name(i)));
+        for (int j = 0; j <= i; j += 7) {
+          InterfaceId found;
+          if (!FindInterfaceId(name(j), found) || found != ids[t][j]) {
+            ++failures[t];
+          }
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  std::set<InterfaceId> all;
+  for (int t = 0; t < threadCount; ++t) {
+    ASSERT_EQ(failures[t], 0);
+    all.insert(ids[t].begin(), ids[t].end());
+  }
+  ASSERT_EQ(all.size(),
+            static_cast<std::size_t>(threadCount * namesPerThread));
+}
+
+namespace {
+struct InterfaceIdTestService
+{
+  virtual ~InterfaceIdTestService() = default;
+};
+struct InterfaceIdTestServiceImpl : InterfaceIdTestService
+{};
+}
+
+TEST(InterfaceIdTest, TemplateLookupBeforeRegistration)
+{
+  // the template lookups remember the interned id of their interface,
+  // a lookup before the interface was ever interned must not remember
+  // the miss
+  auto f = FrameworkFactory().NewFramework();
+  f.Start();
+  auto context = f.GetBundleContext();
+
+  ASSERT_FALSE(context.GetServiceReference<InterfaceIdTestService>());
+  ASSERT_TRUE(context.GetServiceReferences<InterfaceIdTestService>().empty());
+
+  auto reg = context.RegisterService<InterfaceIdTestService>(
+    std::make_shared<InterfaceIdTestServiceImpl>());
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(context.GetServiceReference<InterfaceIdTestService>(),
+              reg.GetReference());
+    ASSERT_EQ(context.GetServiceReferences<InterfaceIdTestService>().size(),
+              1u);
+    ASSERT_EQ(context
+                .GetServiceReferences<InterfaceIdTestService>(
+                  "(service.id=0)")
+                .size(),
+              0u);
+  }
+
+  reg.Unregister();
+  ASSERT_FALSE(context.GetServiceReference<InterfaceIdTestService>());
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
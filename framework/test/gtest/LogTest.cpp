@@ -46,9 +46,11 @@ TEST(LogTest, testDefaultLogMessages)
   ASSERT_NE(std::string::npos,
             temp_buf.str().find(std::string("blaaaaaaaaaaaaaaaaaah\n")));
 
+#ifdef US_ENABLE_DIAG_LOG
   //Test default log sink macro
   ASSERT_NE(std::string::npos, temp_buf.str().find(std::string(__FUNCTION__)));
   ASSERT_NE(std::string::npos, temp_buf.str().find(std::string(__FILE__)));
+#endif
 }
 
 TEST(LogTest, testLogDisabled)
@@ -69,6 +71,31 @@ TEST(LogTest, testLogDisabled)
   ASSERT_TRUE(empty_stream.str().empty());
 }
 
+TEST(LogTest, testLogArgumentsNotEvaluatedIfDisabled)
+{
+  int evaluated = 0;
+  auto message = [&evaluated]() { return ++evaluated; };
+
+  std::ostringstream stream;
+  detail::LogSink sink_disabled(&stream);
+  DIAG_LOG(sink_disabled) << message();
+  ASSERT_EQ(0, evaluated);
+  ASSERT_TRUE(stream.str().empty());
+
+  // DIAG_LOG is an expression, an unbraced if must not capture an else
+  detail::LogSink sink_enabled(&stream, true);
+  if (evaluated == 0)
+    DIAG_LOG(sink_enabled) << message();
+  else
+    FAIL() << "DIAG_LOG captured the else branch";
+#ifdef US_ENABLE_DIAG_LOG
+  ASSERT_EQ(1, evaluated);
+#else
+  ASSERT_EQ(0, evaluated);
+#endif
+}
+
+#ifdef US_ENABLE_DIAG_LOG
 TEST(LogTest, testLogRedirection)
 {
   const char* test_filename = "foo.txt";
@@ -124,7 +151,9 @@ TEST(LogTest, testLogRedirection)
             local_cerr_buffer.str().find(test_log_output.str()));
 }
 
-#ifdef US_ENABLE_THREADING_SUPPORT
+#endif
+
+#if defined(US_ENABLE_THREADING_SUPPORT) && defined(US_ENABLE_DIAG_LOG)
 // hammer the logger from multiple threads. A failure in
 // thread safety will most likely manifest as either a crash
 // or the output validation will see splicing of log lines.
@@ -31,6 +31,7 @@
 #include "cppmicroservices/LDAPProp.h"
 #include "cppmicroservices/ServiceEvent.h"
 #include "cppmicroservices/ServiceEventListenerHook.h"
+#include "cppmicroservices/ServiceFactory.h"
 #include "cppmicroservices/ServiceFindHook.h"
 #include "cppmicroservices/ServiceListenerHook.h"
 
@@ -453,6 +454,120 @@ TEST_F(ServiceHooksTest, TestFindHook)
                                 &TestServiceListener::ServiceChanged);
 }
 
+TEST_F(ServiceHooksTest, TestFindHookRankingChange)
+{
+  // find hooks are only called when there are services to filter
+  auto bundle = cppmicroservices::testing::InstallLib(context, "TestBundleA");
+  bundle.Start();
+
+  TestServiceFindHook::ordering.clear();
+
+  auto serviceFindHook1 = std::make_shared<TestServiceFindHook>(1, context);
+  ServiceProperties hookProps1;
+  hookProps1[Constants::SERVICE_RANKING] = 0;
+  ServiceRegistration<ServiceFindHook> findHookReg1 =
+    context.RegisterService<ServiceFindHook>(serviceFindHook1, hookProps1);
+
+  auto serviceFindHook2 = std::make_shared<TestServiceFindHook>(2, context);
+  ServiceProperties hookProps2;
+  hookProps2[Constants::SERVICE_RANKING] = 10;
+  ServiceRegistration<ServiceFindHook> findHookReg2 =
+    context.RegisterService<ServiceFindHook>(serviceFindHook2, hookProps2);
+
+  context.GetServiceReferences("cppmicroservices::TestBundleAService");
+  ASSERT_EQ(TestServiceFindHook::ordering, std::vector<int>({ 2, 1 }));
+
+  // re-ranking a hook must be picked up by the next lookup
+  hookProps1[Constants::SERVICE_RANKING] = 20;
+  findHookReg1.SetProperties(hookProps1);
+
+  TestServiceFindHook::ordering.clear();
+  context.GetServiceReferences("cppmicroservices::TestBundleAService");
+  ASSERT_EQ(TestServiceFindHook::ordering, std::vector<int>({ 1, 2 }));
+
+  // and so must unregistering one
+  findHookReg1.Unregister();
+
+  TestServiceFindHook::ordering.clear();
+  context.GetServiceReferences("cppmicroservices::TestBundleAService");
+  ASSERT_EQ(TestServiceFindHook::ordering, std::vector<int>({ 2 }));
+
+  findHookReg2.Unregister();
+
+  TestServiceFindHook::ordering.clear();
+  context.GetServiceReferences("cppmicroservices::TestBundleAService");
+  ASSERT_TRUE(TestServiceFindHook::ordering.empty());
+
+  bundle.Stop();
+}
+
+TEST_F(ServiceHooksTest, TestFindHookUseCount)
+{
+  // The framework holds one use of each find hook, however often it
+  // rebuilds its list of find hooks. It gives that use back when it
+  // shuts down, before the hook is unregistered.
+  struct NoopFindHook : public ServiceFindHook
+  {
+    void Find(const BundleContext&,
+              const std::string&,
+              const std::string&,
+              ShrinkableVector<ServiceReferenceBase>&) override
+    {}
+  };
+
+  struct FindHookFactory : public ServiceFactory
+  {
+    InterfaceMapConstPtr GetService(
+      const Bundle& /*bundle*/,
+      const ServiceRegistrationBase& /*registration*/) override
+    {
+      ++gets;
+      return MakeInterfaceMap<ServiceFindHook>(
+        std::make_shared<NoopFindHook>());
+    }
+
+    void UngetService(const Bundle& /*bundle*/,
+                      const ServiceRegistrationBase& registration,
+                      const InterfaceMapConstPtr& /*service*/) override
+    {
+      ++ungets;
+      try {
+        registration.GetReference();
+        ungotWhileRegistered = true;
+      } catch (const std::logic_error&) {
+      }
+    }
+
+    int gets = 0;
+    int ungets = 0;
+    bool ungotWhileRegistered = false;
+  };
+
+  auto bundle = cppmicroservices::testing::InstallLib(context, "TestBundleA");
+  bundle.Start();
+
+  auto factory = std::make_shared<FindHookFactory>();
+  auto frameworkContext = framework.GetBundleContext();
+  frameworkContext.RegisterService<ServiceFindHook>(ToFactory(factory));
+
+  for (int i = 0; i < 5; ++i) {
+    context.GetServiceReferences("cppmicroservices::TestBundleAService");
+    // registering another find hook makes the framework rebuild its list
+    auto otherReg = context.RegisterService<ServiceFindHook>(
+      std::make_shared<NoopFindHook>());
+    context.GetServiceReferences("cppmicroservices::TestBundleAService");
+    otherReg.Unregister();
+  }
+  ASSERT_EQ(factory->gets, 1);
+  ASSERT_EQ(factory->ungets, 0);
+
+  bundle.Stop();
+  framework.Stop();
+  framework.WaitForStop(std::chrono::milliseconds::zero());
+  ASSERT_EQ(factory->ungets, 1);
+  ASSERT_TRUE(factory->ungotWhileRegistered);
+}
+
 TEST_F(ServiceHooksTest, TestEventListenerHook)
 {
   TestServiceListener serviceListener1;
@@ -27,6 +27,7 @@
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/GetBundleContext.h"
+#include "cppmicroservices/LDAPProp.h"
 #include "cppmicroservices/ServiceEvent.h"
 #include "cppmicroservices/SharedLibrary.h"
 
@@ -36,6 +37,12 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 US_MSVC_PUSH_DISABLE_WARNING(4996)
 
 using namespace cppmicroservices;
@@ -377,4 +384,184 @@ TEST_F(ServiceListenerTest, frameSL25a)
   sListen.clearEvents();
 }
 
+namespace {
+struct AsyncListenerTestService
+{
+  virtual ~AsyncListenerTestService() = default;
+};
+}
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+TEST(ServiceListenerAsyncTest, AsyncDeliveryPreservesOrder)
+{
+  FrameworkConfiguration config;
+  config[Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY] =
+    Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY_ASYNC;
+  auto f = FrameworkFactory().NewFramework(config);
+  f.Start();
+  auto context = f.GetBundleContext();
+
+  std::mutex mutex;
+  std::vector<ServiceEvent::Type> types;
+  std::vector<std::thread::id> threads;
+  context.AddAsyncServiceListener(
+    [&](const ServiceEvent& evt) {
+      std::lock_guard<std::mutex> l(mutex);
+      types.push_back(evt.GetType());
+      threads.push_back(std::this_thread::get_id());
+    },
+    LDAPProp(Constants::OBJECTCLASS) ==
+      us_service_interface_iid<AsyncListenerTestService>());
+
+  auto reg = context.RegisterService<AsyncListenerTestService>(
+    std::make_shared<AsyncListenerTestService>());
+  ServiceProperties props;
+  props["modified"] = true;
+  reg.SetProperties(props);
+  reg.Unregister();
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (f.GetServiceEventDeliveryStats().delivered < 3 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto stats = f.GetServiceEventDeliveryStats();
+  ASSERT_EQ(stats.queued, 3u);
+  ASSERT_EQ(stats.delivered, 3u);
+  ASSERT_EQ(stats.pending, 0u);
+  ASSERT_GE(stats.maxPending, 1u);
+
+  std::lock_guard<std::mutex> l(mutex);
+  ASSERT_EQ(types,
+            std::vector<ServiceEvent::Type>(
+              { ServiceEvent::SERVICE_REGISTERED,
+                ServiceEvent::SERVICE_MODIFIED,
+                ServiceEvent::SERVICE_UNREGISTERING }));
+  for (auto id : threads) {
+    ASSERT_NE(id, std::this_thread::get_id());
+  }
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(ServiceListenerAsyncTest, AsyncDeliveryStatsUnderLoad)
+{
+  FrameworkConfiguration config;
+  config[Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY] =
+    Constants::FRAMEWORK_SERVICE_EVENT_DELIVERY_ASYNC;
+  auto f = FrameworkFactory().NewFramework(config);
+  f.Start();
+  auto context = f.GetBundleContext();
+
+  const auto filter = LDAPProp(Constants::OBJECTCLASS) ==
+                      us_service_interface_iid<AsyncListenerTestService>();
+  for (int i = 0; i < 4; ++i) {
+    context.AddAsyncServiceListener([](const ServiceEvent&) {}, filter);
+  }
+
+  // A worker may finish a delivery right after it was posted; the stats
+  // must never show more deliveries pending than were queued.
+  std::atomic<bool> done(false);
+  std::atomic<int> inconsistent(0);
+  std::thread sampler([&] {
+    while (!done) {
+      auto stats = f.GetServiceEventDeliveryStats();
+      if (stats.pending > stats.maxPending) {
+        ++inconsistent;
+      }
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&context] {
+      for (int i = 0; i < 200; ++i) {
+        context
+          .RegisterService<AsyncListenerTestService>(
+            std::make_shared<AsyncListenerTestService>())
+          .Unregister();
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  const std::uint64_t expected = 4 * 4 * 200 * 2;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (f.GetServiceEventDeliveryStats().delivered < expected &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  done = true;
+  sampler.join();
+
+  auto stats = f.GetServiceEventDeliveryStats();
+  ASSERT_EQ(inconsistent, 0);
+  ASSERT_EQ(stats.queued, expected);
+  ASSERT_EQ(stats.delivered, expected);
+  ASSERT_EQ(stats.pending, 0u);
+  ASSERT_GE(stats.maxPending, 1u);
+  ASSERT_LE(stats.maxPending, expected);
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
+
+TEST(ServiceListenerAsyncTest, SyncDeliveryByDefault)
+{
+  auto f = FrameworkFactory().NewFramework();
+  f.Start();
+  auto context = f.GetBundleContext();
+
+  std::vector<std::thread::id> threads;
+  context.AddAsyncServiceListener(
+    [&](const ServiceEvent&) { threads.push_back(std::this_thread::get_id()); });
+  context.RegisterService<AsyncListenerTestService>(
+    std::make_shared<AsyncListenerTestService>());
+
+  ASSERT_EQ(threads, std::vector<std::thread::id>({ std::this_thread::get_id() }));
+  ASSERT_EQ(f.GetServiceEventDeliveryStats().queued, 0u);
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(ServiceListenerCountTest, CountsByObjectClass)
+{
+  auto f = FrameworkFactory().NewFramework();
+  f.Start();
+  auto context = f.GetBundleContext();
+  const std::string iid = us_service_interface_iid<AsyncListenerTestService>();
+  auto before = f.GetServiceListenerCounts();
+
+  auto token1 = context.AddServiceListener(
+    [](const ServiceEvent&) {}, LDAPProp(Constants::OBJECTCLASS) == iid);
+  auto token2 = context.AddServiceListener(
+    [](const ServiceEvent&) {}, LDAPProp(Constants::OBJECTCLASS) == iid);
+  auto token3 = context.AddServiceListener(
+    [](const ServiceEvent&) {}, LDAPProp(Constants::OBJECTCLASS) == "other");
+  auto token4 = context.AddServiceListener([](const ServiceEvent&) {});
+
+  auto counts = f.GetServiceListenerCounts();
+  ASSERT_EQ(counts[iid], before[iid] + 2);
+  ASSERT_EQ(counts["other"], before["other"] + 1);
+  ASSERT_EQ(counts[""], before[""] + 1);
+
+  context.RemoveListener(std::move(token1));
+  context.RemoveListener(std::move(token2));
+  context.RemoveListener(std::move(token3));
+  context.RemoveListener(std::move(token4));
+  counts = f.GetServiceListenerCounts();
+  ASSERT_EQ(counts[iid], before[iid]);
+  ASSERT_EQ(counts["other"], before["other"]);
+  ASSERT_EQ(counts[""], before[""]);
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
 US_MSVC_POP_WARNING
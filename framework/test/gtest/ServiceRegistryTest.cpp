@@ -28,6 +28,7 @@
 #include "TestUtils.h"
 #include "gtest/gtest.h"
 
+#include <thread>
 #include <unordered_set>
 
 using namespace cppmicroservices;
@@ -219,3 +220,66 @@ TEST_F(ServiceRegistryTest, TestServicePropertiesUpdate)
   reg2.Unregister();
   ASSERT_TRUE(context.GetServiceReferences<ITestServiceA>().empty());
 }
+
+TEST_F(ServiceRegistryTest, TestSingletonServiceUse)
+{
+  auto s1 = std::make_shared<TestServiceA>();
+  ServiceRegistration<ITestServiceA> reg1 =
+    context.RegisterService<ITestServiceA>(s1);
+  ServiceReference<ITestServiceA> ref1 =
+    context.GetServiceReference<ITestServiceA>();
+  ASSERT_TRUE(ref1.GetUsingBundles().empty());
+
+  // the bundle uses the service until all service objects it got are released
+  auto service1 = context.GetService(ref1);
+  auto service2 = context.GetService(ref1);
+  auto interfaceMap = context.GetService(ServiceReferenceU(ref1));
+  ASSERT_EQ(service1, s1);
+  ASSERT_EQ(service2, s1);
+  ASSERT_EQ(interfaceMap->at(us_service_interface_iid<ITestServiceA>()), s1);
+  ASSERT_EQ(ref1.GetUsingBundles().size(), 1);
+  // the service objects share the holder instead of allocating their own
+  ASSERT_EQ(service1.use_count(), 3);
+
+  service1.reset();
+  interfaceMap.reset();
+  ASSERT_EQ(ref1.GetUsingBundles().size(), 1);
+  service2.reset();
+  ASSERT_TRUE(ref1.GetUsingBundles().empty());
+
+  // a new use is started once the previous one has been released
+  service1 = context.GetService(ref1);
+  ASSERT_EQ(service1, s1);
+  ASSERT_EQ(ref1.GetUsingBundles().size(), 1);
+
+  reg1.Unregister();
+  ASSERT_TRUE(ref1.GetUsingBundles().empty());
+  ASSERT_EQ(service1, s1);
+  ASSERT_THROW(context.GetService(ref1), std::invalid_argument);
+}
+
+TEST_F(ServiceRegistryTest, TestSingletonServiceUseConcurrent)
+{
+  ServiceRegistration<ITestServiceA> reg1 =
+    context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+  ServiceReference<ITestServiceA> ref1 = reg1.GetReference();
+
+  // some threads keep the service in use while others start and end uses
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([this, ref1, i] {
+      auto held = (i % 2) ? context.GetService(ref1) : nullptr;
+      for (int j = 0; j < 1000; ++j) {
+        auto service = context.GetService(ref1);
+        ASSERT_TRUE(service);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // every use has been released again
+  ASSERT_TRUE(ref1.GetUsingBundles().empty());
+  reg1.Unregister();
+}
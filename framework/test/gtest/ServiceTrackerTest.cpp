@@ -34,9 +34,12 @@
 #include "TestUtils.h"
 #include <TestingConfig.h>
 
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <memory>
+#include <optional>
+#include <thread>
 #include <unordered_map>
 
 #include "gmock/gmock.h"
@@ -444,6 +447,190 @@ TEST_F(ServiceTrackerTestFixture, IsEmpty)
   ASSERT_TRUE(tracker.IsEmpty());
 }
 
+TEST_F(ServiceTrackerTestFixture, Borrow)
+{
+  BundleContext context = framework.GetBundleContext();
+  cppmicroservices::ServiceTracker<MyInterfaceOne> tracker(context);
+  ASSERT_FALSE(tracker.Borrow());
+  tracker.Open();
+  ASSERT_FALSE(tracker.Borrow());
+
+  struct MyServiceOne : public MyInterfaceOne
+  {};
+  auto service1 = std::make_shared<MyServiceOne>();
+  auto svcReg1 = context.RegisterService<MyInterfaceOne>(service1);
+  {
+    auto borrowed = tracker.Borrow();
+    ASSERT_TRUE(borrowed);
+    ASSERT_EQ(service1.get(), borrowed.Get());
+    ASSERT_EQ(tracker.GetService().get(), borrowed.Get());
+  }
+
+  // a better ranked service replaces the cached one, while a handle which
+  // is still in scope keeps referring to the old service
+  auto borrowed = tracker.Borrow();
+  auto service2 = std::make_shared<MyServiceOne>();
+  auto svcReg2 = context.RegisterService<MyInterfaceOne>(
+    service2, { { Constants::SERVICE_RANKING, Any(10) } });
+  ASSERT_EQ(service1.get(), borrowed.Get());
+  ASSERT_EQ(service2.get(), tracker.Borrow().Get());
+  ASSERT_EQ(svcReg2.GetReference(), tracker.GetServiceReference());
+
+  svcReg2.Unregister();
+  ASSERT_EQ(service1.get(), tracker.Borrow().Get());
+
+  tracker.Close();
+  ASSERT_FALSE(tracker.Borrow());
+}
+
+TEST_F(ServiceTrackerTestFixture, BorrowReleasesUnregisteredService)
+{
+  BundleContext context = framework.GetBundleContext();
+  cppmicroservices::ServiceTracker<MyInterfaceOne> tracker(context);
+  tracker.Open();
+
+  struct MyServiceOne : public MyInterfaceOne
+  {};
+  auto service1 = std::make_shared<MyServiceOne>();
+  std::weak_ptr<MyServiceOne> weakService1 = service1;
+  auto svcReg1 = context.RegisterService<MyInterfaceOne>(service1);
+  service1.reset();
+
+  // the service stays alive while a handle is borrowed and is freed by the
+  // tracker, not by the thread releasing the last handle
+  {
+    auto borrowed1 = tracker.Borrow();
+    auto borrowed2 = tracker.Borrow();
+    ASSERT_TRUE(borrowed1);
+    svcReg1.Unregister();
+    ASSERT_FALSE(tracker.Borrow());
+    ASSERT_FALSE(weakService1.expired());
+    {
+      auto moved = std::move(borrowed1);
+    }
+    ASSERT_FALSE(tracker.Borrow());
+    ASSERT_FALSE(weakService1.expired());
+  }
+  ASSERT_FALSE(weakService1.expired());
+  ASSERT_FALSE(tracker.Borrow());
+  ASSERT_TRUE(weakService1.expired());
+
+  tracker.Close();
+}
+
+TEST(QuiescentPtrTest, FreesWhileReadersOverlap)
+{
+  using Ptr = cppmicroservices::detail::QuiescentPtr<std::shared_ptr<int>>;
+  Ptr ptr;
+  auto value = std::make_shared<int>(1);
+  std::weak_ptr<int> weakValue = value;
+  ptr.Reset(std::make_unique<const std::shared_ptr<int>>(std::move(value)));
+
+  // a reader which entered before the replacement keeps the value alive,
+  // readers entering afterwards do not
+  std::optional<Ptr::ReadGuard> first(ptr.Read());
+  ASSERT_EQ(**first->Get(), 1);
+  ptr.Reset();
+  std::optional<Ptr::ReadGuard> second(ptr.Read());
+  ASSERT_EQ(second->Get(), nullptr);
+  ptr.Reclaim();
+  ASSERT_FALSE(weakValue.expired());
+
+  // releasing a guard does not free anything
+  first.reset();
+  ASSERT_FALSE(weakValue.expired());
+  ptr.Reclaim();
+  ASSERT_TRUE(weakValue.expired());
+}
+
+TEST(QuiescentPtrTest, ConcurrentReadersAndWriter)
+{
+  using Ptr = cppmicroservices::detail::QuiescentPtr<std::shared_ptr<int>>;
+  Ptr ptr;
+  std::atomic<int> alive{ 0 };
+  auto makeValue = [&alive](int i) {
+    ++alive;
+    return std::make_unique<const std::shared_ptr<int>>(
+      new int(i), [&alive](int* p) {
+        delete p;
+        --alive;
+      });
+  };
+  ptr.Reset(makeValue(0));
+
+  std::atomic<bool> stop{ false };
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&ptr, &stop] {
+      while (!stop) {
+        auto guard = ptr.Read();
+        // the value must not be freed while the guard exists
+        ASSERT_NE(guard.Get(), nullptr);
+        ASSERT_GE(**guard.Get(), 0);
+      }
+    });
+  }
+  for (int i = 1; i <= 1000; ++i) {
+    ptr.Reset(makeValue(i));
+  }
+  stop = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  // without readers, everything but the current value is freed
+  ptr.Reclaim();
+  ASSERT_EQ(alive, 1);
+  ptr.Reset();
+  ASSERT_EQ(alive, 0);
+}
+
+TEST_F(ServiceTrackerTestFixture, GetSnapshot)
+{
+  BundleContext context = framework.GetBundleContext();
+  cppmicroservices::ServiceTracker<MyInterfaceOne> tracker(context);
+  ASSERT_EQ(-1, tracker.GetSnapshot()->trackingCount);
+  ASSERT_TRUE(tracker.GetSnapshot()->services.empty());
+  tracker.Open();
+
+  struct MyServiceOne : public MyInterfaceOne
+  {};
+  auto service1 = std::make_shared<MyServiceOne>();
+  auto service2 = std::make_shared<MyServiceOne>();
+  auto service3 = std::make_shared<MyServiceOne>();
+  auto svcReg1 = context.RegisterService<MyInterfaceOne>(service1);
+  auto svcReg2 = context.RegisterService<MyInterfaceOne>(
+    service2, { { Constants::SERVICE_RANKING, Any(10) } });
+  auto svcReg3 = context.RegisterService<MyInterfaceOne>(service3);
+
+  // the snapshot is shared until the tracked services change
+  auto snapshot = tracker.GetSnapshot();
+  ASSERT_EQ(snapshot, tracker.GetSnapshot());
+  ASSERT_EQ(tracker.GetTrackingCount(), snapshot->trackingCount);
+
+  // ordered by ranking, then by registration
+  ASSERT_EQ(3, snapshot->services.size());
+  ASSERT_EQ(svcReg2.GetReference(), snapshot->services[0].first);
+  ASSERT_EQ(service2, snapshot->services[0].second);
+  ASSERT_EQ(svcReg1.GetReference(), snapshot->services[1].first);
+  ASSERT_EQ(svcReg3.GetReference(), snapshot->services[2].first);
+  std::vector<std::shared_ptr<MyInterfaceOne>> expected{ service2,
+                                                         service1,
+                                                         service3 };
+  ASSERT_EQ(expected, tracker.GetServices());
+
+  svcReg2.Unregister();
+  auto updated = tracker.GetSnapshot();
+  ASSERT_NE(snapshot, updated);
+  ASSERT_LT(snapshot->trackingCount, updated->trackingCount);
+  ASSERT_EQ(2, updated->services.size());
+  ASSERT_EQ(svcReg1.GetReference(), updated->services[0].first);
+  ASSERT_EQ(3, snapshot->services.size());
+
+  tracker.Close();
+  ASSERT_TRUE(tracker.GetSnapshot()->services.empty());
+}
+
 #ifdef US_ENABLE_THREADING_SUPPORT
 namespace {
 class FooService
@@ -0,0 +1,105 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLERESOURCESERVLET_H
+#define CPPMICROSERVICES_BUNDLERESOURCESERVLET_H
+
+#include "cppmicroservices/httpservice/HttpServlet.h"
+
+#include "cppmicroservices/Bundle.h"
+
+#include <string>
+
+namespace cppmicroservices {
+
+class BundleResource;
+
+struct BundleResourceServletPrivate;
+
+/**
+ * Serves the files of a bundle's resources.
+ *
+ * The path info of a request is appended to the resource root to find the
+ * resource. Resources are decompressed at most once while they stay in an
+ * in-memory cache, which evicts the least recently used resources when its
+ * size limit is reached.
+ *
+ * The servlet answers conditional requests using an <code>ETag</code>
+ * derived from the resource's CRC-32 and the <code>Last-Modified</code> time
+ * of the resource, and single byte ranges of <code>Range</code> requests. If
+ * the client accepts gzip encoding and a resource with the additional
+ * suffix <code>.gz</code> exists, that resource is served instead with
+ * <code>Content-Encoding: gzip</code>.
+ */
+class US_HttpService_EXPORT BundleResourceServlet : public HttpServlet
+{
+public:
+  /// The default size limit of the cache in bytes.
+  static const std::size_t DEFAULT_CACHE_SIZE;
+
+  /**
+   * Creates a servlet which only serves resources passed to
+   * SpoolResource().
+   *
+   * @param cacheSize The maximum number of bytes cached.
+   */
+  explicit BundleResourceServlet(std::size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+  /**
+   * Creates a servlet which serves the resources of \c bundle below
+   * \c resourceRoot.
+   *
+   * @param bundle The bundle containing the resources.
+   * @param resourceRoot The resource path prefixed to the path info of a
+   *        request, for example <code>"/static"</code>.
+   * @param cacheSize The maximum number of bytes cached.
+   */
+  BundleResourceServlet(const Bundle& bundle,
+                        const std::string& resourceRoot,
+                        std::size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+  ~BundleResourceServlet() override;
+
+  /**
+   * Writes \c resource to \c response, including the headers describing it.
+   * Conditional and range requests are answered as described above.
+   *
+   * @param resource The resource to send.
+   * @param request The request for the resource.
+   * @param response The response to write to.
+   * @return \c false if \c resource is not a file, in which case nothing was
+   *         written.
+   */
+  bool SpoolResource(const BundleResource& resource,
+                     HttpServletRequest& request,
+                     HttpServletResponse& response) const;
+
+protected:
+  void DoGet(HttpServletRequest& request,
+             HttpServletResponse& response) override;
+
+private:
+  BundleResourceServletPrivate* d;
+};
+}
+
+#endif // CPPMICROSERVICES_BUNDLERESOURCESERVLET_H
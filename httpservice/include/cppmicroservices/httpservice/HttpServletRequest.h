@@ -26,6 +26,7 @@
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/httpservice/HttpServiceExport.h"
 
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -52,6 +53,17 @@ public:
 
   std::string GetContentType() const;
 
+  /**
+   * Returns a stream for reading the body of the request, for example the
+   * data of a POST or PUT request. The body is read from the connection
+   * while the stream is consumed instead of being buffered as a whole, so
+   * it can only be read once.
+   *
+   * @return The request body. The stream is empty if the request has no
+   *         body.
+   */
+  std::istream& GetInputStream();
+
   std::string GetLocalName() const;
 
   std::string GetRemoteHost() const;
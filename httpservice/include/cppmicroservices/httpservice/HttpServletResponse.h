@@ -293,6 +293,26 @@ public:
 
   std::ostream& GetOutputStream();
 
+  /**
+   * Writes \c size bytes of \c data to the body of the response without
+   * copying them into the buffer of the output stream. Data written to the
+   * output stream before is sent first.
+   *
+   * @return \c false if the data could not be sent.
+   */
+  bool SendBuffer(const char* data, std::size_t size);
+
+  /**
+   * Writes \c length bytes of the file at \c path, starting at \c offset,
+   * to the body of the response like SendBuffer() does.
+   *
+   * @return \c false if the region is not part of the file or could not
+   *         be sent. Nothing was sent if the region is not part of the file.
+   */
+  bool SendFileRegion(const std::string& path,
+                      std::size_t offset,
+                      std::size_t length);
+
   void Reset();
 
   void ResetBuffer();
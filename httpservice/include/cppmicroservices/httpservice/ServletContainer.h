@@ -37,6 +37,32 @@ class BundleContext;
 class US_HttpService_EXPORT ServletContainer
 {
 public:
+  /**
+   * Framework property with the ports the container listens on, for example
+   * <code>"8080"</code> or <code>"127.0.0.1:8080,8443s"</code>. An
+   * <code>int</code> is accepted for a single port. Defaults to 8080.
+   */
+  static const std::string PROP_LISTENING_PORTS;
+
+  /**
+   * Framework property with the number of worker threads serving requests,
+   * a positive <code>int</code>. Defaults to 50.
+   */
+  static const std::string PROP_NUM_THREADS;
+
+  /**
+   * Framework property which, if <code>true</code>, keeps connections open
+   * for further requests. Defaults to <code>false</code>.
+   */
+  static const std::string PROP_ENABLE_KEEP_ALIVE;
+
+  /**
+   * Framework property with the time in milliseconds to wait for the data
+   * of a request, and for the next request on a kept-alive connection, as a
+   * positive <code>int</code>. Defaults to 30000.
+   */
+  static const std::string PROP_REQUEST_TIMEOUT_MS;
+
   ServletContainer(BundleContext bundleCtx,
                    const std::string& contextPath = std::string());
   ~ServletContainer();
@@ -0,0 +1,353 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/httpservice/BundleResourceServlet.h"
+#include "BundleResourceServletPrivate.h"
+
+#include "cppmicroservices/BundleResource.h"
+#include "cppmicroservices/BundleResourceStream.h"
+#include "cppmicroservices/httpservice/HttpServletRequest.h"
+#include "cppmicroservices/httpservice/HttpServletResponse.h"
+
+#include "civetweb/civetweb.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace cppmicroservices {
+
+namespace {
+
+std::string Trim(const std::string& str)
+{
+  std::size_t first = str.find_first_not_of(" \t");
+  if (first == std::string::npos) {
+    return std::string();
+  }
+  return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+}
+
+bool ParseNumber(const std::string& str, std::size_t& value)
+{
+  if (str.empty() || str.size() > 18 ||
+      str.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  value = static_cast<std::size_t>(std::strtoull(str.c_str(), nullptr, 10));
+  return true;
+}
+
+/*
+ * Parses a Range header with a single range of the form "bytes=first-last",
+ * "bytes=first-" or "bytes=-suffixLength". Returns false if the header is
+ * malformed or asks for several ranges, in which case the whole resource is
+ * sent. Otherwise, sets satisfiable to false if the range does not overlap
+ * the resource.
+ */
+bool ParseRange(const std::string& header,
+                std::size_t size,
+                std::size_t& first,
+                std::size_t& last,
+                bool& satisfiable)
+{
+  static const std::string unit = "bytes=";
+  if (header.compare(0, unit.size(), unit) != 0 ||
+      header.find(',') != std::string::npos) {
+    return false;
+  }
+  std::size_t dash = header.find('-', unit.size());
+  if (dash == std::string::npos) {
+    return false;
+  }
+  std::string firstStr = Trim(header.substr(unit.size(), dash - unit.size()));
+  std::string lastStr = Trim(header.substr(dash + 1));
+
+  // first and last are left alone if the whole resource is sent
+  std::size_t value = 0;
+  if (firstStr.empty()) {
+    if (!ParseNumber(lastStr, value)) {
+      return false;
+    }
+    satisfiable = value > 0 && size > 0;
+    first = size > value ? size - value : 0;
+    last = size - 1;
+    return true;
+  }
+
+  std::size_t start = 0;
+  std::size_t end = size - 1;
+  if (!ParseNumber(firstStr, start)) {
+    return false;
+  }
+  if (!lastStr.empty()) {
+    if (!ParseNumber(lastStr, value) || value < start) {
+      return false;
+    }
+    end = std::min(value, end);
+  }
+  first = start;
+  last = end;
+  satisfiable = first < size;
+  return true;
+}
+
+// Checks whether gzip is an acceptable content coding, i.e. listed in the
+// Accept-Encoding header without a quality value of zero.
+bool AcceptsGzip(const HttpServletRequest& request)
+{
+  std::stringstream codings(request.GetHeader("Accept-Encoding"));
+  std::string coding;
+  while (std::getline(codings, coding, ',')) {
+    std::size_t semicolon = coding.find(';');
+    if (Trim(coding.substr(0, semicolon)) != "gzip") {
+      continue;
+    }
+    if (semicolon == std::string::npos) {
+      return true;
+    }
+    std::string param = Trim(coding.substr(semicolon + 1));
+    return param.compare(0, 2, "q=") != 0 ||
+           std::strtod(param.c_str() + 2, nullptr) > 0;
+  }
+  return false;
+}
+
+std::string GetETag(const BundleResource& resource, bool gzip)
+{
+  std::ostringstream etag;
+  etag << '"' << std::hex << resource.GetCrc32() << '-' << resource.GetSize()
+       << (gzip ? "-gz" : "") << '"';
+  return etag.str();
+}
+
+bool MatchesETag(const std::string& header, const std::string& etag)
+{
+  return header == "*" || header.find(etag) != std::string::npos;
+}
+
+bool Spool(BundleResourceServletPrivate* d,
+           const BundleResource& resource,
+           const BundleResource& encoded,
+           bool hasEncoding,
+           HttpServletRequest& request,
+           HttpServletResponse& response)
+{
+  if (!resource || !resource.IsFile()) {
+    return false;
+  }
+
+  const BundleResource& sent = encoded ? encoded : resource;
+  const std::string etag = GetETag(sent, encoded.IsValid());
+  const long long lastModified =
+    static_cast<long long>(resource.GetLastModified()) * 1000;
+
+  response.SetHeader("Accept-Ranges", "bytes");
+  response.SetHeader("ETag", etag);
+  if (lastModified > 0) {
+    response.SetDateHeader("Last-Modified", lastModified);
+  }
+  if (hasEncoding) {
+    response.SetHeader("Vary", "Accept-Encoding");
+  }
+
+  // If-None-Match takes precedence over If-Modified-Since
+  std::string ifNoneMatch = request.GetHeader("If-None-Match");
+  bool notModified = false;
+  if (!ifNoneMatch.empty()) {
+    notModified = MatchesETag(ifNoneMatch, etag);
+  } else if (lastModified > 0) {
+    notModified = request.GetDateHeader("If-Modified-Since") >= lastModified;
+  }
+  if (notModified) {
+    response.SetStatus(HttpServletResponse::SC_NOT_MODIFIED);
+    return true;
+  }
+
+  auto content = d->GetContent(sent);
+  if (!content) {
+    response.SendError(HttpServletResponse::SC_INTERNAL_SERVER_ERROR);
+    return true;
+  }
+
+  const std::size_t size = content->size();
+  std::size_t first = 0;
+  std::size_t last = size - 1;
+  bool partial = false;
+  std::string range = request.GetHeader("Range");
+  std::string ifRange = request.GetHeader("If-Range");
+  if (!range.empty() && (ifRange.empty() || ifRange == etag)) {
+    bool satisfiable = false;
+    if (ParseRange(range, size, first, last, satisfiable)) {
+      if (!satisfiable) {
+        response.SetStatus(
+          HttpServletResponse::SC_REQUESTED_RANGE_NOT_SATISFIABLE);
+        response.SetHeader("Content-Range",
+                           "bytes */" + std::to_string(size));
+        response.SetContentLength(0);
+        return true;
+      }
+      partial = true;
+    }
+  }
+
+  const char* mimeType =
+    mg_get_builtin_mime_type(resource.GetResourcePath().c_str());
+  response.SetContentType(mimeType ? mimeType : "application/octet-stream");
+  if (encoded) {
+    response.SetHeader("Content-Encoding", "gzip");
+  }
+  if (partial) {
+    response.SetStatus(HttpServletResponse::SC_PARTIAL_CONTENT);
+    response.SetHeader("Content-Range",
+                       "bytes " + std::to_string(first) + "-" +
+                         std::to_string(last) + "/" + std::to_string(size));
+  }
+
+  const std::size_t length = size == 0 ? 0 : last - first + 1;
+  response.SetContentLength(length);
+  if (length > 0) {
+    response.SendBuffer(content->data() + first, length);
+  }
+  return true;
+}
+}
+
+//-------------------------------------------------------------------
+//-----------      BundleResourceServletPrivate    ------------------
+//-------------------------------------------------------------------
+
+BundleResourceServletPrivate::BundleResourceServletPrivate(
+  Bundle bundle,
+  std::string resourceRoot,
+  std::size_t cacheSize)
+  : m_Bundle(std::move(bundle))
+  , m_ResourceRoot(std::move(resourceRoot))
+  , m_CacheSize(cacheSize)
+  , m_CachedBytes(0)
+{}
+
+std::shared_ptr<const std::string> BundleResourceServletPrivate::GetContent(
+  const BundleResource& resource)
+{
+  {
+    std::lock_guard<std::mutex> l(m_CacheMutex);
+    auto iter = m_CacheIndex.find(resource);
+    if (iter != m_CacheIndex.end()) {
+      auto entry = iter->second;
+      if (entry->crc32 == resource.GetCrc32() &&
+          entry->lastModified == resource.GetLastModified()) {
+        m_Cache.splice(m_Cache.begin(), m_Cache, entry);
+        return entry->content;
+      }
+      m_CachedBytes -= entry->content->size();
+      m_Cache.erase(entry);
+      m_CacheIndex.erase(iter);
+    }
+  }
+
+  // decompress outside of the lock, another thread might do the same
+  auto content = std::make_shared<std::string>(
+    static_cast<std::size_t>(std::max(resource.GetSize(), 0)), '\0');
+  BundleResourceStream stream(resource, std::ios::binary);
+  stream.read(&(*content)[0], static_cast<std::streamsize>(content->size()));
+  if (static_cast<std::size_t>(stream.gcount()) != content->size()) {
+    return nullptr;
+  }
+  if (content->size() > m_CacheSize) {
+    return content;
+  }
+
+  std::lock_guard<std::mutex> l(m_CacheMutex);
+  if (m_CacheIndex.find(resource) == m_CacheIndex.end()) {
+    m_Cache.push_front(
+      { resource, resource.GetCrc32(), resource.GetLastModified(), content });
+    m_CacheIndex.emplace(resource, m_Cache.begin());
+    m_CachedBytes += content->size();
+    while (m_CachedBytes > m_CacheSize) {
+      m_CachedBytes -= m_Cache.back().content->size();
+      m_CacheIndex.erase(m_Cache.back().resource);
+      m_Cache.pop_back();
+    }
+  }
+  return content;
+}
+
+//-------------------------------------------------------------------
+//-----------         BundleResourceServlet        ------------------
+//-------------------------------------------------------------------
+
+const std::size_t BundleResourceServlet::DEFAULT_CACHE_SIZE = 8 * 1024 * 1024;
+
+BundleResourceServlet::BundleResourceServlet(std::size_t cacheSize)
+  : d(new BundleResourceServletPrivate(Bundle(), std::string(), cacheSize))
+{}
+
+BundleResourceServlet::BundleResourceServlet(const Bundle& bundle,
+                                             const std::string& resourceRoot,
+                                             std::size_t cacheSize)
+  : d(new BundleResourceServletPrivate(
+      bundle,
+      resourceRoot.empty() || resourceRoot.back() != '/'
+        ? resourceRoot
+        : resourceRoot.substr(0, resourceRoot.size() - 1),
+      cacheSize))
+{}
+
+BundleResourceServlet::~BundleResourceServlet()
+{
+  delete d;
+}
+
+bool BundleResourceServlet::SpoolResource(const BundleResource& resource,
+                                          HttpServletRequest& request,
+                                          HttpServletResponse& response) const
+{
+  return Spool(d, resource, BundleResource(), false, request, response);
+}
+
+void BundleResourceServlet::DoGet(HttpServletRequest& request,
+                                  HttpServletResponse& response)
+{
+  std::string path = d->m_ResourceRoot + request.GetPathInfo();
+  BundleResource resource;
+  BundleResource encoded;
+  try {
+    if (d->m_Bundle) {
+      resource = d->m_Bundle.GetResource(path);
+      encoded = d->m_Bundle.GetResource(path + ".gz");
+    }
+  } catch (const std::exception&) {
+    // the bundle was uninstalled
+  }
+
+  bool hasEncoding = encoded && encoded.IsFile();
+  if (!hasEncoding || !AcceptsGzip(request)) {
+    encoded = BundleResource();
+  }
+  if (!Spool(d, resource, encoded, hasEncoding, request, response)) {
+    response.SendError(HttpServletResponse::SC_NOT_FOUND);
+  }
+}
+}
@@ -0,0 +1,73 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLERESOURCESERVLETPRIVATE_H
+#define CPPMICROSERVICES_BUNDLERESOURCESERVLETPRIVATE_H
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleResource.h"
+
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cppmicroservices {
+
+struct BundleResourceServletPrivate
+{
+  BundleResourceServletPrivate(Bundle bundle,
+                               std::string resourceRoot,
+                               std::size_t cacheSize);
+
+  /**
+   * Returns the uncompressed content of \c resource, from the cache if
+   * possible, or nullptr if it could not be read.
+   */
+  std::shared_ptr<const std::string> GetContent(
+    const BundleResource& resource);
+
+  const Bundle m_Bundle;
+  const std::string m_ResourceRoot;
+  const std::size_t m_CacheSize;
+
+private:
+  struct CacheEntry
+  {
+    BundleResource resource;
+    uint32_t crc32;
+    time_t lastModified;
+    std::shared_ptr<const std::string> content;
+  };
+
+  using CacheList = std::list<CacheEntry>;
+
+  std::mutex m_CacheMutex;
+  CacheList m_Cache; ///< most recently used first
+  std::unordered_map<BundleResource, CacheList::iterator> m_CacheIndex;
+  std::size_t m_CachedBytes;
+};
+}
+
+#endif // CPPMICROSERVICES_BUNDLERESOURCESERVLETPRIVATE_H
@@ -0,0 +1,89 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "HttpInputStreamBuffer.h"
+
+#include "civetweb/civetweb.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace cppmicroservices {
+
+HttpInputStreamBuffer::HttpInputStreamBuffer(mg_connection* conn,
+                                             std::size_t bufferSize)
+  : m_Buffer(bufferSize)
+  , m_Connection(conn)
+{
+  char* end = &m_Buffer.front() + m_Buffer.size();
+  setg(end, end, end);
+}
+
+std::streambuf::int_type HttpInputStreamBuffer::underflow()
+{
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+  if (m_Connection == nullptr) {
+    return traits_type::eof();
+  }
+
+  char* base = &m_Buffer.front();
+  int n = mg_read(m_Connection, base, m_Buffer.size());
+  if (n <= 0) {
+    return traits_type::eof();
+  }
+  setg(base, base, base + n);
+  return traits_type::to_int_type(*gptr());
+}
+
+std::streamsize HttpInputStreamBuffer::xsgetn(char* s, std::streamsize n)
+{
+  // drain the buffer first and then read large blocks directly into
+  // the caller's memory
+  std::streamsize count = std::min<std::streamsize>(n, egptr() - gptr());
+  std::memcpy(s, gptr(), static_cast<std::size_t>(count));
+  gbump(static_cast<int>(count));
+
+  while (count < n && m_Connection != nullptr) {
+    std::streamsize remaining = n - count;
+    if (remaining < static_cast<std::streamsize>(m_Buffer.size())) {
+      if (underflow() == traits_type::eof()) {
+        break;
+      }
+      std::streamsize chunk =
+        std::min<std::streamsize>(remaining, egptr() - gptr());
+      std::memcpy(s + count, gptr(), static_cast<std::size_t>(chunk));
+      gbump(static_cast<int>(chunk));
+      count += chunk;
+    } else {
+      int read =
+        mg_read(m_Connection, s + count, static_cast<std::size_t>(remaining));
+      if (read <= 0) {
+        break;
+      }
+      count += read;
+    }
+  }
+  return count;
+}
+}
@@ -0,0 +1,61 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_HTTPINPUTSTREAMBUFFER_H
+#define CPPMICROSERVICES_HTTPINPUTSTREAMBUFFER_H
+
+#include "cppmicroservices/GlobalConfig.h"
+
+#include <streambuf>
+#include <vector>
+
+struct mg_connection;
+
+namespace cppmicroservices {
+
+/**
+ * Reads the body of a request from the connection in blocks of
+ * \c bufferSize bytes, so that large bodies are never held in memory
+ * as a whole.
+ */
+class HttpInputStreamBuffer : public std::streambuf
+{
+public:
+  explicit HttpInputStreamBuffer(mg_connection* conn,
+                                 std::size_t bufferSize = 4096);
+
+protected:
+  int_type underflow() override;
+
+  std::streamsize xsgetn(char* s, std::streamsize n) override;
+
+private:
+  HttpInputStreamBuffer(const HttpInputStreamBuffer&) = delete;
+  HttpInputStreamBuffer& operator=(const HttpInputStreamBuffer&) = delete;
+
+private:
+  std::vector<char> m_Buffer;
+  mg_connection* const m_Connection;
+};
+}
+
+#endif // CPPMICROSERVICES_HTTPINPUTSTREAMBUFFER_H
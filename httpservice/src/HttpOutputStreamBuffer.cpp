@@ -26,20 +26,34 @@
 
 #include "civetweb/civetweb.h"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 
 namespace cppmicroservices {
 
+namespace {
+
+// "\r\n" ending the previous chunk, up to 16 hex digits and "\r\n"
+const std::size_t CHUNK_HEADER_SIZE = 20;
+
+// "\r\n" ending the last chunk and the empty chunk ending the body
+const char BODY_END[] = "\r\n0\r\n\r\n";
+const std::size_t BODY_END_SIZE = sizeof(BODY_END) - 1;
+}
+
 HttpOutputStreamBuffer::HttpOutputStreamBuffer(
   HttpServletResponsePrivate* response,
   std::size_t bufferSize)
-  : m_Buffer(bufferSize + 1)
+  : m_Buffer(CHUNK_HEADER_SIZE + bufferSize + 1 + BODY_END_SIZE)
   , m_Response(response)
   , m_ChunkedCoding(true)
+  , m_ChunkPending(false)
 {
-  char* base = &m_Buffer.front();
-  setp(base, base + m_Buffer.size() - 1);
+  // leave room for framing the buffer as a chunk; overflow() stores one
+  // character at epptr()
+  char* base = &m_Buffer[CHUNK_HEADER_SIZE];
+  setp(base, base + bufferSize);
 }
 
 HttpOutputStreamBuffer::~HttpOutputStreamBuffer()
@@ -57,24 +71,39 @@ HttpOutputStreamBuffer::~HttpOutputStreamBuffer()
     m_Response->m_Headers["Content-Length"] =
       m_Response->LexicalCast(static_cast<long>(pptr() - pbase()));
   }
-  sync();
+  sendBuffer(true);
+}
+
+bool HttpOutputStreamBuffer::SendDirect(const char* data, std::size_t size)
+{
+  if (pptr() != pbase() && !sendBuffer()) {
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+  if (!m_Response->m_Connection) {
+    return false;
+  }
+
+  SelectCoding();
   if (m_ChunkedCoding) {
-    mg_write(m_Response->m_Connection, "0\r\n\r\n", 5);
+    char header[CHUNK_HEADER_SIZE];
+    char* headerEnd = WriteChunkHeader(header, size);
+    if (!Write(header, static_cast<std::size_t>(headerEnd - header))) {
+      return false;
+    }
+  } else if (!m_Response->m_IsCommited && !m_Response->Commit()) {
+    return false;
   }
+  return mg_write(m_Response->m_Connection, data, size) > 0;
 }
 
 bool HttpOutputStreamBuffer::CommitStream()
 {
-  if (!m_Response->m_IsCommited) {
-    m_ChunkedCoding = m_Response->m_Headers.find("Content-Length") ==
-                      m_Response->m_Headers.end();
-    if (m_ChunkedCoding) {
-      m_Response->m_Headers["Transfer-Encoding"] = "chunked";
-    }
-    // this writes the headers if not already written
-    return m_Response->Commit();
-  }
-  return true;
+  SelectCoding();
+  // this writes the headers if not already written
+  return m_Response->Commit();
 }
 
 std::streambuf::int_type HttpOutputStreamBuffer::overflow(int_type ch)
@@ -90,35 +119,87 @@ std::streambuf::int_type HttpOutputStreamBuffer::overflow(int_type ch)
   return traits_type::eof();
 }
 
+std::streamsize HttpOutputStreamBuffer::xsputn(const char* s,
+                                               std::streamsize n)
+{
+  // data which would not fit into the buffer anyway is not copied
+  if (n > epptr() - pbase()) {
+    return SendDirect(s, static_cast<std::size_t>(n)) ? n : 0;
+  }
+  return std::streambuf::xsputn(s, n);
+}
+
 int HttpOutputStreamBuffer::sync()
 {
   return sendBuffer() ? 0 : -1;
 }
 
-bool HttpOutputStreamBuffer::sendBuffer()
+bool HttpOutputStreamBuffer::sendBuffer(bool last)
 {
   if (!m_Response->m_Connection)
     return false;
 
-  // commit the response by writing the headers
-  if (!CommitStream())
-    return false;
+  SelectCoding();
 
-  // write the buffer contents
-  std::ptrdiff_t n = pptr() - pbase();
-  pbump(static_cast<int>(-n));
-  int bytesSend = 0;
+  std::size_t n = static_cast<std::size_t>(pptr() - pbase());
+  pbump(-static_cast<int>(n));
+  const char* begin = pbase();
+  char* end = pbase() + n;
   if (m_ChunkedCoding) {
-    // send chunk size
-    std::string chunkSize =
-      m_Response->LexicalCastHex(static_cast<long>(n)) + "\r\n";
-    bytesSend +=
-      mg_write(m_Response->m_Connection, &chunkSize[0], chunkSize.size());
+    // an empty chunk would end the body
+    if (n > 0) {
+      char header[CHUNK_HEADER_SIZE];
+      std::size_t headerSize =
+        static_cast<std::size_t>(WriteChunkHeader(header, n) - header);
+      begin = std::copy_backward(header, header + headerSize, pbase());
+    }
+    if (last) {
+      const char* bodyEnd = m_ChunkPending ? BODY_END : BODY_END + 2;
+      end = std::copy(bodyEnd, BODY_END + BODY_END_SIZE, end);
+      m_ChunkPending = false;
+    }
   }
-  bytesSend += mg_write(m_Response->m_Connection, pbase(), n);
-  if (m_ChunkedCoding) {
-    bytesSend += mg_write(m_Response->m_Connection, "\r\n", 2);
+  // writes the headers if the response is not committed yet
+  return Write(begin, static_cast<std::size_t>(end - begin));
+}
+
+void HttpOutputStreamBuffer::SelectCoding()
+{
+  if (!m_Response->m_IsCommited) {
+    m_ChunkedCoding = m_Response->m_Headers.find("Content-Length") ==
+                      m_Response->m_Headers.end();
+    if (m_ChunkedCoding) {
+      m_Response->m_Headers["Transfer-Encoding"] = "chunked";
+    }
+  }
+}
+
+char* HttpOutputStreamBuffer::WriteChunkHeader(char* out, std::size_t size)
+{
+  if (m_ChunkPending) {
+    *out++ = '\r';
+    *out++ = '\n';
+  }
+  char digits[16];
+  int count = 0;
+  do {
+    digits[count++] = "0123456789abcdef"[size & 0xf];
+    size >>= 4;
+  } while (size != 0);
+  while (count > 0) {
+    *out++ = digits[--count];
+  }
+  *out++ = '\r';
+  *out++ = '\n';
+  m_ChunkPending = true;
+  return out;
+}
+
+bool HttpOutputStreamBuffer::Write(const char* data, std::size_t size)
+{
+  if (!m_Response->m_IsCommited) {
+    return m_Response->Commit(data, size);
   }
-  return bytesSend > 0;
+  return size == 0 || mg_write(m_Response->m_Connection, data, size) > 0;
 }
 }
@@ -37,18 +37,36 @@ class HttpOutputStreamBuffer : public std::streambuf
 {
 public:
   explicit HttpOutputStreamBuffer(HttpServletResponsePrivate* response,
-                                  std::size_t bufferSize = 1024);
+                                  std::size_t bufferSize = 8192);
   ~HttpOutputStreamBuffer();
 
+  /**
+   * Sends the buffered data followed by \c data, which is written to the
+   * connection without being copied into the buffer.
+   */
+  bool SendDirect(const char* data, std::size_t size);
+
 protected:
   bool CommitStream();
 
 private:
   int_type overflow(int_type ch);
 
+  std::streamsize xsputn(const char* s, std::streamsize n);
+
   int sync();
 
-  bool sendBuffer();
+  /**
+   * Sends the buffered data as one chunk, framed in place so that it takes
+   * a single write. If \c last is true, the end of the body is appended.
+   */
+  bool sendBuffer(bool last = false);
+
+  void SelectCoding();
+
+  char* WriteChunkHeader(char* out, std::size_t size);
+
+  bool Write(const char* data, std::size_t size);
 
   HttpOutputStreamBuffer(const HttpOutputStreamBuffer&);
   HttpOutputStreamBuffer& operator=(const HttpOutputStreamBuffer&);
@@ -57,6 +75,7 @@ private:
   std::vector<char> m_Buffer;
   HttpServletResponsePrivate* m_Response;
   bool m_ChunkedCoding;
+  bool m_ChunkPending; ///< the CRLF ending the last chunk is not yet sent
 };
 }
 
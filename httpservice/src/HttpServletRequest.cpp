@@ -21,6 +21,7 @@
 =============================================================================*/
 
 #include "cppmicroservices/httpservice/HttpServletRequest.h"
+#include "HttpInputStreamBuffer.h"
 #include "HttpServletRequestPrivate.h"
 
 #include "cppmicroservices/httpservice/ServletContext.h"
@@ -81,13 +82,16 @@ HttpServletRequestPrivate::HttpServletRequestPrivate(
   }
 
   // get the uri
-  std::string uri = mg_get_request_info(m_Connection)->uri;
+  const mg_request_info* requestInfo = mg_get_request_info(m_Connection);
+  std::string uri = requestInfo->uri;
   pos = uri.find_first_of('?');
   m_Uri = uri.substr(0, pos);
 
-  // get the query string
+  // get the query string, which civetweb usually splits off the uri
   if (pos != std::string::npos) {
-    m_QueryString = m_Uri.substr(pos);
+    m_QueryString = uri.substr(pos + 1);
+  } else if (requestInfo->query_string) {
+    m_QueryString = requestInfo->query_string;
   }
 
   // reconstruct the url
@@ -144,6 +148,17 @@ std::string HttpServletRequest::GetContentType() const
   return contentType ? std::string(contentType) : std::string();
 }
 
+std::istream& HttpServletRequest::GetInputStream()
+{
+  if (!d->m_InputStream) {
+    d->m_InputStreamBuf =
+      std::make_unique<HttpInputStreamBuffer>(d->m_Connection);
+    d->m_InputStream =
+      std::make_unique<std::istream>(d->m_InputStreamBuf.get());
+  }
+  return *d->m_InputStream;
+}
+
 std::string HttpServletRequest::GetScheme() const
 {
   return d->m_Scheme;
@@ -23,6 +23,7 @@
 #ifndef CPPMICROSERVICES_HTTPSERVLETREQUESTPRIVATE_H
 #define CPPMICROSERVICES_HTTPSERVLETREQUESTPRIVATE_H
 
+#include <istream>
 #include <map>
 #include <memory>
 #include <string>
@@ -57,6 +58,9 @@ struct HttpServletRequestPrivate
 
   using AttributeMapType = std::map<std::string, Any>;
   AttributeMapType m_Attributes;
+
+  std::unique_ptr<std::streambuf> m_InputStreamBuf;
+  std::unique_ptr<std::istream> m_InputStream;
 };
 }
 
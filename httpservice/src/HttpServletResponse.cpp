@@ -28,7 +28,9 @@
 
 #include "civetweb/civetweb.h"
 
+#include <algorithm>
 #include <ctime>
+#include <fstream>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -50,7 +52,7 @@ HttpServletResponsePrivate::HttpServletResponsePrivate(
   , m_HttpOutputStreamBuf(nullptr)
   , m_HttpOutputStream(nullptr)
   , m_IsCommited(false)
-  , m_BufferSize(1024)
+  , m_BufferSize(8192)
 {}
 
 HttpServletResponsePrivate::~HttpServletResponsePrivate()
@@ -62,19 +64,25 @@ HttpServletResponsePrivate::~HttpServletResponsePrivate()
   delete m_HttpOutputStream;
 }
 
-bool HttpServletResponsePrivate::Commit()
+bool HttpServletResponsePrivate::Commit(const char* data, std::size_t size)
 {
   if (m_IsCommited)
     return true;
 
   std::stringstream ss;
-  ss << "HTTP/1.1 " << m_StatusCode << "\r\n";
+  // clients split the status line at spaces, the reason phrase is required
+  // to keep the first header intact
+  ss << "HTTP/1.1 " << m_StatusCode << " "
+     << mg_get_response_code_text(m_Connection, m_StatusCode) << "\r\n";
   for (auto& m_Header : m_Headers) {
     ss << m_Header.first << ": " << m_Header.second << "\r\n";
   }
   ss << "\r\n";
 
   std::string header = ss.str();
+  if (size > 0) {
+    header.append(data, size);
+  }
   int n = mg_write(m_Connection, &header[0], header.size());
   m_IsCommited = n > 0;
   return m_IsCommited;
@@ -147,6 +155,9 @@ void HttpServletResponse::FlushBuffer()
 {
   if (d->m_HttpOutputStream) {
     *d->m_HttpOutputStream << std::flush;
+  } else if (d->m_HttpOutputStreamBuf) {
+    // only SendBuffer() was used, the body is ended by the buffer
+    d->m_HttpOutputStreamBuf->pubsync();
   } else {
     d->Commit();
   }
@@ -180,6 +191,46 @@ std::ostream& HttpServletResponse::GetOutputStream()
   return *d->m_HttpOutputStream;
 }
 
+bool HttpServletResponse::SendBuffer(const char* data, std::size_t size)
+{
+  if (d->m_HttpOutputStream) {
+    d->m_HttpOutputStream->flush();
+  }
+  HttpServletResponse::GetOutputStreamBuffer();
+  return d->m_HttpOutputStreamBuf->SendDirect(data, size);
+}
+
+bool HttpServletResponse::SendFileRegion(const std::string& path,
+                                         std::size_t offset,
+                                         std::size_t length)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  const auto fileSize = static_cast<std::size_t>(file.tellg());
+  if (offset > fileSize || length > fileSize - offset) {
+    return false;
+  }
+  if (length == 0) {
+    // frames the empty body like any other sent buffer
+    return this->SendBuffer(nullptr, 0);
+  }
+  file.seekg(static_cast<std::streamoff>(offset));
+
+  std::vector<char> block(std::min<std::size_t>(length, 64 * 1024));
+  while (length > 0) {
+    file.read(block.data(),
+              static_cast<std::streamsize>(std::min(length, block.size())));
+    const auto n = static_cast<std::size_t>(file.gcount());
+    if (n == 0 || !this->SendBuffer(block.data(), n)) {
+      return false;
+    }
+    length -= n;
+  }
+  return true;
+}
+
 void HttpServletResponse::Reset()
 {
   this->ResetBuffer();
@@ -23,7 +23,9 @@
 #ifndef CPPMICROSERVICES_HTTPSERVLETRESPONSEPRIVATE_H
 #define CPPMICROSERVICES_HTTPSERVLETRESPONSEPRIVATE_H
 
+#include <cstddef>
 #include <map>
+#include <streambuf>
 #include <string>
 
 class CivetServer;
@@ -31,6 +33,7 @@ struct mg_connection;
 
 namespace cppmicroservices {
 
+class HttpOutputStreamBuffer;
 class HttpServletRequest;
 
 struct HttpServletResponsePrivate
@@ -40,7 +43,11 @@ struct HttpServletResponsePrivate
                              mg_connection* conn);
   ~HttpServletResponsePrivate();
 
-  bool Commit();
+  /**
+   * Writes the status line and the headers, followed by \c data in the same
+   * write, unless the response is already committed.
+   */
+  bool Commit(const char* data = nullptr, std::size_t size = 0);
 
   std::string LexicalCast(long int value);
   std::string LexicalCastHex(long int value);
@@ -52,7 +59,7 @@ struct HttpServletResponsePrivate
   int m_StatusCode;
   std::map<std::string, std::string> m_Headers;
   std::streambuf* m_StreamBuf;
-  std::streambuf* m_HttpOutputStreamBuf;
+  HttpOutputStreamBuffer* m_HttpOutputStreamBuf;
   std::ostream* m_HttpOutputStream;
   bool m_IsCommited;
   std::size_t m_BufferSize;
@@ -41,7 +41,9 @@
 
 #include <cassert>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace cppmicroservices {
 
@@ -64,6 +66,26 @@ public:
 
 private:
   bool handleGet(CivetServer* server, mg_connection* conn) override
+  {
+    return HandleRequest(server, conn);
+  }
+
+  bool handlePost(CivetServer* server, mg_connection* conn) override
+  {
+    return HandleRequest(server, conn);
+  }
+
+  bool handlePut(CivetServer* server, mg_connection* conn) override
+  {
+    return HandleRequest(server, conn);
+  }
+
+  bool handleDelete(CivetServer* server, mg_connection* conn) override
+  {
+    return HandleRequest(server, conn);
+  }
+
+  bool HandleRequest(CivetServer* server, mg_connection* conn)
   {
     auto mg_req_info = mg_get_request_info(conn);
     if (mg_req_info->local_uri == nullptr) {
@@ -86,8 +108,11 @@ private:
       request.d->m_PathInfo = uri.substr(pathPrefix.size());
     }
 
-    HttpServletResponse response(
+    // the response does not own its private data; releasing it ends a
+    // chunked body
+    std::unique_ptr<HttpServletResponsePrivate> responseData(
       new HttpServletResponsePrivate(&request, server, conn));
+    HttpServletResponse response(responseData.get());
     response.SetStatus(HttpServletResponse::SC_OK);
 
     try {
@@ -96,15 +121,11 @@ private:
       std::cout << e.what() << std::endl;
       return false;
     }
+    // commits the headers of responses without a body
+    response.FlushBuffer();
     return true;
   }
 
-  //virtual bool handlePost(CivetServer *server, struct mg_connection *conn);
-
-  //virtual bool handlePut(CivetServer *server, struct mg_connection *conn);
-
-  //virtual bool handleDelete(CivetServer *server, struct mg_connection *conn);
-
 private:
   std::shared_ptr<HttpServlet> m_Servlet;
   std::string m_ServletPath;
@@ -114,6 +135,63 @@ private:
 //-----------        ServletContainerPrivate       ------------------
 //-------------------------------------------------------------------
 
+namespace {
+
+void AddOption(std::vector<std::string>& options,
+               const char* name,
+               std::string value)
+{
+  options.emplace_back(name);
+  options.push_back(std::move(value));
+}
+
+Any GetProperty(const AnyMap& properties, const std::string& key)
+{
+  auto iter = properties.find(key);
+  return iter != properties.end() ? iter->second : Any();
+}
+
+// Collects the civetweb options from the framework properties. Values of
+// the wrong type or out of range are ignored, so civetweb uses its default.
+std::vector<std::string> GetServerOptions(const AnyMap& properties)
+{
+  std::vector<std::string> options;
+
+  Any ports = GetProperty(properties, ServletContainer::PROP_LISTENING_PORTS);
+  if (ports.Type() == typeid(std::string) &&
+      !ref_any_cast<std::string>(ports).empty()) {
+    AddOption(options, "listening_ports", ref_any_cast<std::string>(ports));
+  } else if (ports.Type() == typeid(int) && ref_any_cast<int>(ports) > 0) {
+    AddOption(
+      options, "listening_ports", std::to_string(ref_any_cast<int>(ports)));
+  }
+
+  Any threads = GetProperty(properties, ServletContainer::PROP_NUM_THREADS);
+  if (threads.Type() == typeid(int) && ref_any_cast<int>(threads) > 0) {
+    AddOption(
+      options, "num_threads", std::to_string(ref_any_cast<int>(threads)));
+  }
+
+  Any keepAlive =
+    GetProperty(properties, ServletContainer::PROP_ENABLE_KEEP_ALIVE);
+  if (keepAlive.Type() == typeid(bool)) {
+    AddOption(options,
+              "enable_keep_alive",
+              ref_any_cast<bool>(keepAlive) ? "yes" : "no");
+  }
+
+  Any timeout =
+    GetProperty(properties, ServletContainer::PROP_REQUEST_TIMEOUT_MS);
+  if (timeout.Type() == typeid(int) && ref_any_cast<int>(timeout) > 0) {
+    AddOption(options,
+              "request_timeout_ms",
+              std::to_string(ref_any_cast<int>(timeout)));
+  }
+
+  return options;
+}
+}
+
 class ServletConfigImpl : public ServletConfig
 {
 public:
@@ -141,13 +219,15 @@ void ServletContainerPrivate::Start()
     if (m_Server)
       return;
 
-    m_Server = std::make_unique<CivetServer>(nullptr);
-    const mg_context* serverContext = m_Server->getContext();
-    if (serverContext == nullptr) {
-      std::cout << "Servlet Container could not be started." << std::endl;
-      m_Server.reset();
+    try {
+      m_Server = std::make_unique<CivetServer>(
+        GetServerOptions(m_Context.GetProperties()));
+    } catch (const CivetException& e) {
+      std::cout << "Servlet Container could not be started: " << e.what()
+                << std::endl;
       return;
     }
+    const mg_context* serverContext = m_Server->getContext();
     mg_get_ports(serverContext, 1, &port, &sslPort);
   }
 
@@ -245,6 +325,15 @@ void ServletContainerPrivate::RemovedService(
 //-----------            ServletContainer          ------------------
 //-------------------------------------------------------------------
 
+const std::string ServletContainer::PROP_LISTENING_PORTS =
+  "org.cppmicroservices.httpservice.listening_ports";
+const std::string ServletContainer::PROP_NUM_THREADS =
+  "org.cppmicroservices.httpservice.num_threads";
+const std::string ServletContainer::PROP_ENABLE_KEEP_ALIVE =
+  "org.cppmicroservices.httpservice.enable_keep_alive";
+const std::string ServletContainer::PROP_REQUEST_TIMEOUT_MS =
+  "org.cppmicroservices.httpservice.request_timeout_ms";
+
 ServletContainer::ServletContainer(BundleContext bundleCtx,
                                    const std::string& contextPath)
   : d(new ServletContainerPrivate(std::move(bundleCtx), this))
@@ -0,0 +1,180 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "cppmicroservices/httpservice/HttpServlet.h"
+#include "cppmicroservices/httpservice/HttpServletRequest.h"
+#include "cppmicroservices/httpservice/HttpServletResponse.h"
+#include "cppmicroservices/httpservice/ServletContainer.h"
+
+#include "civetweb/civetweb.h"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+using namespace cppmicroservices;
+
+namespace {
+
+const int PORT = 18451;
+const std::size_t PIECE_SIZE = 1024;
+
+/// Sends as many bytes as the query string asks for, either through the
+/// output stream in small pieces or with a single SendBuffer() call
+class PayloadServlet : public HttpServlet
+{
+public:
+  PayloadServlet()
+    : m_Payload(std::size_t(1) << 24, 'x')
+  {}
+
+  void DoGet(HttpServletRequest& request,
+             HttpServletResponse& response) override
+  {
+    const std::size_t size = std::min<std::size_t>(
+      std::strtoull(request.GetQueryString().c_str(), nullptr, 10),
+      m_Payload.size());
+    response.SetContentType("application/octet-stream");
+
+    if (request.GetPathInfo() == "/direct") {
+      response.SendBuffer(m_Payload.data(), size);
+      return;
+    }
+    auto& out = response.GetOutputStream();
+    for (std::size_t pos = 0; pos < size; pos += PIECE_SIZE) {
+      out.write(m_Payload.data() + pos,
+                static_cast<std::streamsize>(
+                  std::min(PIECE_SIZE, size - pos)));
+    }
+  }
+
+private:
+  const std::string m_Payload;
+};
+
+class ResponseFixture : public ::benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State&) override
+  {
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_LISTENING_PORTS] =
+      std::string("127.0.0.1:") + std::to_string(PORT);
+    framework = std::make_shared<Framework>(
+      FrameworkFactory().NewFramework(config));
+    framework->Start();
+
+    auto context = framework->GetBundleContext();
+    container = std::make_unique<ServletContainer>(context, "us");
+    container->Start();
+
+    ServiceProperties props;
+    props[HttpServlet::PROP_CONTEXT_ROOT] = std::string("/bench");
+    registration = context.RegisterService<HttpServlet>(
+      std::make_shared<PayloadServlet>(), props);
+  }
+
+  void TearDown(const ::benchmark::State&) override
+  {
+    registration.Unregister();
+    container->Stop();
+    container.reset();
+    framework->Stop();
+    framework->WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  /// Requests the path and returns the number of bytes received, or -1
+  long long Fetch(const std::string& path)
+  {
+    char ebuf[256] = { 0 };
+    mg_connection* conn =
+      mg_download("127.0.0.1",
+                  PORT,
+                  0,
+                  ebuf,
+                  sizeof(ebuf),
+                  "GET %s HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                  "Connection: close\r\n\r\n",
+                  path.c_str());
+    if (conn == nullptr) {
+      return -1;
+    }
+    long long total = 0;
+    char buf[64 * 1024];
+    int n = 0;
+    while ((n = mg_read(conn, buf, sizeof(buf))) > 0) {
+      total += n;
+    }
+    mg_close_connection(conn);
+    return total;
+  }
+
+  void Run(benchmark::State& state, const std::string& mode)
+  {
+    const std::string path =
+      "/us/bench/" + mode + "?" + std::to_string(state.range(0));
+    for (auto _ : state) {
+      if (Fetch(path) < state.range(0)) {
+        state.SkipWithError("incomplete response");
+        break;
+      }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+  }
+
+protected:
+  std::shared_ptr<Framework> framework;
+  std::unique_ptr<ServletContainer> container;
+  ServiceRegistration<HttpServlet> registration;
+};
+}
+
+/// Benchmark a response written through the output stream in 1 KiB pieces
+BENCHMARK_DEFINE_F(ResponseFixture, StreamedResponse)(benchmark::State& state)
+{
+  Run(state, "stream");
+}
+
+/// Benchmark a response handed to the container in a single SendBuffer() call
+BENCHMARK_DEFINE_F(ResponseFixture, DirectResponse)(benchmark::State& state)
+{
+  Run(state, "direct");
+}
+
+BENCHMARK_REGISTER_F(ResponseFixture, StreamedResponse)
+  ->RangeMultiplier(16)
+  ->Range(1 << 10, 1 << 24)
+  ->UseRealTime();
+
+BENCHMARK_REGISTER_F(ResponseFixture, DirectResponse)
+  ->RangeMultiplier(16)
+  ->Range(1 << 10, 1 << 24)
+  ->UseRealTime();
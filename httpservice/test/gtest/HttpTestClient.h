@@ -0,0 +1,239 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef CPPMICROSERVICES_HTTPTESTCLIENT_H
+#define CPPMICROSERVICES_HTTPTESTCLIENT_H
+
+#include "civetweb/civetweb.h"
+
+#if defined(_WIN32)
+#  include <winsock2.h>
+#else
+#  include <arpa/inet.h>
+#  include <netinet/in.h>
+#  include <sys/socket.h>
+#  include <sys/time.h>
+#  include <unistd.h>
+#endif
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices {
+namespace httptest {
+
+using Headers = std::vector<std::pair<std::string, std::string>>;
+
+struct Response
+{
+  int status = -1; ///< -1 if the response could not be read completely
+  Headers headers;
+  std::string body;
+
+  /// The value of the response header, or an empty string
+  std::string GetHeader(const std::string& name) const
+  {
+    for (const auto& header : headers) {
+      if (mg_strcasecmp(header.first.c_str(), name.c_str()) == 0) {
+        return header.second;
+      }
+    }
+    return std::string();
+  }
+
+  bool HasHeader(const std::string& name) const
+  {
+    for (const auto& header : headers) {
+      if (mg_strcasecmp(header.first.c_str(), name.c_str()) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/**
+ * Sends the request head, which must end with an empty line, followed by the
+ * body, and reads the response. The connection is closed afterwards.
+ */
+inline Response SendRaw(int port,
+                        const std::string& head,
+                        const std::string& body = std::string())
+{
+  Response response;
+  char ebuf[256] = { 0 };
+  mg_connection* conn =
+    mg_connect_client("127.0.0.1", port, 0, ebuf, sizeof(ebuf));
+  if (conn == nullptr) {
+    return response;
+  }
+  if (mg_write(conn, head.data(), head.size()) < 0 ||
+      (!body.empty() && mg_write(conn, body.data(), body.size()) < 0) ||
+      mg_get_response(conn, ebuf, sizeof(ebuf), 30000) < 0) {
+    mg_close_connection(conn);
+    return response;
+  }
+  const mg_request_info* info = mg_get_request_info(conn);
+  for (int i = 0; i < info->num_headers; ++i) {
+    response.headers.emplace_back(info->http_headers[i].name,
+                                  info->http_headers[i].value);
+  }
+  // the request URI of a response holds its status code
+  const int status = std::atoi(info->request_uri);
+  // responses to HEAD and 1xx, 204 and 304 responses never have a body,
+  // mg_read() would wait for one until the connection is closed
+  const bool hasBody = head.compare(0, 5, "HEAD ") != 0 && status >= 200 &&
+                       status != 204 && status != 304;
+  char buf[4096];
+  int n = 0;
+  while (hasBody && (n = mg_read(conn, buf, sizeof(buf))) > 0) {
+    response.body.append(buf, static_cast<std::size_t>(n));
+  }
+  mg_close_connection(conn);
+  // mg_read() fails if the chunked coding is broken
+  response.status = n < 0 ? -1 : status;
+  return response;
+}
+
+/**
+ * Sends a request with the given headers and body, and a Content-Length
+ * header if there is a body or the method expects one. Without it, the
+ * server would read the body of a POST or PUT until the connection closes.
+ */
+inline Response Send(int port,
+                     const std::string& method,
+                     const std::string& path,
+                     const Headers& headers = Headers(),
+                     const std::string& body = std::string())
+{
+  std::string head = method + " " + path +
+                     " HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n";
+  for (const auto& header : headers) {
+    head += header.first + ": " + header.second + "\r\n";
+  }
+  if (!body.empty() || method == "POST" || method == "PUT") {
+    head += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  }
+  head += "\r\n";
+  return SendRaw(port, head, body);
+}
+
+namespace detail {
+
+/// Whether data holds a complete response with a Content-Length header
+inline bool HasCompleteResponse(const std::string& data)
+{
+  const std::size_t headEnd = data.find("\r\n\r\n");
+  if (headEnd == std::string::npos) {
+    return false;
+  }
+  std::size_t length = 0;
+  std::size_t pos = data.find("\r\n");
+  while (pos < headEnd) {
+    const std::size_t next = data.find("\r\n", pos + 2);
+    const std::string line = data.substr(pos + 2, next - pos - 2);
+    static const std::string name = "content-length:";
+    if (line.size() > name.size() &&
+        mg_strncasecmp(line.c_str(), name.c_str(), name.size()) == 0) {
+      length = std::strtoull(line.c_str() + name.size(), nullptr, 10);
+    }
+    pos = next;
+  }
+  return data.size() >= headEnd + 4 + length;
+}
+}
+
+/**
+ * Sends the requests one after the other over a single connection, each
+ * after the response to the previous one was received completely, and
+ * returns everything the server sent until it closed the connection.
+ * Unlike the civetweb client, this sees all responses of a kept-alive
+ * connection. The responses must have a Content-Length header.
+ */
+inline std::string Exchange(int port, const std::vector<std::string>& requests)
+{
+  std::string received;
+#if defined(_WIN32)
+  using Socket = SOCKET;
+  const Socket invalidSocket = INVALID_SOCKET;
+  auto closeSocket = [](Socket s) { closesocket(s); };
+  DWORD timeout = 30000;
+#else
+  using Socket = int;
+  const Socket invalidSocket = -1;
+  auto closeSocket = [](Socket s) { close(s); };
+  timeval timeout = { 30, 0 };
+#endif
+#if defined(MSG_NOSIGNAL)
+  // the server might have closed the connection already
+  const int sendFlags = MSG_NOSIGNAL;
+#else
+  const int sendFlags = 0;
+#endif
+  Socket s = socket(AF_INET, SOCK_STREAM, 0);
+  if (s == invalidSocket) {
+    return received;
+  }
+  setsockopt(s,
+             SOL_SOCKET,
+             SO_RCVTIMEO,
+             reinterpret_cast<const char*>(&timeout),
+             sizeof(timeout));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<unsigned short>(port));
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (connect(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) !=
+      0) {
+    closeSocket(s);
+    return received;
+  }
+  char buf[4096];
+  int n = 0;
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    const std::string& request = requests[i];
+    if (send(s, request.data(), static_cast<int>(request.size()), sendFlags) !=
+        static_cast<int>(request.size())) {
+      break;
+    }
+    // read the response before sending the next request, and everything
+    // after the last one
+    const bool last = i + 1 == requests.size();
+    std::string response;
+    while ((last || !detail::HasCompleteResponse(response)) &&
+           (n = static_cast<int>(recv(s, buf, sizeof(buf), 0))) > 0) {
+      response.append(buf, static_cast<std::size_t>(n));
+    }
+    received += response;
+    if (n <= 0) {
+      break;
+    }
+  }
+  closeSocket(s);
+  return received;
+}
+}
+}
+
+#endif // CPPMICROSERVICES_HTTPTESTCLIENT_H
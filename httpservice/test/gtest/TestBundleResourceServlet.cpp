@@ -0,0 +1,447 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleResource.h"
+#include "cppmicroservices/BundleResourceStream.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "cppmicroservices/httpservice/BundleResourceServlet.h"
+#include "cppmicroservices/httpservice/HttpServlet.h"
+#include "cppmicroservices/httpservice/HttpServletRequest.h"
+#include "cppmicroservices/httpservice/HttpServletResponse.h"
+#include "cppmicroservices/httpservice/ServletContainer.h"
+
+#include "HttpTestClient.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace cppmicroservices;
+using namespace cppmicroservices::httptest;
+
+namespace {
+
+const int PORT = 18454;
+
+/// Serves the resources below "/static" without the ".gz" negotiation
+class SpoolServlet : public BundleResourceServlet
+{
+public:
+  explicit SpoolServlet(Bundle bundle)
+    : m_Bundle(std::move(bundle))
+  {}
+
+  void DoGet(HttpServletRequest& request,
+             HttpServletResponse& response) override
+  {
+    auto resource = m_Bundle.GetResource("/static" + request.GetPathInfo());
+    if (!SpoolResource(resource, request, response)) {
+      response.SendError(HttpServletResponse::SC_NOT_FOUND);
+    }
+  }
+
+private:
+  Bundle m_Bundle;
+};
+
+class BundleResourceServletTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_LISTENING_PORTS] =
+      std::string("127.0.0.1:") + std::to_string(PORT);
+    framework = std::make_shared<Framework>(
+      FrameworkFactory().NewFramework(config));
+    framework->Start();
+
+    auto context = framework->GetBundleContext();
+    for (auto& b : context.GetBundles()) {
+      if (b.GetSymbolicName() == "main") {
+        bundle = b;
+      }
+    }
+    ASSERT_TRUE(bundle) << "the test executable is not a bundle";
+
+    container = std::make_unique<ServletContainer>(context, "us");
+    container->Start();
+
+    Register("/res",
+             std::make_shared<BundleResourceServlet>(bundle, "/static/"));
+    // too small to hold both hello.txt and plain.css
+    Register(
+      "/small",
+      std::make_shared<BundleResourceServlet>(
+        bundle, "/static", GetResource("/static/hello.txt").GetSize() + 1));
+    Register("/spool", std::make_shared<SpoolServlet>(bundle));
+  }
+
+  void TearDown() override
+  {
+    for (auto& registration : registrations) {
+      registration.Unregister();
+    }
+    if (container) {
+      container->Stop();
+      container.reset();
+    }
+    framework->Stop();
+    framework->WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  void Register(const std::string& contextRoot,
+                const std::shared_ptr<HttpServlet>& servlet)
+  {
+    ServiceProperties props;
+    props[HttpServlet::PROP_CONTEXT_ROOT] = contextRoot;
+    registrations.push_back(
+      framework->GetBundleContext().RegisterService<HttpServlet>(servlet,
+                                                                 props));
+  }
+
+  BundleResource GetResource(const std::string& path) const
+  {
+    return bundle.GetResource(path);
+  }
+
+  std::string GetContent(const std::string& path) const
+  {
+    BundleResourceStream stream(GetResource(path), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(stream),
+                       std::istreambuf_iterator<char>());
+  }
+
+  /// The entity tag the servlet computes for the resource
+  std::string GetETag(const std::string& path, bool gzip = false) const
+  {
+    auto resource = GetResource(path);
+    std::ostringstream etag;
+    etag << '"' << std::hex << resource.GetCrc32() << '-'
+         << resource.GetSize() << (gzip ? "-gz" : "") << '"';
+    return etag.str();
+  }
+
+  static Response Get(const std::string& path,
+                      const Headers& headers = Headers())
+  {
+    return Send(PORT, "GET", path, headers);
+  }
+
+  std::shared_ptr<Framework> framework;
+  Bundle bundle;
+  std::unique_ptr<ServletContainer> container;
+  std::vector<ServiceRegistration<HttpServlet>> registrations;
+};
+}
+
+TEST_F(BundleResourceServletTest, ServesResource)
+{
+  const std::string content = GetContent("/static/hello.txt");
+  ASSERT_FALSE(content.empty());
+
+  auto response = Get("/us/res/hello.txt");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, content);
+  EXPECT_EQ(response.GetHeader("Content-Length"),
+            std::to_string(content.size()));
+  EXPECT_EQ(response.GetHeader("Content-Type"), "text/plain");
+  EXPECT_EQ(response.GetHeader("Accept-Ranges"), "bytes");
+  EXPECT_FALSE(response.HasHeader("Content-Encoding"));
+  // hello.txt has a gzip encoded sibling
+  EXPECT_EQ(response.GetHeader("Vary"), "Accept-Encoding");
+
+  response = Get("/us/res/plain.css");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, GetContent("/static/plain.css"));
+  EXPECT_EQ(response.GetHeader("Content-Type"), "text/css");
+  EXPECT_FALSE(response.HasHeader("Vary"));
+
+  EXPECT_EQ(Get("/us/res/missing.txt").status, 404);
+  // a directory is not a resource
+  EXPECT_EQ(Get("/us/res/").status, 404);
+}
+
+TEST_F(BundleResourceServletTest, ETagAndLastModified)
+{
+  auto response = Get("/us/res/hello.txt");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.GetHeader("ETag"), GetETag("/static/hello.txt"));
+
+  // the embedded resources carry their modification time
+  ASSERT_GT(GetResource("/static/hello.txt").GetLastModified(), 0);
+  const std::string lastModified = response.GetHeader("Last-Modified");
+  ASSERT_FALSE(lastModified.empty());
+  EXPECT_NE(lastModified.find(" GMT"), std::string::npos) << lastModified;
+
+  // the headers do not change between requests
+  auto again = Get("/us/res/hello.txt");
+  ASSERT_EQ(again.status, 200);
+  EXPECT_EQ(again.GetHeader("ETag"), response.GetHeader("ETag"));
+  EXPECT_EQ(again.GetHeader("Last-Modified"), lastModified);
+
+  // different content, different tag
+  response = Get("/us/res/plain.css");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.GetHeader("ETag"), GetETag("/static/plain.css"));
+}
+
+TEST_F(BundleResourceServletTest, IfNoneMatch)
+{
+  const std::string etag = GetETag("/static/hello.txt");
+
+  auto response = Get("/us/res/hello.txt", { { "If-None-Match", etag } });
+  EXPECT_EQ(response.status, 304);
+  EXPECT_TRUE(response.body.empty());
+  EXPECT_EQ(response.GetHeader("ETag"), etag);
+
+  // one of several tags
+  response = Get("/us/res/hello.txt",
+                 { { "If-None-Match", "\"0-0\", " + etag + ", \"1-1\"" } });
+  EXPECT_EQ(response.status, 304);
+
+  response = Get("/us/res/hello.txt", { { "If-None-Match", "*" } });
+  EXPECT_EQ(response.status, 304);
+
+  // a stale tag gets the content
+  response = Get("/us/res/hello.txt", { { "If-None-Match", "\"0-0\"" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, GetContent("/static/hello.txt"));
+
+  // the tag of the identity encoding does not match the gzip encoding
+  response = Get("/us/res/hello.txt",
+                 { { "If-None-Match", etag }, { "Accept-Encoding", "gzip" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, GetContent("/static/hello.txt.gz"));
+}
+
+TEST_F(BundleResourceServletTest, IfModifiedSince)
+{
+  const std::string lastModified =
+    Get("/us/res/hello.txt").GetHeader("Last-Modified");
+  ASSERT_FALSE(lastModified.empty());
+
+  auto response =
+    Get("/us/res/hello.txt", { { "If-Modified-Since", lastModified } });
+  EXPECT_EQ(response.status, 304);
+  EXPECT_TRUE(response.body.empty());
+
+  response = Get("/us/res/hello.txt",
+                 { { "If-Modified-Since", "Tue, 01 Jan 2030 00:00:00 GMT" } });
+  EXPECT_EQ(response.status, 304);
+
+  response = Get("/us/res/hello.txt",
+                 { { "If-Modified-Since", "Thu, 01 Jan 1998 00:00:00 GMT" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, GetContent("/static/hello.txt"));
+
+  // If-None-Match takes precedence
+  response = Get("/us/res/hello.txt",
+                 { { "If-None-Match", "\"0-0\"" },
+                   { "If-Modified-Since", lastModified } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, GetContent("/static/hello.txt"));
+}
+
+TEST_F(BundleResourceServletTest, Range)
+{
+  const std::string content = GetContent("/static/hello.txt");
+  const std::string size = std::to_string(content.size());
+
+  auto response = Get("/us/res/hello.txt", { { "Range", "bytes=2-5" } });
+  ASSERT_EQ(response.status, 206);
+  EXPECT_EQ(response.body, content.substr(2, 4));
+  EXPECT_EQ(response.GetHeader("Content-Range"), "bytes 2-5/" + size);
+  EXPECT_EQ(response.GetHeader("Content-Length"), "4");
+
+  // the last bytes
+  response = Get("/us/res/hello.txt", { { "Range", "bytes=-3" } });
+  ASSERT_EQ(response.status, 206);
+  EXPECT_EQ(response.body, content.substr(content.size() - 3));
+
+  // open ended, and a last byte beyond the end
+  response = Get("/us/res/hello.txt", { { "Range", "bytes=100-" } });
+  ASSERT_EQ(response.status, 206);
+  EXPECT_EQ(response.body, content.substr(100));
+  response = Get("/us/res/hello.txt", { { "Range", "bytes=100-99999" } });
+  ASSERT_EQ(response.status, 206);
+  EXPECT_EQ(response.body, content.substr(100));
+
+  // several ranges or a malformed range get the whole content
+  response = Get("/us/res/hello.txt", { { "Range", "bytes=0-1,4-5" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, content);
+  response = Get("/us/res/hello.txt", { { "Range", "bytes=5-2" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, content);
+  response = Get("/us/res/hello.txt", { { "Range", "lines=1-2" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, content);
+}
+
+TEST_F(BundleResourceServletTest, RangeNotSatisfiable)
+{
+  const std::string size =
+    std::to_string(GetContent("/static/hello.txt").size());
+
+  for (const std::string& range :
+       { "bytes=" + size + "-", std::string("bytes=-0") }) {
+    auto response = Get("/us/res/hello.txt", { { "Range", range } });
+    EXPECT_EQ(response.status, 416) << range;
+    EXPECT_EQ(response.GetHeader("Content-Range"), "bytes */" + size)
+      << range;
+    EXPECT_TRUE(response.body.empty()) << range;
+  }
+}
+
+TEST_F(BundleResourceServletTest, IfRange)
+{
+  const std::string content = GetContent("/static/hello.txt");
+  const std::string etag = GetETag("/static/hello.txt");
+
+  auto response = Get("/us/res/hello.txt",
+                      { { "Range", "bytes=10-19" }, { "If-Range", etag } });
+  ASSERT_EQ(response.status, 206);
+  EXPECT_EQ(response.body, content.substr(10, 10));
+
+  // the range is ignored if the client's copy is stale
+  response = Get("/us/res/hello.txt",
+                 { { "Range", "bytes=10-19" }, { "If-Range", "\"0-0\"" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, content);
+}
+
+TEST_F(BundleResourceServletTest, GzipEncoding)
+{
+  const std::string encoded = GetContent("/static/hello.txt.gz");
+  ASSERT_FALSE(encoded.empty());
+
+  for (const std::string accept : { "gzip", "deflate, gzip;q=0.5", " gzip " }) {
+    auto response =
+      Get("/us/res/hello.txt", { { "Accept-Encoding", accept } });
+    ASSERT_EQ(response.status, 200) << accept;
+    EXPECT_EQ(response.body, encoded) << accept;
+    EXPECT_EQ(response.GetHeader("Content-Encoding"), "gzip") << accept;
+    EXPECT_EQ(response.GetHeader("Vary"), "Accept-Encoding") << accept;
+    // the type of the decoded content
+    EXPECT_EQ(response.GetHeader("Content-Type"), "text/plain") << accept;
+    EXPECT_EQ(response.GetHeader("ETag"),
+              GetETag("/static/hello.txt.gz", true))
+      << accept;
+  }
+
+  // gzip is not acceptable
+  for (const std::string accept : { "gzip;q=0", "deflate", "x-gzip" }) {
+    auto response =
+      Get("/us/res/hello.txt", { { "Accept-Encoding", accept } });
+    ASSERT_EQ(response.status, 200) << accept;
+    EXPECT_EQ(response.body, GetContent("/static/hello.txt")) << accept;
+    EXPECT_FALSE(response.HasHeader("Content-Encoding")) << accept;
+    EXPECT_EQ(response.GetHeader("Vary"), "Accept-Encoding") << accept;
+  }
+
+  // nothing to negotiate without a ".gz" sibling
+  auto response =
+    Get("/us/res/plain.css", { { "Accept-Encoding", "gzip" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, GetContent("/static/plain.css"));
+  EXPECT_FALSE(response.HasHeader("Content-Encoding"));
+  EXPECT_FALSE(response.HasHeader("Vary"));
+
+  // ranges apply to the encoded content
+  response = Get("/us/res/hello.txt",
+                 { { "Accept-Encoding", "gzip" }, { "Range", "bytes=0-9" } });
+  ASSERT_EQ(response.status, 206);
+  EXPECT_EQ(response.body, encoded.substr(0, 10));
+  EXPECT_EQ(response.GetHeader("Content-Range"),
+            "bytes 0-9/" + std::to_string(encoded.size()));
+
+  // the encoded content is validated by its own tag
+  const std::string encodedETag = GetETag("/static/hello.txt.gz", true);
+  response = Get("/us/res/hello.txt",
+                 { { "Accept-Encoding", "gzip" },
+                   { "If-None-Match", encodedETag } });
+  EXPECT_EQ(response.status, 304);
+}
+
+TEST_F(BundleResourceServletTest, SpoolResource)
+{
+  // a servlet spooling resources itself does not negotiate the encoding
+  auto response =
+    Get("/us/spool/hello.txt", { { "Accept-Encoding", "gzip" } });
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, GetContent("/static/hello.txt"));
+  EXPECT_FALSE(response.HasHeader("Content-Encoding"));
+  EXPECT_FALSE(response.HasHeader("Vary"));
+  EXPECT_EQ(response.GetHeader("ETag"), GetETag("/static/hello.txt"));
+
+  response = Get("/us/spool/hello.txt",
+                 { { "If-None-Match", GetETag("/static/hello.txt") } });
+  EXPECT_EQ(response.status, 304);
+
+  EXPECT_EQ(Get("/us/spool/missing.txt").status, 404);
+}
+
+TEST_F(BundleResourceServletTest, CacheRevalidation)
+{
+  const std::string hello = GetContent("/static/hello.txt");
+  const std::string encoded = GetContent("/static/hello.txt.gz");
+  const std::string css = GetContent("/static/plain.css");
+  const std::string etag = GetETag("/static/hello.txt");
+
+  // The small cache evicts one resource for the other on every request, the
+  // default cache serves them from memory after the first request. Either
+  // way, the content and its validators stay the same.
+  for (const std::string root : { "/us/res", "/us/small" }) {
+    for (int i = 0; i < 5; ++i) {
+      auto response = Get(root + "/hello.txt");
+      ASSERT_EQ(response.status, 200) << root;
+      EXPECT_EQ(response.body, hello) << root;
+      EXPECT_EQ(response.GetHeader("ETag"), etag) << root;
+
+      response = Get(root + "/plain.css");
+      ASSERT_EQ(response.status, 200) << root;
+      EXPECT_EQ(response.body, css) << root;
+
+      response = Get(root + "/hello.txt", { { "Accept-Encoding", "gzip" } });
+      ASSERT_EQ(response.status, 200) << root;
+      EXPECT_EQ(response.body, encoded) << root;
+
+      // a client revalidating its cached copy
+      response = Get(root + "/hello.txt", { { "If-None-Match", etag } });
+      EXPECT_EQ(response.status, 304) << root;
+
+      response = Get(root + "/hello.txt", { { "Range", "bytes=-5" } });
+      ASSERT_EQ(response.status, 206) << root;
+      EXPECT_EQ(response.body, hello.substr(hello.size() - 5)) << root;
+    }
+  }
+}
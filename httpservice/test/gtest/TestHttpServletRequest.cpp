@@ -0,0 +1,449 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "cppmicroservices/httpservice/HttpServlet.h"
+#include "cppmicroservices/httpservice/HttpServletRequest.h"
+#include "cppmicroservices/httpservice/HttpServletResponse.h"
+#include "cppmicroservices/httpservice/ServletContainer.h"
+
+#include "HttpTestClient.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+
+using namespace cppmicroservices;
+using namespace cppmicroservices::httptest;
+
+namespace {
+
+const int PORT = 18455;
+const std::size_t BUFFER_SIZE = 4096; // of the request's input stream
+
+/// A body whose bytes depend on their position, so that reordered or
+/// dropped bytes are noticed
+std::string MakeBody(std::size_t size)
+{
+  std::string body(size, '\0');
+  for (std::size_t i = 0; i < size; ++i) {
+    body[i] = static_cast<char>((i * 13 + i / 241) % 256);
+  }
+  return body;
+}
+
+/// Sends back the request body. The path info selects how the body is read
+/// from the input stream.
+class EchoServlet : public HttpServlet
+{
+public:
+  void DoPost(HttpServletRequest& request,
+              HttpServletResponse& response) override
+  {
+    Echo(request, response);
+  }
+
+  void DoPut(HttpServletRequest& request,
+             HttpServletResponse& response) override
+  {
+    Echo(request, response);
+  }
+
+  void DoDelete(HttpServletRequest& request,
+                HttpServletResponse& response) override
+  {
+    const std::string body = "deleted " + request.GetPathInfo();
+    response.SetHeader("X-Method", request.GetMethod());
+    response.SetContentType("text/plain");
+    response.SetContentLength(body.size());
+    response.SendBuffer(body.data(), body.size());
+  }
+
+private:
+  static void Echo(HttpServletRequest& request, HttpServletResponse& response)
+  {
+    const std::string mode = request.GetPathInfo();
+    auto& in = request.GetInputStream();
+    std::string body;
+    if (mode == "/get") {
+      // one character at a time, refilling the buffer through underflow()
+      for (int c = in.get(); c != std::char_traits<char>::eof();
+           c = in.get()) {
+        body.push_back(static_cast<char>(c));
+      }
+    } else if (mode == "/read" || mode == "/large") {
+      // blocks smaller than the buffer are copied from it, larger blocks
+      // are read directly
+      const std::size_t block =
+        mode == "/read" ? BUFFER_SIZE / 4 : 2 * BUFFER_SIZE + 17;
+      std::string buf(block, '\0');
+      while (in.read(&buf[0], static_cast<std::streamsize>(block)) ||
+             in.gcount() > 0) {
+        body.append(buf, 0, static_cast<std::size_t>(in.gcount()));
+      }
+    } else if (mode == "/mixed") {
+      // a direct read must drain the buffer filled by get() first
+      std::string buf(3 * BUFFER_SIZE, '\0');
+      for (int c = in.get(); c != std::char_traits<char>::eof();
+           c = in.get()) {
+        body.push_back(static_cast<char>(c));
+        in.read(&buf[0], static_cast<std::streamsize>(buf.size()));
+        body.append(buf, 0, static_cast<std::size_t>(in.gcount()));
+        in.clear(in.rdstate() & ~std::ios::failbit);
+      }
+    } else {
+      response.SendError(HttpServletResponse::SC_NOT_FOUND);
+      return;
+    }
+
+    response.SetHeader("X-Method", request.GetMethod());
+    response.SetHeader("X-Content-Length",
+                       std::to_string(request.GetContentLength()));
+    response.SetContentType("application/octet-stream");
+    response.SetContentLength(body.size());
+    if (!body.empty()) {
+      response.SendBuffer(body.data(), body.size());
+    }
+  }
+};
+
+/// Reports whether another request was served at the same time
+class ConcurrencyServlet : public HttpServlet
+{
+public:
+  void DoGet(HttpServletRequest&, HttpServletResponse& response) override
+  {
+    bool together = false;
+    {
+      // wait a while for the other request, a single worker thread only
+      // takes it when this one is done
+      std::unique_lock<std::mutex> l(m_Mutex);
+      if (++m_Active > 1) {
+        m_Overlapped = true;
+        m_Changed.notify_all();
+      }
+      together = m_Changed.wait_for(
+        l, std::chrono::seconds(2), [this] { return m_Overlapped; });
+    }
+    const std::string body = together ? "together" : "alone";
+    response.SetContentLength(body.size());
+    response.SendBuffer(body.data(), body.size());
+
+    std::lock_guard<std::mutex> l(m_Mutex);
+    --m_Active;
+  }
+
+private:
+  std::mutex m_Mutex;
+  std::condition_variable m_Changed;
+  int m_Active = 0;
+  bool m_Overlapped = false; ///< two requests were served at the same time
+};
+
+/// Only answers GET requests
+class GetOnlyServlet : public HttpServlet
+{
+public:
+  void DoGet(HttpServletRequest&, HttpServletResponse& response) override
+  {
+    const std::string body = "ok";
+    response.SetContentType("text/plain");
+    response.SetContentLength(body.size());
+    response.SendBuffer(body.data(), body.size());
+  }
+};
+
+/// Answers with the query string and the path info of the request
+class QueryServlet : public HttpServlet
+{
+public:
+  void DoGet(HttpServletRequest& request,
+             HttpServletResponse& response) override
+  {
+    const std::string body =
+      request.GetQueryString() + "|" + request.GetPathInfo();
+    response.SetContentType("text/plain");
+    response.SetContentLength(body.size());
+    response.SendBuffer(body.data(), body.size());
+  }
+};
+
+class HttpServletRequestTest : public ::testing::Test
+{
+protected:
+  void TearDown() override { Stop(); }
+
+  /// Starts a container configured with the framework properties
+  void Start(FrameworkConfiguration config = FrameworkConfiguration())
+  {
+    if (config.find(ServletContainer::PROP_LISTENING_PORTS) == config.end()) {
+      config[ServletContainer::PROP_LISTENING_PORTS] =
+        std::string("127.0.0.1:") + std::to_string(PORT);
+    }
+    framework = std::make_shared<Framework>(
+      FrameworkFactory().NewFramework(config));
+    framework->Start();
+
+    auto context = framework->GetBundleContext();
+    container = std::make_unique<ServletContainer>(context, "us");
+    container->Start();
+
+    Register("/echo", std::make_shared<EchoServlet>());
+    Register("/wait", std::make_shared<ConcurrencyServlet>());
+    Register("/get", std::make_shared<GetOnlyServlet>());
+    Register("/query", std::make_shared<QueryServlet>());
+  }
+
+  void Stop()
+  {
+    for (auto& registration : registrations) {
+      registration.Unregister();
+    }
+    registrations.clear();
+    if (container) {
+      container->Stop();
+      container.reset();
+    }
+    if (framework) {
+      framework->Stop();
+      framework->WaitForStop(std::chrono::milliseconds::zero());
+      framework.reset();
+    }
+  }
+
+  void Register(const std::string& contextRoot,
+                const std::shared_ptr<HttpServlet>& servlet)
+  {
+    ServiceProperties props;
+    props[HttpServlet::PROP_CONTEXT_ROOT] = contextRoot;
+    registrations.push_back(
+      framework->GetBundleContext().RegisterService<HttpServlet>(servlet,
+                                                                 props));
+  }
+
+  /// Posts bodies around the buffer size in the given mode
+  void ExpectEchoes(const std::string& mode)
+  {
+    for (std::size_t size : { std::size_t(0),
+                              std::size_t(1),
+                              BUFFER_SIZE - 1,
+                              BUFFER_SIZE,
+                              BUFFER_SIZE + 1,
+                              3 * BUFFER_SIZE + 5,
+                              std::size_t(1) << 20 }) {
+      const std::string body = MakeBody(size);
+      auto response = Send(PORT, "POST", "/us/echo/" + mode, {}, body);
+      ASSERT_EQ(response.status, 200) << mode << " " << size;
+      EXPECT_EQ(response.GetHeader("X-Content-Length"), std::to_string(size))
+        << mode;
+      ASSERT_EQ(response.body.size(), size) << mode;
+      EXPECT_TRUE(response.body == body) << mode << " " << size;
+    }
+  }
+
+  /// Requests "/us/wait" twice at the same time and returns both answers
+  std::string GetConcurrently()
+  {
+    auto first = std::async(std::launch::async,
+                            [] { return Send(PORT, "GET", "/us/wait"); });
+    auto second = Send(PORT, "GET", "/us/wait");
+    return first.get().body + " " + second.body;
+  }
+
+  /// Sends two requests over one connection and returns the number of
+  /// responses received before the server closed it
+  static int CountKeptAliveResponses()
+  {
+    const std::string get = "GET /us/get HTTP/1.1\r\nHost: 127.0.0.1\r\n";
+    const std::string received = Exchange(
+      PORT, { get + "\r\n", get + "Connection: close\r\n\r\n" });
+    int count = 0;
+    for (auto pos = received.find("HTTP/1.1 200"); pos != std::string::npos;
+         pos = received.find("HTTP/1.1 200", pos + 1)) {
+      ++count;
+    }
+    return count;
+  }
+
+  std::shared_ptr<Framework> framework;
+  std::unique_ptr<ServletContainer> container;
+  std::vector<ServiceRegistration<HttpServlet>> registrations;
+};
+}
+
+TEST_F(HttpServletRequestTest, ReadCharacters)
+{
+  Start();
+  ExpectEchoes("get");
+}
+
+TEST_F(HttpServletRequestTest, ReadBlocks)
+{
+  Start();
+  ExpectEchoes("read");
+}
+
+TEST_F(HttpServletRequestTest, ReadLargeBlocks)
+{
+  Start();
+  ExpectEchoes("large");
+}
+
+TEST_F(HttpServletRequestTest, ReadMixed)
+{
+  Start();
+  ExpectEchoes("mixed");
+}
+
+TEST_F(HttpServletRequestTest, ShortBody)
+{
+  FrameworkConfiguration config;
+  config[ServletContainer::PROP_REQUEST_TIMEOUT_MS] = 200;
+  Start(config);
+
+  // the client announces more than it sends, the stream ends with the data
+  // received before the request timed out
+  const auto start = std::chrono::steady_clock::now();
+  auto response = SendRaw(PORT,
+                          "POST /us/echo/read HTTP/1.1\r\n"
+                          "Host: 127.0.0.1\r\nContent-Length: 10\r\n\r\n",
+                          "abc");
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.GetHeader("X-Content-Length"), "10");
+  EXPECT_EQ(response.body, "abc");
+  // well before the default timeout of 30 seconds
+  EXPECT_LT(elapsed, std::chrono::seconds(10));
+}
+
+TEST_F(HttpServletRequestTest, MethodDispatch)
+{
+  Start();
+  const std::string body = MakeBody(BUFFER_SIZE + 1);
+
+  auto response = Send(PORT, "POST", "/us/echo/read", {}, body);
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.GetHeader("X-Method"), "POST");
+  EXPECT_TRUE(response.body == body);
+
+  response = Send(PORT, "PUT", "/us/echo/read", {}, body);
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.GetHeader("X-Method"), "PUT");
+  EXPECT_TRUE(response.body == body);
+
+  response = Send(PORT, "DELETE", "/us/echo/item");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.GetHeader("X-Method"), "DELETE");
+  EXPECT_EQ(response.body, "deleted /item");
+
+  // not implemented by the servlet
+  EXPECT_EQ(Send(PORT, "GET", "/us/echo/read").status, 405);
+  EXPECT_EQ(Send(PORT, "POST", "/us/get", {}, body).status, 405);
+  EXPECT_EQ(Send(PORT, "PUT", "/us/get", {}, body).status, 405);
+  EXPECT_EQ(Send(PORT, "DELETE", "/us/get").status, 405);
+  response = Send(PORT, "GET", "/us/get");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, "ok");
+}
+
+TEST_F(HttpServletRequestTest, QueryString)
+{
+  Start();
+
+  // the query is neither decoded nor part of the path info
+  auto response = Send(PORT, "GET", "/us/query/a/b?start=5&count=%2010");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, "start=5&count=%2010|/a/b");
+
+  response = Send(PORT, "GET", "/us/query/a?x=?y");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, "x=?y|/a");
+
+  for (const char* path : { "/us/query/a", "/us/query/a?" }) {
+    response = Send(PORT, "GET", path);
+    ASSERT_EQ(response.status, 200) << path;
+    EXPECT_EQ(response.body, "|/a") << path;
+  }
+}
+
+TEST_F(HttpServletRequestTest, ListeningPortsAsInt)
+{
+  FrameworkConfiguration config;
+  config[ServletContainer::PROP_LISTENING_PORTS] = PORT;
+  Start(config);
+
+  auto response = Send(PORT, "GET", "/us/get");
+  ASSERT_EQ(response.status, 200);
+  EXPECT_EQ(response.body, "ok");
+}
+
+TEST_F(HttpServletRequestTest, NumThreads)
+{
+  {
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_NUM_THREADS] = 1;
+    Start(config);
+    EXPECT_EQ(GetConcurrently(), "alone alone");
+  }
+  Stop();
+  {
+    // not an int, the default number of threads is used
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_NUM_THREADS] = std::string("1");
+    Start(config);
+    EXPECT_EQ(GetConcurrently(), "together together");
+  }
+}
+
+TEST_F(HttpServletRequestTest, KeepAlive)
+{
+  {
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_ENABLE_KEEP_ALIVE] = true;
+    Start(config);
+    EXPECT_EQ(CountKeptAliveResponses(), 2);
+  }
+  Stop();
+  {
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_ENABLE_KEEP_ALIVE] = false;
+    Start(config);
+    EXPECT_EQ(CountKeptAliveResponses(), 1);
+  }
+  Stop();
+  {
+    // not a bool, keep-alive stays disabled
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_ENABLE_KEEP_ALIVE] = std::string("yes");
+    Start(config);
+    EXPECT_EQ(CountKeptAliveResponses(), 1);
+  }
+}
@@ -0,0 +1,287 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "cppmicroservices/httpservice/HttpServlet.h"
+#include "cppmicroservices/httpservice/HttpServletRequest.h"
+#include "cppmicroservices/httpservice/HttpServletResponse.h"
+#include "cppmicroservices/httpservice/ServletContainer.h"
+
+#include "civetweb/civetweb.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace cppmicroservices;
+
+namespace {
+
+const int PORT = 18453;
+const std::size_t BUFFER_SIZE = 8192;
+const std::size_t MAX_SIZE = std::size_t(1) << 20;
+
+/// A file name in the temporary directory
+std::string MakeTempFilePath(const std::string& name)
+{
+#if defined(_WIN32)
+  const char* tmp = std::getenv("TEMP");
+  const char sep = '\\';
+#else
+  const char* tmp = std::getenv("TMPDIR");
+  const char sep = '/';
+#endif
+  std::string path = (tmp && *tmp) ? tmp : "/tmp";
+  return path + sep + name + "_" +
+         std::to_string(
+           std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+/// A body whose bytes depend on their position, so that reordered or
+/// dropped bytes are noticed
+std::string MakePayload(std::size_t size)
+{
+  std::string payload(size, '\0');
+  for (std::size_t i = 0; i < size; ++i) {
+    payload[i] = static_cast<char>((i * 7 + i / 251) % 256);
+  }
+  return payload;
+}
+
+/// Sends the first bytes of the payload, as many as the query string asks
+/// for. The path info selects how the body is written.
+class PayloadServlet : public HttpServlet
+{
+public:
+  PayloadServlet(std::string filePath)
+    : m_Payload(MakePayload(MAX_SIZE + 1))
+    , m_FilePath(std::move(filePath))
+  {}
+
+  void DoGet(HttpServletRequest& request,
+             HttpServletResponse& response) override
+  {
+    const std::size_t size = std::min<std::size_t>(
+      std::strtoull(request.GetQueryString().c_str(), nullptr, 10),
+      MAX_SIZE);
+    const std::string mode = request.GetPathInfo();
+    const char* data = m_Payload.data();
+    response.SetBufferSize(BUFFER_SIZE);
+    response.SetContentType("application/octet-stream");
+
+    if (mode == "/stream") {
+      // pieces of varying size, down to single characters
+      auto& out = response.GetOutputStream();
+      std::size_t pos = 0;
+      for (std::size_t piece = 1; pos < size; piece = piece * 3 + 1) {
+        if (piece > BUFFER_SIZE) {
+          piece = 1;
+        }
+        const std::size_t n = std::min(piece, size - pos);
+        if (n == 1) {
+          out.put(data[pos]);
+        } else {
+          out.write(data + pos, static_cast<std::streamsize>(n));
+        }
+        pos += n;
+      }
+    } else if (mode == "/direct") {
+      response.SendBuffer(data, size);
+    } else if (mode == "/mixed") {
+      // streamed data must be sent before data sent directly, and a write
+      // larger than the buffer bypasses it
+      auto& out = response.GetOutputStream();
+      std::size_t pos = 0;
+      while (pos < size) {
+        std::size_t n = std::min<std::size_t>(100, size - pos);
+        out.write(data + pos, static_cast<std::streamsize>(n));
+        pos += n;
+        n = std::min<std::size_t>(5000, size - pos);
+        response.SendBuffer(data + pos, n);
+        pos += n;
+        n = std::min<std::size_t>(BUFFER_SIZE + 1, size - pos);
+        out.write(data + pos, static_cast<std::streamsize>(n));
+        pos += n;
+      }
+    } else if (mode == "/length") {
+      // no chunked coding if the length is known
+      response.SetContentLength(size);
+      auto& out = response.GetOutputStream();
+      const std::size_t half = size / 2;
+      out.write(data, static_cast<std::streamsize>(half));
+      response.SendBuffer(data + half, size - half);
+    } else if (mode == "/file") {
+      // the payload is stored in the file from its second byte on
+      if (!response.SendFileRegion(m_FilePath, 1, size)) {
+        response.SendError(HttpServletResponse::SC_INTERNAL_SERVER_ERROR);
+      }
+    } else if (mode == "/badfile") {
+      if (!response.SendFileRegion(m_FilePath, MAX_SIZE, size)) {
+        response.SendError(
+          HttpServletResponse::SC_REQUESTED_RANGE_NOT_SATISFIABLE);
+      }
+    } else {
+      response.SendError(HttpServletResponse::SC_NOT_FOUND);
+    }
+  }
+
+private:
+  const std::string m_Payload;
+  const std::string m_FilePath;
+};
+
+class HttpServletResponseTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    filePath = MakeTempFilePath("usHttpServiceTests");
+    {
+      std::ofstream file(filePath, std::ios::binary);
+      file.put('#');
+      const std::string payload = MakePayload(MAX_SIZE);
+      file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    }
+
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_LISTENING_PORTS] =
+      std::string("127.0.0.1:") + std::to_string(PORT);
+    framework = std::make_shared<Framework>(
+      FrameworkFactory().NewFramework(config));
+    framework->Start();
+
+    auto context = framework->GetBundleContext();
+    container = std::make_unique<ServletContainer>(context, "us");
+    container->Start();
+
+    ServiceProperties props;
+    props[HttpServlet::PROP_CONTEXT_ROOT] = std::string("/test");
+    registration = context.RegisterService<HttpServlet>(
+      std::make_shared<PayloadServlet>(filePath), props);
+  }
+
+  void TearDown() override
+  {
+    registration.Unregister();
+    container->Stop();
+    container.reset();
+    framework->Stop();
+    framework->WaitForStop(std::chrono::milliseconds::zero());
+    std::remove(filePath.c_str());
+  }
+
+  /// Requests the path and returns the status code, or -1 if the response
+  /// could not be read completely
+  int Fetch(const std::string& path, std::string& body)
+  {
+    char ebuf[256] = { 0 };
+    mg_connection* conn =
+      mg_download("127.0.0.1",
+                  PORT,
+                  0,
+                  ebuf,
+                  sizeof(ebuf),
+                  "GET %s HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                  "Connection: close\r\n\r\n",
+                  path.c_str());
+    if (conn == nullptr) {
+      return -1;
+    }
+    body.clear();
+    char buf[4096];
+    int n = 0;
+    while ((n = mg_read(conn, buf, sizeof(buf))) > 0) {
+      body.append(buf, static_cast<std::size_t>(n));
+    }
+    // the request URI of a response holds its status code
+    const int status = std::atoi(mg_get_request_info(conn)->request_uri);
+    mg_close_connection(conn);
+    // mg_read() fails if the chunked coding is broken
+    return n < 0 ? -1 : status;
+  }
+
+  /// Fetches the body in the given mode for sizes around the buffer size
+  void ExpectPayloads(const std::string& mode)
+  {
+    for (std::size_t size : { std::size_t(0),
+                              std::size_t(1),
+                              BUFFER_SIZE - 1,
+                              BUFFER_SIZE,
+                              BUFFER_SIZE + 1,
+                              2 * BUFFER_SIZE,
+                              MAX_SIZE }) {
+      std::string body;
+      ASSERT_EQ(
+        Fetch("/us/test/" + mode + "?" + std::to_string(size), body), 200)
+        << mode << " " << size;
+      ASSERT_EQ(body.size(), size) << mode;
+      EXPECT_TRUE(body == MakePayload(size)) << mode << " " << size;
+    }
+  }
+
+  std::string filePath;
+  std::shared_ptr<Framework> framework;
+  std::unique_ptr<ServletContainer> container;
+  ServiceRegistration<HttpServlet> registration;
+};
+}
+
+TEST_F(HttpServletResponseTest, StreamedResponse)
+{
+  ExpectPayloads("stream");
+}
+
+TEST_F(HttpServletResponseTest, DirectResponse)
+{
+  ExpectPayloads("direct");
+}
+
+TEST_F(HttpServletResponseTest, MixedResponse)
+{
+  ExpectPayloads("mixed");
+}
+
+TEST_F(HttpServletResponseTest, ContentLengthResponse)
+{
+  ExpectPayloads("length");
+}
+
+TEST_F(HttpServletResponseTest, FileRegionResponse)
+{
+  ExpectPayloads("file");
+
+  // nothing is sent if the region is not part of the file
+  const int notSatisfiable =
+    HttpServletResponse::SC_REQUESTED_RANGE_NOT_SATISFIABLE;
+  std::string body;
+  EXPECT_EQ(Fetch("/us/test/badfile?2", body), notSatisfiable);
+}
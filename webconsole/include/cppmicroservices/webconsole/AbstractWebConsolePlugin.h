@@ -28,6 +28,7 @@
 #include "cppmicroservices/webconsole/WebConsoleExport.h"
 #include "cppmicroservices/webconsole/mustache.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -65,6 +66,9 @@ class US_WebConsole_EXPORT AbstractWebConsolePlugin : public HttpServlet
 public:
   using TemplateData = Kainjow::Mustache::Data;
 
+  AbstractWebConsolePlugin();
+  ~AbstractWebConsolePlugin() override;
+
   /**
    * Retrieves the label. This is the last component in the servlet path.
    *
@@ -197,6 +201,14 @@ protected:
   std::vector<std::string> GetCssReferences() const;
 
 protected:
+  /**
+   * Returns the contents of a template file in the bundle of \c context.
+   * The contents are cached by this plugin until the bundle is updated.
+   *
+   * @param templateFile The resource path of the template.
+   * @param context The context of the bundle containing the template.
+   * @return The template, or an empty string if it does not exist.
+   */
   std::string ReadTemplateFile(const std::string& templateFile,
                                cppmicroservices::BundleContext context =
                                  cppmicroservices::GetBundleContext()) const;
@@ -224,6 +236,8 @@ private:
    */
   bool SpoolResource(HttpServletRequest& request,
                      HttpServletResponse& response) const;
+
+  std::unique_ptr<AbstractWebConsolePluginPrivate> d;
 };
 }
 
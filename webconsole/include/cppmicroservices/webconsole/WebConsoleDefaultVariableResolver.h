@@ -28,11 +28,14 @@
 #include "cppmicroservices/webconsole/mustache.hpp"
 
 #include <map>
+#include <memory>
 
 namespace cppmicroservices {
 
 using MustacheData = Kainjow::Mustache::Data;
 
+class WebConsoleTemplateCache;
+
 /**
  * The default Web Console variable resolver class.
  *
@@ -43,11 +46,22 @@ class US_WebConsole_EXPORT WebConsoleDefaultVariableResolver
   : public WebConsoleVariableResolver
 {
 public:
+  WebConsoleDefaultVariableResolver();
+
+  /**
+   * Creates a resolver which takes parsed templates from
+   * <code>templates</code> instead of parsing them for each call to
+   * Resolve.
+   */
+  explicit WebConsoleDefaultVariableResolver(
+    std::shared_ptr<WebConsoleTemplateCache> templates);
+
   virtual std::string Resolve(const std::string& variable) const;
 
   MustacheData& GetData();
 
 private:
+  std::shared_ptr<WebConsoleTemplateCache> m_Templates;
   MustacheData m_Data;
 };
 }
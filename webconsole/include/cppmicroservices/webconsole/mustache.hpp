@@ -318,11 +318,19 @@ public:
 
     using RenderHandler = std::function<void(const StringType&)>;
     void render(const Data& data, const RenderHandler& handler) {
-        if (!isValid()) {
+        render(data, handler, errorMessage_);
+    }
+
+    // Renders without modifying the template, so that a parsed template can
+    // be shared and rendered concurrently. Errors of this render are stored
+    // in errorMessage instead of the template.
+    void render(const Data& data, const RenderHandler& handler, StringType& errorMessage) const {
+        errorMessage = errorMessage_;
+        if (!errorMessage.empty()) {
             return;
         }
         Context ctx{&data};
-        render(handler, ctx);
+        render(handler, ctx, errorMessage);
     }
 
 private:
@@ -688,21 +696,42 @@ private:
         }
     }
 
-    void render(const RenderHandler& handler, Context& ctx) {
-        walk([&handler, &ctx, this](Component& comp) {
-            return BasicMustache<StringType>::renderComponent(handler, ctx, comp);
-        });
+    void render(const RenderHandler& handler, Context& ctx, StringType& errorMessage) const {
+        renderChildren(handler, ctx, rootComponent_, errorMessage);
     }
 
-    StringType render(Context& ctx) {
+    StringType render(Context& ctx, StringType& errorMessage) const {
         std::basic_ostringstream<typename StringType::value_type> ss;
         render([&ss](const StringType& str) {
             ss << str;
-        }, ctx);
+        }, ctx, errorMessage);
         return ss.str();
     }
 
-    WalkControl renderComponent(const RenderHandler& handler, Context& ctx, Component& comp) {
+    // The walk() of rendering, which leaves the components unchanged
+    void renderChildren(const RenderHandler& handler, Context& ctx, const Component& comp, StringType& errorMessage) const {
+        for (const auto& childComp : comp.children) {
+            if (renderComponentTree(handler, ctx, childComp, errorMessage) != WalkControl::Continue) {
+                break;
+            }
+        }
+    }
+
+    WalkControl renderComponentTree(const RenderHandler& handler, Context& ctx, const Component& comp, StringType& errorMessage) const {
+        WalkControl control{renderComponent(handler, ctx, comp, errorMessage)};
+        if (control == WalkControl::Stop) {
+            return control;
+        } else if (control == WalkControl::Skip) {
+            return WalkControl::Continue;
+        }
+        for (const auto& childComp : comp.children) {
+            control = renderComponentTree(handler, ctx, childComp, errorMessage);
+            assert(control == WalkControl::Continue);
+        }
+        return control;
+    }
+
+    WalkControl renderComponent(const RenderHandler& handler, Context& ctx, const Component& comp, StringType& errorMessage) const {
         if (comp.isText()) {
             handler(comp.text);
             return WalkControl::Continue;
@@ -714,7 +743,7 @@ private:
             case Tag::Type::Variable:
             case Tag::Type::UnescapedVariable:
                 if ((var = ctx.get(tag.name)) != nullptr) {
-                    if (!renderVariable(handler, var, ctx, tag.type == Tag::Type::Variable)) {
+                    if (!renderVariable(handler, var, ctx, tag.type == Tag::Type::Variable, errorMessage)) {
                         return WalkControl::Stop;
                     }
                 }
@@ -722,32 +751,29 @@ private:
             case Tag::Type::SectionBegin:
                 if ((var = ctx.get(tag.name)) != nullptr) {
                     if (var->isLambda()) {
-                        if (!renderLambda(handler, var, ctx, false, *comp.tag.sectionText, true)) {
+                        if (!renderLambda(handler, var, ctx, false, *comp.tag.sectionText, true, errorMessage)) {
                             return WalkControl::Stop;
                         }
                     } else if (!var->isFalse() && !var->isEmptyList()) {
-                        renderSection(handler, ctx, comp, var);
+                        renderSection(handler, ctx, comp, var, errorMessage);
                     }
                 }
                 return WalkControl::Skip;
             case Tag::Type::SectionBeginInverted:
                 if ((var = ctx.get(tag.name)) == nullptr || var->isFalse() || var->isEmptyList()) {
-                    renderSection(handler, ctx, comp, var);
+                    renderSection(handler, ctx, comp, var, errorMessage);
                 }
                 return WalkControl::Skip;
             case Tag::Type::Partial:
                 if ((var = ctx.get_partial(tag.name)) != nullptr && var->isPartial()) {
                     const auto partial = var->partial();
-                    BasicMustache tmpl{partial()};
+                    const BasicMustache tmpl{partial()};
                     if (!tmpl.isValid()) {
-                        errorMessage_ = tmpl.errorMessage();
+                        errorMessage = tmpl.errorMessage();
                     } else {
-                        tmpl.render(handler, ctx);
-                        if (!tmpl.isValid()) {
-                            errorMessage_ = tmpl.errorMessage();
-                        }
+                        tmpl.render(handler, ctx, errorMessage);
                     }
-                    if (!tmpl.isValid()) {
+                    if (!errorMessage.empty()) {
                         return WalkControl::Stop;
                     }
                 }
@@ -762,47 +788,42 @@ private:
         return WalkControl::Continue;
     }
 
-    bool renderLambda(const RenderHandler& handler, const Data* var, Context& ctx, bool escaped, const StringType& text, bool parseWithSameContext) {
+    bool renderLambda(const RenderHandler& handler, const Data* var, Context& ctx, bool escaped, const StringType& text, bool parseWithSameContext, StringType& errorMessage) const {
         const auto lambdaResult = var->callLambda(text);
         assert(lambdaResult.isString());
-        BasicMustache tmpl = parseWithSameContext ? BasicMustache{lambdaResult.stringValue(), ctx} : BasicMustache{lambdaResult.stringValue()};
+        const BasicMustache tmpl = parseWithSameContext ? BasicMustache{lambdaResult.stringValue(), ctx} : BasicMustache{lambdaResult.stringValue()};
         if (!tmpl.isValid()) {
-            errorMessage_ = tmpl.errorMessage();
+            errorMessage = tmpl.errorMessage();
         } else {
-            const StringType str{tmpl.render(ctx)};
-            if (!tmpl.isValid()) {
-                errorMessage_ = tmpl.errorMessage();
-            } else {
+            const StringType str{tmpl.render(ctx, errorMessage)};
+            if (errorMessage.empty()) {
                 handler(escaped ? escape(str) : str);
             }
         }
-        return tmpl.isValid();
+        return errorMessage.empty();
     }
 
-    bool renderVariable(const RenderHandler& handler, const Data* var, Context& ctx, bool escaped) {
+    bool renderVariable(const RenderHandler& handler, const Data* var, Context& ctx, bool escaped, StringType& errorMessage) const {
         if (var->isString()) {
             const auto varstr = var->stringValue();
             handler(escaped ? escape(varstr) : varstr);
         } else if (var->isLambda()) {
-            return renderLambda(handler, var, ctx, escaped, {}, false);
+            return renderLambda(handler, var, ctx, escaped, {}, false, errorMessage);
         }
         return true;
     }
 
-    void renderSection(const RenderHandler& handler, Context& ctx, Component& incomp, const Data* var) {
-        const auto callback = [&handler, &ctx, this](Component& comp) -> WalkControl {
-            return BasicMustache<StringType>::renderComponent(handler, ctx, comp);
-        };
+    void renderSection(const RenderHandler& handler, Context& ctx, const Component& incomp, const Data* var, StringType& errorMessage) const {
         if (var && var->isNonEmptyList()) {
             for (const auto& item : var->list()) {
                 const ContextPusher ctxpusher{ctx, &item};
-                walkChildren(callback, incomp);
+                renderChildren(handler, ctx, incomp, errorMessage);
             }
         } else if (var) {
             const ContextPusher ctxpusher{ctx, var};
-            walkChildren(callback, incomp);
+            renderChildren(handler, ctx, incomp, errorMessage);
         } else {
-            walkChildren(callback, incomp);
+            renderChildren(handler, ctx, incomp, errorMessage);
         }
     }
 
@@ -28,12 +28,19 @@
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/BundleResource.h"
 #include "cppmicroservices/BundleResourceStream.h"
+#include "cppmicroservices/httpservice/BundleResourceServlet.h"
 #include "cppmicroservices/httpservice/HttpServletRequest.h"
 #include "cppmicroservices/httpservice/HttpServletResponse.h"
 #include "cppmicroservices/httpservice/ServletContext.h"
 #include "cppmicroservices/webconsole/WebConsoleDefaultVariableResolver.h"
 
+#include "WebConsoleTemplateCache.h"
+
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
 
 namespace Kainjow {
 
@@ -57,6 +64,32 @@ std::string NumToString(int64_t val)
 #endif
 }
 
+struct AbstractWebConsolePluginPrivate
+{
+  struct Template
+  {
+    Bundle::TimeStamp lastModified;
+    std::string content;
+  };
+
+  std::mutex m_TemplatesMutex;
+  // keyed by bundle id and resource path
+  std::map<std::pair<long, std::string>, Template> m_Templates;
+
+  // serves the resources of this plugin and caches their contents
+  BundleResourceServlet m_ResourceServlet;
+
+  // parsed template fragments, shared by the resolvers of all requests
+  std::shared_ptr<WebConsoleTemplateCache> m_TemplateCache =
+    std::make_shared<WebConsoleTemplateCache>();
+};
+
+AbstractWebConsolePlugin::AbstractWebConsolePlugin()
+  : d(new AbstractWebConsolePluginPrivate)
+{}
+
+AbstractWebConsolePlugin::~AbstractWebConsolePlugin() = default;
+
 std::string AbstractWebConsolePlugin::GetCategory() const
 {
   return std::string();
@@ -103,7 +136,8 @@ AbstractWebConsolePlugin::GetVariableResolver(HttpServletRequest& request)
     return any_cast<std::shared_ptr<WebConsoleVariableResolver>>(resolverAny);
   }
 
-  auto resolver = std::make_shared<WebConsoleDefaultVariableResolver>();
+  auto resolver =
+    std::make_shared<WebConsoleDefaultVariableResolver>(d->m_TemplateCache);
   auto& data = resolver->GetData();
   data["appRoot"] =
     request.GetAttribute(WebConsoleConstants::ATTR_APP_ROOT).ToString();
@@ -265,11 +299,22 @@ std::string AbstractWebConsolePlugin::ReadTemplateFile(
     context = cppmicroservices::GetBundleContext();
   }
 
-  cppmicroservices::BundleResource res =
-    context.GetBundle().GetResource(templateFile);
+  Bundle bundle = context.GetBundle();
+  const auto key = std::make_pair(bundle.GetBundleId(), templateFile);
+  const auto lastModified = bundle.GetLastModified();
+  {
+    std::lock_guard<std::mutex> l(d->m_TemplatesMutex);
+    auto iter = d->m_Templates.find(key);
+    if (iter != d->m_Templates.end() &&
+        iter->second.lastModified == lastModified) {
+      return iter->second.content;
+    }
+  }
+
+  cppmicroservices::BundleResource res = bundle.GetResource(templateFile);
   if (!res) {
     std::cout << "Resource file '" << templateFile << "' not found in bundle '"
-              << context.GetBundle().GetSymbolicName() << "'" << std::endl;
+              << bundle.GetSymbolicName() << "'" << std::endl;
     return result;
   }
 
@@ -278,25 +323,20 @@ std::string AbstractWebConsolePlugin::ReadTemplateFile(
   result.resize(static_cast<std::size_t>(resStream.tellg()));
   resStream.seekg(0, std::ios::beg);
   resStream.read(&result[0], result.size());
+
+  std::lock_guard<std::mutex> l(d->m_TemplatesMutex);
+  d->m_Templates[key] = { lastModified, result };
   return result;
 }
 
 std::string AbstractWebConsolePlugin::GetHeader() const
 {
-  static std::string HEADER;
-  if (HEADER.empty()) {
-    HEADER = this->ReadTemplateFile("/templates/main_header.html");
-  }
-  return HEADER;
+  return this->ReadTemplateFile("/templates/main_header.html");
 }
 
 std::string AbstractWebConsolePlugin::GetFooter() const
 {
-  static std::string FOOTER;
-  if (FOOTER.empty()) {
-    FOOTER = this->ReadTemplateFile("/templates/main_footer.html");
-  }
-  return FOOTER;
+  return this->ReadTemplateFile("/templates/main_footer.html");
 }
 
 BundleResource AbstractWebConsolePlugin::GetResource(
@@ -309,34 +349,16 @@ bool AbstractWebConsolePlugin::SpoolResource(
   HttpServletRequest& request,
   HttpServletResponse& response) const
 {
-  std::string pi = request.GetPathInfo();
-  cppmicroservices::BundleResource res = this->GetResource(pi);
+  cppmicroservices::BundleResource res =
+    this->GetResource(request.GetPathInfo());
   if (!res) {
     return false;
   }
 
-  // check whether we may return 304/UNMODIFIED
-  long long lastModified = res.GetLastModified();
-  if (lastModified > 0) {
-    long long ifModifiedSince = request.GetDateHeader("If-Modified-Since");
-    if (ifModifiedSince >= lastModified) {
-      response.SetStatus(HttpServletResponse::SC_NOT_MODIFIED);
-      return true;
-    }
-    // have to send, so set the last modified header now
-    response.SetDateHeader("Last-Modified", lastModified);
+  if (!d->m_ResourceServlet.SpoolResource(res, request, response)) {
+    // a directory
+    response.SendError(HttpServletResponse::SC_NOT_FOUND);
   }
-
-  cppmicroservices::BundleResourceStream resStream(res, std::ios::binary);
-
-  // describe the contents
-  response.SetContentType(GetServletContext()->GetMimeType(pi));
-  int size = res.GetSize();
-  response.SetIntHeader("Content-Length", size);
-
-  // spool the actual contents
-  response.GetOutputStream() << resStream.rdbuf();
-
   return true;
 }
 }
@@ -21,6 +21,7 @@
 =============================================================================*/
 
 #include "BundlesPlugin.h"
+#include "ListPage.h"
 
 #include "cppmicroservices/httpservice/ServletContext.h"
 
@@ -35,6 +36,7 @@
 #include "cppmicroservices/BundleResourceStream.h"
 #include "cppmicroservices/Constants.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace cppmicroservices {
@@ -60,6 +62,12 @@ bool SetIfExists(AbstractWebConsolePlugin::TemplateData& entry,
   return false;
 }
 
+void WriteString(rapidjson::Writer<rapidjson::StringBuffer>& writer,
+                 const std::string& str)
+{
+  writer.String(str.c_str(), static_cast<rapidjson::SizeType>(str.size()));
+}
+
 std::string SizeTag(const std::pair<std::size_t, std::size_t>& p)
 {
   std::stringstream ss;
@@ -102,24 +110,29 @@ void BundlesPlugin::RenderContent(HttpServletRequest& request,
   switch (static_cast<RequestType>(
     any_cast<int>(request.GetAttribute(REQ_BUNDLE_TYPE)))) {
     case RequestType::MainPage: {
-      BundleResource res =
-        GetBundleContext().GetBundle().GetResource("/templates/bundles.html");
-      if (!res)
+      std::string tmpl = ReadTemplateFile("/templates/bundles.html");
+      if (tmpl.empty())
         break;
 
+      auto bundles = GetContext().GetBundles();
+      std::sort(
+        bundles.begin(), bundles.end(), [](Bundle const& b1, Bundle const& b2) {
+          return b1.GetBundleId() < b2.GetBundleId();
+        });
+      ListPage page(request, bundles.size());
+
       auto& data = std::static_pointer_cast<WebConsoleDefaultVariableResolver>(
                      GetVariableResolver(request))
                      ->GetData();
-      data["bundles"] = GetBundlesData();
+      data["bundles"] = GetBundlesData(bundles, page);
+      data["page"] = page.GetTemplateData();
 
-      BundleResourceStream rs(res, std::ios_base::binary);
-      response.GetOutputStream() << rs.rdbuf();
+      response.GetOutputStream() << tmpl;
       return;
     }
     case RequestType::Bundle: {
-      BundleResource res =
-        GetBundleContext().GetBundle().GetResource("/templates/bundle.html");
-      if (!res)
+      std::string tmpl = ReadTemplateFile("/templates/bundle.html");
+      if (tmpl.empty())
         break;
 
       std::string pluginRoot =
@@ -130,8 +143,7 @@ void BundlesPlugin::RenderContent(HttpServletRequest& request,
                      ->GetData();
       GetBundleData(id, data, pluginRoot);
 
-      BundleResourceStream rs(res, std::ios_base::binary);
-      response.GetOutputStream() << rs.rdbuf();
+      response.GetOutputStream() << tmpl;
       return;
     }
     case RequestType::Resource: {
@@ -201,16 +213,14 @@ bool BundlesPlugin::IsHtmlRequest(HttpServletRequest& request)
   return requestType != RequestType::Resource;
 }
 
-AbstractWebConsolePlugin::TemplateData BundlesPlugin::GetBundlesData() const
+AbstractWebConsolePlugin::TemplateData BundlesPlugin::GetBundlesData(
+  const std::vector<Bundle>& bundles,
+  const ListPage& page) const
 {
   TemplateData data(TemplateData::Type::List);
 
-  auto bundles = GetContext().GetBundles();
-  std::sort(
-    bundles.begin(), bundles.end(), [](Bundle const& b1, Bundle const& b2) {
-      return b1.GetBundleId() < b2.GetBundleId();
-    });
-  for (auto& bundle : bundles) {
+  for (std::size_t i = page.GetStart(); i < page.GetEnd(); ++i) {
+    const Bundle& bundle = bundles[i];
     TemplateData entry;
 
     const AnyMap& headers = bundle.GetHeaders();
@@ -235,16 +245,12 @@ std::pair<std::size_t, std::size_t> BundlesPlugin::GetResourceJsonTree(
   Bundle& bundle,
   const std::string& parentPath,
   const BundleResource& currResource,
-  std::string& json,
-  int level,
+  JsonWriter& writer,
   const std::string& pluginRoot) const
 {
   std::pair<std::size_t, std::size_t> totalSize(0, 0);
-  std::string indent;
-  for (int i = 0; i < level; i++) {
-    indent += "  ";
-  }
 
+  writer.StartObject();
   if (currResource.IsFile()) {
     char lm_buf[50] = { 0 };
     time_t lm_t = currResource.GetLastModified();
@@ -256,66 +262,59 @@ std::pair<std::size_t, std::size_t> BundlesPlugin::GetResourceJsonTree(
     std::string lm_str(lm_buf);
     std::string::size_type pos = lm_str.find_last_not_of(" \r\n");
     lm_str = lm_str.substr(0, pos != std::string::npos ? pos + 1 : pos);
-    json += indent + "{ text : '" + currResource.GetName() + "',\n" + indent +
-            "  icon : 'glyphicon glyphicon-open',\n" + indent + "  href : '" +
-            pluginRoot + "/" + NumToString(bundle.GetBundleId()) +
-            "/resources" + currResource.GetResourcePath() + "',\n" + indent +
-            "  tags : ['Size: " +
-            SizeTag(std::make_pair(currResource.GetSize(),
-                                   currResource.GetCompressedSize())) +
-            "',\n" + indent + "          'Last modified: " + lm_str + "'] }\n";
     totalSize.first += currResource.GetSize();
     totalSize.second += currResource.GetCompressedSize();
+
+    writer.Key("text");
+    WriteString(writer, currResource.GetName());
+    writer.Key("icon");
+    writer.String("glyphicon glyphicon-open");
+    writer.Key("href");
+    WriteString(writer,
+                pluginRoot + "/" + NumToString(bundle.GetBundleId()) +
+                  "/resources" + currResource.GetResourcePath());
+    writer.Key("tags");
+    writer.StartArray();
+    WriteString(writer, "Size: " + SizeTag(totalSize));
+    WriteString(writer, "Last modified: " + lm_str);
+    writer.EndArray();
   } else {
-    json += indent + "{ text : '" +
-            currResource.GetResourcePath().substr(parentPath.size()) + "',\n";
-    json += indent + "  selectable : false\n";
-    std::vector<std::string> children = currResource.GetChildren();
-    if (children.empty()) {
-      json += "}";
-    } else {
-      json += indent + ", nodes : [\n";
-      std::vector<BundleResource> childDirs;
-      std::vector<BundleResource> childFiles;
+    writer.Key("text");
+    WriteString(writer,
+                currResource.GetResourcePath().substr(parentPath.size()));
+    writer.Key("selectable");
+    writer.Bool(false);
+
+    std::vector<BundleResource> children = currResource.GetChildResources();
+    children.erase(std::remove_if(children.begin(),
+                                  children.end(),
+                                  [](const BundleResource& child) {
+                                    return !child.IsValid();
+                                  }),
+                   children.end());
+    if (!children.empty()) {
+      // directories first
+      std::stable_partition(
+        children.begin(), children.end(), [](const BundleResource& child) {
+          return child.IsDir();
+        });
+
+      writer.Key("nodes");
+      writer.StartArray();
       for (auto& child : children) {
-        BundleResource childResource =
-          bundle.GetResource(currResource.GetResourcePath() + "/" + child);
-        if (childResource.IsValid()) {
-          if (childResource.IsDir()) {
-            childDirs.push_back(childResource);
-          } else {
-            childFiles.push_back(childResource);
-          }
-        }
-      }
-
-      for (auto& childDir : childDirs) {
-        auto size = GetResourceJsonTree(bundle,
-                                        currResource.GetResourcePath(),
-                                        childDir,
-                                        json,
-                                        level + 1,
-                                        pluginRoot);
-        totalSize.first += size.first;
-        totalSize.second += size.second;
-        json += indent + ",\n";
-      }
-      for (auto & childFile : childFiles) {
-        auto size = GetResourceJsonTree(bundle,
-                                        currResource.GetResourcePath(),
-                                        childFile,
-                                        json,
-                                        level + 1,
-                                        pluginRoot);
+        auto size = GetResourceJsonTree(
+          bundle, currResource.GetResourcePath(), child, writer, pluginRoot);
         totalSize.first += size.first;
         totalSize.second += size.second;
-        json += indent + ",\n";
       }
-      json += indent + "],\n";
-      json += indent + "tags : ['Size: " + SizeTag(totalSize) + "']\n";
-      json += indent + "}\n";
+      writer.EndArray();
+      writer.Key("tags");
+      writer.StartArray();
+      WriteString(writer, "Size: " + SizeTag(totalSize));
+      writer.EndArray();
     }
   }
+  writer.EndObject();
 
   return totalSize;
 }
@@ -338,13 +337,16 @@ void BundlesPlugin::GetBundleData(long id,
 
   // --------------- Get bundle resource information ------------------
 
-  std::string res_json = "[";
+  rapidjson::StringBuffer res_json;
+  JsonWriter writer(res_json);
+  writer.StartArray();
   BundleResource resource = bundle.GetResource("/");
   if (resource.IsValid()) {
-    GetResourceJsonTree(bundle, "", resource, res_json, 0, pluginRoot);
+    GetResourceJsonTree(bundle, "", resource, writer, pluginRoot);
   }
-  res_json += "]";
-  data["bundle-resources"] = res_json;
+  writer.EndArray();
+  data["bundle-resources"] =
+    std::string(res_json.GetString(), res_json.GetSize());
 
   // ------------- Get registered service information ----------------
 
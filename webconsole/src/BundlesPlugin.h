@@ -25,8 +25,13 @@
 
 #include "cppmicroservices/webconsole/SimpleWebConsolePlugin.h"
 
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
 namespace cppmicroservices {
 
+class ListPage;
+
 class BundlesPlugin : public SimpleWebConsolePlugin
 {
 public:
@@ -46,7 +51,10 @@ private:
 
   bool IsHtmlRequest(HttpServletRequest& request);
 
-  TemplateData GetBundlesData() const;
+  using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+  TemplateData GetBundlesData(const std::vector<Bundle>& bundles,
+                              const ListPage& page) const;
 
   void GetBundleData(long id,
                      TemplateData& data,
@@ -56,8 +64,7 @@ private:
     Bundle& bundle,
     const std::string& parentPath,
     const BundleResource& currResource,
-    std::string& json,
-    int level,
+    JsonWriter& writer,
     const std::string& pluginRoot) const;
 };
 }
@@ -0,0 +1,114 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ListPage.h"
+
+#include "cppmicroservices/httpservice/HttpServletRequest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace cppmicroservices {
+
+std::string NumToString(int64_t val);
+
+namespace {
+
+// Returns the positive number in the query parameter \c name, or
+// \c defaultValue if there is none.
+std::size_t GetQueryNumber(const std::string& query,
+                           const std::string& name,
+                           std::size_t defaultValue)
+{
+  std::size_t pos = 0;
+  while (pos < query.size()) {
+    std::size_t end = query.find('&', pos);
+    if (end == std::string::npos) {
+      end = query.size();
+    }
+    if (query.compare(pos, name.size() + 1, name + "=") == 0) {
+      std::string value =
+        query.substr(pos + name.size() + 1, end - pos - name.size() - 1);
+      if (!value.empty() && value.size() < 10 &&
+          value.find_first_not_of("0123456789") == std::string::npos) {
+        return static_cast<std::size_t>(
+          std::strtoul(value.c_str(), nullptr, 10));
+      }
+      return defaultValue;
+    }
+    pos = end + 1;
+  }
+  return defaultValue;
+}
+}
+
+const std::size_t ListPage::DEFAULT_COUNT = 100;
+
+ListPage::ListPage(const HttpServletRequest& request, std::size_t total)
+  : m_Total(total)
+{
+  const std::string query = request.GetQueryString();
+  m_Count = GetQueryNumber(query, "count", DEFAULT_COUNT);
+  if (m_Count == 0) {
+    m_Count = DEFAULT_COUNT;
+  }
+  m_Start = GetQueryNumber(query, "start", 0);
+  if (m_Start >= m_Total) {
+    // show the last page
+    m_Start = m_Total > 0 ? (m_Total - 1) / m_Count * m_Count : 0;
+  }
+}
+
+std::size_t ListPage::GetStart() const
+{
+  return m_Start;
+}
+
+std::size_t ListPage::GetEnd() const
+{
+  return m_Start + std::min(m_Count, m_Total - m_Start);
+}
+
+AbstractWebConsolePlugin::TemplateData ListPage::GetTemplateData() const
+{
+  using TemplateData = AbstractWebConsolePlugin::TemplateData;
+
+  if (m_Start == 0 && m_Total <= m_Count) {
+    return TemplateData(TemplateData::Type::False);
+  }
+
+  TemplateData data;
+  data["first"] = NumToString(static_cast<int64_t>(m_Start + 1));
+  data["last"] = NumToString(static_cast<int64_t>(GetEnd()));
+  data["total"] = NumToString(static_cast<int64_t>(m_Total));
+  data["count"] = NumToString(static_cast<int64_t>(m_Count));
+  if (m_Start > 0) {
+    std::size_t previous = m_Start > m_Count ? m_Start - m_Count : 0;
+    data["previous"] = NumToString(static_cast<int64_t>(previous));
+  }
+  if (GetEnd() < m_Total) {
+    data["next"] = NumToString(static_cast<int64_t>(GetEnd()));
+  }
+  return data;
+}
+}
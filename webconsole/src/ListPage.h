@@ -0,0 +1,66 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_LISTPAGE_H
+#define CPPMICROSERVICES_LISTPAGE_H
+
+#include "cppmicroservices/webconsole/AbstractWebConsolePlugin.h"
+
+#include <cstddef>
+
+namespace cppmicroservices {
+
+/**
+ * A page of a long list rendered by a plugin. The page is selected by the
+ * <code>start</code> and <code>count</code> query parameters of a request.
+ */
+class ListPage
+{
+public:
+  /// The number of list entries on a page if the request does not say.
+  static const std::size_t DEFAULT_COUNT;
+
+  ListPage(const HttpServletRequest& request, std::size_t total);
+
+  /// The index of the first entry on the page.
+  std::size_t GetStart() const;
+
+  /// The index after the last entry on the page.
+  std::size_t GetEnd() const;
+
+  /**
+   * Returns the data for a <code>{{#page}}</code> template section with
+   * the fields <code>first</code>, <code>last</code>, <code>total</code> and
+   * <code>count</code>. The fields <code>previous</code> and
+   * <code>next</code> hold the start of the neighbouring pages, if they
+   * exist. If the whole list fits onto the page, the data is false.
+   */
+  AbstractWebConsolePlugin::TemplateData GetTemplateData() const;
+
+private:
+  std::size_t m_Start;
+  std::size_t m_Count;
+  std::size_t m_Total;
+};
+}
+
+#endif // CPPMICROSERVICES_LISTPAGE_H
@@ -0,0 +1,436 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "MetricsServlet.h"
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/GetBundleContext.h"
+#include "cppmicroservices/ServiceReference.h"
+
+#include "cppmicroservices/httpservice/HttpServletRequest.h"
+#include "cppmicroservices/httpservice/HttpServletResponse.h"
+
+// Declarative Services is only built under these conditions, see the
+// top-level CMakeLists.txt
+#if defined(US_BUILD_SHARED_LIBS) && defined(US_ENABLE_THREADING_SUPPORT)
+#  define US_WEBCONSOLE_HAVE_SCR
+#  include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
+#endif
+
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/writer.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace cppmicroservices {
+
+namespace {
+
+using JsonWriter = rapidjson::Writer<rapidjson::OStreamWrapper>;
+
+const char* GetStateName(Bundle::State state)
+{
+  switch (state) {
+    case Bundle::STATE_UNINSTALLED:
+      return "UNINSTALLED";
+    case Bundle::STATE_INSTALLED:
+      return "INSTALLED";
+    case Bundle::STATE_RESOLVED:
+      return "RESOLVED";
+    case Bundle::STATE_STARTING:
+      return "STARTING";
+    case Bundle::STATE_STOPPING:
+      return "STOPPING";
+    case Bundle::STATE_ACTIVE:
+      return "ACTIVE";
+  }
+  return "UNKNOWN";
+}
+
+void WriteString(JsonWriter& writer, const std::string& str)
+{
+  writer.String(str.c_str(), static_cast<rapidjson::SizeType>(str.size()));
+}
+
+// Escapes a Prometheus label value
+std::string EscapeLabel(const std::string& value)
+{
+  std::string result;
+  result.reserve(value.size());
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      result += '\\';
+      result += c;
+    } else if (c == '\n') {
+      result += "\\n";
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+bool WantsPrometheus(const HttpServletRequest& request)
+{
+  const std::string query = request.GetQueryString();
+  const std::string param = "format=";
+  std::size_t pos = query.find(param);
+  while (pos != std::string::npos && pos > 0 && query[pos - 1] != '&') {
+    pos = query.find(param, pos + 1);
+  }
+  if (pos != std::string::npos) {
+    return query.compare(pos + param.size(), 10, "prometheus") == 0;
+  }
+  return request.GetHeader("Accept").find("text/plain") != std::string::npos;
+}
+
+/*
+ * Information about one service registration. Only the references are
+ * taken from the service registry, the properties written out are read
+ * afterwards under the lock of each registration.
+ */
+struct ServiceInfo
+{
+  long id = -1;
+  long bundleId = -1;
+  std::vector<std::string> objectClass;
+  std::size_t propertyCount = 0;
+};
+
+bool GetServiceInfo(const ServiceReferenceU& ref, ServiceInfo& info)
+{
+  Any objectClass = ref.GetProperty(Constants::OBJECTCLASS);
+  Any id = ref.GetProperty(Constants::SERVICE_ID);
+  if (objectClass.Empty() || id.Empty()) {
+    // unregistered in the meantime
+    return false;
+  }
+  info.id = any_cast<long>(id);
+  info.objectClass = ref_any_cast<std::vector<std::string>>(objectClass);
+  info.propertyCount = ref.GetPropertyKeys().size();
+  Bundle bundle = ref.GetBundle();
+  info.bundleId = bundle ? bundle.GetBundleId() : -1;
+  return true;
+}
+
+/*
+ * The number of components managed by Declarative Services and the number
+ * of their component configurations by state.
+ */
+struct ComponentInfo
+{
+  std::size_t components = 0;
+  std::map<std::string, std::size_t> configurations;
+};
+
+#ifdef US_WEBCONSOLE_HAVE_SCR
+const char* GetStateName(
+  service::component::runtime::dto::ComponentState state)
+{
+  using service::component::runtime::dto::ComponentState;
+  switch (state) {
+    case ComponentState::UNSATISFIED_REFERENCE:
+      return "UNSATISFIED_REFERENCE";
+    case ComponentState::SATISFIED:
+      return "SATISFIED";
+    case ComponentState::ACTIVE:
+      return "ACTIVE";
+  }
+  return "UNKNOWN";
+}
+#endif
+
+/*
+ * Counts the components of the ServiceComponentRuntime service, if Declarative
+ * Services is running. Returns false otherwise.
+ */
+bool GetComponentInfo(BundleContext& context, ComponentInfo& info)
+{
+#ifdef US_WEBCONSOLE_HAVE_SCR
+  using service::component::runtime::ComponentQuery;
+  using service::component::runtime::ServiceComponentRuntime;
+
+  auto ref = context.GetServiceReference<ServiceComponentRuntime>();
+  if (!ref) {
+    return false;
+  }
+  auto runtime = context.GetService(ref);
+  if (!runtime) {
+    return false;
+  }
+  ComponentQuery query;
+  query.serviceProperties = false;
+  auto result = runtime->QueryComponentConfigurationDTOs(query);
+  info.components = result.descriptions.size();
+  // report every state, also the ones without component configurations
+  for (auto state : { "UNSATISFIED_REFERENCE", "SATISFIED", "ACTIVE" }) {
+    info.configurations[state] = 0;
+  }
+  for (const auto& config : result.configurations) {
+    ++info.configurations[GetStateName(config.state)];
+  }
+  return true;
+#else
+  US_UNUSED(context);
+  US_UNUSED(info);
+  return false;
+#endif
+}
+}
+
+void MetricsServlet::DoGet(HttpServletRequest& request,
+                           HttpServletResponse& response)
+{
+  BundleContext context = GetBundleContext();
+  if (!context) {
+    response.SendError(HttpServletResponse::SC_SERVICE_UNAVAILABLE);
+    return;
+  }
+
+  response.SetHeader("Cache-Control", "no-cache");
+  if (WantsPrometheus(request)) {
+    response.SetContentType("text/plain; version=0.0.4; charset=utf-8");
+    WritePrometheus(context, response.GetOutputStream());
+  } else {
+    response.SetContentType("application/json");
+    WriteJson(context, response.GetOutputStream());
+  }
+}
+
+void MetricsServlet::WriteJson(BundleContext& context, std::ostream& os)
+{
+  rapidjson::OStreamWrapper stream(os);
+  JsonWriter writer(stream);
+  writer.StartObject();
+
+  writer.Key("bundles");
+  writer.StartArray();
+  for (const auto& bundle : context.GetBundles()) {
+    writer.StartObject();
+    writer.Key("id");
+    writer.Int64(bundle.GetBundleId());
+    writer.Key("name");
+    WriteString(writer, bundle.GetSymbolicName());
+    writer.Key("version");
+    WriteString(writer, bundle.GetVersion().ToString());
+    writer.Key("state");
+    writer.String(GetStateName(bundle.GetState()));
+    writer.EndObject();
+  }
+  writer.EndArray();
+
+  writer.Key("services");
+  writer.StartArray();
+  ServiceInfo info;
+  for (const auto& ref : context.GetServiceReferences("")) {
+    if (!GetServiceInfo(ref, info)) {
+      continue;
+    }
+    writer.StartObject();
+    writer.Key("id");
+    writer.Int64(info.id);
+    writer.Key("bundle");
+    writer.Int64(info.bundleId);
+    writer.Key("objectclass");
+    writer.StartArray();
+    for (const auto& name : info.objectClass) {
+      WriteString(writer, name);
+    }
+    writer.EndArray();
+    writer.Key("properties");
+    writer.Uint64(info.propertyCount);
+    writer.EndObject();
+  }
+  writer.EndArray();
+
+  ComponentInfo components;
+  if (GetComponentInfo(context, components)) {
+    writer.Key("components");
+    writer.StartObject();
+    writer.Key("count");
+    writer.Uint64(components.components);
+    writer.Key("configurations");
+    writer.StartObject();
+    for (const auto& count : components.configurations) {
+      WriteString(writer, count.first);
+      writer.Uint64(count.second);
+    }
+    writer.EndObject();
+    writer.EndObject();
+  }
+
+  Framework framework(context.GetBundle(0));
+
+  writer.Key("service_listeners");
+  writer.StartObject();
+  for (const auto& count : framework.GetServiceListenerCounts()) {
+    WriteString(writer, count.first);
+    writer.Uint64(count.second);
+  }
+  writer.EndObject();
+
+  auto delivery = framework.GetServiceEventDeliveryStats();
+  writer.Key("service_event_delivery");
+  writer.StartObject();
+  writer.Key("queued");
+  writer.Uint64(delivery.queued);
+  writer.Key("delivered");
+  writer.Uint64(delivery.delivered);
+  writer.Key("pending");
+  writer.Uint64(delivery.pending);
+  writer.Key("max_pending");
+  writer.Uint64(delivery.maxPending);
+  writer.EndObject();
+
+  std::ostringstream counters;
+  performance_counters_to_json(counters, framework.GetPerformanceCounters());
+  const std::string countersJson = counters.str();
+  writer.Key("performance_counters");
+  writer.RawValue(
+    countersJson.c_str(), countersJson.size(), rapidjson::kObjectType);
+
+  writer.EndObject();
+  stream.Flush();
+}
+
+void MetricsServlet::WritePrometheus(BundleContext& context, std::ostream& os)
+{
+  std::map<std::string, std::size_t> bundleStates;
+  for (const auto& bundle : context.GetBundles()) {
+    ++bundleStates[GetStateName(bundle.GetState())];
+  }
+  os << "# HELP cppmicroservices_bundles Installed bundles by state.\n"
+        "# TYPE cppmicroservices_bundles gauge\n";
+  for (const auto& state : bundleStates) {
+    os << "cppmicroservices_bundles{state=\"" << state.first << "\"} "
+       << state.second << '\n';
+  }
+
+  std::size_t services = 0;
+  std::size_t properties = 0;
+  std::map<std::string, std::size_t> classes;
+  ServiceInfo info;
+  for (const auto& ref : context.GetServiceReferences("")) {
+    if (!GetServiceInfo(ref, info)) {
+      continue;
+    }
+    ++services;
+    properties += info.propertyCount;
+    for (const auto& name : info.objectClass) {
+      ++classes[name];
+    }
+  }
+  os << "# HELP cppmicroservices_services Registered services.\n"
+        "# TYPE cppmicroservices_services gauge\n"
+        "cppmicroservices_services "
+     << services
+     << "\n# HELP cppmicroservices_service_properties Properties of all "
+        "registered services.\n"
+        "# TYPE cppmicroservices_service_properties gauge\n"
+        "cppmicroservices_service_properties "
+     << properties
+     << "\n# HELP cppmicroservices_service_registrations Registered services "
+        "by object class.\n"
+        "# TYPE cppmicroservices_service_registrations gauge\n";
+  for (const auto& count : classes) {
+    os << "cppmicroservices_service_registrations{objectclass=\""
+       << EscapeLabel(count.first) << "\"} " << count.second << '\n';
+  }
+
+  ComponentInfo components;
+  if (GetComponentInfo(context, components)) {
+    os << "# HELP cppmicroservices_components Components managed by "
+          "Declarative Services.\n"
+          "# TYPE cppmicroservices_components gauge\n"
+          "cppmicroservices_components "
+       << components.components
+       << "\n# HELP cppmicroservices_component_configurations Component "
+          "configurations by state.\n"
+          "# TYPE cppmicroservices_component_configurations gauge\n";
+    for (const auto& count : components.configurations) {
+      os << "cppmicroservices_component_configurations{state=\""
+         << count.first << "\"} " << count.second << '\n';
+    }
+  }
+
+  Framework framework(context.GetBundle(0));
+
+  os << "# HELP cppmicroservices_service_listeners Service listeners by "
+        "object class, \"\" for listeners of all classes.\n"
+        "# TYPE cppmicroservices_service_listeners gauge\n";
+  for (const auto& count : framework.GetServiceListenerCounts()) {
+    os << "cppmicroservices_service_listeners{objectclass=\""
+       << EscapeLabel(count.first) << "\"} " << count.second << '\n';
+  }
+
+  auto delivery = framework.GetServiceEventDeliveryStats();
+  os << "# HELP cppmicroservices_service_events_queued_total Service events "
+        "queued for asynchronous listeners.\n"
+        "# TYPE cppmicroservices_service_events_queued_total counter\n"
+        "cppmicroservices_service_events_queued_total "
+     << delivery.queued
+     << "\n# HELP cppmicroservices_service_events_delivered_total Queued "
+        "service events which have been delivered.\n"
+        "# TYPE cppmicroservices_service_events_delivered_total counter\n"
+        "cppmicroservices_service_events_delivered_total "
+     << delivery.delivered
+     << "\n# HELP cppmicroservices_service_events_pending Queued service "
+        "events which have not been delivered yet.\n"
+        "# TYPE cppmicroservices_service_events_pending gauge\n"
+        "cppmicroservices_service_events_pending "
+     << delivery.pending << '\n';
+
+  auto counters = framework.GetPerformanceCounters();
+  if (counters.empty()) {
+    return;
+  }
+  os << "# HELP cppmicroservices_perf_events_total Events recorded by "
+        "performance counters.\n"
+        "# TYPE cppmicroservices_perf_events_total counter\n";
+  for (const auto& counter : counters) {
+    os << "cppmicroservices_perf_events_total{counter=\""
+       << EscapeLabel(counter.first) << "\"} " << counter.second.count << '\n';
+  }
+  os << "# HELP cppmicroservices_perf_amount_total Amounts recorded by "
+        "performance counters.\n"
+        "# TYPE cppmicroservices_perf_amount_total counter\n";
+  for (const auto& counter : counters) {
+    os << "cppmicroservices_perf_amount_total{counter=\""
+       << EscapeLabel(counter.first) << "\"} " << counter.second.amount
+       << '\n';
+  }
+  os << "# HELP cppmicroservices_perf_seconds_total Time recorded by "
+        "performance counters.\n"
+        "# TYPE cppmicroservices_perf_seconds_total counter\n";
+  for (const auto& counter : counters) {
+    os << "cppmicroservices_perf_seconds_total{counter=\""
+       << EscapeLabel(counter.first)
+       << "\"} " << counter.second.duration.count() / 1e9 << '\n';
+  }
+}
+}
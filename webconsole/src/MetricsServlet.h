@@ -0,0 +1,61 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_METRICSSERVLET_H
+#define CPPMICROSERVICES_METRICSSERVLET_H
+
+#include "cppmicroservices/httpservice/HttpServlet.h"
+
+#include <ostream>
+
+namespace cppmicroservices {
+
+class BundleContext;
+
+/**
+ * Serves the runtime state of the framework in a machine readable form:
+ * the installed bundles, the service registrations with the number of
+ * their properties, the components of Declarative Services with their
+ * component configurations by state, the service listeners by object
+ * class, the counters of the asynchronous service event delivery and the
+ * performance counters. The components are left out if no
+ * ServiceComponentRuntime service is registered.
+ *
+ * The state is written as JSON, or in the Prometheus text exposition
+ * format if the <code>format=prometheus</code> query parameter is given
+ * or the client accepts <code>text/plain</code>. The response is streamed
+ * while the bundles and services are visited, it is never built as a
+ * whole.
+ */
+class MetricsServlet : public HttpServlet
+{
+public:
+  void DoGet(HttpServletRequest& request,
+             HttpServletResponse& response) override;
+
+private:
+  static void WriteJson(BundleContext& context, std::ostream& os);
+  static void WritePrometheus(BundleContext& context, std::ostream& os);
+};
+}
+
+#endif // CPPMICROSERVICES_METRICSSERVLET_H
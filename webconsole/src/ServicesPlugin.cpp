@@ -21,6 +21,7 @@
 =============================================================================*/
 
 #include "ServicesPlugin.h"
+#include "ListPage.h"
 
 #include "cppmicroservices/webconsole/WebConsoleDefaultVariableResolver.h"
 
@@ -29,12 +30,10 @@
 
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleContext.h"
-#include "cppmicroservices/BundleResource.h"
-#include "cppmicroservices/BundleResourceStream.h"
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/GetBundleContext.h"
 
-#include <set>
+#include <iterator>
 
 namespace cppmicroservices {
 
@@ -49,36 +48,36 @@ void ServicesPlugin::RenderContent(HttpServletRequest& request,
 {
   std::string pathInfo = request.GetPathInfo();
   if (pathInfo == "/services") {
-    BundleResource res =
-      GetBundleContext().GetBundle().GetResource("/templates/services.html");
-    if (res) {
+    std::string tmpl = ReadTemplateFile("/templates/services.html");
+    if (!tmpl.empty()) {
+      auto ids = GetIds();
+      ListPage page(request, ids.size());
+
       auto& data = std::static_pointer_cast<WebConsoleDefaultVariableResolver>(
                      GetVariableResolver(request))
                      ->GetData();
-      data["services"] = GetIds();
+      data["services"] = GetIdsData(ids, page);
+      data["page"] = page.GetTemplateData();
 
-      BundleResourceStream rs(res, std::ios_base::binary);
-      response.GetOutputStream() << rs.rdbuf();
+      response.GetOutputStream() << tmpl;
     }
   } else if (pathInfo.size() > 20 &&
              pathInfo.compare(0, 20, "/services/interface/") == 0) {
     std::string id = pathInfo.substr(20);
-    BundleResource res = GetBundleContext().GetBundle().GetResource(
-      "/templates/service_interface.html");
-    if (res) {
+    std::string tmpl = ReadTemplateFile("/templates/service_interface.html");
+    if (!tmpl.empty()) {
       auto& data = std::static_pointer_cast<WebConsoleDefaultVariableResolver>(
                      GetVariableResolver(request))
                      ->GetData();
       data["interface"] = id;
       data["services"] = GetInterface(id);
 
-      BundleResourceStream rs(res, std::ios_base::binary);
-      response.GetOutputStream() << rs.rdbuf();
+      response.GetOutputStream() << tmpl;
     }
   }
 }
 
-AbstractWebConsolePlugin::TemplateData ServicesPlugin::GetIds() const
+std::set<std::string> ServicesPlugin::GetIds() const
 {
   std::set<std::string> ids;
   std::vector<ServiceReferenceU> refs = GetContext().GetServiceReferences("");
@@ -89,10 +88,18 @@ AbstractWebConsolePlugin::TemplateData ServicesPlugin::GetIds() const
       ids.insert(id);
     }
   }
+  return ids;
+}
 
+AbstractWebConsolePlugin::TemplateData ServicesPlugin::GetIdsData(
+  const std::set<std::string>& ids,
+  const ListPage& page) const
+{
   TemplateData data(TemplateData::Type::List);
-  for (auto const& id : ids) {
-    data << TemplateData{ "id", id };
+  auto iter =
+    std::next(ids.begin(), static_cast<std::ptrdiff_t>(page.GetStart()));
+  for (std::size_t i = page.GetStart(); i < page.GetEnd(); ++i, ++iter) {
+    data << TemplateData{ "id", *iter };
   }
   return data;
 }
@@ -25,18 +25,24 @@
 
 #include "cppmicroservices/webconsole/SimpleWebConsolePlugin.h"
 
+#include <set>
+
 namespace cppmicroservices {
 
+class ListPage;
+
 class ServicesPlugin : public SimpleWebConsolePlugin
 {
 public:
   ServicesPlugin();
 
 private:
-  void RenderContent(HttpServletRequest& /*request*/,
+  void RenderContent(HttpServletRequest& request,
                      HttpServletResponse& response);
 
-  TemplateData GetIds() const;
+  std::set<std::string> GetIds() const;
+  TemplateData GetIdsData(const std::set<std::string>& ids,
+                          const ListPage& page) const;
   TemplateData GetInterface(const std::string& iid) const;
 };
 }
@@ -30,7 +30,6 @@
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/BundleResource.h"
-#include "cppmicroservices/BundleResourceStream.h"
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/GetBundleContext.h"
 
@@ -43,9 +42,8 @@ SettingsPlugin::SettingsPlugin()
 void SettingsPlugin::RenderContent(HttpServletRequest& request,
                                    HttpServletResponse& response)
 {
-  BundleResource res =
-    GetBundleContext().GetBundle().GetResource("/templates/settings.html");
-  if (res) {
+  std::string tmpl = ReadTemplateFile("/templates/settings.html");
+  if (!tmpl.empty()) {
     auto props = GetBundleContext().GetProperties();
     auto& data = std::static_pointer_cast<WebConsoleDefaultVariableResolver>(
                    GetVariableResolver(request))
@@ -72,8 +70,7 @@ void SettingsPlugin::RenderContent(HttpServletRequest& request,
     }
     data["us-fwprops"] = std::move(fwProps);
 
-    BundleResourceStream rs(res, std::ios_base::binary);
-    response.GetOutputStream() << rs.rdbuf();
+    response.GetOutputStream() << tmpl;
   }
 }
 
@@ -25,6 +25,7 @@
 #include "cppmicroservices/webconsole/WebConsoleDefaultVariableResolver.h"
 
 #include <cassert>
+#include <cstring>
 #include <functional>
 #include <utility>
 
@@ -56,6 +57,26 @@ std::streambuf::int_type VariableResolverStreamBuffer::overflow(int_type ch)
   return traits_type::eof();
 }
 
+std::streamsize VariableResolverStreamBuffer::xsputn(const char* s,
+                                                    std::streamsize n)
+{
+  const char* const end = s + n;
+  while (s != end) {
+    if (m_State == State::NIL) {
+      auto brace = static_cast<const char*>(
+        std::memchr(s, '{', static_cast<std::size_t>(end - s)));
+      const char* textEnd = brace ? brace : end;
+      m_Out->write(s, textEnd - s);
+      s = textEnd;
+      if (s == end) {
+        break;
+      }
+    }
+    Parse(*s++);
+  }
+  return n;
+}
+
 int VariableResolverStreamBuffer::sync()
 {
   return 0;
@@ -48,6 +48,12 @@ public:
 private:
   int_type overflow(int_type ch);
 
+  /**
+   * Writes text outside of mustache tags to the output stream as a block
+   * and parses the rest character by character.
+   */
+  std::streamsize xsputn(const char* s, std::streamsize n);
+
   int sync();
 
   /**
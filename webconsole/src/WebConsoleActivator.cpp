@@ -25,6 +25,7 @@
 #include "cppmicroservices/BundleActivator.h"
 
 #include "BundlesPlugin.h"
+#include "MetricsServlet.h"
 #include "ServicesPlugin.h"
 #include "SettingsPlugin.h"
 
@@ -41,6 +42,7 @@ public:
 
 private:
   std::shared_ptr<HttpServlet> m_WebConsoleServlet;
+  std::shared_ptr<HttpServlet> m_MetricsServlet;
 
   std::shared_ptr<SettingsPlugin> m_SettingsPlugin;
   std::shared_ptr<ServicesPlugin> m_ServicesPlugin;
@@ -59,6 +61,11 @@ void WebConsoleActivator::Start(BundleContext context)
 
   std::cout << "****** Registering WebConsoleServlet at /console" << std::endl;
 
+  m_MetricsServlet = std::make_shared<MetricsServlet>();
+  cppmicroservices::ServiceProperties metricsProps;
+  metricsProps[HttpServlet::PROP_CONTEXT_ROOT] = std::string("/metrics");
+  context.RegisterService<HttpServlet>(m_MetricsServlet, metricsProps);
+
   m_SettingsPlugin->Register();
   m_ServicesPlugin->Register();
   m_BundlesPlugin->Register();
@@ -22,15 +22,36 @@
 
 #include "cppmicroservices/webconsole/WebConsoleDefaultVariableResolver.h"
 
-#include <string>
+#include "WebConsoleTemplateCache.h"
+
+#include <sstream>
+#include <utility>
 
 namespace cppmicroservices {
 
+WebConsoleDefaultVariableResolver::WebConsoleDefaultVariableResolver() =
+  default;
+
+WebConsoleDefaultVariableResolver::WebConsoleDefaultVariableResolver(
+  std::shared_ptr<WebConsoleTemplateCache> templates)
+  : m_Templates(std::move(templates))
+{}
+
 std::string WebConsoleDefaultVariableResolver::Resolve(
   const std::string& variable) const
 {
-  Kainjow::Mustache mustache(variable);
-  return mustache.render(m_Data);
+  if (!m_Templates) {
+    Kainjow::Mustache mustache(variable);
+    return mustache.render(m_Data);
+  }
+  // the shared template is rendered as is, the errors of this render are
+  // kept out of it
+  auto compiled = m_Templates->Get(variable);
+  std::ostringstream result;
+  std::string error;
+  compiled->render(
+    m_Data, [&result](const std::string& str) { result << str; }, error);
+  return result.str();
 }
 
 MustacheData& WebConsoleDefaultVariableResolver::GetData()
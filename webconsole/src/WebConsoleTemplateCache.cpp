@@ -0,0 +1,64 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "WebConsoleTemplateCache.h"
+
+namespace cppmicroservices {
+
+const std::size_t WebConsoleTemplateCache::DEFAULT_SIZE = 256;
+
+WebConsoleTemplateCache::WebConsoleTemplateCache(std::size_t size)
+  : m_Size(size)
+{}
+
+std::shared_ptr<const Kainjow::Mustache> WebConsoleTemplateCache::Get(
+  const std::string& text)
+{
+  {
+    std::lock_guard<std::mutex> l(m_Mutex);
+    auto iter = m_Index.find(text);
+    if (iter != m_Index.end()) {
+      m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+      return iter->second->mustache;
+    }
+  }
+
+  // parse outside of the lock, another thread might do the same
+  auto mustache = std::make_shared<const Kainjow::Mustache>(text);
+  if (m_Size == 0) {
+    return mustache;
+  }
+
+  std::lock_guard<std::mutex> l(m_Mutex);
+  auto iter = m_Index.find(text);
+  if (iter != m_Index.end()) {
+    return iter->second->mustache;
+  }
+  m_Entries.push_front({ text, mustache });
+  m_Index.emplace(text, m_Entries.begin());
+  while (m_Entries.size() > m_Size) {
+    m_Index.erase(m_Entries.back().text);
+    m_Entries.pop_back();
+  }
+  return mustache;
+}
+}
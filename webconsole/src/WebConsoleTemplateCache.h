@@ -0,0 +1,73 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_WEBCONSOLETEMPLATECACHE_H
+#define CPPMICROSERVICES_WEBCONSOLETEMPLATECACHE_H
+
+#include "cppmicroservices/webconsole/mustache.hpp"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cppmicroservices {
+
+/**
+ * Parsed Mustache templates of a plugin, keyed by their text. The least
+ * recently used template is dropped when the cache is full.
+ */
+class WebConsoleTemplateCache
+{
+public:
+  /// The number of templates a cache holds if not told otherwise.
+  static const std::size_t DEFAULT_SIZE;
+
+  explicit WebConsoleTemplateCache(std::size_t size = DEFAULT_SIZE);
+
+  /**
+   * Returns the parsed template for <code>text</code>, parsing it if it is
+   * not cached. The returned template is shared, render it with the const
+   * <code>render</code> overload which reports errors per render.
+   */
+  std::shared_ptr<const Kainjow::Mustache> Get(const std::string& text);
+
+private:
+  struct Entry
+  {
+    std::string text;
+    std::shared_ptr<const Kainjow::Mustache> mustache;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const std::size_t m_Size;
+
+  std::mutex m_Mutex;
+  EntryList m_Entries; ///< most recently used first
+  std::unordered_map<std::string, EntryList::iterator> m_Index;
+};
+}
+
+#endif // CPPMICROSERVICES_WEBCONSOLETEMPLATECACHE_H
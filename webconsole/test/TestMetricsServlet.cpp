@@ -0,0 +1,207 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "cppmicroservices/httpservice/ServletContainer.h"
+
+#include "civetweb/civetweb.h"
+#include "rapidjson/document.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace cppmicroservices;
+
+namespace {
+
+const int PORT = 18452;
+
+class MetricsServletTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_LISTENING_PORTS] =
+      std::string("127.0.0.1:") + std::to_string(PORT);
+    framework = std::make_shared<Framework>(
+      FrameworkFactory().NewFramework(config));
+    framework->Start();
+
+    auto context = framework->GetBundleContext();
+    for (auto& bundle : context.InstallBundles(US_WEBCONSOLE_BUNDLE_FILE)) {
+      bundle.Start();
+    }
+#ifdef US_DS_BUNDLE_FILE
+    for (auto& bundle : context.InstallBundles(US_DS_BUNDLE_FILE)) {
+      bundle.Start();
+    }
+    for (auto& bundle : context.InstallBundles(US_DS_TEST_BUNDLE_FILE)) {
+      bundle.Start();
+    }
+#endif
+
+    container = std::make_unique<ServletContainer>(context, "us");
+    container->Start();
+  }
+
+  void TearDown() override
+  {
+    container->Stop();
+    container.reset();
+    framework->Stop();
+    framework->WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  /// Requests the path and returns the status code and the body
+  int Fetch(const std::string& path,
+            const std::string& headers,
+            std::string& body)
+  {
+    char ebuf[256] = { 0 };
+    mg_connection* conn =
+      mg_download("127.0.0.1",
+                  PORT,
+                  0,
+                  ebuf,
+                  sizeof(ebuf),
+                  "GET %s HTTP/1.1\r\nHost: 127.0.0.1\r\n%s"
+                  "Connection: close\r\n\r\n",
+                  path.c_str(),
+                  headers.c_str());
+    if (conn == nullptr) {
+      return -1;
+    }
+    body.clear();
+    char buf[4096];
+    int n = 0;
+    while ((n = mg_read(conn, buf, sizeof(buf))) > 0) {
+      body.append(buf, static_cast<std::size_t>(n));
+    }
+    // the request URI of a response holds its status code
+    const int status = std::atoi(mg_get_request_info(conn)->request_uri);
+    mg_close_connection(conn);
+    return status;
+  }
+
+  std::shared_ptr<Framework> framework;
+  std::unique_ptr<ServletContainer> container;
+};
+
+// Checks that every line is a comment or a sample of the Prometheus text
+// exposition format
+void ExpectPrometheusFormat(const std::string& text)
+{
+  const std::regex comment("# (HELP|TYPE) [a-zA-Z_:][a-zA-Z0-9_:]* .*");
+  const std::regex sample(
+    "[a-zA-Z_:][a-zA-Z0-9_:]*"
+    "(\\{[a-zA-Z_][a-zA-Z0-9_]*=\"([^\"\\\\]|\\\\.)*\""
+    "(,[a-zA-Z_][a-zA-Z0-9_]*=\"([^\"\\\\]|\\\\.)*\")*\\})?"
+    " [-+]?[0-9.]+([eE][-+]?[0-9]+)?");
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    EXPECT_TRUE(std::regex_match(line, comment) ||
+                std::regex_match(line, sample))
+      << line;
+  }
+}
+}
+
+TEST_F(MetricsServletTest, JsonMetrics)
+{
+  std::string body;
+  ASSERT_EQ(Fetch("/us/metrics", "", body), 200);
+
+  rapidjson::Document doc;
+  doc.Parse(body.c_str(), body.size());
+  ASSERT_FALSE(doc.HasParseError()) << body;
+  ASSERT_TRUE(doc.IsObject());
+  ASSERT_TRUE(doc.HasMember("bundles"));
+  EXPECT_TRUE(doc["bundles"].IsArray());
+  ASSERT_TRUE(doc.HasMember("services"));
+  EXPECT_TRUE(doc["services"].IsArray());
+  ASSERT_TRUE(doc.HasMember("service_listeners"));
+  EXPECT_TRUE(doc["service_listeners"].IsObject());
+  ASSERT_TRUE(doc.HasMember("service_event_delivery"));
+  EXPECT_TRUE(doc["service_event_delivery"].IsObject());
+  ASSERT_TRUE(doc.HasMember("performance_counters"));
+  EXPECT_TRUE(doc["performance_counters"].IsObject());
+}
+
+TEST_F(MetricsServletTest, PrometheusMetrics)
+{
+  std::string body;
+  ASSERT_EQ(Fetch("/us/metrics?format=prometheus", "", body), 200);
+  EXPECT_NE(body.find("cppmicroservices_bundles{state=\"ACTIVE\"}"),
+            std::string::npos);
+  ExpectPrometheusFormat(body);
+
+  std::string accepted;
+  ASSERT_EQ(Fetch("/us/metrics", "Accept: text/plain\r\n", accepted), 200);
+  ExpectPrometheusFormat(accepted);
+  EXPECT_NE(accepted.find("cppmicroservices_services "), std::string::npos);
+}
+
+#ifdef US_DS_BUNDLE_FILE
+TEST_F(MetricsServletTest, ComponentMetrics)
+{
+  // the component of the test bundle is activated asynchronously
+  std::string body;
+  rapidjson::Document doc;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(Fetch("/us/metrics", "", body), 200);
+    doc.Parse(body.c_str(), body.size());
+    ASSERT_FALSE(doc.HasParseError()) << body;
+    ASSERT_TRUE(doc.HasMember("components")) << body;
+    if (doc["components"]["configurations"]["ACTIVE"].GetUint64() == 1) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  const auto& components = doc["components"];
+  EXPECT_EQ(components["count"].GetUint64(), 1u);
+  EXPECT_EQ(components["configurations"]["ACTIVE"].GetUint64(), 1u);
+  EXPECT_EQ(components["configurations"]["SATISFIED"].GetUint64(), 0u);
+  EXPECT_EQ(
+    components["configurations"]["UNSATISFIED_REFERENCE"].GetUint64(), 0u);
+
+  ASSERT_EQ(Fetch("/us/metrics?format=prometheus", "", body), 200);
+  ExpectPrometheusFormat(body);
+  EXPECT_NE(body.find("cppmicroservices_components 1\n"), std::string::npos);
+  EXPECT_NE(
+    body.find("cppmicroservices_component_configurations{state=\"ACTIVE\"} 1\n"),
+    std::string::npos);
+}
+#endif
@@ -0,0 +1,242 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "cppmicroservices/httpservice/ServletContainer.h"
+
+#include "civetweb/civetweb.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+using namespace cppmicroservices;
+
+namespace {
+
+const int PORT = 18456;
+
+struct TestServiceA
+{
+  virtual ~TestServiceA() = default;
+};
+
+struct TestServiceB
+{
+  virtual ~TestServiceB() = default;
+};
+
+class WebConsolePagesTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    FrameworkConfiguration config;
+    config[ServletContainer::PROP_LISTENING_PORTS] =
+      std::string("127.0.0.1:") + std::to_string(PORT);
+    framework = std::make_shared<Framework>(
+      FrameworkFactory().NewFramework(config));
+    framework->Start();
+
+    auto context = framework->GetBundleContext();
+    for (auto& bundle : context.InstallBundles(US_WEBCONSOLE_BUNDLE_FILE)) {
+      bundle.Start();
+      webConsole = bundle;
+    }
+
+    container = std::make_unique<ServletContainer>(context, "us");
+    container->Start();
+  }
+
+  void TearDown() override
+  {
+    container->Stop();
+    container.reset();
+    framework->Stop();
+    framework->WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  /// Requests the path and returns the status code and the body
+  int Fetch(const std::string& path, std::string& body)
+  {
+    char ebuf[256] = { 0 };
+    mg_connection* conn =
+      mg_download("127.0.0.1",
+                  PORT,
+                  0,
+                  ebuf,
+                  sizeof(ebuf),
+                  "GET %s HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                  "Connection: close\r\n\r\n",
+                  path.c_str());
+    if (conn == nullptr) {
+      return -1;
+    }
+    body.clear();
+    char buf[4096];
+    int n = 0;
+    while ((n = mg_read(conn, buf, sizeof(buf))) > 0) {
+      body.append(buf, static_cast<std::size_t>(n));
+    }
+    // the request URI of a response holds its status code
+    const int status = std::atoi(mg_get_request_info(conn)->request_uri);
+    mg_close_connection(conn);
+    return status;
+  }
+
+  /// The pager of the bundle list for the query, or an empty string if
+  /// the whole list is shown
+  std::string GetBundlesPager(const std::string& query)
+  {
+    std::string body;
+    EXPECT_EQ(Fetch("/us/console/bundles" + query, body), 200) << query;
+    const auto begin = body.find("<ul class=\"pager\">");
+    if (begin == std::string::npos) {
+      return std::string();
+    }
+    return body.substr(begin, body.find("</ul>", begin) - begin);
+  }
+
+  /// The text of a pager showing the entries first to last
+  std::string Range(std::size_t first, std::size_t last) const
+  {
+    return "<li>" + std::to_string(first) + " - " + std::to_string(last) +
+           " of " + std::to_string(GetBundleCount()) + "</li>";
+  }
+
+  std::size_t GetBundleCount() const
+  {
+    return framework->GetBundleContext().GetBundles().size();
+  }
+
+  std::shared_ptr<Framework> framework;
+  Bundle webConsole;
+  std::unique_ptr<ServletContainer> container;
+};
+}
+
+TEST_F(WebConsolePagesTest, BundlesPaging)
+{
+  const std::size_t total = GetBundleCount();
+  ASSERT_GE(total, 2u);
+
+  // the whole list fits onto the default page
+  EXPECT_EQ(GetBundlesPager(""), "");
+
+  // the first page
+  std::string pager = GetBundlesPager("?count=1");
+  EXPECT_NE(pager.find(Range(1, 1)), std::string::npos) << pager;
+  EXPECT_NE(pager.find("?start=1&amp;count=1\""), std::string::npos) << pager;
+  EXPECT_EQ(pager.find("class=\"previous\""), std::string::npos) << pager;
+
+  // a page in between
+  pager = GetBundlesPager("?start=1&count=1");
+  EXPECT_NE(pager.find(Range(2, 2)), std::string::npos) << pager;
+  EXPECT_NE(pager.find("?start=0&amp;count=1\""), std::string::npos) << pager;
+
+  // the last page, also for a start beyond the end
+  for (const std::string& start : { std::to_string(total - 1),
+                                    std::to_string(total),
+                                    std::string("1000") }) {
+    pager = GetBundlesPager("?start=" + start + "&count=1");
+    EXPECT_NE(pager.find(Range(total, total)), std::string::npos)
+      << start << " " << pager;
+    EXPECT_EQ(pager.find("class=\"next\""), std::string::npos) << pager;
+  }
+
+  // the parameters in any order, with others around them
+  pager = GetBundlesPager("?x=y&count=1&z&start=1");
+  EXPECT_NE(pager.find(Range(2, 2)), std::string::npos) << pager;
+}
+
+TEST_F(WebConsolePagesTest, InvalidPagingParameters)
+{
+  // the default count is used
+  for (const char* query : { "?count=0",
+                             "?count=",
+                             "?count=abc",
+                             "?count=-1",
+                             "?count=1x",
+                             "?count=+1",
+                             "?count=1234567890",
+                             "?xcount=1",
+                             "?Count=1" }) {
+    EXPECT_EQ(GetBundlesPager(query), "") << query;
+  }
+
+  // the first page is shown
+  for (const char* query : { "?start=abc&count=1",
+                             "?start=-1&count=1",
+                             "?start=&count=1",
+                             "?start=12345678901&count=1",
+                             "?count=1&count=2" }) {
+    const std::string pager = GetBundlesPager(query);
+    EXPECT_NE(pager.find(Range(1, 1)), std::string::npos)
+      << query << " " << pager;
+  }
+}
+
+TEST_F(WebConsolePagesTest, ServicesPaging)
+{
+  // besides the HttpServlet interface of the console
+  auto context = framework->GetBundleContext();
+  context.RegisterService<TestServiceA>(std::make_shared<TestServiceA>());
+  context.RegisterService<TestServiceB>(std::make_shared<TestServiceB>());
+
+  std::string body;
+  ASSERT_EQ(Fetch("/us/console/services", body), 200);
+  EXPECT_EQ(body.find("<ul class=\"pager\">"), std::string::npos);
+
+  ASSERT_EQ(Fetch("/us/console/services?count=1", body), 200);
+  EXPECT_NE(body.find("<li>1 - 1 of 3</li>"), std::string::npos);
+  EXPECT_NE(body.find("?start=1&amp;count=1\""), std::string::npos);
+
+  ASSERT_EQ(Fetch("/us/console/services?start=2&count=2", body), 200);
+  EXPECT_NE(body.find("<li>3 - 3 of 3</li>"), std::string::npos);
+  EXPECT_NE(body.find("?start=0&amp;count=2\""), std::string::npos);
+}
+
+TEST_F(WebConsolePagesTest, PluginRestart)
+{
+  std::string before;
+  ASSERT_EQ(Fetch("/us/console/bundles", before), 200);
+
+  // the plugins and their cached templates go away with the bundle
+  webConsole.Stop();
+  std::string body;
+  EXPECT_EQ(Fetch("/us/console/bundles", body), 404);
+
+  // and new plugins render the pages from scratch
+  webConsole.Start();
+  ASSERT_EQ(Fetch("/us/console/bundles", body), 200);
+  EXPECT_EQ(body, before);
+  ASSERT_EQ(Fetch("/us/console/bundles?count=1", body), 200);
+  EXPECT_NE(body.find(Range(1, 1)), std::string::npos);
+}
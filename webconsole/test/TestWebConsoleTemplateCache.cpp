@@ -0,0 +1,179 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "WebConsoleTemplateCache.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppmicroservices;
+
+namespace {
+
+using Mustache = Kainjow::Mustache;
+using Data = Kainjow::Mustache::Data;
+
+/// Renders the shared template and returns the text, the error of the
+/// render is stored in error
+std::string Render(const Mustache& mustache,
+                   const Data& data,
+                   std::string& error)
+{
+  std::ostringstream result;
+  mustache.render(
+    data, [&result](const std::string& str) { result << str; }, error);
+  return result.str();
+}
+}
+
+TEST(WebConsoleTemplateCacheTest, SharesParsedTemplates)
+{
+  WebConsoleTemplateCache cache;
+  auto hello = cache.Get("Hello {{name}}");
+  EXPECT_EQ(cache.Get("Hello {{name}}"), hello);
+
+  std::string error;
+  EXPECT_EQ(Render(*hello, Data("name", "World"), error), "Hello World");
+  EXPECT_TRUE(error.empty());
+}
+
+TEST(WebConsoleTemplateCacheTest, ChangedTemplate)
+{
+  WebConsoleTemplateCache cache;
+  auto before = cache.Get("<p>{{name}}</p>");
+  auto after = cache.Get("<div>{{name}}</div>");
+  EXPECT_NE(before, after);
+
+  std::string error;
+  EXPECT_EQ(Render(*after, Data("name", "x"), error), "<div>x</div>");
+  EXPECT_EQ(Render(*before, Data("name", "x"), error), "<p>x</p>");
+}
+
+TEST(WebConsoleTemplateCacheTest, EvictsLeastRecentlyUsed)
+{
+  WebConsoleTemplateCache cache(2);
+  auto a = cache.Get("a");
+  std::weak_ptr<const Mustache> b = cache.Get("b");
+  EXPECT_EQ(cache.Get("a"), a);
+  cache.Get("c");
+
+  // b was used least recently and is gone
+  EXPECT_TRUE(b.expired());
+  EXPECT_EQ(cache.Get("a"), a);
+}
+
+TEST(WebConsoleTemplateCacheTest, ZeroSize)
+{
+  WebConsoleTemplateCache cache(0);
+  std::weak_ptr<const Mustache> first = cache.Get("a");
+  EXPECT_TRUE(first.expired());
+}
+
+TEST(WebConsoleTemplateCacheTest, DroppedWithCache)
+{
+  // the templates of a plugin go away with the plugin's cache, unless a
+  // render still uses them
+  auto cache = std::make_shared<WebConsoleTemplateCache>();
+  std::weak_ptr<const Mustache> dropped = cache->Get("a");
+  auto used = cache->Get("b");
+  cache.reset();
+  EXPECT_TRUE(dropped.expired());
+
+  std::string error;
+  EXPECT_EQ(Render(*used, Data(), error), "b");
+}
+
+TEST(WebConsoleTemplateCacheTest, InvalidTemplate)
+{
+  WebConsoleTemplateCache cache;
+  auto invalid = cache.Get("{{#open}}");
+  ASSERT_FALSE(invalid->isValid());
+
+  std::string error;
+  EXPECT_EQ(Render(*invalid, Data("open", Data::Type::True), error), "");
+  EXPECT_EQ(error, invalid->errorMessage());
+}
+
+TEST(WebConsoleTemplateCacheTest, ErrorsArePerRender)
+{
+  WebConsoleTemplateCache cache;
+  auto mustache = cache.Get("[{{#wrap}}x{{/wrap}}]");
+
+  // the lambda produces a template which does not parse
+  Data broken;
+  broken["wrap"] =
+    Data::LambdaType([](const std::string&) { return std::string("{{#y}}"); });
+  std::string error;
+  Render(*mustache, broken, error);
+  EXPECT_FALSE(error.empty());
+
+  // the error stays with the render
+  EXPECT_TRUE(mustache->isValid());
+  EXPECT_EQ(cache.Get("[{{#wrap}}x{{/wrap}}]"), mustache);
+  Data working;
+  working["wrap"] = Data::LambdaType(
+    [](const std::string& text) { return "<b>" + text + "</b>"; });
+  EXPECT_EQ(Render(*mustache, working, error), "[<b>x</b>]");
+  EXPECT_TRUE(error.empty());
+}
+
+TEST(WebConsoleTemplateCacheTest, ConcurrentRenders)
+{
+  WebConsoleTemplateCache cache;
+  auto mustache = cache.Get(
+    "{{#items}}<li>{{name}}{{^last}},{{/last}}</li>{{/items}}{{! list }}");
+
+  std::vector<std::thread> threads;
+  std::vector<int> failures(8, 0);
+  for (std::size_t t = 0; t < failures.size(); ++t) {
+    threads.emplace_back([&, t] {
+      Data items = Data::List();
+      std::string expected;
+      for (std::size_t i = 0; i <= t; ++i) {
+        Data item;
+        item["name"] = std::to_string(t) + "." + std::to_string(i);
+        item["last"] = i == t ? Data::Type::True : Data::Type::False;
+        items.push_back(item);
+        expected += "<li>" + std::to_string(t) + "." + std::to_string(i) +
+                    (i == t ? "" : ",") + "</li>";
+      }
+      Data data("items", items);
+      for (int i = 0; i < 500; ++i) {
+        std::string error;
+        if (Render(*mustache, data, error) != expected || !error.empty()) {
+          ++failures[t];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (std::size_t t = 0; t < failures.size(); ++t) {
+    EXPECT_EQ(failures[t], 0) << "thread " << t;
+  }
+}